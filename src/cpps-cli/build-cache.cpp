@@ -0,0 +1,576 @@
+#include "cpps-cli/build-cache.hpp"
+
+#include <cstring>
+#include <optional>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "cpps/diagnosis.hpp"
+#include "cpps/utility/trace.hpp"
+
+#if !defined(CPPS_VERSION)
+#define CPPS_VERSION "unknown"
+#endif
+
+namespace CPPS::CLI {
+
+namespace {
+
+constexpr std::uint64_t HashMultiplier{0x9E3779B97F4A7C15ULL};
+
+constexpr std::uint64_t mix(std::uint64_t value)
+{
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+// not cryptographic, the content size is stored along to lower the collision odds further
+std::uint64_t hash(std::string_view data, std::uint64_t seed)
+{
+    std::uint64_t result = seed ^ (data.size() * HashMultiplier);
+
+    std::size_t index = 0;
+
+    for (; index + sizeof(std::uint64_t) <= data.size(); index += sizeof(std::uint64_t))
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data.data() + index, sizeof(word));
+
+        result = mix(result ^ word) * HashMultiplier;
+    }
+
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, data.data() + index, data.size() - index);
+
+    return mix(result ^ tail);
+}
+
+std::uint64_t getSeed()
+{
+    static const std::uint64_t Seed = hash(fmt::format("cpps {} cache {}", BuildCache::getBuildId(), BuildCache::FormatVersion), 0);
+    return Seed;
+}
+
+std::string makeBuildId()
+{
+    std::string buildId = CPPS_VERSION;
+
+#if defined(__linux__)
+    struct stat status
+    {
+    };
+
+    if (stat("/proc/self/exe", &status) == 0)
+    {
+        buildId += fmt::format(" {} {}.{}", status.st_size, status.st_mtim.tv_sec, status.st_mtim.tv_nsec);
+    }
+#endif
+
+    return buildId;
+}
+
+template<typename T>
+void write(std::string& data, T value)
+{
+    const std::size_t size = data.size();
+    data.resize(size + sizeof(T));
+    std::memcpy(data.data() + size, &value, sizeof(T));
+}
+
+void writeString(std::string& data, std::string_view text)
+{
+    write(data, static_cast<std::uint32_t>(text.size()));
+    data += text;
+}
+
+template<typename T>
+bool read(std::string_view& data, T& value)
+{
+    if (data.size() < sizeof(T))
+    {
+        return false;
+    }
+
+    std::memcpy(&value, data.data(), sizeof(T));
+    data.remove_prefix(sizeof(T));
+
+    return true;
+}
+
+bool readString(std::string_view& data, std::string& text)
+{
+    std::uint32_t size = 0;
+
+    if (!read(data, size) || data.size() < size)
+    {
+        return false;
+    }
+
+    text = data.substr(0, size);
+    data.remove_prefix(size);
+
+    return true;
+}
+
+constexpr unsigned IsErrorFlag{1U << 0U};
+constexpr unsigned HasLocationFlag{1U << 1U};
+constexpr unsigned HasFixMessageFlag{1U << 2U};
+
+void serializeEntry(std::string& data, const Diagnosis::Entry& entry, bool isError)
+{
+    const unsigned flags = (isError ? IsErrorFlag : 0U) | (entry.location ? HasLocationFlag : 0U) | (entry.fixMessage ? HasFixMessageFlag : 0U);
+
+    write(data, static_cast<std::uint8_t>(flags));
+
+    if (entry.location)
+    {
+        write(data, entry.location->line);
+        write(data, entry.location->column);
+    }
+
+    writeString(data, entry.message.str());
+
+    if (entry.fixMessage)
+    {
+        writeString(data, *entry.fixMessage);
+    }
+}
+
+} // namespace
+
+#if defined(_WIN32)
+
+BuildCache::BuildCache(std::filesystem::path directory)
+    : _directory(std::move(directory))
+{
+}
+
+BuildCache::~BuildCache() = default;
+
+bool BuildCache::open(Diagnosis& diagnosis)
+{
+    diagnosis.error("the build cache is not supported on this platform");
+    return false;
+}
+
+bool BuildCache::flush(Diagnosis&)
+{
+    return true;
+}
+
+bool BuildCache::replay(const Key&, Diagnosis&)
+{
+    return false;
+}
+
+#else
+
+namespace {
+
+// unlocks on destruction
+class FileLock
+{
+public:
+    FileLock(int fd, int operation)
+        : _fd(fd)
+        , _isLocked(flock(fd, operation) == 0)
+    {
+    }
+
+    ~FileLock()
+    {
+        if (_isLocked)
+        {
+            flock(_fd, LOCK_UN);
+        }
+    }
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+    FileLock(FileLock&&) = delete;
+    FileLock& operator=(FileLock&&) = delete;
+
+    [[nodiscard]] bool isLocked() const
+    {
+        return _isLocked;
+    }
+
+private:
+    int _fd;
+    bool _isLocked;
+};
+
+bool writeAll(int fd, const void* data, std::size_t size, off_t offset)
+{
+    const auto* bytes = static_cast<const char*>(data);
+
+    while (size > 0)
+    {
+        const ssize_t written = pwrite(fd, bytes, size, offset);
+
+        if (written <= 0)
+        {
+            return false;
+        }
+
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+        offset += written;
+    }
+
+    return true;
+}
+
+std::optional<std::size_t> getFileSize(int fd)
+{
+    struct stat status
+    {
+    };
+
+    if (fstat(fd, &status) != 0)
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<std::size_t>(status.st_size);
+}
+
+} // namespace
+
+BuildCache::BuildCache(std::filesystem::path directory)
+    : _directory(std::move(directory))
+{
+}
+
+BuildCache::~BuildCache()
+{
+    if (_indexFd >= 0)
+    {
+        close(_indexFd);
+    }
+
+    if (_dataFd >= 0)
+    {
+        close(_dataFd);
+    }
+}
+
+bool BuildCache::open(Diagnosis& diagnosis)
+{
+    CPPS_TRACE_ZONE("BuildCache::open");
+
+    std::error_code error;
+
+    std::filesystem::create_directories(_directory, error);
+
+    if (error)
+    {
+        diagnosis.error(fmt::format("cannot create the build cache directory {}: {}", _directory.string(), error.message()));
+        return false;
+    }
+
+    _indexFd = ::open((_directory / "index").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    _dataFd = ::open((_directory / "data").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+    if (_indexFd < 0 || _dataFd < 0)
+    {
+        diagnosis.error(fmt::format("cannot open the build cache in {}", _directory.string()));
+        return false;
+    }
+
+    const FileLock lock{_indexFd, LOCK_SH};
+
+    if (!lock.isLocked())
+    {
+        diagnosis.error(fmt::format("cannot lock the build cache in {}", _directory.string()));
+        return false;
+    }
+
+    const std::optional<std::size_t> size = getFileSize(_indexFd);
+
+    if (!size || *size <= sizeof(IndexHeader))
+    {
+        return true;
+    }
+
+    void* data = mmap(nullptr, *size, PROT_READ, MAP_SHARED, _indexFd, 0);
+
+    if (data == MAP_FAILED)
+    {
+        diagnosis.error(fmt::format("cannot map the build cache index in {}", _directory.string()));
+        return false;
+    }
+
+    loadIndex(static_cast<const std::byte*>(data), *size);
+
+    munmap(data, *size);
+
+    return true;
+}
+
+bool BuildCache::flush(Diagnosis& diagnosis)
+{
+    CPPS_TRACE_ZONE("BuildCache::flush");
+
+    const std::scoped_lock pendingLock{_pendingMutex};
+
+    if (_pendingEntries.empty())
+    {
+        return true;
+    }
+
+    const FileLock lock{_indexFd, LOCK_EX};
+
+    auto fail = [this, &diagnosis] {
+        diagnosis.error(fmt::format("cannot write the build cache in {}", _directory.string()));
+        return false;
+    };
+
+    if (!lock.isLocked())
+    {
+        return fail();
+    }
+
+    std::optional<std::size_t> indexSize = getFileSize(_indexFd);
+    std::optional<std::size_t> dataSize = getFileSize(_dataFd);
+
+    if (!indexSize || !dataSize)
+    {
+        return fail();
+    }
+
+    IndexHeader header{};
+
+    const bool hasValidHeader = *indexSize >= sizeof(IndexHeader) && pread(_indexFd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header))
+                             && header.magic == Header.magic && header.version == Header.version && header.recordSize == Header.recordSize;
+
+    // a new or unreadable cache starts over
+    if (!hasValidHeader)
+    {
+        if (ftruncate(_indexFd, 0) != 0 || ftruncate(_dataFd, 0) != 0 || !writeAll(_indexFd, &Header, sizeof(Header), 0))
+        {
+            return fail();
+        }
+
+        indexSize = sizeof(IndexHeader);
+        dataSize = 0;
+    }
+
+    // drops the partial record of a torn write
+    const std::size_t recordsSize = (*indexSize - sizeof(IndexHeader)) / sizeof(IndexRecord) * sizeof(IndexRecord);
+    off_t indexOffset = static_cast<off_t>(sizeof(IndexHeader) + recordsSize);
+    off_t dataOffset = static_cast<off_t>(*dataSize);
+
+    std::vector<IndexRecord> records;
+    records.reserve(_pendingEntries.size());
+
+    for (const PendingEntry& entry : _pendingEntries)
+    {
+        const IndexRecord& record = records.emplace_back(IndexRecord{
+            .hash = entry.key.hash,
+            .contentSize = entry.key.contentSize,
+            .dataOffset = static_cast<std::uint64_t>(dataOffset),
+            .dataSize = static_cast<std::uint32_t>(entry.data.size()),
+            .dataChecksum = static_cast<std::uint32_t>(hash(entry.data, 0))});
+
+        // the data first, a record never points to missing data
+        if (!writeAll(_dataFd, entry.data.data(), entry.data.size(), dataOffset) || !writeAll(_indexFd, &record, sizeof(record), indexOffset))
+        {
+            return fail();
+        }
+
+        dataOffset += static_cast<off_t>(entry.data.size());
+        indexOffset += static_cast<off_t>(sizeof(record));
+    }
+
+    if (ftruncate(_indexFd, indexOffset) != 0)
+    {
+        return fail();
+    }
+
+    _pendingEntries.clear();
+
+    const std::unique_lock recordsLock{_recordsMutex};
+
+    for (const IndexRecord& record : records)
+    {
+        _records.insert_or_assign(record.hash, record);
+    }
+
+    return true;
+}
+
+bool BuildCache::replay(const Key& key, Diagnosis& diagnosis)
+{
+    IndexRecord record{};
+
+    {
+        const std::shared_lock lock{_recordsMutex};
+
+        const auto it = _records.find(key.hash);
+
+        if (it == _records.end() || it->second.contentSize != key.contentSize)
+        {
+            return false;
+        }
+
+        record = it->second;
+    }
+
+    std::string data(record.dataSize, '\0');
+
+    const bool isRead = pread(_dataFd, data.data(), data.size(), static_cast<off_t>(record.dataOffset)) == static_cast<ssize_t>(data.size());
+
+    return isRead && static_cast<std::uint32_t>(hash(data, 0)) == record.dataChecksum && deserialize(data, diagnosis);
+}
+
+#endif
+
+BuildCache::Key BuildCache::makeKey(std::string_view content, const Diagnosis& diagnosis)
+{
+    const std::uint64_t settings = mix(diagnosis.getErrorLimit() ^ (diagnosis.isFailFast() ? HashMultiplier : 0));
+
+    return Key{.hash = hash(content, getSeed() ^ settings), .contentSize = content.size()};
+}
+
+const std::string& BuildCache::getBuildId()
+{
+    static const std::string BuildId = makeBuildId();
+    return BuildId;
+}
+
+void BuildCache::add(const Key& key, const Diagnosis& diagnosis)
+{
+    std::string data = serialize(diagnosis);
+
+    const std::scoped_lock lock{_pendingMutex};
+
+    _pendingEntries.push_back(PendingEntry{.key = key, .data = std::move(data)});
+}
+
+void BuildCache::loadIndex(const std::byte* data, std::size_t size)
+{
+    IndexHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != Header.magic || header.version != Header.version || header.recordSize != Header.recordSize)
+    {
+        return;
+    }
+
+    // a trailing partial record is ignored
+    for (std::size_t offset = sizeof(IndexHeader); offset + sizeof(IndexRecord) <= size; offset += sizeof(IndexRecord))
+    {
+        IndexRecord record{};
+        std::memcpy(&record, data + offset, sizeof(record));
+
+        _records.insert_or_assign(record.hash, record);
+    }
+}
+
+std::string BuildCache::serialize(const Diagnosis& diagnosis)
+{
+    std::string data;
+
+    write(data, static_cast<std::uint32_t>(diagnosis.getErrors().size() + diagnosis.getWarnings().size()));
+
+    for (const Diagnosis::Entry& entry : diagnosis.getErrors())
+    {
+        serializeEntry(data, entry, true);
+    }
+
+    for (const Diagnosis::Entry& entry : diagnosis.getWarnings())
+    {
+        serializeEntry(data, entry, false);
+    }
+
+    return data;
+}
+
+bool BuildCache::deserialize(std::string_view data, Diagnosis& diagnosis)
+{
+    std::uint32_t count = 0;
+
+    if (!read(data, count))
+    {
+        return false;
+    }
+
+    // nothing is added to the diagnosis until the whole data is valid
+    std::vector<std::pair<Diagnosis::Entry, bool>> entries;
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        std::uint8_t flags = 0;
+
+        if (!read(data, flags))
+        {
+            return false;
+        }
+
+        std::optional<SourceLocation> location;
+
+        if ((flags & HasLocationFlag) != 0)
+        {
+            SourceLocation readLocation;
+
+            if (!read(data, readLocation.line) || !read(data, readLocation.column))
+            {
+                return false;
+            }
+
+            location = readLocation;
+        }
+
+        std::string message;
+
+        if (!readString(data, message))
+        {
+            return false;
+        }
+
+        std::optional<std::string> fixMessage;
+
+        if ((flags & HasFixMessageFlag) != 0)
+        {
+            if (!readString(data, fixMessage.emplace()))
+            {
+                return false;
+            }
+        }
+
+        entries.emplace_back(Diagnosis::Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = location}, (flags & IsErrorFlag) != 0);
+    }
+
+    if (!data.empty())
+    {
+        return false;
+    }
+
+    for (auto& [entry, isError] : entries)
+    {
+        if (isError)
+        {
+            diagnosis.error(std::move(entry));
+        }
+        else
+        {
+            diagnosis.warning(std::move(entry));
+        }
+    }
+
+    return true;
+}
+
+} // namespace CPPS::CLI
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CPPS {
+
+class Diagnosis;
+
+namespace CLI {
+
+/**
+ * Persistent cache of the diagnoses of each input, keyed by the hash of its content, of the compiler build
+ * and of the diagnosis settings.
+ *
+ * The directory holds two append-only files:
+ *  - index: a header followed by fixed size records, readable in place (ie mmap)
+ *  - data: the serialized diagnoses the records point to
+ *
+ * The files are locked with flock, shared to load and exclusive to append,
+ * so concurrent driver processes can share the directory. A record is appended after its data,
+ * a torn write leaves a partial record which is ignored and truncated by the next append.
+ * Several processes may append the same key, the last record wins.
+ *
+ * The index is loaded once by open, a long-lived process (see CompileServer) keeps the cache opened
+ * and sees its own flushed entries, not the ones appended by the other processes since.
+ *
+ * The files only grow, delete the directory to reclaim the space.
+ */
+class BuildCache
+{
+public:
+    static constexpr std::uint32_t FormatVersion{1};
+
+    // the hash of the content, seeded by the compiler build, the format version and the diagnosis settings
+    struct Key
+    {
+        std::uint64_t hash{0};
+        std::uint64_t contentSize{0};
+    };
+
+public:
+    explicit BuildCache(std::filesystem::path directory);
+    ~BuildCache();
+
+    BuildCache(const BuildCache&) = delete;
+    BuildCache& operator=(const BuildCache&) = delete;
+    BuildCache(BuildCache&&) = delete;
+    BuildCache& operator=(BuildCache&&) = delete;
+
+    // loads the index, false with an error added to the diagnosis if the cache cannot be used
+    [[nodiscard]] bool open(Diagnosis& diagnosis);
+
+    // the error limit and fail-fast of diagnosis change the stored entries, they are part of the key
+    [[nodiscard]] static Key makeKey(std::string_view content, const Diagnosis& diagnosis);
+
+    // the compiler version and the executable identity (size and modification time), a rebuilt compiler
+    // does not replay the diagnoses of the previous one
+    [[nodiscard]] static const std::string& getBuildId();
+
+    // adds the cached diagnoses of the key to the diagnosis, false if the key is not cached
+    // thread-safe
+    [[nodiscard]] bool replay(const Key& key, Diagnosis& diagnosis);
+
+    // the diagnosis messages must be detached, see Diagnosis::detachMessages
+    // thread-safe, stored by flush
+    void add(const Key& key, const Diagnosis& diagnosis);
+
+    // appends the added entries, they can be replayed afterwards
+    // thread-safe
+    [[nodiscard]] bool flush(Diagnosis& diagnosis);
+
+private:
+    struct IndexHeader
+    {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t recordSize;
+    };
+
+    struct IndexRecord
+    {
+        std::uint64_t hash;
+        std::uint64_t contentSize;
+        std::uint64_t dataOffset;
+        std::uint32_t dataSize;
+        std::uint32_t dataChecksum;
+    };
+
+    struct PendingEntry
+    {
+        Key key;
+        std::string data;
+    };
+
+    static constexpr IndexHeader Header{{'C', 'P', 'P', 'S', 'C', 'A', 'C', 'H'}, FormatVersion, sizeof(IndexRecord)};
+
+    void loadIndex(const std::byte* data, std::size_t size);
+
+    [[nodiscard]] static std::string serialize(const Diagnosis& diagnosis);
+    [[nodiscard]] static bool deserialize(std::string_view data, Diagnosis& diagnosis);
+
+private:
+    std::filesystem::path _directory;
+
+    int _indexFd{-1};
+    int _dataFd{-1};
+
+    // hash -> record, the content size is checked on lookup
+    std::shared_mutex _recordsMutex;
+    std::unordered_map<std::uint64_t, IndexRecord> _records;
+
+    std::mutex _pendingMutex;
+    std::vector<PendingEntry> _pendingEntries;
+};
+
+} // namespace CLI
+
+} // namespace CPPS
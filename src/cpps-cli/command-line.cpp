@@ -0,0 +1,115 @@
+#include "cpps-cli/command-line.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include "cpps/utility/thread-pool.hpp"
+
+namespace CPPS::CLI {
+
+void addArguments(argparse::ArgumentParser& program)
+{
+    program.add_argument("inputs")
+        .help("source files or directories, searched recursively for .cpp2 and .h2 files")
+        .nargs(argparse::nargs_pattern::any);
+
+    program.add_argument("-j", "--jobs")
+        .help("number of threads, defaults to the hardware concurrency")
+        .default_value(ThreadPool::getDefaultThreadsCount())
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--error-limit")
+        .help("report at most the given number of errors, the others are only counted")
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--fail-fast")
+        .help("stop once the error limit is reached, or at the first error without --error-limit")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("--time-report")
+        .help("print the wall time, cpu time, throughput and allocations of each phase")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("--time-report-json")
+        .help("write the time report as json to the given path")
+        .default_value(std::string{});
+
+    program.add_argument("--trace-out")
+        .help("write the trace zones of each thread as chrome trace event json to the given path")
+        .default_value(std::string{});
+
+    program.add_argument("--cache-dir")
+        .help("reuse the diagnoses of the unchanged inputs, stored in the given directory")
+        .default_value(std::string{});
+
+    program.add_argument("--output-dir")
+        .help("write the C++ generated from each input to the given directory")
+        .default_value(std::string{});
+
+    program.add_argument("--watch")
+        .help("recompile each source file when it is written, until interrupted")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("--server")
+        .help("run as a compile server listening on the given unix socket, --jobs clients are served concurrently")
+        .default_value(std::string{});
+
+    program.add_argument("--connect")
+        .help("compile on the server listening on the given unix socket")
+        .default_value(std::string{});
+}
+
+CommandLine getCommandLine(argparse::ArgumentParser& program)
+{
+    CommandLine commandLine;
+    DriverOptions& options = commandLine.driverOptions;
+
+    if (const std::optional<std::vector<std::string>> inputs = program.present<std::vector<std::string>>("inputs"))
+    {
+        for (const std::string& input : *inputs)
+        {
+            options.inputs.emplace_back(input);
+        }
+    }
+
+    options.threadsCount = program.get<std::size_t>("--jobs");
+
+    if (const std::optional<std::size_t> errorLimit = program.present<std::size_t>("--error-limit"))
+    {
+        options.errorLimit = *errorLimit;
+    }
+
+    options.failFast = program.get<bool>("--fail-fast");
+    options.timeReport = program.get<bool>("--time-report");
+    options.timeReportJsonPath = program.get<std::string>("--time-report-json");
+    options.traceOutPath = program.get<std::string>("--trace-out");
+    options.cacheDirectory = program.get<std::string>("--cache-dir");
+    options.outputDirectory = program.get<std::string>("--output-dir");
+
+    commandLine.serverSocketPath = program.get<std::string>("--server");
+    commandLine.connectSocketPath = program.get<std::string>("--connect");
+    commandLine.watch = program.get<bool>("--watch");
+
+    if (options.inputs.empty() && commandLine.serverSocketPath.empty())
+    {
+        throw std::runtime_error{"no inputs given"};
+    }
+
+    // the watcher does not generate
+    if (commandLine.watch && !options.outputDirectory.empty())
+    {
+        throw std::runtime_error{"--output-dir is not supported with --watch"};
+    }
+
+    return commandLine;
+}
+
+} // namespace CPPS::CLI
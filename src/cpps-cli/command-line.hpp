@@ -0,0 +1,36 @@
+#pragma once
+
+#include <filesystem>
+
+#include "cpps-cli/driver.hpp"
+
+namespace argparse {
+
+class ArgumentParser;
+
+} // namespace argparse
+
+namespace CPPS::CLI {
+
+struct CommandLine
+{
+    DriverOptions driverOptions;
+
+    // serve the command lines forwarded on this socket, see CompileServer
+    std::filesystem::path serverSocketPath;
+
+    // forward the command line to the server listening on this socket, see CompileClient
+    std::filesystem::path connectSocketPath;
+
+    // recompile the inputs when they are written, see Watcher
+    bool watch{false};
+};
+
+// shared by main and CompileServer, so a forwarded command line is parsed as a local one
+void addArguments(argparse::ArgumentParser& program);
+
+// the program must be parsed, throws std::runtime_error if neither inputs nor a server socket are given, or if --watch
+// is given with --output-dir
+[[nodiscard]] CommandLine getCommandLine(argparse::ArgumentParser& program);
+
+} // namespace CPPS::CLI
@@ -0,0 +1,667 @@
+#include "cpps-cli/compile-server.hpp"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <argparse/argparse.hpp>
+#include <fmt/format.h>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "cpps/diagnosis.hpp"
+#include "cpps/utility/thread-pool.hpp"
+#include "cpps-cli/build-cache.hpp"
+#include "cpps-cli/command-line.hpp"
+#include "cpps-cli/driver.hpp"
+
+namespace CPPS::CLI {
+
+#if defined(_WIN32)
+
+CompileServer::CompileServer(std::filesystem::path socketPath, std::size_t connectionsCount, std::chrono::milliseconds receiveTimeout)
+    : _socketPath(std::move(socketPath))
+    , _connectionsCount(connectionsCount)
+    , _receiveTimeout(receiveTimeout)
+{
+}
+
+CompileServer::~CompileServer() = default;
+
+int CompileServer::run()
+{
+    fmt::print(stderr, "cpps-cli: error: the compile server is not supported on this platform\n");
+    return 1;
+}
+
+void CompileServer::stop()
+{
+}
+
+CompileClient::CompileClient(std::filesystem::path socketPath)
+    : CompileClient(std::move(socketPath), stderr)
+{
+}
+
+CompileClient::CompileClient(std::filesystem::path socketPath, std::FILE* output)
+    : _socketPath(std::move(socketPath))
+    , _output(output)
+{
+}
+
+int CompileClient::run(const std::vector<std::string>&)
+{
+    fmt::print(_output, "cpps-cli: error: the compile server is not supported on this platform\n");
+    return 1;
+}
+
+#else
+
+namespace {
+
+// the request payload is the working directory then the arguments, each terminated by '\0'
+struct RequestHeader
+{
+    std::uint32_t protocolVersion;
+    std::uint32_t payloadSize;
+};
+
+// followed by the output
+struct ResponseHeader
+{
+    std::int32_t exitCode;
+    std::uint32_t outputSize;
+};
+
+// written by the signal handler to wake up the accept loop
+std::atomic<int> stopPipeWriteFd{-1};
+
+extern "C" void onStopSignal(int)
+{
+    const char byte = 0;
+    [[maybe_unused]] const ssize_t written = write(stopPipeWriteFd, &byte, 1);
+}
+
+// closes on destruction
+class FileDescriptor
+{
+public:
+    explicit FileDescriptor(int fd)
+        : _fd(fd)
+    {
+    }
+
+    ~FileDescriptor()
+    {
+        if (_fd >= 0)
+        {
+            close(_fd);
+        }
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    FileDescriptor(FileDescriptor&&) = delete;
+    FileDescriptor& operator=(FileDescriptor&&) = delete;
+
+    [[nodiscard]] int get() const
+    {
+        return _fd;
+    }
+
+private:
+    int _fd;
+};
+
+bool sendAll(int fd, const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+
+    while (size > 0)
+    {
+        // a disconnected peer must not raise SIGPIPE
+        const ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (sent <= 0)
+        {
+            return false;
+        }
+
+        bytes += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+
+    return true;
+}
+
+bool receiveAll(int fd, void* data, std::size_t size)
+{
+    auto* bytes = static_cast<char*>(data);
+
+    while (size > 0)
+    {
+        const ssize_t received = recv(fd, bytes, size, 0);
+
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (received <= 0)
+        {
+            return false;
+        }
+
+        bytes += received;
+        size -= static_cast<std::size_t>(received);
+    }
+
+    return true;
+}
+
+std::optional<sockaddr_un> makeAddress(const std::filesystem::path& socketPath)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    const std::string& path = socketPath.native();
+
+    // the terminating '\0' included
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return std::nullopt;
+    }
+
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    return address;
+}
+
+bool connectTo(int fd, const sockaddr_un& address)
+{
+    return connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+}
+
+// the output written to a FILE*, as the driver writes to stderr
+class OutputBuffer
+{
+public:
+    OutputBuffer()
+        : _file(open_memstream(&_data, &_size))
+    {
+    }
+
+    ~OutputBuffer()
+    {
+        if (_file != nullptr)
+        {
+            std::fclose(_file);
+        }
+
+        std::free(_data);
+    }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+    OutputBuffer(OutputBuffer&&) = delete;
+    OutputBuffer& operator=(OutputBuffer&&) = delete;
+
+    // nullptr if the stream cannot be created
+    [[nodiscard]] std::FILE* getFile() const
+    {
+        return _file;
+    }
+
+    // valid until the destruction, no more writes afterwards
+    [[nodiscard]] std::string_view take()
+    {
+        std::fclose(_file);
+        _file = nullptr;
+
+        return {_data, _size};
+    }
+
+private:
+    char* _data{nullptr};
+    std::size_t _size{0};
+
+    std::FILE* _file;
+};
+
+} // namespace
+
+CompileServer::CompileServer(std::filesystem::path socketPath, std::size_t connectionsCount, std::chrono::milliseconds receiveTimeout)
+    : _socketPath(std::move(socketPath))
+    , _connectionsCount(connectionsCount)
+    , _receiveTimeout(receiveTimeout)
+{
+}
+
+CompileServer::~CompileServer() = default;
+
+int CompileServer::run()
+{
+    const std::optional<sockaddr_un> address = makeAddress(_socketPath);
+
+    if (!address)
+    {
+        fmt::print(stderr, "cpps-cli: error: the socket path is too long: {}\n", _socketPath.string());
+        return 1;
+    }
+
+    const FileDescriptor listener{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+
+    if (listener.get() < 0)
+    {
+        fmt::print(stderr, "cpps-cli: error: cannot create the socket: {}\n", std::strerror(errno));
+        return 1;
+    }
+
+    // the socket file of a server that did not exit cleanly is replaced, the one of a running server is not
+    {
+        const FileDescriptor probe{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+
+        if (probe.get() >= 0 && connectTo(probe.get(), *address))
+        {
+            fmt::print(stderr, "cpps-cli: error: a server is already listening on {}\n", _socketPath.string());
+            return 1;
+        }
+
+        std::error_code error;
+        std::filesystem::remove(_socketPath, error);
+    }
+
+    if (bind(listener.get(), reinterpret_cast<const sockaddr*>(&*address), sizeof(*address)) != 0 || listen(listener.get(), SOMAXCONN) != 0)
+    {
+        fmt::print(stderr, "cpps-cli: error: cannot listen on {}: {}\n", _socketPath.string(), std::strerror(errno));
+        return 1;
+    }
+
+    std::array<int, 2> stopPipe{-1, -1};
+
+    if (pipe2(stopPipe.data(), O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+        fmt::print(stderr, "cpps-cli: error: cannot create the stop pipe: {}\n", std::strerror(errno));
+        return 1;
+    }
+
+    const FileDescriptor stopPipeRead{stopPipe[0]};
+    const FileDescriptor stopPipeWrite{stopPipe[1]};
+
+    stopPipeWriteFd = stopPipeWrite.get();
+    _stopPipeWriteFd = stopPipeWrite.get();
+
+    // stop may have been called before the pipe was created
+    if (_isStopRequested)
+    {
+        onStopSignal(0);
+    }
+
+    struct sigaction action
+    {
+    };
+
+    action.sa_handler = onStopSignal;
+    sigemptyset(&action.sa_mask);
+
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    fmt::print(stderr, "cpps-cli: listening on {}\n", _socketPath.string());
+
+    {
+        // the drivers of all the requests share the compile threads, the connection threads mostly wait on them
+        ThreadPool compilePool{_connectionsCount};
+        ThreadPool pool{_connectionsCount};
+
+        std::array<pollfd, 2> fds{pollfd{.fd = listener.get(), .events = POLLIN, .revents = 0}, pollfd{.fd = stopPipeRead.get(), .events = POLLIN, .revents = 0}};
+
+        while (true)
+        {
+            if (poll(fds.data(), fds.size(), -1) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                fmt::print(stderr, "cpps-cli: error: cannot poll the socket: {}\n", std::strerror(errno));
+                break;
+            }
+
+            if ((fds[1].revents & POLLIN) != 0)
+            {
+                break;
+            }
+
+            const int connection = accept4(listener.get(), nullptr, nullptr, SOCK_CLOEXEC);
+
+            if (connection >= 0)
+            {
+                const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(_receiveTimeout);
+
+                timeval timeout{};
+                timeout.tv_sec = seconds.count();
+                timeout.tv_usec = std::chrono::duration_cast<std::chrono::microseconds>(_receiveTimeout - seconds).count();
+
+                // an idle client must not hold a connection thread forever
+                setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+                pool.submit([this, connection, &compilePool] { serve(connection, compilePool); });
+            }
+        }
+
+        // the connections still receiving their request are closed, the requests in progress are completed
+        shutdownConnections();
+
+        pool.wait();
+    }
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    stopPipeWriteFd = -1;
+    _stopPipeWriteFd = -1;
+
+    std::error_code error;
+    std::filesystem::remove(_socketPath, error);
+
+    return 0;
+}
+
+void CompileServer::stop()
+{
+    _isStopRequested = true;
+
+    const int fd = _stopPipeWriteFd;
+
+    if (fd >= 0)
+    {
+        const char byte = 0;
+        [[maybe_unused]] const ssize_t written = write(fd, &byte, 1);
+    }
+}
+
+bool CompileServer::addConnection(int connection)
+{
+    const std::scoped_lock lock{_connectionsMutex};
+
+    if (_isStopping)
+    {
+        return false;
+    }
+
+    _connections.insert(connection);
+
+    return true;
+}
+
+void CompileServer::removeConnection(int connection)
+{
+    const std::scoped_lock lock{_connectionsMutex};
+    _connections.erase(connection);
+}
+
+void CompileServer::shutdownConnections()
+{
+    const std::scoped_lock lock{_connectionsMutex};
+
+    _isStopping = true;
+
+    // the blocked receives return, the responses can still be sent
+    for (const int connection : _connections)
+    {
+        shutdown(connection, SHUT_RD);
+    }
+}
+
+void CompileServer::serve(int connection, ThreadPool& compilePool)
+{
+    const FileDescriptor connectionFd{connection};
+
+    if (!addConnection(connection))
+    {
+        return;
+    }
+
+    RequestHeader header{};
+
+    std::string payload;
+
+    // removed before being closed, the descriptor may be reused by another connection afterwards
+    const bool isReceived = [this, connection, &header, &payload] {
+        bool received = receiveAll(connection, &header, sizeof(header));
+
+        // the mismatched and the oversized requests are answered with an error
+        if (received && header.protocolVersion == ProtocolVersion && header.payloadSize <= MaxRequestSize)
+        {
+            payload.resize(header.payloadSize);
+            received = receiveAll(connection, payload.data(), payload.size());
+        }
+
+        removeConnection(connection);
+
+        return received;
+    }();
+
+    if (!isReceived)
+    {
+        return;
+    }
+
+    OutputBuffer output;
+
+    if (output.getFile() == nullptr)
+    {
+        return;
+    }
+
+    int exitCode = 1;
+
+    if (header.protocolVersion != ProtocolVersion)
+    {
+        fmt::print(output.getFile(), "cpps-cli: error: the client protocol version {} does not match the server one {}\n", header.protocolVersion, ProtocolVersion);
+    }
+    else if (header.payloadSize > MaxRequestSize)
+    {
+        fmt::print(output.getFile(), "cpps-cli: error: the command line is larger than {} bytes\n", MaxRequestSize);
+    }
+    else
+    {
+        // working directory, then the arguments
+        std::vector<std::string> strings;
+
+        for (std::size_t begin = 0; begin < payload.size();)
+        {
+            const std::size_t end = payload.find('\0', begin);
+
+            if (end == std::string::npos)
+            {
+                break;
+            }
+
+            strings.emplace_back(payload, begin, end - begin);
+            begin = end + 1;
+        }
+
+        if (strings.size() < 2)
+        {
+            fmt::print(output.getFile(), "cpps-cli: error: invalid request\n");
+        }
+        else
+        {
+            const std::filesystem::path workingDirectory = strings.front();
+            strings.erase(strings.begin());
+
+            try
+            {
+                exitCode = compile(strings, workingDirectory, output.getFile(), compilePool);
+            }
+            catch (const std::exception& exception)
+            {
+                fmt::print(output.getFile(), "cpps-cli: error: {}\n", exception.what());
+            }
+        }
+    }
+
+    const std::string_view text = output.take();
+
+    const ResponseHeader response{.exitCode = exitCode, .outputSize = static_cast<std::uint32_t>(text.size())};
+
+    // a disconnected client is ignored
+    if (sendAll(connection, &response, sizeof(response)))
+    {
+        [[maybe_unused]] const bool isSent = sendAll(connection, text.data(), text.size());
+    }
+}
+
+int CompileServer::compile(const std::vector<std::string>& arguments, const std::filesystem::path& workingDirectory, std::FILE* output, ThreadPool& compilePool)
+{
+    // -h and -v would exit the server
+    argparse::ArgumentParser program{"cpps-cli", "", argparse::default_arguments::none};
+
+    addArguments(program);
+
+    try
+    {
+        program.parse_args(arguments);
+    }
+    catch (const std::exception& exception)
+    {
+        fmt::print(output, "{}\n", exception.what());
+        return 1;
+    }
+
+    CommandLine commandLine = getCommandLine(program);
+
+    if (!commandLine.serverSocketPath.empty() || commandLine.watch || !commandLine.driverOptions.traceOutPath.empty())
+    {
+        fmt::print(output, "cpps-cli: error: --server, --watch and --trace-out are not supported by the compile server\n");
+        return 1;
+    }
+
+    DriverOptions& options = commandLine.driverOptions;
+
+    options.workingDirectory = workingDirectory;
+
+    BuildCache* cache = options.cacheDirectory.empty() ? nullptr : getCache(workingDirectory / options.cacheDirectory, output);
+
+    Driver driver{std::move(options), output, cache, &compilePool};
+
+    return driver.run();
+}
+
+BuildCache* CompileServer::getCache(const std::filesystem::path& directory, std::FILE* output)
+{
+    const std::filesystem::path key = directory.lexically_normal();
+
+    const std::scoped_lock lock{_cachesMutex};
+
+    auto it = _caches.find(key);
+
+    if (it != _caches.end())
+    {
+        return it->second.get();
+    }
+
+    auto cache = std::make_unique<BuildCache>(key);
+
+    Diagnosis diagnosis;
+
+    // retried by the next request
+    if (!cache->open(diagnosis))
+    {
+        fmt::print(output, "cpps-cli: error: {}\n", diagnosis.getErrors().front().message);
+        return nullptr;
+    }
+
+    return _caches.emplace(key, std::move(cache)).first->second.get();
+}
+
+CompileClient::CompileClient(std::filesystem::path socketPath)
+    : CompileClient(std::move(socketPath), stderr)
+{
+}
+
+CompileClient::CompileClient(std::filesystem::path socketPath, std::FILE* output)
+    : _socketPath(std::move(socketPath))
+    , _output(output)
+{
+}
+
+int CompileClient::run(const std::vector<std::string>& arguments)
+{
+    const std::optional<sockaddr_un> address = makeAddress(_socketPath);
+
+    if (!address)
+    {
+        fmt::print(_output, "cpps-cli: error: the socket path is too long: {}\n", _socketPath.string());
+        return 1;
+    }
+
+    const FileDescriptor connection{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+
+    if (connection.get() < 0 || !connectTo(connection.get(), *address))
+    {
+        fmt::print(_output, "cpps-cli: error: cannot connect to the server on {}: {}\n", _socketPath.string(), std::strerror(errno));
+        return 1;
+    }
+
+    std::error_code error;
+
+    std::string payload = std::filesystem::current_path(error).string();
+    payload += '\0';
+
+    for (const std::string& argument : arguments)
+    {
+        payload += argument;
+        payload += '\0';
+    }
+
+    const RequestHeader request{.protocolVersion = CompileServer::ProtocolVersion, .payloadSize = static_cast<std::uint32_t>(payload.size())};
+
+    ResponseHeader response{};
+
+    if (!sendAll(connection.get(), &request, sizeof(request)) || !sendAll(connection.get(), payload.data(), payload.size())
+        || !receiveAll(connection.get(), &response, sizeof(response)))
+    {
+        fmt::print(_output, "cpps-cli: error: the server on {} disconnected\n", _socketPath.string());
+        return 1;
+    }
+
+    std::string output(response.outputSize, '\0');
+
+    if (!receiveAll(connection.get(), output.data(), output.size()))
+    {
+        fmt::print(_output, "cpps-cli: error: the server on {} disconnected\n", _socketPath.string());
+        return 1;
+    }
+
+    std::fwrite(output.data(), 1, output.size(), _output);
+
+    return response.exitCode;
+}
+
+#endif
+
+} // namespace CPPS::CLI
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace CPPS {
+
+class ThreadPool;
+
+} // namespace CPPS
+
+namespace CPPS::CLI {
+
+class BuildCache;
+
+/**
+ * Long-lived compiler process, serves the command lines forwarded by CompileClient on a unix domain socket.
+ *
+ * Each connection carries one request: the client working directory and its command line,
+ * parsed as a local one. The response is the exit code and the output the driver would have written to stderr.
+ * The clients are served concurrently on connectionsCount threads, and all the requests compile on a single pool of
+ * connectionsCount threads, the --jobs of a request is ignored.
+ *
+ * A client which does not send its whole request within the receive timeout is disconnected, so idle clients
+ * cannot hold the connection threads. On stop, the connections still receiving their request are shut down
+ * and the requests already compiling are completed.
+ *
+ * The build caches stay opened between the requests, so their index is loaded once.
+ * --trace-out is rejected as the trace is process-wide, and --watch as it never returns.
+ */
+class CompileServer
+{
+public:
+    // bumped on any change of the messages, a mismatched client is rejected
+    static constexpr std::uint32_t ProtocolVersion{1};
+
+    // the command lines and the outputs are bounded, a larger request is rejected
+    static constexpr std::uint32_t MaxRequestSize{1024U * 1024U};
+
+    static constexpr std::chrono::milliseconds DefaultReceiveTimeout{10'000};
+
+public:
+    CompileServer(std::filesystem::path socketPath, std::size_t connectionsCount, std::chrono::milliseconds receiveTimeout = DefaultReceiveTimeout);
+    ~CompileServer();
+
+    CompileServer(const CompileServer&) = delete;
+    CompileServer& operator=(const CompileServer&) = delete;
+    CompileServer(CompileServer&&) = delete;
+    CompileServer& operator=(CompileServer&&) = delete;
+
+    // serves until SIGINT, SIGTERM or stop, returns the process exit code
+    [[nodiscard]] int run();
+
+    // thread-safe, run returns once the requests in progress are done, even if it is not started yet
+    void stop();
+
+private:
+    void serve(int connection, ThreadPool& compilePool);
+
+    // false if the server is stopping, then the connection must be closed
+    [[nodiscard]] bool addConnection(int connection);
+    void removeConnection(int connection);
+    void shutdownConnections();
+
+    [[nodiscard]] int compile(const std::vector<std::string>& arguments, const std::filesystem::path& workingDirectory, std::FILE* output, ThreadPool& compilePool);
+
+    // nullptr if the cache cannot be opened, the error is written to output
+    [[nodiscard]] BuildCache* getCache(const std::filesystem::path& directory, std::FILE* output);
+
+private:
+    std::filesystem::path _socketPath;
+    std::size_t _connectionsCount;
+    std::chrono::milliseconds _receiveTimeout;
+
+    // written by stop and by the signal handler, -1 until run creates the stop pipe
+    std::atomic<bool> _isStopRequested{false};
+    std::atomic<int> _stopPipeWriteFd{-1};
+
+    // the connections receiving their request
+    std::mutex _connectionsMutex;
+    std::set<int> _connections;
+    bool _isStopping{false};
+
+    std::mutex _cachesMutex;
+    std::map<std::filesystem::path, std::unique_ptr<BuildCache>> _caches;
+};
+
+/**
+ * Forwards a command line to a CompileServer and writes its output to stderr.
+ */
+class CompileClient
+{
+public:
+    explicit CompileClient(std::filesystem::path socketPath);
+
+    // the server output and the errors are written to output
+    CompileClient(std::filesystem::path socketPath, std::FILE* output);
+
+    // arguments is the whole command line, including the program name, returns the server exit code
+    [[nodiscard]] int run(const std::vector<std::string>& arguments);
+
+private:
+    std::filesystem::path _socketPath;
+
+    std::FILE* _output;
+};
+
+} // namespace CPPS::CLI
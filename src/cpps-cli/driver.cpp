@@ -0,0 +1,570 @@
+#include "cpps-cli/driver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <latch>
+#include <map>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "cpps/cpp-generator.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+#include "cpps/tokens.hpp"
+#include "cpps/utility/output-sink.hpp"
+#include "cpps/utility/trace.hpp"
+
+namespace CPPS::CLI {
+
+namespace {
+
+constexpr std::array<std::string_view, 2> SourceExtensions{".cpp2", ".h2"};
+
+bool isSourceFile(const std::filesystem::directory_entry& entry)
+{
+    return entry.is_regular_file() && hasSourceExtension(entry.path());
+}
+
+// compiler style location, 1-based
+std::string formatLocation(const std::optional<SourceLocation>& location)
+{
+    if (!location.has_value() || location->line == InvalidSourceLine)
+    {
+        return {};
+    }
+
+    if (location->column == InvalidSourceColumn)
+    {
+        return fmt::format(":{}", location->line + 1);
+    }
+
+    return fmt::format(":{}:{}", location->line + 1, location->column + 1);
+}
+
+// nothing to remove if outputPath is empty
+void removeOutput(const std::filesystem::path& outputPath)
+{
+    if (!outputPath.empty())
+    {
+        std::error_code error;
+        std::filesystem::remove(outputPath, error);
+    }
+}
+
+// next to the output, so that it is renamed on the same file system
+// unique between the processes and the threads writing the same output
+std::filesystem::path makeTemporaryPath(const std::filesystem::path& outputPath)
+{
+    static std::atomic<std::size_t> counter{0};
+    static const unsigned processKey = std::random_device{}();
+
+    std::filesystem::path path = outputPath;
+    path += fmt::format(".{:08x}-{}.tmp", processKey, counter++);
+
+    return path;
+}
+
+// writes the C++ of a source parsed without error to a temporary file, renamed to outputPath once it is complete
+// a write failure is reported as an error, nothing is renamed if an error is added
+void generate(const std::filesystem::path& path,
+              const std::filesystem::path& outputPath,
+              Diagnosis& diagnosis,
+              const Source& source,
+              const CST::TranslationUnit& translationUnit,
+              FileTime* fileTime)
+{
+    const ScopedPhaseTimer timer{fileTime, Phase::Generate};
+
+    std::error_code error;
+
+    // the outputs of an input directory keep their relative paths
+    std::filesystem::create_directories(outputPath.parent_path(), error);
+
+    const std::filesystem::path temporaryPath = makeTemporaryPath(outputPath);
+
+    std::FILE* file = std::fopen(temporaryPath.string().c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        diagnosis.error(fmt::format("cannot write the file {}", outputPath.string()));
+        return;
+    }
+
+    bool succeeded = false;
+
+    {
+        OutputSink sink{file};
+
+        CppGenerator generator{diagnosis, source, translationUnit, sink, path.string()};
+        generator.generate();
+
+        succeeded = sink.flush();
+    }
+
+    if (std::fclose(file) != 0 || !succeeded)
+    {
+        diagnosis.error(fmt::format("cannot write the file {}", outputPath.string()));
+    }
+
+    // the errors of the generator leave an incomplete output too
+    if (diagnosis.getErrors().empty())
+    {
+        std::filesystem::rename(temporaryPath, outputPath, error);
+
+        if (!error)
+        {
+            return;
+        }
+
+        diagnosis.error(fmt::format("cannot write the file {}", outputPath.string()));
+    }
+
+    std::filesystem::remove(temporaryPath, error);
+}
+
+} // namespace
+
+Driver::Driver(DriverOptions options)
+    : _options(std::move(options))
+    , _output(stderr)
+{
+}
+
+Driver::Driver(DriverOptions options, std::FILE* output, BuildCache* cache, ThreadPool* pool)
+    : _options(std::move(options))
+    , _output(output)
+    , _cache(cache)
+    , _pool(pool)
+{
+    _options.cacheDirectory.clear();
+}
+
+int Driver::run()
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    if (!_options.traceOutPath.empty())
+    {
+        Trace::start();
+    }
+
+    Diagnosis inputsDiagnosis;
+
+    std::vector<std::filesystem::path> outputPaths;
+
+    const std::vector<std::filesystem::path> files = collectFiles(inputsDiagnosis, outputPaths);
+
+    std::optional<BuildCache> ownedCache;
+    BuildCache* cache = _cache;
+
+    if (!_options.cacheDirectory.empty())
+    {
+        ownedCache.emplace(resolve(_options.cacheDirectory));
+
+        // compiles without cache
+        if (ownedCache->open(inputsDiagnosis))
+        {
+            cache = &*ownedCache;
+        }
+    }
+
+    for (const Diagnosis::Entry& entry : inputsDiagnosis.getErrors())
+    {
+        fmt::print(_output, "cpps-cli: error: {}\n", entry.message);
+    }
+
+    std::optional<TimeReport> timeReport;
+
+    if (_options.timeReport || !_options.timeReportJsonPath.empty())
+    {
+        timeReport.emplace(files);
+    }
+
+    ConcurrentDiagnosis diagnosis;
+
+    // before the shards are created, also mixed in the cache keys
+    diagnosis.setErrorLimit(_options.errorLimit);
+    diagnosis.setFailFast(_options.failFast);
+
+    std::atomic<std::size_t> cacheHitsCount{0};
+
+    {
+        std::optional<ThreadPool> ownedPool;
+        ThreadPool* pool = _pool;
+
+        if (pool == nullptr)
+        {
+            pool = &ownedPool.emplace(_options.threadsCount);
+        }
+
+        // a single input is compiled on this thread and parsed on the pool
+        if (files.size() == 1 && pool->getThreadsCount() > 1)
+        {
+            FileTime* fileTime = timeReport ? &timeReport->getFileTime(0) : nullptr;
+
+            if (compile(resolve(files[0]), outputPaths[0], diagnosis.createShard(0), fileTime, cache, pool))
+            {
+                ++cacheHitsCount;
+            }
+        }
+        else
+        {
+            // the pool may run the tasks of other drivers, only this driver files are waited for
+            std::latch filesCompiled{static_cast<std::ptrdiff_t>(files.size())};
+            std::vector<std::exception_ptr> exceptions(files.size());
+
+            for (std::size_t i = 0; i < files.size(); ++i)
+            {
+                FileTime* fileTime = timeReport ? &timeReport->getFileTime(i) : nullptr;
+
+                pool->submit([this, &diagnosis, &files, &outputPaths, &cacheHitsCount, &filesCompiled, &exceptions, i, fileTime, cache] {
+                    try
+                    {
+                        if (compile(resolve(files[i]), outputPaths[i], diagnosis.createShard(i), fileTime, cache, nullptr))
+                        {
+                            ++cacheHitsCount;
+                        }
+                    }
+                    catch (...)
+                    {
+                        exceptions[i] = std::current_exception();
+                    }
+
+                    filesCompiled.count_down();
+                });
+            }
+
+            filesCompiled.wait();
+
+            for (const std::exception_ptr& exception : exceptions)
+            {
+                if (exception)
+                {
+                    std::rethrow_exception(exception);
+                }
+            }
+        }
+    }
+
+    const ConcurrentDiagnosis::Merged merged = diagnosis.merge();
+
+    report(files, merged);
+
+    bool succeeded = merged.errors.empty() && merged.droppedErrorsCount == 0 && inputsDiagnosis.getErrors().empty();
+
+    if (cache != nullptr)
+    {
+        Diagnosis cacheDiagnosis;
+
+        if (!cache->flush(cacheDiagnosis))
+        {
+            fmt::print(_output, "cpps-cli: warning: {}\n", cacheDiagnosis.getErrors().front().message);
+        }
+    }
+
+    if (timeReport)
+    {
+        timeReport->setElapsedTime(std::chrono::steady_clock::now() - startTime);
+
+        if (_options.timeReport)
+        {
+            fmt::print(_output, "{}", timeReport->formatText());
+
+            if (cache != nullptr)
+            {
+                fmt::print(_output, "build cache: {} hits, {} misses\n", cacheHitsCount.load(), files.size() - cacheHitsCount);
+            }
+        }
+
+        if (!_options.timeReportJsonPath.empty())
+        {
+            std::ofstream stream{resolve(_options.timeReportJsonPath)};
+
+            stream << timeReport->formatJson();
+
+            if (!stream)
+            {
+                fmt::print(_output, "cpps-cli: error: cannot write the time report to {}\n", _options.timeReportJsonPath.string());
+                succeeded = false;
+            }
+        }
+    }
+
+    if (!_options.traceOutPath.empty())
+    {
+        Trace::stop();
+
+        std::ofstream stream{resolve(_options.traceOutPath)};
+
+        stream << Trace::formatChromeJson();
+
+        if (!stream)
+        {
+            fmt::print(_output, "cpps-cli: error: cannot write the trace to {}\n", _options.traceOutPath.string());
+            succeeded = false;
+        }
+    }
+
+    return succeeded ? 0 : 1;
+}
+
+std::filesystem::path Driver::resolve(const std::filesystem::path& path) const
+{
+    // an absolute path replaces the working directory
+    return _options.workingDirectory / path;
+}
+
+std::vector<std::filesystem::path> Driver::collectFiles(Diagnosis& diagnosis, std::vector<std::filesystem::path>& outputPaths) const
+{
+    std::vector<std::filesystem::path> files;
+
+    // the files by output path, to reject the inputs which would overwrite the C++ of another one
+    std::map<std::filesystem::path, std::filesystem::path> generatedFiles;
+
+    auto addFile = [this, &diagnosis, &files, &outputPaths, &generatedFiles](const std::filesystem::path& file, const std::filesystem::path& relativePath) {
+        std::filesystem::path outputPath = getOutputPath(relativePath);
+
+        if (!outputPath.empty())
+        {
+            const auto [it, isInserted] = generatedFiles.emplace(outputPath.lexically_normal(), file);
+
+            if (!isInserted)
+            {
+                diagnosis.error(fmt::format("inputs {} and {} are both generated to {}", it->second.string(), file.string(), outputPath.string()));
+                return;
+            }
+        }
+
+        files.push_back(file);
+        outputPaths.push_back(std::move(outputPath));
+    };
+
+    for (const std::filesystem::path& input : _options.inputs)
+    {
+        const std::filesystem::path resolvedInput = resolve(input);
+
+        std::error_code error;
+
+        if (std::filesystem::is_directory(resolvedInput, error))
+        {
+            std::vector<std::filesystem::path> relativePaths;
+
+            for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator{resolvedInput, error})
+            {
+                if (isSourceFile(entry))
+                {
+                    relativePaths.push_back(entry.path().lexically_relative(resolvedInput));
+                }
+            }
+
+            // the iteration order is unspecified
+            std::sort(relativePaths.begin(), relativePaths.end());
+
+            for (const std::filesystem::path& relativePath : relativePaths)
+            {
+                addFile(input / relativePath, relativePath);
+            }
+        }
+        else if (std::filesystem::exists(resolvedInput, error))
+        {
+            addFile(input, input.filename());
+        }
+        else
+        {
+            diagnosis.error(fmt::format("input not found: {}", input.string()));
+        }
+    }
+
+    return files;
+}
+
+std::filesystem::path Driver::getOutputPath(const std::filesystem::path& relativePath) const
+{
+    if (_options.outputDirectory.empty())
+    {
+        return {};
+    }
+
+    std::filesystem::path path = relativePath;
+    path.replace_extension(relativePath.extension() == ".h2" ? ".h" : ".cpp");
+
+    return resolve(_options.outputDirectory) / path;
+}
+
+bool Driver::compile(const std::filesystem::path& path,
+                     const std::filesystem::path& outputPath,
+                     Diagnosis& diagnosis,
+                     FileTime* fileTime,
+                     BuildCache* cache,
+                     ThreadPool* parsePool)
+{
+    CPPS_TRACE_ZONE("Driver::compile", [&path] { return path.string(); });
+
+    std::optional<Source> source;
+    std::optional<BuildCache::Key> cacheKey;
+
+    {
+        const ScopedPhaseTimer timer{fileTime, Phase::Read};
+
+        std::ifstream stream{path};
+
+        if (!stream)
+        {
+            diagnosis.error("cannot open the file");
+            removeOutput(outputPath);
+            return false;
+        }
+
+        // the cache only stores the diagnoses, the C++ must be generated again
+        if (cache != nullptr && outputPath.empty())
+        {
+            std::string content{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+            cacheKey = BuildCache::makeKey(content, diagnosis);
+
+            if (cache->replay(*cacheKey, diagnosis))
+            {
+                // the lines are not read
+                if (fileTime != nullptr)
+                {
+                    fileTime->bytesCount = content.size();
+                }
+
+                return true;
+            }
+
+            std::istringstream contentStream{std::move(content)};
+
+            SourceReader reader{diagnosis, contentStream};
+
+            source = reader.read();
+        }
+        else
+        {
+            SourceReader reader{diagnosis, stream};
+
+            source = reader.read();
+        }
+    }
+
+    if (source.has_value())
+    {
+        if (fileTime != nullptr)
+        {
+            std::error_code error;
+            const std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+
+            fileTime->bytesCount = error ? 0 : static_cast<std::size_t>(fileSize);
+            fileTime->linesCount = source->size();
+        }
+
+        Tokens tokens;
+
+        {
+            const ScopedPhaseTimer timer{fileTime, Phase::Lex};
+
+            Lexer lexer{diagnosis, *source};
+
+            tokens = lexer.lex();
+        }
+
+        std::optional<CST::TranslationUnit> translationUnit;
+
+        {
+            const ScopedPhaseTimer timer{fileTime, Phase::Parse};
+
+            CST::Parser parser{diagnosis, tokens};
+
+            translationUnit = parsePool != nullptr ? parser.parse(*parsePool) : parser.parse();
+        }
+
+        if (!outputPath.empty() && diagnosis.getErrors().empty())
+        {
+            generate(path, outputPath, diagnosis, *source, *translationUnit, fileTime);
+        }
+    }
+
+    // the C++ of a previous run does not match the source anymore
+    if (!diagnosis.getErrors().empty())
+    {
+        removeOutput(outputPath);
+    }
+
+    // the messages may view the source
+    diagnosis.detachMessages();
+
+    // with fail-fast, the errors of the other files may have stopped this one, its diagnoses are incomplete
+    if (cacheKey && !diagnosis.shouldStop())
+    {
+        cache->add(*cacheKey, diagnosis);
+    }
+
+    return false;
+}
+
+void Driver::report(const std::vector<std::filesystem::path>& files, const ConcurrentDiagnosis::Merged& merged) const
+{
+    auto print = [this, &files](const ConcurrentDiagnosis::Entry& entry, std::string_view type) {
+        fmt::print(_output, "{}\n", formatDiagnosisEntry(files[entry.file], entry.entry, type));
+    };
+
+    auto errorIt = merged.errors.begin();
+    auto warningIt = merged.warnings.begin();
+
+    // both are sorted by file, report each file diagnoses together
+    while (errorIt != merged.errors.end() || warningIt != merged.warnings.end())
+    {
+        const bool isError = warningIt == merged.warnings.end() || (errorIt != merged.errors.end() && errorIt->file <= warningIt->file);
+
+        if (isError)
+        {
+            print(*errorIt++, "error");
+        }
+        else
+        {
+            print(*warningIt++, "warning");
+        }
+    }
+
+    for (const ConcurrentDiagnosis::SkippedWork& skippedWork : merged.skippedWorks)
+    {
+        fmt::print(_output, "{}: {}\n", files[skippedWork.file].string(), Diagnosis::formatSkippedWork(skippedWork.phase, skippedWork.work));
+    }
+
+    fmt::print(_output, "{} files, {} errors, {} warnings\n", files.size(), merged.errors.size() + merged.droppedErrorsCount, merged.warnings.size());
+
+    if (merged.droppedErrorsCount > 0)
+    {
+        fmt::print(_output, "{} errors not reported (limit is {})\n", merged.droppedErrorsCount, _options.errorLimit);
+    }
+}
+
+bool hasSourceExtension(const std::filesystem::path& path)
+{
+    const std::string extension = path.extension().string();
+
+    return std::find(SourceExtensions.begin(), SourceExtensions.end(), extension) != SourceExtensions.end();
+}
+
+std::string formatDiagnosisEntry(const std::filesystem::path& file, const Diagnosis::Entry& entry, std::string_view type)
+{
+    return fmt::format("{}{}: {}: {}", file.string(), formatLocation(entry.location), type, entry.message);
+}
+
+} // namespace CPPS::CLI
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cpps/concurrent-diagnosis.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/utility/thread-pool.hpp"
+#include "cpps-cli/build-cache.hpp"
+#include "cpps-cli/time-report.hpp"
+
+namespace CPPS::CLI {
+
+struct DriverOptions
+{
+    // files or directories, the directories are searched recursively for the source extensions
+    std::vector<std::filesystem::path> inputs;
+
+    std::size_t threadsCount{ThreadPool::getDefaultThreadsCount()};
+
+    // the errors of all the inputs after the limit are counted but not reported
+    std::size_t errorLimit{Diagnosis::NoErrorLimit};
+
+    // the phases stop once the error limit is reached, or at the first error without limit
+    bool failFast{false};
+
+    // per phase times printed after the diagnoses
+    bool timeReport{false};
+
+    // per phase times written as json, nothing written if empty
+    std::filesystem::path timeReportJsonPath;
+
+    // chrome trace event json, nothing written if empty
+    std::filesystem::path traceOutPath;
+
+    // the unchanged inputs reuse the diagnoses of the previous runs, no cache if empty
+    std::filesystem::path cacheDirectory;
+
+    // the C++ of each input is written in it, as <stem>.cpp or <stem>.h, nothing generated if empty
+    // the files of an input directory keep their path relative to it, two inputs generated to the same file are an error
+    std::filesystem::path outputDirectory;
+
+    // the relative paths are resolved against it, the current directory if empty
+    // the inputs are reported as given
+    std::filesystem::path workingDirectory;
+};
+
+/**
+ * Runs SourceReader -> Lexer -> CST::Parser on each input file in parallel, or on the declarations of a single input.
+ * The diagnoses are reported in the input order, whatever the threads count. The work skipped by fail-fast is reported
+ * after them.
+ * With a cache directory, the inputs whose content did not change are not compiled again.
+ * With an output directory, the C++ of each input parsed without error is generated, the cache is not used. An output is
+ * replaced only once completely written, and removed when its input has errors.
+ */
+class Driver
+{
+public:
+    explicit Driver(DriverOptions options);
+
+    // the diagnoses and the reports are written to output
+    // an opened cache is used instead of options.cacheDirectory, no cache if nullptr
+    // the files are compiled on pool, which may be shared by several drivers, instead of options.threadsCount threads
+    Driver(DriverOptions options, std::FILE* output, BuildCache* cache, ThreadPool* pool = nullptr);
+
+    // returns the process exit code
+    [[nodiscard]] int run();
+
+private:
+    [[nodiscard]] std::filesystem::path resolve(const std::filesystem::path& path) const;
+
+    // outputPaths gets the output path of each file, see getOutputPath
+    [[nodiscard]] std::vector<std::filesystem::path> collectFiles(Diagnosis& diagnosis, std::vector<std::filesystem::path>& outputPaths) const;
+
+    // the resolved path of the C++ generated from the file at relativePath from its input, empty if nothing is generated
+    [[nodiscard]] std::filesystem::path getOutputPath(const std::filesystem::path& relativePath) const;
+
+    // fileTime, cache and parsePool may be nullptr, returns true if the diagnoses are replayed from the cache
+    // the declarations are parsed in parallel on parsePool, see CST::Parser::parse(ThreadPool&)
+    // the C++ is written to outputPath unless it is empty, with #line directives to path
+    static bool compile(const std::filesystem::path& path,
+                        const std::filesystem::path& outputPath,
+                        Diagnosis& diagnosis,
+                        FileTime* fileTime,
+                        BuildCache* cache,
+                        ThreadPool* parsePool);
+
+    void report(const std::vector<std::filesystem::path>& files, const ConcurrentDiagnosis::Merged& merged) const;
+
+private:
+    DriverOptions _options;
+
+    std::FILE* _output;
+
+    // opened by run from options.cacheDirectory if nullptr
+    BuildCache* _cache{nullptr};
+
+    // created by run with options.threadsCount threads if nullptr
+    ThreadPool* _pool{nullptr};
+};
+
+// .cpp2 or .h2
+[[nodiscard]] bool hasSourceExtension(const std::filesystem::path& path);
+
+// compiler style "file:line:column: type: message", the location is 1-based
+[[nodiscard]] std::string formatDiagnosisEntry(const std::filesystem::path& file, const Diagnosis::Entry& entry, std::string_view type);
+
+} // namespace CPPS::CLI
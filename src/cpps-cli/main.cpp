@@ -1,9 +1,59 @@
-#include "cpps/source-reader.hpp"
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+#include <fmt/format.h>
+
+#include "cpps-cli/command-line.hpp"
+#include "cpps-cli/compile-server.hpp"
+#include "cpps-cli/driver.hpp"
+#include "cpps-cli/watcher.hpp"
 
 int main(int argc, char* argv[])
 {
-    (void)argc;
-    (void)argv;
+    argparse::ArgumentParser program{"cpps-cli"};
+
+    CPPS::CLI::addArguments(program);
+
+    CPPS::CLI::CommandLine commandLine;
+
+    try
+    {
+        program.parse_args(argc, argv);
+
+        commandLine = CPPS::CLI::getCommandLine(program);
+    }
+    catch (const std::exception& exception)
+    {
+        fmt::print(stderr, "{}\n{}", exception.what(), program.help().str());
+        return 1;
+    }
+
+    if (!commandLine.serverSocketPath.empty())
+    {
+        CPPS::CLI::CompileServer server{commandLine.serverSocketPath, commandLine.driverOptions.threadsCount};
+
+        return server.run();
+    }
+
+    if (!commandLine.connectSocketPath.empty())
+    {
+        // parsed again by the server
+        CPPS::CLI::CompileClient client{commandLine.connectSocketPath};
+
+        return client.run(std::vector<std::string>(argv, argv + argc));
+    }
+
+    if (commandLine.watch)
+    {
+        CPPS::CLI::Watcher watcher{std::move(commandLine.driverOptions)};
+
+        return watcher.run();
+    }
+
+    CPPS::CLI::Driver driver{std::move(commandLine.driverOptions)};
 
-    return 0;
-}
\ No newline at end of file
+    return driver.run();
+}
@@ -0,0 +1,214 @@
+#include "cpps-cli/time-report.hpp"
+
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace CPPS::CLI {
+
+namespace {
+
+constexpr std::array<std::string_view, PhaseCount> PhaseNames{"read", "lex", "parse", "generate"};
+
+constexpr double BytesPerMegabyte{1024.0 * 1024.0};
+
+double toSeconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+double toMilliseconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+double getRate(std::size_t count, std::chrono::nanoseconds duration)
+{
+    return duration.count() > 0 ? static_cast<double>(count) / toSeconds(duration) : 0.0;
+}
+
+std::string escapeJson(std::string_view text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+
+    for (const char c : text)
+    {
+        switch (c)
+        {
+        case '"': escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                escaped += fmt::format("\\u{:04x}", static_cast<unsigned char>(c));
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+    }
+
+    return escaped;
+}
+
+void formatTextFile(std::back_insert_iterator<std::string> out, std::string_view name, const FileTime& fileTime)
+{
+    fmt::format_to(out, "{} ({} bytes, {} lines)\n", name, fileTime.bytesCount, fileTime.linesCount);
+
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+    {
+        const PhaseTime& phase = fileTime.phases[i];
+
+        fmt::format_to(out,
+                       "  {:<8} wall {:>10.3f} ms  cpu {:>10.3f} ms  {:>9.2f} MB/s  {:>12.0f} lines/s  {:>8} allocations ({} bytes)\n",
+                       PhaseNames[i],
+                       toMilliseconds(phase.wallTime),
+                       toMilliseconds(phase.cpuTime),
+                       getRate(fileTime.bytesCount, phase.wallTime) / BytesPerMegabyte,
+                       getRate(fileTime.linesCount, phase.wallTime),
+                       phase.allocations.count,
+                       phase.allocations.bytesCount);
+    }
+}
+
+void formatJsonFile(std::back_insert_iterator<std::string> out, std::string_view name, const FileTime& fileTime)
+{
+    fmt::format_to(out, R"({{"name":"{}","bytes":{},"lines":{},"phases":{{)", escapeJson(name), fileTime.bytesCount, fileTime.linesCount);
+
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+    {
+        const PhaseTime& phase = fileTime.phases[i];
+
+        fmt::format_to(out,
+                       R"({}"{}":{{"wall_ns":{},"cpu_ns":{},"mb_per_s":{:.3f},"lines_per_s":{:.1f},"allocations":{},"allocated_bytes":{}}})",
+                       i == 0 ? "" : ",",
+                       PhaseNames[i],
+                       phase.wallTime.count(),
+                       phase.cpuTime.count(),
+                       getRate(fileTime.bytesCount, phase.wallTime) / BytesPerMegabyte,
+                       getRate(fileTime.linesCount, phase.wallTime),
+                       phase.allocations.count,
+                       phase.allocations.bytesCount);
+    }
+
+    fmt::format_to(out, "}}}}");
+}
+
+} // namespace
+
+PhaseTime& PhaseTime::operator+=(const PhaseTime& other)
+{
+    wallTime += other.wallTime;
+    cpuTime += other.cpuTime;
+    allocations += other.allocations;
+    return *this;
+}
+
+ScopedPhaseTimer::ScopedPhaseTimer(FileTime* fileTime, Phase phase)
+    : _phaseTime(fileTime != nullptr ? &fileTime->phases[static_cast<std::size_t>(phase)] : nullptr)
+{
+    if (_phaseTime != nullptr)
+    {
+        _allocationsStart = AllocationCounter::getThreadCount();
+        _cpuStart = ThreadCpuClock::now();
+        _wallStart = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedPhaseTimer::~ScopedPhaseTimer()
+{
+    if (_phaseTime != nullptr)
+    {
+        _phaseTime->wallTime += std::chrono::steady_clock::now() - _wallStart;
+        _phaseTime->cpuTime += ThreadCpuClock::now() - _cpuStart;
+        _phaseTime->allocations += AllocationCounter::getThreadCount() - _allocationsStart;
+    }
+}
+
+TimeReport::TimeReport(std::vector<std::filesystem::path> files)
+    : _files(std::move(files))
+    , _fileTimes(_files.size())
+{
+}
+
+FileTime& TimeReport::getFileTime(std::size_t fileIndex)
+{
+    return _fileTimes[fileIndex];
+}
+
+void TimeReport::setElapsedTime(std::chrono::nanoseconds elapsedTime)
+{
+    _elapsedTime = elapsedTime;
+}
+
+std::string TimeReport::formatText() const
+{
+    std::string text;
+
+    auto out = std::back_inserter(text);
+
+    for (std::size_t i = 0; i < _files.size(); ++i)
+    {
+        formatTextFile(out, _files[i].string(), _fileTimes[i]);
+    }
+
+    // the phases of different files overlap, the total wall time is the sum of the threads time
+    formatTextFile(out, "total", getTotal());
+
+    fmt::format_to(out, "elapsed {:.3f} ms\n", toMilliseconds(_elapsedTime));
+
+    return text;
+}
+
+std::string TimeReport::formatJson() const
+{
+    std::string json;
+
+    auto out = std::back_inserter(json);
+
+    fmt::format_to(out, R"({{"elapsed_ns":{},"total":)", _elapsedTime.count());
+
+    formatJsonFile(out, "total", getTotal());
+
+    fmt::format_to(out, R"(,"files":[)");
+
+    for (std::size_t i = 0; i < _files.size(); ++i)
+    {
+        if (i > 0)
+        {
+            fmt::format_to(out, ",");
+        }
+
+        formatJsonFile(out, _files[i].string(), _fileTimes[i]);
+    }
+
+    fmt::format_to(out, "]}}\n");
+
+    return json;
+}
+
+FileTime TimeReport::getTotal() const
+{
+    FileTime total;
+
+    for (const FileTime& fileTime : _fileTimes)
+    {
+        total.bytesCount += fileTime.bytesCount;
+        total.linesCount += fileTime.linesCount;
+
+        for (std::size_t i = 0; i < PhaseCount; ++i)
+        {
+            total.phases[i] += fileTime.phases[i];
+        }
+    }
+
+    return total;
+}
+
+} // namespace CPPS::CLI
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "cpps/utility/allocation-counter.hpp"
+#include "cpps/utility/thread-cpu-clock.hpp"
+
+namespace CPPS::CLI {
+
+enum class Phase : std::uint8_t
+{
+    Read,
+    Lex,
+    Parse,
+    Generate
+};
+
+inline constexpr std::size_t PhaseCount{4};
+
+struct PhaseTime
+{
+    std::chrono::nanoseconds wallTime{0};
+    std::chrono::nanoseconds cpuTime{0};
+    AllocationCount allocations;
+
+    PhaseTime& operator+=(const PhaseTime& other);
+};
+
+struct FileTime
+{
+    std::size_t bytesCount{0};
+    std::size_t linesCount{0};
+
+    std::array<PhaseTime, PhaseCount> phases;
+};
+
+// measures the calling thread from construction to destruction, does nothing if fileTime is nullptr
+class ScopedPhaseTimer
+{
+public:
+    ScopedPhaseTimer(FileTime* fileTime, Phase phase);
+    ~ScopedPhaseTimer();
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer(ScopedPhaseTimer&&) = delete;
+    ScopedPhaseTimer& operator=(ScopedPhaseTimer&&) = delete;
+
+private:
+    PhaseTime* _phaseTime;
+
+    std::chrono::steady_clock::time_point _wallStart;
+    ThreadCpuClock::time_point _cpuStart;
+    AllocationCount _allocationsStart;
+};
+
+/**
+ * Per file and aggregated phase times.
+ * Each file time is written by a single thread, no synchronization is required until the report is formatted.
+ */
+class TimeReport
+{
+public:
+    explicit TimeReport(std::vector<std::filesystem::path> files);
+
+    [[nodiscard]] FileTime& getFileTime(std::size_t fileIndex);
+
+    void setElapsedTime(std::chrono::nanoseconds elapsedTime);
+
+    [[nodiscard]] std::string formatText() const;
+    [[nodiscard]] std::string formatJson() const;
+
+private:
+    [[nodiscard]] FileTime getTotal() const;
+
+private:
+    std::vector<std::filesystem::path> _files;
+    std::vector<FileTime> _fileTimes;
+
+    std::chrono::nanoseconds _elapsedTime{0};
+};
+
+} // namespace CPPS::CLI
@@ -0,0 +1,476 @@
+#include "cpps-cli/watcher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "cpps/source-reader.hpp"
+#include "cpps/utility/thread-pool.hpp"
+
+namespace CPPS::CLI {
+
+#if !defined(__linux__)
+
+Watcher::Watcher(DriverOptions options, std::chrono::milliseconds debounceTime)
+    : _options(std::move(options))
+    , _debounceTime(debounceTime)
+{
+}
+
+Watcher::~Watcher() = default;
+
+int Watcher::run()
+{
+    return start() ? 0 : 1;
+}
+
+bool Watcher::start()
+{
+    fmt::print(stderr, "cpps-cli: error: the watch mode is only supported on linux\n");
+    return false;
+}
+
+bool Watcher::waitForChanges(std::set<std::filesystem::path>& /*changedFiles*/, std::optional<std::chrono::milliseconds> /*timeout*/)
+{
+    return false;
+}
+
+#else
+
+namespace {
+
+constexpr std::uint32_t WatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ONLYDIR | IN_MASK_ADD;
+
+bool isWithin(const std::filesystem::path& path, const std::filesystem::path& directory)
+{
+    return std::mismatch(directory.begin(), directory.end(), path.begin(), path.end()).first == directory.end();
+}
+
+// the same file given as a relative path, through a symbolic link or with dot segments has a single path
+std::filesystem::path canonicalize(const std::filesystem::path& path)
+{
+    std::error_code error;
+
+    std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(path, error);
+
+    if (error)
+    {
+        return std::filesystem::absolute(path, error).lexically_normal();
+    }
+
+    return canonicalPath;
+}
+
+} // namespace
+
+Watcher::Watcher(DriverOptions options, std::chrono::milliseconds debounceTime)
+    : _options(std::move(options))
+    , _debounceTime(debounceTime)
+{
+}
+
+Watcher::~Watcher()
+{
+    if (_inotifyFd >= 0)
+    {
+        close(_inotifyFd);
+    }
+}
+
+int Watcher::run()
+{
+    if (!start())
+    {
+        return 1;
+    }
+
+    fmt::print(stderr, "cpps-cli: watching for changes\n");
+
+    while (true)
+    {
+        std::set<std::filesystem::path> changedFiles;
+
+        if (!waitForChanges(changedFiles))
+        {
+            return 1;
+        }
+
+        for (const std::filesystem::path& path : changedFiles)
+        {
+            recompile(path);
+        }
+    }
+}
+
+bool Watcher::start()
+{
+    _inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+
+    if (_inotifyFd < 0)
+    {
+        fmt::print(stderr, "cpps-cli: error: cannot watch the inputs: {}\n", std::strerror(errno));
+        return false;
+    }
+
+    std::vector<std::filesystem::path> files;
+
+    for (const std::filesystem::path& givenInput : _options.inputs)
+    {
+        const std::filesystem::path input = canonicalize(_options.workingDirectory / givenInput);
+
+        std::error_code error;
+
+        if (std::filesystem::is_directory(input, error))
+        {
+            if (!watchDirectory(input, true, files))
+            {
+                return false;
+            }
+        }
+        else if (std::filesystem::exists(input, error))
+        {
+            if (!watchDirectory(input.parent_path(), false, files))
+            {
+                return false;
+            }
+
+            _inputFiles.insert(input);
+            files.push_back(input);
+        }
+        else
+        {
+            fmt::print(stderr, "cpps-cli: error: input not found: {}\n", givenInput.string());
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+
+    std::vector<std::unique_ptr<CompiledFile>> compiledFiles(files.size());
+
+    {
+        ThreadPool pool{_options.threadsCount};
+
+        for (std::size_t i = 0; i < files.size(); ++i)
+        {
+            pool.submit([&files, &compiledFiles, i] {
+                compiledFiles[i] = std::make_unique<CompiledFile>();
+                compile(files[i], *compiledFiles[i]);
+            });
+        }
+
+        pool.wait();
+    }
+
+    std::size_t errorsCount = 0;
+    std::size_t warningsCount = 0;
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        report(files[i], *compiledFiles[i]);
+
+        errorsCount += compiledFiles[i]->diagnosis.getErrors().size();
+        warningsCount += compiledFiles[i]->diagnosis.getWarnings().size();
+
+        _files.insert_or_assign(files[i], std::move(compiledFiles[i]));
+    }
+
+    fmt::print(stderr, "{} files, {} errors, {} warnings\n", files.size(), errorsCount, warningsCount);
+
+    return true;
+}
+
+bool Watcher::waitForChanges(std::set<std::filesystem::path>& changedFiles, std::optional<std::chrono::milliseconds> timeout)
+{
+    for (std::optional<std::chrono::milliseconds> pollTimeout = timeout;; pollTimeout = _debounceTime)
+    {
+        const int result = pollEvents(pollTimeout);
+
+        if (result < 0)
+        {
+            return false;
+        }
+
+        // no event during the debounce time, or none before the timeout
+        if (result == 0)
+        {
+            return true;
+        }
+
+        if (!readEvents(changedFiles))
+        {
+            return false;
+        }
+    }
+}
+
+int Watcher::pollEvents(std::optional<std::chrono::milliseconds> timeout)
+{
+    pollfd descriptor{.fd = _inotifyFd, .events = POLLIN, .revents = 0};
+
+    const int result = poll(&descriptor, 1, timeout ? static_cast<int>(timeout->count()) : -1);
+
+    if (result < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+
+        fmt::print(stderr, "cpps-cli: error: cannot wait for the file events: {}\n", std::strerror(errno));
+        return -1;
+    }
+
+    return result > 0 ? 1 : 0;
+}
+
+bool Watcher::watchDirectory(const std::filesystem::path& path, bool isRecursive, std::vector<std::filesystem::path>& files)
+{
+    const int wd = inotify_add_watch(_inotifyFd, path.c_str(), WatchMask | (isRecursive ? IN_CREATE : 0U));
+
+    if (wd < 0)
+    {
+        fmt::print(stderr, "cpps-cli: error: cannot watch {}: {}\n", path.string(), std::strerror(errno));
+        return false;
+    }
+
+    // the same directory is watched once, with the masks merged by IN_MASK_ADD
+    auto [it, isInserted] = _directories.try_emplace(wd, WatchedDirectory{.path = path, .isRecursive = isRecursive});
+
+    if (!isInserted)
+    {
+        it->second.isRecursive = it->second.isRecursive || isRecursive;
+    }
+
+    if (!isRecursive)
+    {
+        return true;
+    }
+
+    // listed after the watch is added, a file created in between is not missed
+    std::error_code error;
+
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{path, error})
+    {
+        const std::filesystem::path entryPath = path / entry.path().filename();
+
+        if (entry.is_directory() && !entry.is_symlink())
+        {
+            if (!watchDirectory(entryPath, true, files))
+            {
+                return false;
+            }
+        }
+        else if (entry.is_regular_file() && hasSourceExtension(entryPath))
+        {
+            files.push_back(canonicalize(entryPath));
+        }
+    }
+
+    return true;
+}
+
+void Watcher::unwatchDirectory(const std::filesystem::path& path)
+{
+    for (auto it = _directories.begin(); it != _directories.end();)
+    {
+        if (isWithin(it->second.path, path))
+        {
+            inotify_rm_watch(_inotifyFd, it->first);
+            it = _directories.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool Watcher::readEvents(std::set<std::filesystem::path>& changedFiles)
+{
+    alignas(inotify_event) std::array<char, 64UL * 1024UL> buffer{};
+
+    const ssize_t size = read(_inotifyFd, buffer.data(), buffer.size());
+
+    if (size < 0)
+    {
+        if (errno == EINTR || errno == EAGAIN)
+        {
+            return true;
+        }
+
+        fmt::print(stderr, "cpps-cli: error: cannot read the file events: {}\n", std::strerror(errno));
+        return false;
+    }
+
+    for (std::size_t offset = 0; offset < static_cast<std::size_t>(size);)
+    {
+        inotify_event event{};
+        std::memcpy(&event, buffer.data() + offset, sizeof(event));
+
+        const char* name = buffer.data() + offset + sizeof(event);
+
+        offset += sizeof(event) + event.len;
+
+        // some events are lost, every file is compiled again
+        if ((event.mask & IN_Q_OVERFLOW) != 0)
+        {
+            for (const auto& [path, file] : _files)
+            {
+                changedFiles.insert(path);
+            }
+
+            continue;
+        }
+
+        const auto it = _directories.find(event.wd);
+
+        if (it == _directories.end())
+        {
+            continue;
+        }
+
+        if ((event.mask & IN_IGNORED) != 0)
+        {
+            _directories.erase(it);
+            continue;
+        }
+
+        if (event.len == 0)
+        {
+            continue;
+        }
+
+        // copied, watching a new directory may rehash
+        const std::filesystem::path path = canonicalize(it->second.path / name);
+        const bool isRecursive = it->second.isRecursive;
+
+        if ((event.mask & IN_ISDIR) != 0)
+        {
+            if (!isRecursive)
+            {
+                continue;
+            }
+
+            if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+            {
+                std::vector<std::filesystem::path> files;
+
+                if (watchDirectory(path, true, files))
+                {
+                    changedFiles.insert(files.begin(), files.end());
+                }
+            }
+            else if ((event.mask & (IN_DELETE | IN_MOVED_FROM)) != 0)
+            {
+                unwatchDirectory(path);
+
+                // a moved directory has no event for its files
+                for (const auto& [filePath, file] : _files)
+                {
+                    if (isWithin(filePath, path))
+                    {
+                        changedFiles.insert(filePath);
+                    }
+                }
+            }
+
+            continue;
+        }
+
+        if (isRecursive ? hasSourceExtension(path) : _inputFiles.contains(path))
+        {
+            changedFiles.insert(path);
+        }
+    }
+
+    return true;
+}
+
+void Watcher::recompile(const std::filesystem::path& path)
+{
+    std::error_code error;
+
+    if (!std::filesystem::is_regular_file(path, error))
+    {
+        if (_files.erase(path) > 0)
+        {
+            fmt::print(stderr, "{}: removed\n", path.string());
+        }
+
+        return;
+    }
+
+    std::unique_ptr<CompiledFile>& file = _files[path];
+
+    if (!file)
+    {
+        file = std::make_unique<CompiledFile>();
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    compile(path, *file);
+
+    const std::chrono::duration<double, std::milli> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+    report(path, *file);
+
+    const CST::IncrementalParser::Stats& stats = file->parser.getStats();
+
+    fmt::print(stderr, "{}: {} errors, {} warnings, compiled in {:.3f} ms, {} of {} declarations parsed\n", path.string(), file->diagnosis.getErrors().size(), file->diagnosis.getWarnings().size(), elapsedTime.count(), stats.parsedDeclarationsCount, stats.parsedDeclarationsCount + stats.reusedDeclarationsCount);
+}
+
+// an unreadable file keeps its previous parse, the next update is compared to it
+void Watcher::compile(const std::filesystem::path& path, CompiledFile& file)
+{
+    file.diagnosis = {};
+
+    std::ifstream stream{path};
+
+    if (!stream)
+    {
+        file.diagnosis.error("cannot open the file");
+        return;
+    }
+
+    SourceReader reader{file.diagnosis, stream};
+
+    if (std::optional<Source> source = reader.read())
+    {
+        file.parser.update(file.diagnosis, std::move(*source));
+    }
+}
+
+void Watcher::report(const std::filesystem::path& path, const CompiledFile& file)
+{
+    for (const Diagnosis::Entry& entry : file.diagnosis.getErrors())
+    {
+        fmt::print(stderr, "{}\n", formatDiagnosisEntry(path, entry, "error"));
+    }
+
+    for (const Diagnosis::Entry& entry : file.diagnosis.getWarnings())
+    {
+        fmt::print(stderr, "{}\n", formatDiagnosisEntry(path, entry, "warning"));
+    }
+}
+
+#endif
+
+} // namespace CPPS::CLI
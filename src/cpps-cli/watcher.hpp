@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "cpps/cst/incremental-parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps-cli/driver.hpp"
+
+namespace CPPS::CLI {
+
+/**
+ * Compiles the inputs, then recompiles each source file when it is written, until the process is interrupted.
+ *
+ * The Source, Tokens and TranslationUnit of each file stay resident, only the written file is compiled again
+ * and only its diagnoses are reported. The file is parsed incrementally, see CST::IncrementalParser.
+ *
+ * The directories are watched recursively with inotify, including the ones created afterwards.
+ * An input file is watched through its parent directory, as editors often save by renaming a temporary file.
+ * The inputs and the event paths are canonical, a file is the same whatever the path it is given or written by.
+ *
+ * The events are debounced: the changes are collected until no event is received for the debounce time,
+ * an editor saving in several steps or a checkout writing many files triggers a single recompilation.
+ */
+class Watcher
+{
+public:
+    static constexpr std::chrono::milliseconds DefaultDebounceTime{50};
+
+    explicit Watcher(DriverOptions options, std::chrono::milliseconds debounceTime = DefaultDebounceTime);
+    ~Watcher();
+
+    Watcher(const Watcher&) = delete;
+    Watcher& operator=(const Watcher&) = delete;
+    Watcher(Watcher&&) = delete;
+    Watcher& operator=(Watcher&&) = delete;
+
+    // only returns on error, with the process exit code
+    [[nodiscard]] int run();
+
+    // watches and compiles the inputs
+    [[nodiscard]] bool start();
+
+    // adds the canonical paths of the written files, empty if nothing is written before the timeout
+    [[nodiscard]] bool waitForChanges(std::set<std::filesystem::path>& changedFiles, std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+private:
+    // never moved, the diagnosis views the source of the parser
+    struct CompiledFile
+    {
+        CST::IncrementalParser parser;
+        Diagnosis diagnosis;
+    };
+
+    struct WatchedDirectory
+    {
+        std::filesystem::path path;
+
+        // all the source files and subdirectories, or only the input files
+        bool isRecursive{false};
+    };
+
+    // adds the source files found to files
+    bool watchDirectory(const std::filesystem::path& path, bool isRecursive, std::vector<std::filesystem::path>& files);
+    void unwatchDirectory(const std::filesystem::path& path);
+
+    // 1 if events are pending, 0 on timeout, -1 on error
+    int pollEvents(std::optional<std::chrono::milliseconds> timeout);
+
+    // reads the pending events, returns the written files
+    bool readEvents(std::set<std::filesystem::path>& changedFiles);
+
+    void recompile(const std::filesystem::path& path);
+
+    // the diagnosis of the file is replaced, its parser is updated if the file is read
+    static void compile(const std::filesystem::path& path, CompiledFile& file);
+
+    static void report(const std::filesystem::path& path, const CompiledFile& file);
+
+private:
+    DriverOptions _options;
+    std::chrono::milliseconds _debounceTime;
+
+    int _inotifyFd{-1};
+
+    std::unordered_map<int, WatchedDirectory> _directories;
+    std::set<std::filesystem::path> _inputFiles;
+
+    std::map<std::filesystem::path, std::unique_ptr<CompiledFile>> _files;
+};
+
+} // namespace CPPS::CLI
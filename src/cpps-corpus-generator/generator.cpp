@@ -0,0 +1,394 @@
+#include "cpps-corpus-generator/generator.hpp"
+
+#include <array>
+#include <iterator>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace CPPS::Corpus {
+
+namespace {
+
+constexpr std::array<std::string_view, 9> BinaryOperators{"+", "-", "*", "/", "%", "==", "!=", "&&", "||"};
+constexpr std::array<std::string_view, 2> PrefixOperators{"-", "!"};
+constexpr std::array<std::string_view, 7> ParameterModifiers{"", "in ", "copy ", "inout ", "move ", "out ", "forward "};
+constexpr std::array<std::string_view, 4> Types{"int", "bool", "char", "*int"};
+
+// the identifiers used by the expressions, declared or not
+constexpr std::size_t ExpressionIdentifiersCount{16};
+
+} // namespace
+
+Generator::Generator(GeneratorOptions options)
+    : _options(options)
+    , _state(options.seed)
+{
+}
+
+GeneratedCorpus Generator::generate()
+{
+    _state = _options.seed;
+    _corpus = {};
+    _identifiersCount = 0;
+
+    while (_corpus.linesCount < _options.linesCount)
+    {
+        const std::size_t percent = nextBelow(100);
+
+        if (percent < _options.cppPercent)
+        {
+            generateCpp();
+        }
+        else if (percent < _options.cppPercent + _options.commentPercent)
+        {
+            generateComment();
+        }
+        else if (nextPercent(50))
+        {
+            generateVariable();
+        }
+        else
+        {
+            generateFunction();
+        }
+
+        if (nextPercent(10))
+        {
+            endLine();
+        }
+    }
+
+    return std::move(_corpus);
+}
+
+void Generator::generateVariable()
+{
+    ++_corpus.declarationsCount;
+
+    appendIdentifier("variable_", _identifiersCount++);
+    append(": ");
+    generateType();
+    append(" = ");
+
+    if (nextPercent(_options.invalidPercent))
+    {
+        ++_corpus.invalidDeclarationsCount;
+
+        switch (nextBelow(3))
+        {
+        case 0:
+            append("(");
+            generateExpression(_options.expressionDepth);
+            break;
+        case 1:
+            generateLeaf();
+            append(" $ ");
+            generateLeaf();
+            break;
+        default:
+            // missing initializer
+            break;
+        }
+    }
+    else
+    {
+        generateExpression(_options.expressionDepth);
+    }
+
+    append(";");
+    endLine();
+}
+
+void Generator::generateFunction()
+{
+    ++_corpus.declarationsCount;
+
+    appendIdentifier("function_", _identifiersCount++);
+    append(": (");
+
+    for (std::size_t i = 0; i < _options.parametersCount; ++i)
+    {
+        if (i > 0)
+        {
+            append(", ");
+        }
+
+        append(ParameterModifiers[nextBelow(ParameterModifiers.size())]);
+        appendIdentifier("parameter_", i);
+        append(": ");
+        generateType();
+    }
+
+    append(") -> int = {");
+
+    generateCompoundStatement(_options.statementDepth, 0);
+
+    endLine();
+}
+
+void Generator::generateCpp()
+{
+    switch (nextBelow(3))
+    {
+    case 0:
+        appendIdentifier("int cpp_function_", _identifiersCount++);
+        append("(int value) { return value * 2; }");
+        endLine(true);
+        break;
+    case 1:
+        appendIdentifier("struct cpp_struct_", _identifiersCount++);
+        endLine(true);
+        append("{");
+        endLine(true);
+        append("    int value{0};");
+        endLine(true);
+        append("};");
+        endLine(true);
+        break;
+    default:
+        appendIdentifier("#define CPP_MACRO_", _identifiersCount++);
+        append(" 1");
+        endLine(true);
+        break;
+    }
+}
+
+void Generator::generateComment()
+{
+    if (nextPercent(50))
+    {
+        append("// a line comment");
+        endLine();
+        return;
+    }
+
+    append("/*");
+    endLine();
+
+    for (std::size_t i = 0; i < _options.commentLinesCount; ++i)
+    {
+        appendIdentifier(" * block comment line ", i);
+        endLine();
+    }
+
+    append(" */");
+    endLine();
+}
+
+void Generator::generateCompoundStatement(std::size_t depth, std::size_t indent)
+{
+    endLine();
+
+    const std::size_t count = 1 + nextBelow(3);
+    const std::size_t nestedIndex = nextBelow(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        appendIndent(indent + 1);
+
+        if (depth > 0 && i == nestedIndex)
+        {
+            append("{");
+            generateCompoundStatement(depth - 1, indent + 1);
+            endLine();
+        }
+        else
+        {
+            generateStatement();
+        }
+    }
+
+    appendIndent(indent);
+    append("}");
+}
+
+void Generator::generateStatement()
+{
+    switch (nextBelow(4))
+    {
+    case 0:
+        appendIdentifier("value_", nextBelow(ExpressionIdentifiersCount));
+        append(" = ");
+        generateExpression(_options.expressionDepth);
+        break;
+    case 1:
+        appendIdentifier("local_", nextBelow(ExpressionIdentifiersCount));
+        append(": ");
+        generateType();
+        append(" = ");
+        generateExpression(_options.expressionDepth);
+        break;
+    case 2:
+        appendIdentifier("function_", nextBelow(ExpressionIdentifiersCount));
+        append("(");
+        generateExpression(_options.expressionDepth);
+        append(")");
+        break;
+    default:
+        append("return ");
+        generateExpression(_options.expressionDepth);
+        break;
+    }
+
+    append(";");
+    endLine();
+}
+
+// only one operand is nested, the expressions grow linearly with the depth
+void Generator::generateExpression(std::size_t depth)
+{
+    if (depth == 0)
+    {
+        generateLeaf();
+        return;
+    }
+
+    switch (nextBelow(5))
+    {
+    case 0:
+    {
+        const bool isLeftNested = nextPercent(50);
+        const std::string_view op = BinaryOperators[nextBelow(BinaryOperators.size())];
+
+        append("(");
+
+        if (isLeftNested)
+        {
+            generateExpression(depth - 1);
+            fmt::format_to(std::back_inserter(_corpus.text), " {} ", op);
+            generateLeaf();
+        }
+        else
+        {
+            generateLeaf();
+            fmt::format_to(std::back_inserter(_corpus.text), " {} ", op);
+            generateExpression(depth - 1);
+        }
+
+        append(")");
+        break;
+    }
+    case 1:
+    {
+        const std::size_t count = 1 + nextBelow(3);
+        const std::size_t nestedIndex = nextBelow(count);
+
+        appendIdentifier("function_", nextBelow(ExpressionIdentifiersCount));
+        append("(");
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                append(", ");
+            }
+
+            if (i == nestedIndex)
+            {
+                generateExpression(depth - 1);
+            }
+            else
+            {
+                generateLeaf();
+            }
+        }
+
+        append(")");
+        break;
+    }
+    case 2:
+        append(PrefixOperators[nextBelow(PrefixOperators.size())]);
+        append("(");
+        generateExpression(depth - 1);
+        append(")");
+        break;
+    case 3:
+        appendIdentifier("value_", nextBelow(ExpressionIdentifiersCount));
+        appendIdentifier(".member_", nextBelow(ExpressionIdentifiersCount));
+        append("(");
+        generateExpression(depth - 1);
+        append(")");
+        break;
+    default:
+        appendIdentifier("value_", nextBelow(ExpressionIdentifiersCount));
+        append("[");
+        generateExpression(depth - 1);
+        append("]");
+        break;
+    }
+}
+
+void Generator::generateLeaf()
+{
+    switch (nextBelow(4))
+    {
+    case 0:
+        fmt::format_to(std::back_inserter(_corpus.text), "{}", nextBelow(1000));
+        break;
+    case 1:
+        fmt::format_to(std::back_inserter(_corpus.text), "'{}'", static_cast<char>('a' + nextBelow(26)));
+        break;
+    case 2:
+        append(nextPercent(50) ? "true" : "false");
+        break;
+    default:
+        appendIdentifier("value_", nextBelow(ExpressionIdentifiersCount));
+        break;
+    }
+}
+
+void Generator::generateType()
+{
+    append(Types[nextBelow(Types.size())]);
+}
+
+void Generator::append(std::string_view text)
+{
+    _corpus.text += text;
+}
+
+void Generator::appendIdentifier(std::string_view prefix, std::size_t count)
+{
+    fmt::format_to(std::back_inserter(_corpus.text), "{}{}", prefix, count);
+}
+
+void Generator::appendIndent(std::size_t indent)
+{
+    _corpus.text.append(indent * 4, ' ');
+}
+
+void Generator::endLine(bool isCpp)
+{
+    _corpus.text += '\n';
+
+    ++_corpus.linesCount;
+
+    if (isCpp)
+    {
+        ++_corpus.cppLinesCount;
+    }
+}
+
+std::uint64_t Generator::next()
+{
+    _state += 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t z = _state;
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31U);
+}
+
+std::size_t Generator::nextBelow(std::size_t count)
+{
+    return next() % count;
+}
+
+bool Generator::nextPercent(std::size_t percent)
+{
+    return nextBelow(100) < percent;
+}
+
+} // namespace CPPS::Corpus
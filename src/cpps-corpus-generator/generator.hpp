@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace CPPS::Corpus {
+
+struct GeneratorOptions
+{
+    // the same seed and options generate the same corpus, on every platform
+    std::uint64_t seed{0};
+
+    // the corpus is generated until it has at least linesCount lines
+    std::size_t linesCount{1000};
+
+    // nesting depth of the expressions and of the compound statements
+    std::size_t expressionDepth{3};
+    std::size_t statementDepth{2};
+
+    std::size_t parametersCount{3};
+
+    std::size_t commentLinesCount{4};
+
+    // share of the generated items that are C++ code or comments, in percent
+    std::size_t cppPercent{20};
+    std::size_t commentPercent{10};
+
+    // share of the cpps declarations made ill-formed, in percent
+    std::size_t invalidPercent{0};
+};
+
+struct GeneratedCorpus
+{
+    std::string text;
+
+    std::size_t linesCount{0};
+    std::size_t cppLinesCount{0};
+
+    // the top level cpps declarations, including the invalid ones
+    std::size_t declarationsCount{0};
+    std::size_t invalidDeclarationsCount{0};
+};
+
+/**
+ * Generates sources following docs/ebnf.ebnf, restricted to what the parser supports:
+ * variables with nested expressions, functions with parameter lists and nested compound statements,
+ * interleaved with C++ code, preprocessor directives, comments and empty lines.
+ *
+ * The invalid declarations have a single local error (unbalanced parenthesis, unexpected char or
+ * missing initializer) so the rest of the corpus stays well-formed.
+ */
+class Generator
+{
+public:
+    explicit Generator(GeneratorOptions options);
+
+    [[nodiscard]] GeneratedCorpus generate();
+
+private:
+    void generateVariable();
+    void generateFunction();
+    void generateCpp();
+    void generateComment();
+
+    // the opening brace is already on the current line
+    void generateCompoundStatement(std::size_t depth, std::size_t indent);
+    void generateStatement();
+    void generateExpression(std::size_t depth);
+    void generateLeaf();
+    void generateType();
+
+    void append(std::string_view text);
+    void appendIdentifier(std::string_view prefix, std::size_t count);
+    void appendIndent(std::size_t indent);
+    void endLine(bool isCpp = false);
+
+    // splitmix64, the std distributions do not generate the same values on every standard library
+    [[nodiscard]] std::uint64_t next();
+    [[nodiscard]] std::size_t nextBelow(std::size_t count);
+    [[nodiscard]] bool nextPercent(std::size_t percent);
+
+private:
+    GeneratorOptions _options;
+
+    std::uint64_t _state;
+
+    GeneratedCorpus _corpus;
+    std::size_t _identifiersCount{0};
+};
+
+} // namespace CPPS::Corpus
@@ -0,0 +1,111 @@
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <string>
+
+#include <argparse/argparse.hpp>
+#include <fmt/format.h>
+
+#include "cpps-corpus-generator/generator.hpp"
+
+int main(int argc, char* argv[])
+{
+    argparse::ArgumentParser program{"cpps-generate-corpus"};
+
+    const CPPS::Corpus::GeneratorOptions defaults;
+
+    program.add_argument("-o", "--output")
+        .help("the generated source file, printed on the standard output if empty")
+        .default_value(std::string{});
+
+    program.add_argument("--seed")
+        .help("the same seed and options generate the same source")
+        .default_value(defaults.seed)
+        .scan<'u', std::uint64_t>();
+
+    program.add_argument("--lines")
+        .help("minimum lines count")
+        .default_value(defaults.linesCount)
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--expression-depth")
+        .help("nesting depth of the expressions")
+        .default_value(defaults.expressionDepth)
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--statement-depth")
+        .help("nesting depth of the compound statements")
+        .default_value(defaults.statementDepth)
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--parameters")
+        .help("parameters count of the functions")
+        .default_value(defaults.parametersCount)
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--comment-lines")
+        .help("lines count of the block comments")
+        .default_value(defaults.commentLinesCount)
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--cpp-percent")
+        .help("share of the generated items that are C++ code")
+        .default_value(defaults.cppPercent)
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--comment-percent")
+        .help("share of the generated items that are comments")
+        .default_value(defaults.commentPercent)
+        .scan<'u', std::size_t>();
+
+    program.add_argument("--invalid-percent")
+        .help("share of the cpps declarations made ill-formed")
+        .default_value(defaults.invalidPercent)
+        .scan<'u', std::size_t>();
+
+    try
+    {
+        program.parse_args(argc, argv);
+    }
+    catch (const std::exception& exception)
+    {
+        fmt::print(stderr, "{}\n{}", exception.what(), program.help().str());
+        return 1;
+    }
+
+    CPPS::Corpus::GeneratorOptions options;
+
+    options.seed = program.get<std::uint64_t>("--seed");
+    options.linesCount = program.get<std::size_t>("--lines");
+    options.expressionDepth = program.get<std::size_t>("--expression-depth");
+    options.statementDepth = program.get<std::size_t>("--statement-depth");
+    options.parametersCount = program.get<std::size_t>("--parameters");
+    options.commentLinesCount = program.get<std::size_t>("--comment-lines");
+    options.cppPercent = program.get<std::size_t>("--cpp-percent");
+    options.commentPercent = program.get<std::size_t>("--comment-percent");
+    options.invalidPercent = program.get<std::size_t>("--invalid-percent");
+
+    const CPPS::Corpus::GeneratedCorpus corpus = CPPS::Corpus::Generator{options}.generate();
+
+    const std::string output = program.get<std::string>("--output");
+
+    if (output.empty())
+    {
+        fmt::print("{}", corpus.text);
+    }
+    else
+    {
+        std::ofstream stream{output, std::ios::binary};
+
+        if (!stream.write(corpus.text.data(), static_cast<std::streamsize>(corpus.text.size())))
+        {
+            fmt::print(stderr, "cannot write {}\n", output);
+            return 1;
+        }
+    }
+
+    fmt::print(stderr, "{} lines, {} C++ lines, {} declarations, {} invalid\n", corpus.linesCount, corpus.cppLinesCount, corpus.declarationsCount, corpus.invalidDeclarationsCount);
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "cpps/concurrent-diagnosis.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace CPPS {
+
+namespace {
+
+struct SortableEntry
+{
+    ConcurrentDiagnosis::FileIndex file;
+    ConcurrentDiagnosis::PartIndex part;
+    std::size_t sequence;
+    const Diagnosis::Entry* entry;
+};
+
+// entries without location first
+auto getSortKey(const SortableEntry& value)
+{
+    const std::optional<SourceLocation>& location = value.entry->location;
+
+    return std::make_tuple(value.file,
+                           location.has_value(),
+                           location.has_value() ? location->line : SourceLine{0},
+                           location.has_value() ? location->column : SourceColumn{0},
+                           value.part,
+                           value.sequence);
+}
+
+template<typename ShardsT, typename GetEntriesT>
+std::vector<ConcurrentDiagnosis::Entry> mergeEntries(const ShardsT& shards, GetEntriesT getEntries)
+{
+    std::vector<SortableEntry> sortables;
+
+    for (const auto& shard : shards)
+    {
+        const std::span<const Diagnosis::Entry> entries = getEntries(shard.diagnosis);
+
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            sortables.push_back(SortableEntry{.file = shard.file, .part = shard.part, .sequence = i, .entry = &entries[i]});
+        }
+    }
+
+    std::sort(sortables.begin(), sortables.end(), [](const SortableEntry& lhs, const SortableEntry& rhs) { return getSortKey(lhs) < getSortKey(rhs); });
+
+    std::vector<ConcurrentDiagnosis::Entry> merged;
+    merged.reserve(sortables.size());
+
+    for (const SortableEntry& sortable : sortables)
+    {
+        merged.push_back(ConcurrentDiagnosis::Entry{.file = sortable.file, .entry = *sortable.entry});
+    }
+
+    return merged;
+}
+
+template<typename ShardsT>
+std::vector<ConcurrentDiagnosis::SkippedWork> mergeSkippedWorks(const ShardsT& shards)
+{
+    std::map<std::pair<ConcurrentDiagnosis::FileIndex, std::size_t>, Diagnosis::SkippedWork> works;
+
+    for (const auto& shard : shards)
+    {
+        for (std::size_t phase = 0; phase < Diagnosis::PhaseCount; ++phase)
+        {
+            if (const std::optional<Diagnosis::SkippedWork> work = shard.diagnosis.getSkippedWork(static_cast<Diagnosis::Phase>(phase)))
+            {
+                Diagnosis::SkippedWork& merged = works[{shard.file, phase}];
+
+                merged.processedCount += work->processedCount;
+                merged.skippedCount += work->skippedCount;
+            }
+        }
+    }
+
+    std::vector<ConcurrentDiagnosis::SkippedWork> merged;
+    merged.reserve(works.size());
+
+    for (const auto& [key, work] : works)
+    {
+        merged.push_back(ConcurrentDiagnosis::SkippedWork{.file = key.first, .phase = static_cast<Diagnosis::Phase>(key.second), .work = work});
+    }
+
+    return merged;
+}
+
+} // namespace
+
+void ConcurrentDiagnosis::setErrorLimit(std::size_t limit)
+{
+    const std::scoped_lock lock{_mutex};
+    _errorLimit = limit;
+}
+
+void ConcurrentDiagnosis::setFailFast(bool failFast)
+{
+    const std::scoped_lock lock{_mutex};
+    _isFailFast = failFast;
+}
+
+Diagnosis& ConcurrentDiagnosis::createShard(FileIndex file, PartIndex part)
+{
+    const std::scoped_lock lock{_mutex};
+
+    Shard& shard = _shards.emplace_back(Shard{.file = file, .part = part, .diagnosis = {}});
+
+    // each shard stores its first errors up to the limit, merge() keeps the first ones of all the shards
+    shard.diagnosis.setErrorLimit(_errorLimit);
+    shard.diagnosis.setFailFast(_isFailFast);
+    shard.diagnosis.setSharedErrorsCount(&_errorsCount);
+
+    return shard.diagnosis;
+}
+
+ConcurrentDiagnosis::Merged ConcurrentDiagnosis::merge() const
+{
+    const std::scoped_lock lock{_mutex};
+
+    Merged merged{
+        .errors = mergeEntries(_shards, [](const Diagnosis& diagnosis) { return diagnosis.getErrors(); }),
+        .warnings = mergeEntries(_shards, [](const Diagnosis& diagnosis) { return diagnosis.getWarnings(); }),
+        .droppedErrorsCount = 0,
+        .skippedWorks = mergeSkippedWorks(_shards)};
+
+    if (merged.errors.size() > _errorLimit)
+    {
+        merged.errors.erase(merged.errors.begin() + static_cast<std::ptrdiff_t>(_errorLimit), merged.errors.end());
+    }
+
+    merged.droppedErrorsCount = _errorsCount.load() - merged.errors.size();
+
+    return merged;
+}
+
+std::size_t ConcurrentDiagnosis::getErrorsCount() const
+{
+    return _errorsCount.load();
+}
+
+} // namespace CPPS
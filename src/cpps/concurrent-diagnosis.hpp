@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "cpps/diagnosis.hpp"
+
+namespace CPPS {
+
+/**
+ * Collects the diagnoses of several threads without locking the phases.
+ *
+ * Each unit of work (a file, or a part of a file) gets its own shard, a plain Diagnosis used by a single thread.
+ * merge() orders the entries by file, location, part, then report order, the result does not depend on the threads.
+ *
+ * The error limit and fail-fast apply to the errors of all the shards: the shards count their errors together and
+ * stop once the total reaches the limit, and merge() keeps the first errors up to the limit.
+ * With fail-fast, the errors reported by the other shards before they stop depend on the threads.
+ */
+class ConcurrentDiagnosis
+{
+public:
+    using FileIndex = std::size_t;
+    using PartIndex = std::size_t;
+
+    struct Entry
+    {
+        FileIndex file;
+        Diagnosis::Entry entry;
+    };
+
+    struct SkippedWork
+    {
+        FileIndex file;
+        Diagnosis::Phase phase;
+        Diagnosis::SkippedWork work;
+    };
+
+    struct Merged
+    {
+        std::vector<Entry> errors;
+        std::vector<Entry> warnings;
+
+        // the errors after the limit, not in errors
+        std::size_t droppedErrorsCount{0};
+
+        // the phases stopped by fail-fast, by file then phase, the parts of a file are summed
+        std::vector<SkippedWork> skippedWorks;
+    };
+
+public:
+    ConcurrentDiagnosis() = default;
+
+    ConcurrentDiagnosis(const ConcurrentDiagnosis&) = delete;
+    ConcurrentDiagnosis& operator=(const ConcurrentDiagnosis&) = delete;
+
+    // applied to the shards created afterwards
+    void setErrorLimit(std::size_t limit);
+    void setFailFast(bool failFast);
+
+    // thread-safe, the returned shard stays valid for the collector lifetime
+    // the (file, part) pair must be unique
+    [[nodiscard]] Diagnosis& createShard(FileIndex file, PartIndex part = 0);
+
+    // must not be called while a shard is in use
+    [[nodiscard]] Merged merge() const;
+
+    // stored and dropped errors of all the shards
+    [[nodiscard]] std::size_t getErrorsCount() const;
+
+private:
+    struct Shard
+    {
+        FileIndex file;
+        PartIndex part;
+        Diagnosis diagnosis;
+    };
+
+    mutable std::mutex _mutex;
+
+    std::deque<Shard> _shards;
+
+    // the errors reported to all the shards, checked by their fail-fast
+    std::atomic<std::size_t> _errorsCount{0};
+
+    std::size_t _errorLimit{Diagnosis::NoErrorLimit};
+    bool _isFailFast{false};
+};
+
+} // namespace CPPS
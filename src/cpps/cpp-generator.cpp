@@ -0,0 +1,599 @@
+#include "cpps/cpp-generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include "cpps/utility/trace.hpp"
+
+namespace CPPS {
+
+namespace {
+
+// the postfix operators generated as the prefix C++ ones
+bool isPrefixInCpp(const Token& op)
+{
+    return op.lexeme == Punctuator::Multiply || op.lexeme == Punctuator::Ampersand || op.lexeme == Punctuator::Tilde;
+}
+
+bool returnsVoid(const CST::FunctionSignature& signature)
+{
+    if (signature.returns.is<std::monostate>())
+    {
+        return true;
+    }
+
+    const CST::IdentifierExpression* returns = signature.returns.getIf<CST::IdentifierExpression>();
+
+    if (returns == nullptr)
+    {
+        return false;
+    }
+
+    const CST::UnqualifiedIdentifier* identifier = returns->identifier.type.getIf<CST::UnqualifiedIdentifier>();
+
+    return identifier != nullptr && identifier->identifier.get().text == "void";
+}
+
+std::string escapeStringLiteral(std::string_view text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+        }
+
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+} // namespace
+
+Diagnosis::Message CppGenerator::DiagnosisMessage::unsupportedFunctionParameter()
+{
+    return "a function parameter cannot be generated to C++ yet";
+}
+
+Diagnosis::Message CppGenerator::DiagnosisMessage::unsupportedNamedReturns()
+{
+    return "named return values cannot be generated to C++ yet";
+}
+
+Diagnosis::Message CppGenerator::DiagnosisMessage::unsupportedObjectInitializer()
+{
+    return "an object must be initialized by an expression";
+}
+
+CppGenerator::CppGenerator(Diagnosis& diagnosis, const Source& source, const CST::TranslationUnit& translationUnit, OutputSink& sink, std::string_view fileName)
+    : _diagnosis(diagnosis)
+    , _source(source)
+    , _translationUnit(translationUnit)
+    , _sink(sink)
+    , _fileName(escapeStringLiteral(fileName))
+{
+}
+
+void CppGenerator::generate()
+{
+    CPPS_TRACE_ZONE("CppGenerator::generate");
+
+    const CST::DeclarationList& declarations = _translationUnit.declarations;
+
+    std::size_t declarationIndex = 0;
+
+    // the lines of the generated declarations
+    std::optional<SourceLine> lastGeneratedLine;
+
+    // the copied lines follow a #line directive
+    bool isCopying = false;
+
+    for (SourceLine line = 0; line < _source.size(); ++line)
+    {
+        const Source::Line& sourceLine = _source[line];
+
+        const bool hasDeclaration = declarationIndex < declarations.size() && declarations[declarationIndex].startLocation.line <= line;
+
+        // the comments and the empty lines read as Cpps between the declarations are copied as well
+        if (!hasDeclaration && (sourceLine.getType() != Source::Line::Type::Cpps || !lastGeneratedLine || line > *lastGeneratedLine))
+        {
+            if (!isCopying)
+            {
+                writeLineDirective(line);
+                isCopying = true;
+            }
+
+            _sink.write(sourceLine.getText());
+            _sink.write('\n');
+            continue;
+        }
+
+        isCopying = false;
+
+        for (; declarationIndex < declarations.size() && declarations[declarationIndex].startLocation.line <= line; ++declarationIndex)
+        {
+            const CST::Declaration& declaration = declarations[declarationIndex];
+
+            writeLineDirective(declaration.startLocation.line);
+
+            generate(declaration, false);
+
+            lastGeneratedLine = std::max(lastGeneratedLine.value_or(0), declaration.endLocation.line);
+        }
+    }
+}
+
+void CppGenerator::generate(const CST::Declaration& declaration, bool isLocal)
+{
+    if (const CST::FunctionSignature* signature = declaration.type.getIf<CST::FunctionSignature>())
+    {
+        if (!isLocal)
+        {
+            generateFunction(declaration, *signature);
+            return;
+        }
+
+        writeIndentation();
+
+        _sink.write("auto ");
+        generate(*declaration.identifier);
+        _sink.write(" = ");
+
+        generateLambda(declaration, *signature);
+
+        _sink.write(";\n");
+        return;
+    }
+
+    writeIndentation();
+
+    generateObject(declaration);
+
+    _sink.write('\n');
+}
+
+void CppGenerator::generateObject(const CST::Declaration& declaration)
+{
+    generateType(declaration);
+
+    _sink.write(' ');
+    generate(*declaration.identifier);
+
+    if (declaration.initializer)
+    {
+        const CST::ExpressionStatement* statement = (*declaration.initializer)->type.getIf<CST::ExpressionStatement>();
+
+        if (statement != nullptr && statement->expression)
+        {
+            _sink.write(" = ");
+            generate(*statement->expression);
+        }
+        else
+        {
+            _diagnosis.error(DiagnosisMessage::unsupportedObjectInitializer(), declaration.equalLocation);
+        }
+    }
+
+    _sink.write(';');
+}
+
+void CppGenerator::generateFunction(const CST::Declaration& declaration, const CST::FunctionSignature& signature)
+{
+    _sink.write("auto ");
+    generate(*declaration.identifier);
+    generate(signature.parameters);
+    generateSignatureEnd(signature);
+    _sink.write('\n');
+
+    generateFunctionBody(declaration, signature);
+    _sink.write('\n');
+}
+
+void CppGenerator::generateLambda(const CST::Declaration& declaration, const CST::FunctionSignature& signature)
+{
+    _sink.write("[&]");
+    generate(signature.parameters);
+    generateSignatureEnd(signature);
+    _sink.write('\n');
+
+    generateFunctionBody(declaration, signature);
+}
+
+void CppGenerator::generate(const CST::ParameterDeclarationList& parameters)
+{
+    _sink.write('(');
+
+    for (std::size_t i = 0; i < parameters.size(); ++i)
+    {
+        if (i > 0)
+        {
+            _sink.write(", ");
+        }
+
+        generate(parameters[i]);
+    }
+
+    _sink.write(')');
+}
+
+void CppGenerator::generate(const CST::ParameterDeclaration& parameter)
+{
+    const CST::Declaration& declaration = *parameter.declaration;
+
+    if (declaration.type.is<CST::FunctionSignature>())
+    {
+        _diagnosis.error(DiagnosisMessage::unsupportedFunctionParameter(), parameter.location);
+        return;
+    }
+
+    generateType(declaration);
+
+    switch (parameter.modifier)
+    {
+    case ParameterModifier::In:
+        _sink.write(" const&");
+        break;
+
+    case ParameterModifier::Copy:
+        break;
+
+    case ParameterModifier::InOut:
+    case ParameterModifier::Out:
+        _sink.write('&');
+        break;
+
+    case ParameterModifier::Move:
+    case ParameterModifier::Forward:
+        _sink.write("&&");
+        break;
+    }
+
+    _sink.write(' ');
+    generate(*declaration.identifier);
+
+    if (declaration.initializer)
+    {
+        if (const CST::ExpressionStatement* statement = (*declaration.initializer)->type.getIf<CST::ExpressionStatement>(); statement != nullptr && statement->expression)
+        {
+            _sink.write(" = ");
+            generate(*statement->expression);
+        }
+    }
+}
+
+void CppGenerator::generateSignatureEnd(const CST::FunctionSignature& signature)
+{
+    if (!signature.throws)
+    {
+        _sink.write(" noexcept");
+    }
+
+    _sink.write(" -> ");
+
+    if (const CST::IdentifierExpression* returns = signature.returns.getIf<CST::IdentifierExpression>())
+    {
+        generate(*returns);
+        return;
+    }
+
+    if (const CST::ParameterDeclarationList* returns = signature.returns.getIf<CST::ParameterDeclarationList>())
+    {
+        _diagnosis.error(DiagnosisMessage::unsupportedNamedReturns(), returns->openParenthesisLocation);
+    }
+
+    _sink.write("void");
+}
+
+void CppGenerator::generateFunctionBody(const CST::Declaration& declaration, const CST::FunctionSignature& signature)
+{
+    const CST::Statement& body = **declaration.initializer;
+
+    if (const CST::CompoundStatement* statements = body.type.getIf<CST::CompoundStatement>())
+    {
+        generate(*statements);
+        return;
+    }
+
+    // f: () -> int = 0; is f: () -> int = { return 0; }
+    writeIndentation();
+    _sink.write("{\n");
+
+    ++_indentation;
+
+    const CST::ExpressionStatement* statement = body.type.getIf<CST::ExpressionStatement>();
+
+    if (statement != nullptr && statement->expression)
+    {
+        writeIndentation();
+
+        if (!returnsVoid(signature))
+        {
+            _sink.write("return ");
+        }
+
+        generate(*statement->expression);
+        _sink.write(";\n");
+    }
+    else
+    {
+        generate(body);
+    }
+
+    --_indentation;
+
+    writeIndentation();
+    _sink.write('}');
+}
+
+void CppGenerator::generateType(const CST::Declaration& declaration)
+{
+    if (const CST::IdentifierExpression* type = declaration.type.getIf<CST::IdentifierExpression>())
+    {
+        generate(*type);
+    }
+    else
+    {
+        _sink.write("auto");
+    }
+
+    if (declaration.pointerDeclaration)
+    {
+        _sink.write('*');
+    }
+}
+
+void CppGenerator::generate(const CST::IdentifierExpression& expression)
+{
+    if (const CST::UnqualifiedIdentifier* identifier = expression.identifier.type.getIf<CST::UnqualifiedIdentifier>())
+    {
+        generate(*identifier);
+    }
+    else if (const CST::QualifiedIdentifier* qualifiedIdentifier = expression.identifier.type.getIf<CST::QualifiedIdentifier>())
+    {
+        for (const CST::QualifiedIdentifier::Term& term : qualifiedIdentifier->terms)
+        {
+            _sink.write(term.scope.get().text);
+            generate(term.identifier);
+        }
+    }
+}
+
+void CppGenerator::generate(const CST::UnqualifiedIdentifier& identifier)
+{
+    if (identifier.constIdentifier)
+    {
+        _sink.write("const ");
+    }
+
+    _sink.write(identifier.identifier.get().text);
+}
+
+void CppGenerator::generate(const CST::Statement& statement)
+{
+    if (const CST::Declaration* declaration = statement.type.getIf<CST::Declaration>())
+    {
+        generate(*declaration, true);
+    }
+    else if (const CST::CompoundStatement* statements = statement.type.getIf<CST::CompoundStatement>())
+    {
+        generate(*statements);
+        _sink.write('\n');
+    }
+    else if (const CST::ExpressionStatement* expressionStatement = statement.type.getIf<CST::ExpressionStatement>())
+    {
+        writeIndentation();
+        generate(*expressionStatement->expression);
+        _sink.write(";\n");
+    }
+    else if (const CST::ReturnStatement* returnStatement = statement.type.getIf<CST::ReturnStatement>())
+    {
+        writeIndentation();
+        _sink.write("return");
+
+        if (returnStatement->expression)
+        {
+            _sink.write(' ');
+            generate(*returnStatement->expression);
+        }
+
+        _sink.write(";\n");
+    }
+}
+
+void CppGenerator::generate(const CST::CompoundStatement& statement)
+{
+    writeIndentation();
+    _sink.write("{\n");
+
+    ++_indentation;
+
+    for (std::size_t i = 0; i < statement.size(); ++i)
+    {
+        generate(statement[i]);
+    }
+
+    --_indentation;
+
+    writeIndentation();
+    _sink.write('}');
+}
+
+void CppGenerator::generate(const CST::Expression& expression)
+{
+    generate(expression, expression.getRoot());
+}
+
+void CppGenerator::generate(const CST::Expression& expression, const CST::Expression::Operation& operation)
+{
+    if (operation.kind == CST::Expression::Kind::Basic)
+    {
+        generate(expression.getBasic(operation));
+        return;
+    }
+
+    // the operations are nested by precedence as in C++, no parentheses are needed
+    generate(expression, expression.getLhs(operation));
+
+    _sink.write(' ');
+    _sink.write(operation.op->get().text);
+    _sink.write(' ');
+
+    generate(expression, expression.getRhs(operation));
+}
+
+void CppGenerator::generate(const CST::BasicExpression& expression)
+{
+    if (expression.prefix)
+    {
+        const std::vector<CST::TokenRef>& ops = expression.prefix->ops;
+
+        for (std::size_t i = 0; i < ops.size(); ++i)
+        {
+            // - -x is not --x
+            if (i > 0 && ops[i].get().text == ops[i - 1].get().text && ops[i].get().lexeme != Punctuator::Not)
+            {
+                _sink.write(' ');
+            }
+
+            _sink.write(ops[i].get().text);
+        }
+    }
+
+    const std::size_t termsCount = expression.postfix ? expression.postfix->terms.size() : 0;
+
+    // x*& is (&(*x)), the innermost operator is the first term
+    for (std::size_t i = termsCount; i > 0; --i)
+    {
+        const Token& op = expression.postfix->terms[i - 1].op.get();
+
+        if (isPrefixInCpp(op))
+        {
+            _sink.write('(');
+            _sink.write(op.text);
+        }
+    }
+
+    const CST::PrimaryExpression& primary = *expression.primary;
+
+    if (primary.type.is<Token>())
+    {
+        _sink.write(primary.type.as<Token>().text);
+    }
+    else if (const CST::IdentifierExpression* identifierExpression = primary.type.getIf<CST::IdentifierExpression>())
+    {
+        generate(*identifierExpression);
+    }
+    else if (const CST::ExpressionList* expressions = primary.type.getIf<CST::ExpressionList>())
+    {
+        generate(*expressions, "(", ")");
+    }
+    else if (const CST::Declaration* declaration = primary.type.getIf<CST::Declaration>())
+    {
+        // the parser only accepts an unnamed function
+        generateLambda(*declaration, declaration->type.as<CST::FunctionSignature>());
+    }
+
+    for (std::size_t i = 0; i < termsCount; ++i)
+    {
+        const CST::PostfixExpression::Term& term = expression.postfix->terms[i];
+
+        if (isPrefixInCpp(term.op.get()))
+        {
+            _sink.write(')');
+        }
+        else if (term.arguments)
+        {
+            generate(term.arguments->expressions, term.op.get().text, term.arguments->closeOp.get().text);
+        }
+        else
+        {
+            _sink.write(term.op.get().text);
+
+            if (term.identifierExpression)
+            {
+                generate(*term.identifierExpression);
+            }
+        }
+    }
+}
+
+void CppGenerator::generate(const CST::ExpressionTerm& term)
+{
+    switch (term.modifier)
+    {
+    case ParameterModifier::Move:
+        _sink.write("std::move(");
+        generate(*term.expression);
+        _sink.write(')');
+        break;
+
+    case ParameterModifier::Forward:
+        _sink.write("std::forward<decltype(");
+        generate(*term.expression);
+        _sink.write(")>(");
+        generate(*term.expression);
+        _sink.write(')');
+        break;
+
+    case ParameterModifier::Copy:
+    case ParameterModifier::In:
+    case ParameterModifier::InOut:
+    case ParameterModifier::Out:
+        generate(*term.expression);
+        break;
+    }
+}
+
+void CppGenerator::generate(const CST::ExpressionList& expressions, std::string_view open, std::string_view close)
+{
+    _sink.write(open);
+
+    for (std::size_t i = 0; i < expressions.size(); ++i)
+    {
+        if (i > 0)
+        {
+            _sink.write(", ");
+        }
+
+        generate(expressions[i]);
+    }
+
+    _sink.write(close);
+}
+
+void CppGenerator::writeIndentation()
+{
+    for (std::size_t i = 0; i < _indentation * IndentationWidth; ++i)
+    {
+        _sink.write(' ');
+    }
+}
+
+void CppGenerator::writeLineDirective(SourceLine line)
+{
+    if (_fileName.empty())
+    {
+        return;
+    }
+
+    // the directive is 1-based
+    std::array<char, 16> number{};
+    const std::to_chars_result result = std::to_chars(number.data(), number.data() + number.size(), std::uint64_t{line} + 1);
+
+    _sink.write("#line ");
+    _sink.write(std::string_view{number.data(), result.ptr});
+    _sink.write(" \"");
+    _sink.write(_fileName);
+    _sink.write("\"\n");
+}
+
+} // namespace CPPS
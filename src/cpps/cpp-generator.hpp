@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "cpps/cst.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/source.hpp"
+#include "cpps/utility/output-sink.hpp"
+
+namespace CPPS {
+
+/**
+ * Writes the C++ of a source to a sink, in a single pass over its lines.
+ *
+ * The lines which are not Cpps, ie Cpp, Preprocessor, Comment, Empty and Import, are copied as is. The Cpps declarations
+ * are generated in place of their lines:
+ * - an object is `Type name = initializer;`, `auto` if its type is deduced
+ * - a function is `auto name(parameters) noexcept -> Returns`, `throws` drops the noexcept
+ * - a parameter is passed as `T const&` (in), `T` (copy), `T&` (inout, out) or `T&&` (move, forward)
+ * - a local function and an unnamed function expression are lambdas capturing by reference
+ * - the postfix `*`, `&` and `~` are generated as the prefix C++ operators
+ *
+ * A `#line` directive precedes each generated declaration and the copied lines following it, so that the C++ compiler
+ * reports the lines of the source file.
+ *
+ * The generator recurses on the nesting of the nodes, which the parser bounds by CST::Parser::MaxNestingDepth.
+ */
+class CppGenerator
+{
+public:
+    struct DiagnosisMessage
+    {
+        static Diagnosis::Message unsupportedFunctionParameter();
+        static Diagnosis::Message unsupportedNamedReturns();
+        static Diagnosis::Message unsupportedObjectInitializer();
+    };
+
+    static constexpr std::size_t IndentationWidth{4};
+
+public:
+    // the translation unit must be parsed from the source without error
+    // fileName is the source file named by the #line directives, none are written if it is empty
+    CppGenerator(Diagnosis& diagnosis, const Source& source, const CST::TranslationUnit& translationUnit, OutputSink& sink, std::string_view fileName);
+
+    void generate();
+
+private:
+    // a declaration at namespace scope or in a compound statement, on its own lines
+    void generate(const CST::Declaration& declaration, bool isLocal);
+
+    void generateObject(const CST::Declaration& declaration);
+    void generateFunction(const CST::Declaration& declaration, const CST::FunctionSignature& signature);
+    void generateLambda(const CST::Declaration& declaration, const CST::FunctionSignature& signature);
+
+    void generate(const CST::ParameterDeclarationList& parameters);
+    void generate(const CST::ParameterDeclaration& parameter);
+    void generateSignatureEnd(const CST::FunctionSignature& signature);
+    void generateFunctionBody(const CST::Declaration& declaration, const CST::FunctionSignature& signature);
+
+    // the type of an object or a parameter declaration
+    void generateType(const CST::Declaration& declaration);
+
+    void generate(const CST::IdentifierExpression& expression);
+    void generate(const CST::UnqualifiedIdentifier& identifier);
+
+    // a statement on its own lines
+    void generate(const CST::Statement& statement);
+    void generate(const CST::CompoundStatement& statement);
+
+    void generate(const CST::Expression& expression);
+    void generate(const CST::Expression& expression, const CST::Expression::Operation& operation);
+    void generate(const CST::BasicExpression& expression);
+    void generate(const CST::ExpressionTerm& term);
+    void generate(const CST::ExpressionList& expressions, std::string_view open, std::string_view close);
+
+    void writeIndentation();
+
+    // the next output line is line of the source
+    void writeLineDirective(SourceLine line);
+
+private:
+    Diagnosis& _diagnosis;
+    const Source& _source;
+    const CST::TranslationUnit& _translationUnit;
+
+    OutputSink& _sink;
+
+    // escaped for a string literal
+    std::string _fileName;
+
+    std::size_t _indentation{0};
+};
+
+} // namespace CPPS
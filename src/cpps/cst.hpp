@@ -24,4 +24,5 @@
 #include "cpps/cst/statement-list.hpp"
 #include "cpps/cst/statement.hpp"
 #include "cpps/cst/translation-unit.hpp"
+#include "cpps/cst/typed-expression.hpp"
 #include "cpps/cst/unqualified-identifier.hpp"
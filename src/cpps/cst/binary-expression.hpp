@@ -7,9 +7,21 @@
 
 namespace CPPS::CST {
 
+// A basic-expression of the Expression a typed view is built from, referenced by the typed view
+struct BasicExpressionRef
+{
+    [[nodiscard]] SourceLocation getLocation() const;
+
+    // owned by the Expression, which must outlive the typed view
+    const BasicExpression* basic{nullptr};
+};
+
+// The typed view of an Expression, one type per precedence level, see makeTypedExpression()
 template<typename ExpressionTypeT>
 struct BinaryExpression : ExpressionTypeT
 {
+    using Operand = ExpressionTypeT;
+
     struct Term : ExpressionTypeT
     {
         explicit Term(const Token& token);
@@ -32,7 +44,7 @@ struct BinaryExpression : ExpressionTypeT
 };
 
 // clang-format off
-struct IsAsExpression : BinaryExpression<BasicExpression> {};
+struct IsAsExpression : BinaryExpression<BasicExpressionRef> {};
 struct MultiplicativeExpression : BinaryExpression<IsAsExpression> {};
 struct AdditiveExpression : BinaryExpression<MultiplicativeExpression> {};
 struct ShiftExpression : BinaryExpression<AdditiveExpression> {};
@@ -47,6 +59,11 @@ struct LogicalOrExpression : BinaryExpression<LogicalAndExpression> {};
 struct AssignmentExpression : BinaryExpression<LogicalOrExpression> {};
 // clang-format on
 
+inline SourceLocation BasicExpressionRef::getLocation() const
+{
+    return basic->getLocation();
+}
+
 template<typename ExpressionTypeT>
 BinaryExpression<ExpressionTypeT>::Term::Term(const Token& token)
     : op(token)
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "cpps/source-location.hpp"
+
+namespace CPPS::CST::BinaryFormat {
+
+/**
+ * The records of a translation unit serialized by BinaryWriter and read in place by BinaryReader.
+ *
+ * The buffer starts with the Header, every record is 4-byte aligned and holds fixed size fields, in the byte order of the
+ * writer. A node is a record, a list of nodes is an array of Refs, the small nodes of an Expression and of a
+ * PostfixExpression are arrays of records.
+ *
+ * A Ref is the offset of its target from the start of the record holding it, or from the start of the array of Refs
+ * holding it, 0 is null. The buffer has no absolute position, it can be mapped at any address. The records are written
+ * in pre-order: a Ref to a node or to an array points forward, except to a token or a text which are shared.
+ *
+ * The tokens are records of their lexeme, location and text, each token and each text is stored once.
+ * The format depends on the Lexeme encoding and on the node types: FormatVersion must change with them.
+ */
+
+inline constexpr std::array<char, 8> Magic{'C', 'P', 'P', 'S', 'C', 'S', 'T', '\0'};
+
+inline constexpr std::uint32_t FormatVersion{1};
+
+// written as is, read back as 0x04030201 by a reader of the other byte order
+inline constexpr std::uint32_t ByteOrderMark{0x01020304};
+
+inline constexpr std::uint32_t Alignment{4};
+
+struct Ref
+{
+    std::int32_t offset{0};
+};
+
+struct ArrayRef
+{
+    std::uint32_t count{0};
+    Ref data;
+};
+
+// the alternative index of a NodeVariant, the node is null for std::monostate and a null node
+struct VariantRef
+{
+    std::uint32_t index{0};
+    Ref node;
+};
+
+struct Header
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+
+    // the size of the whole buffer
+    std::uint32_t size;
+
+    // Refs to DeclarationRecord
+    ArrayRef declarations;
+
+    // DamagedRegionRecord
+    ArrayRef damagedRegions;
+};
+
+struct DamagedRegionRecord
+{
+    SourceLocation beginLocation;
+    SourceLocation endLocation;
+};
+
+struct TokenRecord
+{
+    std::uint16_t lexeme;
+    std::uint16_t reserved;
+    SourceLocation location;
+
+    // chars
+    ArrayRef text;
+};
+
+struct DeclarationRecord
+{
+    Ref identifier;
+    VariantRef type;
+    Ref pointerDeclaration;
+    Ref initializer;
+    SourceLocation startLocation;
+    SourceLocation endLocation;
+    SourceLocation equalLocation;
+};
+
+struct FunctionSignatureRecord
+{
+    Ref parameters;
+    VariantRef returns;
+    std::uint32_t throws;
+};
+
+struct ParameterDeclarationListRecord
+{
+    // Refs to ParameterDeclarationRecord
+    ArrayRef parameters;
+    SourceLocation openParenthesisLocation;
+    SourceLocation closeParenthesisLocation;
+};
+
+struct ParameterDeclarationRecord
+{
+    Ref declaration;
+    std::uint32_t modifier;
+    SourceLocation location;
+};
+
+struct IdentifierRecord
+{
+    VariantRef type;
+};
+
+struct IdentifierExpressionRecord
+{
+    IdentifierRecord identifier;
+    SourceLocation location;
+};
+
+struct QualifiedIdentifierTermRecord
+{
+    Ref scope;
+    Ref identifier;
+};
+
+struct QualifiedIdentifierRecord
+{
+    // QualifiedIdentifierTermRecord
+    ArrayRef terms;
+};
+
+struct UnqualifiedIdentifierRecord
+{
+    Ref identifier;
+    Ref constIdentifier;
+};
+
+struct StatementRecord
+{
+    VariantRef type;
+};
+
+struct CompoundStatementRecord
+{
+    // Refs to StatementRecord
+    ArrayRef statements;
+    SourceLocation openBraceLocation;
+    SourceLocation closeBraceLocation;
+};
+
+struct ExpressionStatementRecord
+{
+    Ref expression;
+    std::uint32_t hasSemicolon;
+};
+
+struct IterationStatementRecord
+{
+    std::uint32_t reserved;
+};
+
+struct ReturnStatementRecord
+{
+    Ref identifier;
+    Ref expression;
+};
+
+struct SelectionStatementRecord
+{
+    std::uint32_t reserved;
+};
+
+struct OperationRecord
+{
+    std::uint32_t kind;
+    std::uint32_t lhs;
+    std::uint32_t rhs;
+    Ref op;
+};
+
+struct BasicExpressionRecord
+{
+    Ref prefix;
+    Ref primary;
+    Ref postfix;
+};
+
+struct ExpressionRecord
+{
+    // OperationRecord
+    ArrayRef operations;
+
+    // BasicExpressionRecord
+    ArrayRef basics;
+};
+
+struct ExpressionTermRecord
+{
+    Ref expression;
+    std::uint32_t modifier;
+};
+
+struct ExpressionListRecord
+{
+    // Refs to ExpressionTermRecord
+    ArrayRef terms;
+    SourceLocation openParenthesisLocation;
+    SourceLocation closeParenthesisLocation;
+};
+
+struct PrefixExpressionRecord
+{
+    // Refs to TokenRecord
+    ArrayRef ops;
+};
+
+struct PrimaryExpressionRecord
+{
+    VariantRef type;
+};
+
+struct PostfixTermRecord
+{
+    Ref op;
+    Ref identifierExpression;
+
+    // an ExpressionListRecord and its closing token, for [ and (
+    Ref arguments;
+    Ref closeOp;
+};
+
+struct PostfixExpressionRecord
+{
+    // PostfixTermRecord
+    ArrayRef terms;
+};
+
+template<typename RecordT>
+concept Record = std::is_trivially_copyable_v<RecordT> && std::is_standard_layout_v<RecordT> && sizeof(RecordT) % Alignment == 0 &&
+                 alignof(RecordT) <= Alignment;
+
+} // namespace CPPS::CST::BinaryFormat
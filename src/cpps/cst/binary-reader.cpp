@@ -0,0 +1,941 @@
+#include "cpps/cst/binary-reader.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace CPPS::CST {
+
+namespace {
+
+// checks every record reachable from the header, so that the views can read the buffer unchecked
+class RecordChecker
+{
+public:
+    // bytes is the whole buffer, of the size of the header
+    explicit RecordChecker(std::span<const std::byte> bytes);
+
+    // the offset of the first invalid record, nullopt if every record is valid
+    [[nodiscard]] std::optional<std::size_t> check(const BinaryFormat::Header& header);
+
+private:
+    using Check = bool (RecordChecker::*)(std::size_t offset);
+
+    struct Pending
+    {
+        std::size_t offset;
+        Check check;
+    };
+
+    template<typename T>
+    bool checkNode(std::size_t offset);
+
+    template<typename T>
+    bool checkRef(std::size_t origin, BinaryFormat::Ref ref, bool isRequired = false);
+
+    template<typename T>
+    bool checkList(std::size_t origin, BinaryFormat::ArrayRef ref);
+
+    template<typename T>
+    bool checkArray(std::size_t origin, BinaryFormat::ArrayRef ref);
+
+    template<typename VariantT>
+    bool checkVariant(std::size_t origin, BinaryFormat::VariantRef ref);
+
+    bool checkToken(std::int64_t offset);
+
+    bool checkRecord(std::size_t offset, const BinaryFormat::DamagedRegionRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::DeclarationRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::FunctionSignatureRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::ParameterDeclarationListRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::ParameterDeclarationRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::IdentifierExpressionRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::QualifiedIdentifierTermRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::QualifiedIdentifierRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::UnqualifiedIdentifierRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::StatementRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::CompoundStatementRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::ExpressionStatementRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::IterationStatementRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::ReturnStatementRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::SelectionStatementRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::ExpressionRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::BasicExpressionRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::ExpressionTermRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::ExpressionListRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::PrefixExpressionRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::PrimaryExpressionRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::PostfixTermRecord& record);
+    bool checkRecord(std::size_t offset, const BinaryFormat::PostfixExpressionRecord& record);
+
+    // the offset of the count records of an array, nullopt if they are out of the buffer
+    template<BinaryFormat::Record RecordT>
+    std::optional<std::size_t> findArray(std::size_t origin, BinaryFormat::ArrayRef ref) const;
+
+    template<BinaryFormat::Record RecordT>
+    bool load(std::int64_t offset, RecordT& record);
+
+    [[nodiscard]] bool isInBuffer(std::int64_t offset, std::size_t size) const;
+
+    // a record loaded or a Ref read costs a unit: a valid buffer needs less units than its size, as each takes at least
+    // 4 bytes, while a record referenced many times cannot make the check quadratic
+    bool spend();
+
+    std::span<const std::byte> _bytes;
+
+    // the records are checked from a stack rather than recursively, the nesting depth comes from the buffer
+    std::vector<Pending> _pending;
+
+    std::size_t _unitsLeft;
+};
+
+RecordChecker::RecordChecker(std::span<const std::byte> bytes)
+    : _bytes(bytes)
+    , _unitsLeft(bytes.size())
+{
+}
+
+std::optional<std::size_t> RecordChecker::check(const BinaryFormat::Header& header)
+{
+    if (_bytes.size() < sizeof(BinaryFormat::Header) || !checkList<Declaration>(0, header.declarations) ||
+        !checkArray<TranslationUnit::DamagedRegion>(0, header.damagedRegions))
+    {
+        return 0;
+    }
+
+    while (!_pending.empty())
+    {
+        const Pending pending = _pending.back();
+        _pending.pop_back();
+
+        if (!(this->*pending.check)(pending.offset))
+        {
+            return pending.offset;
+        }
+    }
+
+    return std::nullopt;
+}
+
+template<typename T>
+bool RecordChecker::checkNode(std::size_t offset)
+{
+    typename BinaryView<T>::Record record;
+
+    return load(static_cast<std::int64_t>(offset), record) && checkRecord(offset, record);
+}
+
+template<typename T>
+bool RecordChecker::checkRef(std::size_t origin, BinaryFormat::Ref ref, bool isRequired)
+{
+    if (ref.offset == 0)
+    {
+        return !isRequired;
+    }
+
+    if constexpr (std::is_same_v<T, Token>)
+    {
+        // the tokens are stored once, they may be before their Ref
+        return checkToken(static_cast<std::int64_t>(origin) + ref.offset);
+    }
+    else
+    {
+        const std::size_t offset = origin + static_cast<std::size_t>(ref.offset);
+
+        // the other nodes are written after their Ref, which leaves no cycle to follow
+        if (ref.offset < 0 || offset % BinaryFormat::Alignment != 0 || !isInBuffer(static_cast<std::int64_t>(offset), sizeof(typename BinaryView<T>::Record)))
+        {
+            return false;
+        }
+
+        _pending.push_back({.offset = offset, .check = &RecordChecker::checkNode<T>});
+
+        return true;
+    }
+}
+
+template<typename T>
+bool RecordChecker::checkList(std::size_t origin, BinaryFormat::ArrayRef ref)
+{
+    const std::optional<std::size_t> data = findArray<BinaryFormat::Ref>(origin, ref);
+
+    if (!data)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < ref.count; ++i)
+    {
+        BinaryFormat::Ref item;
+
+        if (!load(static_cast<std::int64_t>(*data + i * sizeof(BinaryFormat::Ref)), item) || !checkRef<T>(*data, item, true))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename T>
+bool RecordChecker::checkArray(std::size_t origin, BinaryFormat::ArrayRef ref)
+{
+    using RecordT = typename BinaryView<T>::Record;
+
+    const std::optional<std::size_t> data = findArray<RecordT>(origin, ref);
+
+    if (!data)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < ref.count; ++i)
+    {
+        const std::size_t offset = *data + i * sizeof(RecordT);
+
+        RecordT record;
+
+        if (!load(static_cast<std::int64_t>(offset), record) || !checkRecord(offset, record))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename VariantT>
+bool RecordChecker::checkVariant(std::size_t origin, BinaryFormat::VariantRef ref)
+{
+    return [this, origin, ref]<typename... TypesT>(TypeList<TypesT...>) {
+        auto checkAlternative = [this, origin, ref]<typename T>(std::type_identity<T>) {
+            if constexpr (std::is_same_v<T, std::monostate>)
+            {
+                return ref.node.offset == 0;
+            }
+            else
+            {
+                return checkRef<T>(origin, ref.node);
+            }
+        };
+
+        return ((ref.index == IndexOfFromTypeListV<TypesT, typename VariantT::Types> && checkAlternative(std::type_identity<TypesT>{})) || ...);
+    }(typename VariantT::Types{});
+}
+
+bool RecordChecker::checkToken(std::int64_t offset)
+{
+    BinaryFormat::TokenRecord record;
+
+    if (!load(offset, record) || !Lexeme::isData(record.lexeme))
+    {
+        return false;
+    }
+
+    // the texts are stored once too, in any direction, and are not aligned
+    return record.text.count == 0 || isInBuffer(offset + record.text.data.offset, record.text.count);
+}
+
+bool RecordChecker::checkRecord(std::size_t, const BinaryFormat::DamagedRegionRecord&)
+{
+    return true;
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::DeclarationRecord& record)
+{
+    return checkRef<UnqualifiedIdentifier>(offset, record.identifier) && checkVariant<Declaration::Type>(offset, record.type) &&
+           checkRef<Token>(offset, record.pointerDeclaration) && checkRef<Statement>(offset, record.initializer);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::FunctionSignatureRecord& record)
+{
+    return checkRef<ParameterDeclarationList>(offset, record.parameters, true) && checkVariant<FunctionSignature::Returns>(offset, record.returns);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::ParameterDeclarationListRecord& record)
+{
+    return checkList<ParameterDeclaration>(offset, record.parameters);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::ParameterDeclarationRecord& record)
+{
+    return checkRef<Declaration>(offset, record.declaration) && record.modifier < ParameterModifierCount;
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::IdentifierExpressionRecord& record)
+{
+    // the IdentifierRecord is the first field of the record, its Refs are from the same origin
+    return checkVariant<Identifier::Type>(offset, record.identifier.type);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::QualifiedIdentifierTermRecord& record)
+{
+    return checkRef<Token>(offset, record.scope, true) && checkRef<UnqualifiedIdentifier>(offset, record.identifier, true);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::QualifiedIdentifierRecord& record)
+{
+    return checkArray<QualifiedIdentifier::Term>(offset, record.terms);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::UnqualifiedIdentifierRecord& record)
+{
+    return checkRef<Token>(offset, record.identifier, true) && checkRef<Token>(offset, record.constIdentifier);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::StatementRecord& record)
+{
+    return checkVariant<Statement::Type>(offset, record.type);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::CompoundStatementRecord& record)
+{
+    return checkList<Statement>(offset, record.statements);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::ExpressionStatementRecord& record)
+{
+    return checkRef<Expression>(offset, record.expression);
+}
+
+bool RecordChecker::checkRecord(std::size_t, const BinaryFormat::IterationStatementRecord&)
+{
+    return true;
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::ReturnStatementRecord& record)
+{
+    return checkRef<Token>(offset, record.identifier, true) && checkRef<Expression>(offset, record.expression);
+}
+
+bool RecordChecker::checkRecord(std::size_t, const BinaryFormat::SelectionStatementRecord&)
+{
+    return true;
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::ExpressionRecord& record)
+{
+    const std::optional<std::size_t> operations = findArray<BinaryFormat::OperationRecord>(offset, record.operations);
+
+    // the root is the last operation
+    if (!operations || record.operations.count == 0 || !checkArray<BasicExpression>(offset, record.basics))
+    {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < record.operations.count; ++i)
+    {
+        const std::size_t operationOffset = *operations + i * sizeof(BinaryFormat::OperationRecord);
+
+        BinaryFormat::OperationRecord operation;
+
+        if (!load(static_cast<std::int64_t>(operationOffset), operation) || operation.kind > static_cast<std::uint32_t>(Expression::Kind::Assignment))
+        {
+            return false;
+        }
+
+        // the operands are before their operation
+        const bool hasOperands = operation.kind == static_cast<std::uint32_t>(Expression::Kind::Basic) ? operation.lhs < record.basics.count
+                                                                                                        : operation.lhs < i && operation.rhs < i;
+
+        if (!hasOperands || !checkRef<Token>(operationOffset, operation.op))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::BasicExpressionRecord& record)
+{
+    return checkRef<PrefixExpression>(offset, record.prefix) && checkRef<PrimaryExpression>(offset, record.primary) &&
+           checkRef<PostfixExpression>(offset, record.postfix);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::ExpressionTermRecord& record)
+{
+    return checkRef<Expression>(offset, record.expression) && record.modifier < ParameterModifierCount;
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::ExpressionListRecord& record)
+{
+    return checkList<ExpressionTerm>(offset, record.terms);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::PrefixExpressionRecord& record)
+{
+    return checkList<Token>(offset, record.ops);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::PrimaryExpressionRecord& record)
+{
+    return checkVariant<PrimaryExpression::Type>(offset, record.type);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::PostfixTermRecord& record)
+{
+    return checkRef<Token>(offset, record.op, true) && checkRef<IdentifierExpression>(offset, record.identifierExpression) &&
+           checkRef<ExpressionList>(offset, record.arguments) && checkRef<Token>(offset, record.closeOp);
+}
+
+bool RecordChecker::checkRecord(std::size_t offset, const BinaryFormat::PostfixExpressionRecord& record)
+{
+    return checkArray<PostfixExpression::Term>(offset, record.terms);
+}
+
+template<BinaryFormat::Record RecordT>
+std::optional<std::size_t> RecordChecker::findArray(std::size_t origin, BinaryFormat::ArrayRef ref) const
+{
+    // the data of an empty array is never read
+    if (ref.count == 0)
+    {
+        return origin;
+    }
+
+    // the arrays are written after their Ref too
+    if (ref.data.offset <= 0)
+    {
+        return std::nullopt;
+    }
+
+    const std::size_t data = origin + static_cast<std::size_t>(ref.data.offset);
+
+    if (data % BinaryFormat::Alignment != 0 || data > _bytes.size() || ref.count > (_bytes.size() - data) / sizeof(RecordT))
+    {
+        return std::nullopt;
+    }
+
+    return data;
+}
+
+template<BinaryFormat::Record RecordT>
+bool RecordChecker::load(std::int64_t offset, RecordT& record)
+{
+    if (!spend() || offset % BinaryFormat::Alignment != 0 || !isInBuffer(offset, sizeof(RecordT)))
+    {
+        return false;
+    }
+
+    std::memcpy(&record, _bytes.data() + offset, sizeof(RecordT));
+
+    return true;
+}
+
+bool RecordChecker::isInBuffer(std::int64_t offset, std::size_t size) const
+{
+    return offset >= 0 && static_cast<std::uint64_t>(offset) <= _bytes.size() && size <= _bytes.size() - static_cast<std::size_t>(offset);
+}
+
+bool RecordChecker::spend()
+{
+    if (_unitsLeft == 0)
+    {
+        return false;
+    }
+
+    --_unitsLeft;
+
+    return true;
+}
+
+} // namespace
+
+Diagnosis::Message BinaryReader::DiagnosisMessage::byteOrderMismatch()
+{
+    return "the binary CST was written with another byte order";
+}
+
+Diagnosis::Message BinaryReader::DiagnosisMessage::invalidMagic()
+{
+    return "the buffer is not a binary CST";
+}
+
+Diagnosis::Message BinaryReader::DiagnosisMessage::invalidRecord(std::size_t offset)
+{
+    return {"the binary CST has an invalid record at offset {}", offset};
+}
+
+Diagnosis::Message BinaryReader::DiagnosisMessage::misalignedBuffer()
+{
+    return "the binary CST buffer is not 4-byte aligned";
+}
+
+Diagnosis::Message BinaryReader::DiagnosisMessage::truncatedBuffer(std::size_t size, std::size_t expectedSize)
+{
+    return {"the binary CST is truncated, {} bytes instead of {}", size, expectedSize};
+}
+
+Diagnosis::Message BinaryReader::DiagnosisMessage::unsupportedVersion(std::uint32_t version)
+{
+    return {"unsupported binary CST version {}", std::uint64_t{version}};
+}
+
+BinaryReader::BinaryReader(std::span<const std::byte> bytes)
+    : _bytes(bytes)
+{
+}
+
+bool BinaryReader::open(Diagnosis& diagnosis)
+{
+    _isOpened = false;
+
+    if (_bytes.size() < sizeof(BinaryFormat::Header))
+    {
+        diagnosis.error(DiagnosisMessage::truncatedBuffer(_bytes.size(), sizeof(BinaryFormat::Header)));
+        return false;
+    }
+
+    if (reinterpret_cast<std::uintptr_t>(_bytes.data()) % BinaryFormat::Alignment != 0)
+    {
+        diagnosis.error(DiagnosisMessage::misalignedBuffer());
+        return false;
+    }
+
+    std::memcpy(&_header, _bytes.data(), sizeof(BinaryFormat::Header));
+
+    if (_header.magic != BinaryFormat::Magic)
+    {
+        diagnosis.error(DiagnosisMessage::invalidMagic());
+        return false;
+    }
+
+    if (_header.byteOrderMark != BinaryFormat::ByteOrderMark)
+    {
+        diagnosis.error(DiagnosisMessage::byteOrderMismatch());
+        return false;
+    }
+
+    if (_header.version != BinaryFormat::FormatVersion)
+    {
+        diagnosis.error(DiagnosisMessage::unsupportedVersion(_header.version));
+        return false;
+    }
+
+    if (_bytes.size() < _header.size)
+    {
+        diagnosis.error(DiagnosisMessage::truncatedBuffer(_bytes.size(), _header.size));
+        return false;
+    }
+
+    if (const std::optional<std::size_t> offset = RecordChecker{_bytes.first(_header.size)}.check(_header))
+    {
+        diagnosis.error(DiagnosisMessage::invalidRecord(*offset));
+        return false;
+    }
+
+    _isOpened = true;
+
+    return true;
+}
+
+BinaryListView<Declaration> BinaryReader::getDeclarations() const
+{
+    assert(_isOpened);
+
+    return {resolve(_bytes.data(), _header.declarations.data), _header.declarations.count};
+}
+
+BinaryArrayView<TranslationUnit::DamagedRegion> BinaryReader::getDamagedRegions() const
+{
+    assert(_isOpened);
+
+    return {resolve(_bytes.data(), _header.damagedRegions.data), _header.damagedRegions.count};
+}
+
+Lexeme BinaryView<Token>::lexeme() const
+{
+    return Lexeme::fromData(load().lexeme);
+}
+
+SourceLocation BinaryView<Token>::location() const
+{
+    return load().location;
+}
+
+std::string_view BinaryView<Token>::text() const
+{
+    const BinaryFormat::ArrayRef text = load().text;
+
+    if (text.count == 0)
+    {
+        return {};
+    }
+
+    return {reinterpret_cast<const char*>(resolve(getRecord(), text.data)), text.count};
+}
+
+Token BinaryView<Token>::get() const
+{
+    return {lexeme(), location(), text()};
+}
+
+SourceLocation BinaryView<TranslationUnit::DamagedRegion>::beginLocation() const
+{
+    return load().beginLocation;
+}
+
+SourceLocation BinaryView<TranslationUnit::DamagedRegion>::endLocation() const
+{
+    return load().endLocation;
+}
+
+SourceLocation BinaryView<Declaration>::getLocation() const
+{
+    return startLocation();
+}
+
+BinaryView<UnqualifiedIdentifier> BinaryView<Declaration>::identifier() const
+{
+    return getNode<UnqualifiedIdentifier>(load().identifier);
+}
+
+BinaryVariantView<Declaration::Type> BinaryView<Declaration>::type() const
+{
+    return getVariant<Declaration::Type>(load().type);
+}
+
+BinaryView<Token> BinaryView<Declaration>::pointerDeclaration() const
+{
+    return getNode<Token>(load().pointerDeclaration);
+}
+
+BinaryView<Statement> BinaryView<Declaration>::initializer() const
+{
+    return getNode<Statement>(load().initializer);
+}
+
+SourceLocation BinaryView<Declaration>::startLocation() const
+{
+    return load().startLocation;
+}
+
+SourceLocation BinaryView<Declaration>::endLocation() const
+{
+    return load().endLocation;
+}
+
+SourceLocation BinaryView<Declaration>::equalLocation() const
+{
+    return load().equalLocation;
+}
+
+BinaryView<ParameterDeclarationList> BinaryView<FunctionSignature>::parameters() const
+{
+    return getNode<ParameterDeclarationList>(load().parameters);
+}
+
+BinaryVariantView<FunctionSignature::Returns> BinaryView<FunctionSignature>::returns() const
+{
+    return getVariant<FunctionSignature::Returns>(load().returns);
+}
+
+bool BinaryView<FunctionSignature>::throws() const
+{
+    return load().throws != 0;
+}
+
+bool BinaryView<ParameterDeclarationList>::empty() const
+{
+    return load().parameters.count == 0;
+}
+
+std::size_t BinaryView<ParameterDeclarationList>::size() const
+{
+    return load().parameters.count;
+}
+
+BinaryView<ParameterDeclaration> BinaryView<ParameterDeclarationList>::operator[](std::size_t index) const
+{
+    return getList<ParameterDeclaration>(load().parameters)[index];
+}
+
+SourceLocation BinaryView<ParameterDeclarationList>::openParenthesisLocation() const
+{
+    return load().openParenthesisLocation;
+}
+
+SourceLocation BinaryView<ParameterDeclarationList>::closeParenthesisLocation() const
+{
+    return load().closeParenthesisLocation;
+}
+
+BinaryView<Declaration> BinaryView<ParameterDeclaration>::declaration() const
+{
+    return getNode<Declaration>(load().declaration);
+}
+
+ParameterModifier BinaryView<ParameterDeclaration>::modifier() const
+{
+    return static_cast<ParameterModifier>(load().modifier);
+}
+
+SourceLocation BinaryView<ParameterDeclaration>::location() const
+{
+    return load().location;
+}
+
+BinaryVariantView<Identifier::Type> BinaryView<Identifier>::type() const
+{
+    return getVariant<Identifier::Type>(load().type);
+}
+
+SourceLocation BinaryView<IdentifierExpression>::getLocation() const
+{
+    return location();
+}
+
+BinaryView<Identifier> BinaryView<IdentifierExpression>::identifier() const
+{
+    // the IdentifierRecord is the first field of the record
+    return BinaryView<Identifier>{getRecord()};
+}
+
+SourceLocation BinaryView<IdentifierExpression>::location() const
+{
+    return load().location;
+}
+
+BinaryView<Token> BinaryView<QualifiedIdentifier::Term>::scope() const
+{
+    return getNode<Token>(load().scope);
+}
+
+BinaryView<UnqualifiedIdentifier> BinaryView<QualifiedIdentifier::Term>::identifier() const
+{
+    return getNode<UnqualifiedIdentifier>(load().identifier);
+}
+
+BinaryArrayView<QualifiedIdentifier::Term> BinaryView<QualifiedIdentifier>::terms() const
+{
+    return getArray<QualifiedIdentifier::Term>(load().terms);
+}
+
+SourceLocation BinaryView<UnqualifiedIdentifier>::getLocation() const
+{
+    return identifier().location();
+}
+
+BinaryView<Token> BinaryView<UnqualifiedIdentifier>::identifier() const
+{
+    return getNode<Token>(load().identifier);
+}
+
+BinaryView<Token> BinaryView<UnqualifiedIdentifier>::constIdentifier() const
+{
+    return getNode<Token>(load().constIdentifier);
+}
+
+BinaryVariantView<Statement::Type> BinaryView<Statement>::type() const
+{
+    return getVariant<Statement::Type>(load().type);
+}
+
+SourceLocation BinaryView<CompoundStatement>::getLocation() const
+{
+    return openBraceLocation();
+}
+
+bool BinaryView<CompoundStatement>::empty() const
+{
+    return load().statements.count == 0;
+}
+
+std::size_t BinaryView<CompoundStatement>::size() const
+{
+    return load().statements.count;
+}
+
+BinaryView<Statement> BinaryView<CompoundStatement>::operator[](std::size_t index) const
+{
+    return getList<Statement>(load().statements)[index];
+}
+
+SourceLocation BinaryView<CompoundStatement>::openBraceLocation() const
+{
+    return load().openBraceLocation;
+}
+
+SourceLocation BinaryView<CompoundStatement>::closeBraceLocation() const
+{
+    return load().closeBraceLocation;
+}
+
+BinaryView<Expression> BinaryView<ExpressionStatement>::expression() const
+{
+    return getNode<Expression>(load().expression);
+}
+
+bool BinaryView<ExpressionStatement>::hasSemicolon() const
+{
+    return load().hasSemicolon != 0;
+}
+
+SourceLocation BinaryView<ReturnStatement>::getLocation() const
+{
+    return identifier().location();
+}
+
+BinaryView<Token> BinaryView<ReturnStatement>::identifier() const
+{
+    return getNode<Token>(load().identifier);
+}
+
+BinaryView<Expression> BinaryView<ReturnStatement>::expression() const
+{
+    return getNode<Expression>(load().expression);
+}
+
+Expression::Kind BinaryView<Expression::Operation>::kind() const
+{
+    return static_cast<Expression::Kind>(load().kind);
+}
+
+std::uint32_t BinaryView<Expression::Operation>::lhs() const
+{
+    return load().lhs;
+}
+
+std::uint32_t BinaryView<Expression::Operation>::rhs() const
+{
+    return load().rhs;
+}
+
+BinaryView<Token> BinaryView<Expression::Operation>::op() const
+{
+    return getNode<Token>(load().op);
+}
+
+bool BinaryView<Expression>::isBasic() const
+{
+    return getRoot().kind() == Expression::Kind::Basic;
+}
+
+BinaryView<Expression::Operation> BinaryView<Expression>::getRoot() const
+{
+    const BinaryArrayView<Expression::Operation> operations = this->operations();
+
+    return operations[operations.size() - 1];
+}
+
+BinaryView<Expression::Operation> BinaryView<Expression>::getLhs(const BinaryView<Expression::Operation>& operation) const
+{
+    assert(operation.kind() != Expression::Kind::Basic);
+
+    return operations()[operation.lhs()];
+}
+
+BinaryView<Expression::Operation> BinaryView<Expression>::getRhs(const BinaryView<Expression::Operation>& operation) const
+{
+    assert(operation.kind() != Expression::Kind::Basic);
+
+    return operations()[operation.rhs()];
+}
+
+BinaryView<BasicExpression> BinaryView<Expression>::getBasic(const BinaryView<Expression::Operation>& operation) const
+{
+    assert(operation.kind() == Expression::Kind::Basic);
+
+    return basics()[operation.lhs()];
+}
+
+BinaryArrayView<Expression::Operation> BinaryView<Expression>::operations() const
+{
+    return getArray<Expression::Operation>(load().operations);
+}
+
+BinaryArrayView<BasicExpression> BinaryView<Expression>::basics() const
+{
+    return getArray<BasicExpression>(load().basics);
+}
+
+BinaryView<Expression> BinaryView<ExpressionTerm>::expression() const
+{
+    return getNode<Expression>(load().expression);
+}
+
+ParameterModifier BinaryView<ExpressionTerm>::modifier() const
+{
+    return static_cast<ParameterModifier>(load().modifier);
+}
+
+bool BinaryView<ExpressionList>::empty() const
+{
+    return load().terms.count == 0;
+}
+
+std::size_t BinaryView<ExpressionList>::size() const
+{
+    return load().terms.count;
+}
+
+BinaryView<ExpressionTerm> BinaryView<ExpressionList>::operator[](std::size_t index) const
+{
+    return getList<ExpressionTerm>(load().terms)[index];
+}
+
+SourceLocation BinaryView<ExpressionList>::openParenthesisLocation() const
+{
+    return load().openParenthesisLocation;
+}
+
+SourceLocation BinaryView<ExpressionList>::closeParenthesisLocation() const
+{
+    return load().closeParenthesisLocation;
+}
+
+BinaryView<PrefixExpression> BinaryView<BasicExpression>::prefix() const
+{
+    return getNode<PrefixExpression>(load().prefix);
+}
+
+BinaryView<PrimaryExpression> BinaryView<BasicExpression>::primary() const
+{
+    return getNode<PrimaryExpression>(load().primary);
+}
+
+BinaryView<PostfixExpression> BinaryView<BasicExpression>::postfix() const
+{
+    return getNode<PostfixExpression>(load().postfix);
+}
+
+BinaryListView<Token> BinaryView<PrefixExpression>::ops() const
+{
+    return getList<Token>(load().ops);
+}
+
+BinaryVariantView<PrimaryExpression::Type> BinaryView<PrimaryExpression>::type() const
+{
+    return getVariant<PrimaryExpression::Type>(load().type);
+}
+
+BinaryView<Token> BinaryView<PostfixExpression::Term>::op() const
+{
+    return getNode<Token>(load().op);
+}
+
+BinaryView<IdentifierExpression> BinaryView<PostfixExpression::Term>::identifierExpression() const
+{
+    return getNode<IdentifierExpression>(load().identifierExpression);
+}
+
+BinaryView<ExpressionList> BinaryView<PostfixExpression::Term>::arguments() const
+{
+    return getNode<ExpressionList>(load().arguments);
+}
+
+BinaryView<Token> BinaryView<PostfixExpression::Term>::closeOp() const
+{
+    return getNode<Token>(load().closeOp);
+}
+
+BinaryArrayView<PostfixExpression::Term> BinaryView<PostfixExpression>::terms() const
+{
+    return getArray<PostfixExpression::Term>(load().terms);
+}
+
+} // namespace CPPS::CST
@@ -0,0 +1,605 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include "cpps/cst.hpp"
+#include "cpps/cst/binary-format.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/utility/type-list.hpp"
+
+namespace CPPS::CST {
+
+// a read only node of a serialized translation unit, specialized below for each node type
+template<typename T>
+class BinaryView;
+
+template<typename T>
+class BinaryListView;
+
+template<typename T>
+class BinaryArrayView;
+
+template<typename VariantT>
+class BinaryVariantView;
+
+/**
+ * Reads in place a translation unit serialized by BinaryWriter, e.g. from a mapped file or a shared memory.
+ *
+ * The nodes are BinaryViews over the buffer, with an accessor for each field of the node type: a node is a view, a list
+ * of nodes a BinaryListView or a BinaryArrayView, a NodeVariant a BinaryVariantView and a token a BinaryView<Token>
+ * which text views the buffer. Nothing is copied nor allocated, a view costs a pointer and the buffer must outlive it.
+ *
+ * open checks the header and every record reachable from it: the offsets stay in the buffer, the lexemes, enums and
+ * variant indexes are valid and the Refs to nodes point forward, so a corrupted buffer is diagnosed rather than read out of
+ * bounds. The buffer must stay unchanged while it is read.
+ */
+class BinaryReader
+{
+public:
+    struct DiagnosisMessage
+    {
+        static Diagnosis::Message byteOrderMismatch();
+        static Diagnosis::Message invalidMagic();
+        static Diagnosis::Message invalidRecord(std::size_t offset);
+        static Diagnosis::Message misalignedBuffer();
+        static Diagnosis::Message truncatedBuffer(std::size_t size, std::size_t expectedSize);
+        static Diagnosis::Message unsupportedVersion(std::uint32_t version);
+    };
+
+public:
+    explicit BinaryReader(std::span<const std::byte> bytes);
+
+    // checks the header and the records, false with an error added to the diagnosis if the buffer cannot be read
+    [[nodiscard]] bool open(Diagnosis& diagnosis);
+
+    // the reader must be opened
+    [[nodiscard]] BinaryListView<Declaration> getDeclarations() const;
+    [[nodiscard]] BinaryArrayView<TranslationUnit::DamagedRegion> getDamagedRegions() const;
+
+private:
+    std::span<const std::byte> _bytes;
+
+    BinaryFormat::Header _header{};
+
+    bool _isOpened{false};
+};
+
+// the target of ref, a Ref held by the record or the array of Refs at origin, nullptr if ref is null
+[[nodiscard]] inline const std::byte* resolve(const std::byte* origin, BinaryFormat::Ref ref)
+{
+    return ref.offset != 0 ? origin + ref.offset : nullptr;
+}
+
+template<BinaryFormat::Record RecordT>
+class BinaryRecordView
+{
+public:
+    using Record = RecordT;
+
+public:
+    BinaryRecordView() = default;
+
+    // record is nullptr for a null node
+    explicit BinaryRecordView(const std::byte* record);
+
+    [[nodiscard]] explicit operator bool() const;
+
+protected:
+    [[nodiscard]] const std::byte* getRecord() const;
+
+    [[nodiscard]] RecordT load() const;
+
+    template<typename T>
+    [[nodiscard]] BinaryView<T> getNode(BinaryFormat::Ref ref) const;
+
+    template<typename T>
+    [[nodiscard]] BinaryListView<T> getList(BinaryFormat::ArrayRef ref) const;
+
+    template<typename T>
+    [[nodiscard]] BinaryArrayView<T> getArray(BinaryFormat::ArrayRef ref) const;
+
+    template<typename VariantT>
+    [[nodiscard]] BinaryVariantView<VariantT> getVariant(BinaryFormat::VariantRef ref) const;
+
+private:
+    const std::byte* _record{nullptr};
+};
+
+// an array of Refs to T records
+template<typename T>
+class BinaryListView
+{
+public:
+    BinaryListView() = default;
+    BinaryListView(const std::byte* data, std::uint32_t count);
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] BinaryView<T> operator[](std::size_t index) const;
+
+private:
+    const std::byte* _data{nullptr};
+    std::uint32_t _count{0};
+};
+
+// an array of T records
+template<typename T>
+class BinaryArrayView
+{
+public:
+    BinaryArrayView() = default;
+    BinaryArrayView(const std::byte* data, std::uint32_t count);
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] BinaryView<T> operator[](std::size_t index) const;
+
+private:
+    const std::byte* _data{nullptr};
+    std::uint32_t _count{0};
+};
+
+template<typename VariantT>
+class BinaryVariantView
+{
+public:
+    BinaryVariantView(std::uint32_t index, const std::byte* node);
+
+    template<typename T>
+    [[nodiscard]] bool is() const;
+
+    [[nodiscard]] std::size_t index() const;
+
+    // a null view if the node is null
+    template<typename T>
+    [[nodiscard]] BinaryView<T> as() const;
+
+private:
+    std::uint32_t _index;
+    const std::byte* _node;
+};
+
+template<>
+class BinaryView<Token> : public BinaryRecordView<BinaryFormat::TokenRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] Lexeme lexeme() const;
+    [[nodiscard]] SourceLocation location() const;
+    [[nodiscard]] std::string_view text() const;
+
+    [[nodiscard]] Token get() const;
+};
+
+template<>
+class BinaryView<TranslationUnit::DamagedRegion> : public BinaryRecordView<BinaryFormat::DamagedRegionRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] SourceLocation beginLocation() const;
+    [[nodiscard]] SourceLocation endLocation() const;
+};
+
+template<>
+class BinaryView<Declaration> : public BinaryRecordView<BinaryFormat::DeclarationRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] SourceLocation getLocation() const;
+
+    [[nodiscard]] BinaryView<UnqualifiedIdentifier> identifier() const;
+    [[nodiscard]] BinaryVariantView<Declaration::Type> type() const;
+    [[nodiscard]] BinaryView<Token> pointerDeclaration() const;
+    [[nodiscard]] BinaryView<Statement> initializer() const;
+    [[nodiscard]] SourceLocation startLocation() const;
+    [[nodiscard]] SourceLocation endLocation() const;
+    [[nodiscard]] SourceLocation equalLocation() const;
+};
+
+template<>
+class BinaryView<FunctionSignature> : public BinaryRecordView<BinaryFormat::FunctionSignatureRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryView<ParameterDeclarationList> parameters() const;
+    [[nodiscard]] BinaryVariantView<FunctionSignature::Returns> returns() const;
+    [[nodiscard]] bool throws() const;
+};
+
+template<>
+class BinaryView<ParameterDeclarationList> : public BinaryRecordView<BinaryFormat::ParameterDeclarationListRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] BinaryView<ParameterDeclaration> operator[](std::size_t index) const;
+
+    [[nodiscard]] SourceLocation openParenthesisLocation() const;
+    [[nodiscard]] SourceLocation closeParenthesisLocation() const;
+};
+
+template<>
+class BinaryView<ParameterDeclaration> : public BinaryRecordView<BinaryFormat::ParameterDeclarationRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryView<Declaration> declaration() const;
+    [[nodiscard]] ParameterModifier modifier() const;
+    [[nodiscard]] SourceLocation location() const;
+};
+
+template<>
+class BinaryView<Identifier> : public BinaryRecordView<BinaryFormat::IdentifierRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryVariantView<Identifier::Type> type() const;
+};
+
+template<>
+class BinaryView<IdentifierExpression> : public BinaryRecordView<BinaryFormat::IdentifierExpressionRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] SourceLocation getLocation() const;
+
+    [[nodiscard]] BinaryView<Identifier> identifier() const;
+    [[nodiscard]] SourceLocation location() const;
+};
+
+template<>
+class BinaryView<QualifiedIdentifier::Term> : public BinaryRecordView<BinaryFormat::QualifiedIdentifierTermRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryView<Token> scope() const;
+    [[nodiscard]] BinaryView<UnqualifiedIdentifier> identifier() const;
+};
+
+template<>
+class BinaryView<QualifiedIdentifier> : public BinaryRecordView<BinaryFormat::QualifiedIdentifierRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryArrayView<QualifiedIdentifier::Term> terms() const;
+};
+
+template<>
+class BinaryView<UnqualifiedIdentifier> : public BinaryRecordView<BinaryFormat::UnqualifiedIdentifierRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] SourceLocation getLocation() const;
+
+    [[nodiscard]] BinaryView<Token> identifier() const;
+    [[nodiscard]] BinaryView<Token> constIdentifier() const;
+};
+
+template<>
+class BinaryView<Statement> : public BinaryRecordView<BinaryFormat::StatementRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryVariantView<Statement::Type> type() const;
+};
+
+template<>
+class BinaryView<CompoundStatement> : public BinaryRecordView<BinaryFormat::CompoundStatementRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] SourceLocation getLocation() const;
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] BinaryView<Statement> operator[](std::size_t index) const;
+
+    [[nodiscard]] SourceLocation openBraceLocation() const;
+    [[nodiscard]] SourceLocation closeBraceLocation() const;
+};
+
+template<>
+class BinaryView<ExpressionStatement> : public BinaryRecordView<BinaryFormat::ExpressionStatementRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryView<Expression> expression() const;
+    [[nodiscard]] bool hasSemicolon() const;
+};
+
+template<>
+class BinaryView<IterationStatement> : public BinaryRecordView<BinaryFormat::IterationStatementRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+};
+
+template<>
+class BinaryView<ReturnStatement> : public BinaryRecordView<BinaryFormat::ReturnStatementRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] SourceLocation getLocation() const;
+
+    [[nodiscard]] BinaryView<Token> identifier() const;
+    [[nodiscard]] BinaryView<Expression> expression() const;
+};
+
+template<>
+class BinaryView<SelectionStatement> : public BinaryRecordView<BinaryFormat::SelectionStatementRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+};
+
+template<>
+class BinaryView<Expression::Operation> : public BinaryRecordView<BinaryFormat::OperationRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] Expression::Kind kind() const;
+    [[nodiscard]] std::uint32_t lhs() const;
+    [[nodiscard]] std::uint32_t rhs() const;
+    [[nodiscard]] BinaryView<Token> op() const;
+};
+
+template<>
+class BinaryView<Expression> : public BinaryRecordView<BinaryFormat::ExpressionRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] bool isBasic() const;
+
+    [[nodiscard]] BinaryView<Expression::Operation> getRoot() const;
+    [[nodiscard]] BinaryView<Expression::Operation> getLhs(const BinaryView<Expression::Operation>& operation) const;
+    [[nodiscard]] BinaryView<Expression::Operation> getRhs(const BinaryView<Expression::Operation>& operation) const;
+    [[nodiscard]] BinaryView<BasicExpression> getBasic(const BinaryView<Expression::Operation>& operation) const;
+
+    [[nodiscard]] BinaryArrayView<Expression::Operation> operations() const;
+    [[nodiscard]] BinaryArrayView<BasicExpression> basics() const;
+};
+
+template<>
+class BinaryView<ExpressionTerm> : public BinaryRecordView<BinaryFormat::ExpressionTermRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryView<Expression> expression() const;
+    [[nodiscard]] ParameterModifier modifier() const;
+};
+
+template<>
+class BinaryView<ExpressionList> : public BinaryRecordView<BinaryFormat::ExpressionListRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] BinaryView<ExpressionTerm> operator[](std::size_t index) const;
+
+    [[nodiscard]] SourceLocation openParenthesisLocation() const;
+    [[nodiscard]] SourceLocation closeParenthesisLocation() const;
+};
+
+template<>
+class BinaryView<BasicExpression> : public BinaryRecordView<BinaryFormat::BasicExpressionRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryView<PrefixExpression> prefix() const;
+    [[nodiscard]] BinaryView<PrimaryExpression> primary() const;
+    [[nodiscard]] BinaryView<PostfixExpression> postfix() const;
+};
+
+template<>
+class BinaryView<PrefixExpression> : public BinaryRecordView<BinaryFormat::PrefixExpressionRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryListView<Token> ops() const;
+};
+
+template<>
+class BinaryView<PrimaryExpression> : public BinaryRecordView<BinaryFormat::PrimaryExpressionRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryVariantView<PrimaryExpression::Type> type() const;
+};
+
+template<>
+class BinaryView<PostfixExpression::Term> : public BinaryRecordView<BinaryFormat::PostfixTermRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryView<Token> op() const;
+    [[nodiscard]] BinaryView<IdentifierExpression> identifierExpression() const;
+
+    // the expressions of the [ or ( term, and its closing token
+    [[nodiscard]] BinaryView<ExpressionList> arguments() const;
+    [[nodiscard]] BinaryView<Token> closeOp() const;
+};
+
+template<>
+class BinaryView<PostfixExpression> : public BinaryRecordView<BinaryFormat::PostfixExpressionRecord>
+{
+public:
+    using BinaryRecordView::BinaryRecordView;
+
+    [[nodiscard]] BinaryArrayView<PostfixExpression::Term> terms() const;
+};
+
+template<BinaryFormat::Record RecordT>
+BinaryRecordView<RecordT>::BinaryRecordView(const std::byte* record)
+    : _record(record)
+{
+}
+
+template<BinaryFormat::Record RecordT>
+BinaryRecordView<RecordT>::operator bool() const
+{
+    return _record != nullptr;
+}
+
+template<BinaryFormat::Record RecordT>
+const std::byte* BinaryRecordView<RecordT>::getRecord() const
+{
+    return _record;
+}
+
+template<BinaryFormat::Record RecordT>
+RecordT BinaryRecordView<RecordT>::load() const
+{
+    assert(_record != nullptr);
+
+    RecordT record;
+    std::memcpy(&record, _record, sizeof(RecordT));
+    return record;
+}
+
+template<BinaryFormat::Record RecordT>
+template<typename T>
+BinaryView<T> BinaryRecordView<RecordT>::getNode(BinaryFormat::Ref ref) const
+{
+    return BinaryView<T>{resolve(_record, ref)};
+}
+
+template<BinaryFormat::Record RecordT>
+template<typename T>
+BinaryListView<T> BinaryRecordView<RecordT>::getList(BinaryFormat::ArrayRef ref) const
+{
+    return {resolve(_record, ref.data), ref.count};
+}
+
+template<BinaryFormat::Record RecordT>
+template<typename T>
+BinaryArrayView<T> BinaryRecordView<RecordT>::getArray(BinaryFormat::ArrayRef ref) const
+{
+    return {resolve(_record, ref.data), ref.count};
+}
+
+template<BinaryFormat::Record RecordT>
+template<typename VariantT>
+BinaryVariantView<VariantT> BinaryRecordView<RecordT>::getVariant(BinaryFormat::VariantRef ref) const
+{
+    return {ref.index, resolve(_record, ref.node)};
+}
+
+template<typename T>
+BinaryListView<T>::BinaryListView(const std::byte* data, std::uint32_t count)
+    : _data(data)
+    , _count(count)
+{
+}
+
+template<typename T>
+bool BinaryListView<T>::empty() const
+{
+    return _count == 0;
+}
+
+template<typename T>
+std::size_t BinaryListView<T>::size() const
+{
+    return _count;
+}
+
+template<typename T>
+BinaryView<T> BinaryListView<T>::operator[](std::size_t index) const
+{
+    assert(index < _count);
+
+    BinaryFormat::Ref ref;
+    std::memcpy(&ref, _data + index * sizeof(BinaryFormat::Ref), sizeof(BinaryFormat::Ref));
+
+    return BinaryView<T>{resolve(_data, ref)};
+}
+
+template<typename T>
+BinaryArrayView<T>::BinaryArrayView(const std::byte* data, std::uint32_t count)
+    : _data(data)
+    , _count(count)
+{
+}
+
+template<typename T>
+bool BinaryArrayView<T>::empty() const
+{
+    return _count == 0;
+}
+
+template<typename T>
+std::size_t BinaryArrayView<T>::size() const
+{
+    return _count;
+}
+
+template<typename T>
+BinaryView<T> BinaryArrayView<T>::operator[](std::size_t index) const
+{
+    assert(index < _count);
+
+    return BinaryView<T>{_data + index * sizeof(typename BinaryView<T>::Record)};
+}
+
+template<typename VariantT>
+BinaryVariantView<VariantT>::BinaryVariantView(std::uint32_t index, const std::byte* node)
+    : _index(index)
+    , _node(node)
+{
+}
+
+template<typename VariantT>
+template<typename T>
+bool BinaryVariantView<VariantT>::is() const
+{
+    return _index == IndexOfFromTypeListV<T, typename VariantT::Types>;
+}
+
+template<typename VariantT>
+std::size_t BinaryVariantView<VariantT>::index() const
+{
+    return _index;
+}
+
+template<typename VariantT>
+template<typename T>
+BinaryView<T> BinaryVariantView<VariantT>::as() const
+{
+    assert(is<T>());
+
+    return BinaryView<T>{_node};
+}
+
+} // namespace CPPS::CST
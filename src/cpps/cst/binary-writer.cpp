@@ -0,0 +1,424 @@
+#include "cpps/cst/binary-writer.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "cpps/utility/trace.hpp"
+
+namespace CPPS::CST {
+
+BinaryWriter::BinaryWriter(const TranslationUnit& translationUnit)
+    : _translationUnit(translationUnit)
+{
+}
+
+std::vector<std::byte> BinaryWriter::write()
+{
+    CPPS_TRACE_ZONE("BinaryWriter::write");
+
+    _buffer.clear();
+    _tokenOffsets.clear();
+    _textOffsets.clear();
+
+    const std::uint32_t offset = reserve<BinaryFormat::Header>();
+
+    BinaryFormat::Header header{.magic = BinaryFormat::Magic, .version = BinaryFormat::FormatVersion, .byteOrderMark = BinaryFormat::ByteOrderMark, .size = 0, .declarations = {}, .damagedRegions = {}};
+
+    const DeclarationList& declarations = _translationUnit.declarations;
+
+    header.declarations = writeRefs(offset, declarations.size(), [this, &declarations](std::size_t i) { return write(declarations[i]); });
+
+    const std::vector<TranslationUnit::DamagedRegion>& damagedRegions = _translationUnit.damagedRegions;
+
+    const std::uint32_t regionsOffset = reserve<BinaryFormat::DamagedRegionRecord>(damagedRegions.size());
+
+    for (std::size_t i = 0; i < damagedRegions.size(); ++i)
+    {
+        store(regionsOffset + static_cast<std::uint32_t>(i * sizeof(BinaryFormat::DamagedRegionRecord)),
+              BinaryFormat::DamagedRegionRecord{.beginLocation = damagedRegions[i].beginLocation, .endLocation = damagedRegions[i].endLocation});
+    }
+
+    header.damagedRegions = {.count = static_cast<std::uint32_t>(damagedRegions.size()), .data = makeRef(offset, regionsOffset)};
+    header.size = static_cast<std::uint32_t>(_buffer.size());
+
+    store(offset, header);
+
+    return std::move(_buffer);
+}
+
+std::uint32_t BinaryWriter::write(const Token& token)
+{
+    if (auto it = _tokenOffsets.find(&token); it != _tokenOffsets.end())
+    {
+        return it->second;
+    }
+
+    const std::uint32_t offset = reserve<BinaryFormat::TokenRecord>();
+
+    store(offset, BinaryFormat::TokenRecord{.lexeme = token.lexeme.getData(), .reserved = 0, .location = token.location, .text = writeText(offset, token.text)});
+
+    _tokenOffsets.emplace(&token, offset);
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const Declaration& declaration)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::DeclarationRecord>();
+
+    BinaryFormat::DeclarationRecord record{};
+    record.identifier = writeIf(offset, declaration.identifier);
+    record.type = writeVariant(offset, declaration.type);
+
+    if (declaration.pointerDeclaration)
+    {
+        record.pointerDeclaration = makeRef(offset, write(declaration.pointerDeclaration->get()));
+    }
+
+    if (declaration.initializer)
+    {
+        record.initializer = writeIf(offset, *declaration.initializer);
+    }
+
+    record.startLocation = declaration.startLocation;
+    record.endLocation = declaration.endLocation;
+    record.equalLocation = declaration.equalLocation;
+
+    store(offset, record);
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const FunctionSignature& signature)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::FunctionSignatureRecord>();
+
+    store(offset,
+          BinaryFormat::FunctionSignatureRecord{
+              .parameters = makeRef(offset, write(signature.parameters)),
+              .returns = writeVariant(offset, signature.returns),
+              .throws = signature.throws ? 1U : 0U});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const ParameterDeclarationList& parameters)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::ParameterDeclarationListRecord>();
+
+    store(offset,
+          BinaryFormat::ParameterDeclarationListRecord{
+              .parameters = writeRefs(offset, parameters.size(), [this, &parameters](std::size_t i) { return write(parameters[i]); }),
+              .openParenthesisLocation = parameters.openParenthesisLocation,
+              .closeParenthesisLocation = parameters.closeParenthesisLocation});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const ParameterDeclaration& parameter)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::ParameterDeclarationRecord>();
+
+    store(offset,
+          BinaryFormat::ParameterDeclarationRecord{
+              .declaration = writeIf(offset, parameter.declaration),
+              .modifier = static_cast<std::uint32_t>(parameter.modifier),
+              .location = parameter.location});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const IdentifierExpression& expression)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::IdentifierExpressionRecord>();
+
+    store(offset, BinaryFormat::IdentifierExpressionRecord{.identifier = {.type = writeVariant(offset, expression.identifier.type)}, .location = expression.location});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const QualifiedIdentifier& identifier)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::QualifiedIdentifierRecord>();
+    const std::uint32_t termsOffset = reserve<BinaryFormat::QualifiedIdentifierTermRecord>(identifier.terms.size());
+
+    for (std::size_t i = 0; i < identifier.terms.size(); ++i)
+    {
+        write(termsOffset + static_cast<std::uint32_t>(i * sizeof(BinaryFormat::QualifiedIdentifierTermRecord)), identifier.terms[i]);
+    }
+
+    store(offset, BinaryFormat::QualifiedIdentifierRecord{.terms = {.count = static_cast<std::uint32_t>(identifier.terms.size()), .data = makeRef(offset, termsOffset)}});
+
+    return offset;
+}
+
+void BinaryWriter::write(std::uint32_t offset, const QualifiedIdentifier::Term& term)
+{
+    store(offset, BinaryFormat::QualifiedIdentifierTermRecord{.scope = makeRef(offset, write(term.scope.get())), .identifier = makeRef(offset, write(term.identifier))});
+}
+
+std::uint32_t BinaryWriter::write(const UnqualifiedIdentifier& identifier)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::UnqualifiedIdentifierRecord>();
+
+    BinaryFormat::UnqualifiedIdentifierRecord record{};
+    record.identifier = makeRef(offset, write(identifier.identifier.get()));
+
+    if (identifier.constIdentifier)
+    {
+        record.constIdentifier = makeRef(offset, write(identifier.constIdentifier->get()));
+    }
+
+    store(offset, record);
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const Statement& statement)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::StatementRecord>();
+
+    store(offset, BinaryFormat::StatementRecord{.type = writeVariant(offset, statement.type)});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const CompoundStatement& statement)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::CompoundStatementRecord>();
+
+    store(offset,
+          BinaryFormat::CompoundStatementRecord{
+              .statements = writeRefs(offset, statement.size(), [this, &statement](std::size_t i) { return write(statement[i]); }),
+              .openBraceLocation = statement.openBraceLocation,
+              .closeBraceLocation = statement.closeBraceLocation});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const ExpressionStatement& statement)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::ExpressionStatementRecord>();
+
+    store(offset, BinaryFormat::ExpressionStatementRecord{.expression = writeIf(offset, statement.expression), .hasSemicolon = statement.hasSemicolon ? 1U : 0U});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const IterationStatement&)
+{
+    return reserve<BinaryFormat::IterationStatementRecord>();
+}
+
+std::uint32_t BinaryWriter::write(const ReturnStatement& statement)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::ReturnStatementRecord>();
+
+    store(offset, BinaryFormat::ReturnStatementRecord{.identifier = makeRef(offset, write(statement.identifier.get())), .expression = writeIf(offset, statement.expression)});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const SelectionStatement&)
+{
+    return reserve<BinaryFormat::SelectionStatementRecord>();
+}
+
+std::uint32_t BinaryWriter::write(const Expression& expression)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::ExpressionRecord>();
+
+    const std::uint32_t operationsOffset = reserve<BinaryFormat::OperationRecord>(expression.operations.size());
+
+    for (std::size_t i = 0; i < expression.operations.size(); ++i)
+    {
+        const Expression::Operation& operation = expression.operations[i];
+        const auto operationOffset = operationsOffset + static_cast<std::uint32_t>(i * sizeof(BinaryFormat::OperationRecord));
+
+        store(operationOffset,
+              BinaryFormat::OperationRecord{
+                  .kind = static_cast<std::uint32_t>(operation.kind),
+                  .lhs = operation.lhs,
+                  .rhs = operation.rhs,
+                  .op = operation.op ? makeRef(operationOffset, write(operation.op->get())) : BinaryFormat::Ref{}});
+    }
+
+    const std::uint32_t basicsOffset = reserve<BinaryFormat::BasicExpressionRecord>(expression.basics.size());
+
+    for (std::size_t i = 0; i < expression.basics.size(); ++i)
+    {
+        write(basicsOffset + static_cast<std::uint32_t>(i * sizeof(BinaryFormat::BasicExpressionRecord)), expression.basics[i]);
+    }
+
+    store(offset,
+          BinaryFormat::ExpressionRecord{
+              .operations = {.count = static_cast<std::uint32_t>(expression.operations.size()), .data = makeRef(offset, operationsOffset)},
+              .basics = {.count = static_cast<std::uint32_t>(expression.basics.size()), .data = makeRef(offset, basicsOffset)}});
+
+    return offset;
+}
+
+void BinaryWriter::write(std::uint32_t offset, const BasicExpression& expression)
+{
+    BinaryFormat::BasicExpressionRecord record{};
+    record.prefix = writeIf(offset, expression.prefix);
+    record.primary = writeIf(offset, expression.primary);
+    record.postfix = writeIf(offset, expression.postfix);
+
+    store(offset, record);
+}
+
+std::uint32_t BinaryWriter::write(const ExpressionList& expressions)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::ExpressionListRecord>();
+
+    store(offset,
+          BinaryFormat::ExpressionListRecord{
+              .terms = writeRefs(offset, expressions.size(), [this, &expressions](std::size_t i) { return write(expressions[i]); }),
+              .openParenthesisLocation = expressions.openParenthesisLocation,
+              .closeParenthesisLocation = expressions.closeParenthesisLocation});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const ExpressionTerm& term)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::ExpressionTermRecord>();
+
+    store(offset, BinaryFormat::ExpressionTermRecord{.expression = writeIf(offset, term.expression), .modifier = static_cast<std::uint32_t>(term.modifier)});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const PrefixExpression& expression)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::PrefixExpressionRecord>();
+
+    store(offset, BinaryFormat::PrefixExpressionRecord{.ops = writeRefs(offset, expression.ops.size(), [this, &expression](std::size_t i) { return write(expression.ops[i].get()); })});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const PrimaryExpression& expression)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::PrimaryExpressionRecord>();
+
+    store(offset, BinaryFormat::PrimaryExpressionRecord{.type = writeVariant(offset, expression.type)});
+
+    return offset;
+}
+
+std::uint32_t BinaryWriter::write(const PostfixExpression& expression)
+{
+    const std::uint32_t offset = reserve<BinaryFormat::PostfixExpressionRecord>();
+    const std::uint32_t termsOffset = reserve<BinaryFormat::PostfixTermRecord>(expression.terms.size());
+
+    for (std::size_t i = 0; i < expression.terms.size(); ++i)
+    {
+        write(termsOffset + static_cast<std::uint32_t>(i * sizeof(BinaryFormat::PostfixTermRecord)), expression.terms[i]);
+    }
+
+    store(offset, BinaryFormat::PostfixExpressionRecord{.terms = {.count = static_cast<std::uint32_t>(expression.terms.size()), .data = makeRef(offset, termsOffset)}});
+
+    return offset;
+}
+
+void BinaryWriter::write(std::uint32_t offset, const PostfixExpression::Term& term)
+{
+    BinaryFormat::PostfixTermRecord record{};
+    record.op = makeRef(offset, write(term.op.get()));
+    record.identifierExpression = writeIf(offset, term.identifierExpression);
+
+    if (term.arguments)
+    {
+        record.arguments = makeRef(offset, write(term.arguments->expressions));
+        record.closeOp = makeRef(offset, write(term.arguments->closeOp.get()));
+    }
+
+    store(offset, record);
+}
+
+template<BinaryFormat::Record RecordT>
+std::uint32_t BinaryWriter::reserve(std::size_t count)
+{
+    static_assert(sizeof(RecordT) % BinaryFormat::Alignment == 0);
+
+    const std::size_t offset = _buffer.size();
+
+    assert(offset % BinaryFormat::Alignment == 0);
+    assert(offset + count * sizeof(RecordT) <= std::numeric_limits<std::int32_t>::max());
+
+    _buffer.resize(offset + count * sizeof(RecordT));
+
+    return static_cast<std::uint32_t>(offset);
+}
+
+template<BinaryFormat::Record RecordT>
+void BinaryWriter::store(std::uint32_t offset, const RecordT& record)
+{
+    assert(offset + sizeof(RecordT) <= _buffer.size());
+
+    std::memcpy(_buffer.data() + offset, &record, sizeof(RecordT));
+}
+
+BinaryFormat::Ref BinaryWriter::makeRef(std::uint32_t from, std::uint32_t to)
+{
+    return {.offset = static_cast<std::int32_t>(to) - static_cast<std::int32_t>(from)};
+}
+
+template<typename T>
+BinaryFormat::Ref BinaryWriter::writeIf(std::uint32_t from, const Node<T>& node)
+{
+    return node ? makeRef(from, write(*node)) : BinaryFormat::Ref{};
+}
+
+template<typename... TypesT>
+BinaryFormat::VariantRef BinaryWriter::writeVariant(std::uint32_t from, const NodeVariant<TypesT...>& variant)
+{
+    BinaryFormat::VariantRef ref{.index = static_cast<std::uint32_t>(variant.index()), .node = {}};
+
+    variant.visit([this, from, &ref](const auto& node) { ref.node = makeRef(from, write(node)); });
+
+    return ref;
+}
+
+template<typename WriteItemT>
+BinaryFormat::ArrayRef BinaryWriter::writeRefs(std::uint32_t from, std::size_t count, WriteItemT writeItem)
+{
+    const std::uint32_t arrayOffset = reserve<BinaryFormat::Ref>(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t itemOffset = writeItem(i);
+
+        store(arrayOffset + static_cast<std::uint32_t>(i * sizeof(BinaryFormat::Ref)), makeRef(arrayOffset, itemOffset));
+    }
+
+    return {.count = static_cast<std::uint32_t>(count), .data = makeRef(from, arrayOffset)};
+}
+
+BinaryFormat::ArrayRef BinaryWriter::writeText(std::uint32_t from, std::string_view text)
+{
+    auto it = _textOffsets.find(text);
+
+    if (it == _textOffsets.end())
+    {
+        // the chars are padded to keep the records aligned
+        const std::size_t offset = _buffer.size();
+
+        _buffer.resize(offset + (text.size() + BinaryFormat::Alignment - 1) / BinaryFormat::Alignment * BinaryFormat::Alignment);
+
+        if (!text.empty())
+        {
+            std::memcpy(_buffer.data() + offset, text.data(), text.size());
+        }
+
+        it = _textOffsets.emplace(text, static_cast<std::uint32_t>(offset)).first;
+    }
+
+    return {.count = static_cast<std::uint32_t>(text.size()), .data = makeRef(from, it->second)};
+}
+
+} // namespace CPPS::CST
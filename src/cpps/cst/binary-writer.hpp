@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "cpps/cst.hpp"
+#include "cpps/cst/binary-format.hpp"
+
+namespace CPPS::CST {
+
+/**
+ * Serializes a translation unit in the format of binary-format.hpp, to be cached or shared with another process and read
+ * in place by BinaryReader.
+ *
+ * The records are written in pre-order, a node before its children, so a walk of the reader mostly moves forward.
+ * The writer recurses on the nesting of the nodes, which the parser bounds by Parser::MaxNestingDepth.
+ */
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(const TranslationUnit& translationUnit);
+
+    [[nodiscard]] std::vector<std::byte> write();
+
+private:
+    // each write returns the offset of the record in the buffer
+    std::uint32_t write(const Token& token);
+
+    std::uint32_t write(const Declaration& declaration);
+    std::uint32_t write(const FunctionSignature& signature);
+    std::uint32_t write(const ParameterDeclarationList& parameters);
+    std::uint32_t write(const ParameterDeclaration& parameter);
+
+    std::uint32_t write(const IdentifierExpression& expression);
+    std::uint32_t write(const QualifiedIdentifier& identifier);
+    std::uint32_t write(const UnqualifiedIdentifier& identifier);
+
+    std::uint32_t write(const Statement& statement);
+    std::uint32_t write(const CompoundStatement& statement);
+    std::uint32_t write(const ExpressionStatement& statement);
+    std::uint32_t write(const IterationStatement& statement);
+    std::uint32_t write(const ReturnStatement& statement);
+    std::uint32_t write(const SelectionStatement& statement);
+
+    std::uint32_t write(const Expression& expression);
+    std::uint32_t write(const ExpressionList& expressions);
+    std::uint32_t write(const ExpressionTerm& term);
+
+    std::uint32_t write(const PrefixExpression& expression);
+    std::uint32_t write(const PrimaryExpression& expression);
+    std::uint32_t write(const PostfixExpression& expression);
+
+    void write(std::uint32_t offset, const BasicExpression& expression);
+    void write(std::uint32_t offset, const PostfixExpression::Term& term);
+    void write(std::uint32_t offset, const QualifiedIdentifier::Term& term);
+
+private:
+    // appends a zeroed record, aligned
+    template<BinaryFormat::Record RecordT>
+    std::uint32_t reserve(std::size_t count = 1);
+
+    template<BinaryFormat::Record RecordT>
+    void store(std::uint32_t offset, const RecordT& record);
+
+    static BinaryFormat::Ref makeRef(std::uint32_t from, std::uint32_t to);
+
+    template<typename T>
+    BinaryFormat::Ref writeIf(std::uint32_t from, const Node<T>& node);
+
+    template<typename... TypesT>
+    BinaryFormat::VariantRef writeVariant(std::uint32_t from, const NodeVariant<TypesT...>& variant);
+
+    // an array of Refs to the records written by writeItem for each index
+    template<typename WriteItemT>
+    BinaryFormat::ArrayRef writeRefs(std::uint32_t from, std::size_t count, WriteItemT writeItem);
+
+    BinaryFormat::ArrayRef writeText(std::uint32_t from, std::string_view text);
+
+private:
+    const TranslationUnit& _translationUnit;
+
+    std::vector<std::byte> _buffer;
+
+    std::unordered_map<const Token*, std::uint32_t> _tokenOffsets;
+    std::unordered_map<std::string_view, std::uint32_t> _textOffsets;
+};
+
+} // namespace CPPS::CST
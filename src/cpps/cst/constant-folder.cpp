@@ -0,0 +1,1017 @@
+#include "cpps/cst/constant-folder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "cpps/cst/walker.hpp"
+#include "cpps/token.hpp"
+#include "cpps/utility/trace.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+// the integer types of the literals, and of the operations by the usual arithmetic conversions, as the host C++
+enum class IntegerType : std::uint8_t
+{
+    Int,
+    UnsignedInt,
+    Long,
+    UnsignedLong,
+    LongLong,
+    UnsignedLongLong
+};
+
+// the bits of the value in the width of its type, two's complement if the type is signed
+struct Integer
+{
+    IntegerType type{IntegerType::Int};
+    std::uint64_t bits{0};
+};
+
+using Constant = std::variant<bool, Integer, double>;
+
+static_assert(std::numeric_limits<unsigned long long>::digits <= std::numeric_limits<std::uint64_t>::digits);
+
+// the folded tokens are never destroyed
+static_assert(std::is_trivially_destructible_v<Token>);
+
+constexpr bool isSigned(IntegerType type)
+{
+    return type == IntegerType::Int || type == IntegerType::Long || type == IntegerType::LongLong;
+}
+
+constexpr int getRank(IntegerType type)
+{
+    switch (type)
+    {
+    case IntegerType::Int:
+    case IntegerType::UnsignedInt: return 0;
+    case IntegerType::Long:
+    case IntegerType::UnsignedLong: return 1;
+    default: return 2;
+    }
+}
+
+constexpr int getWidth(IntegerType type)
+{
+    switch (type)
+    {
+    case IntegerType::Int:
+    case IntegerType::UnsignedInt: return std::numeric_limits<unsigned int>::digits;
+    case IntegerType::Long:
+    case IntegerType::UnsignedLong: return std::numeric_limits<unsigned long>::digits;
+    default: return std::numeric_limits<unsigned long long>::digits;
+    }
+}
+
+constexpr IntegerType makeUnsigned(IntegerType type)
+{
+    switch (type)
+    {
+    case IntegerType::Int: return IntegerType::UnsignedInt;
+    case IntegerType::Long: return IntegerType::UnsignedLong;
+    case IntegerType::LongLong: return IntegerType::UnsignedLongLong;
+    default: return type;
+    }
+}
+
+constexpr std::string_view getSuffix(IntegerType type)
+{
+    switch (type)
+    {
+    case IntegerType::Int: return "";
+    case IntegerType::UnsignedInt: return "U";
+    case IntegerType::Long: return "L";
+    case IntegerType::UnsignedLong: return "UL";
+    case IntegerType::LongLong: return "LL";
+    default: return "ULL";
+    }
+}
+
+constexpr std::uint64_t getMask(IntegerType type)
+{
+    return getWidth(type) == std::numeric_limits<std::uint64_t>::digits ? std::numeric_limits<std::uint64_t>::max() : (std::uint64_t{1} << getWidth(type)) - 1;
+}
+
+constexpr std::int64_t getMax(IntegerType type)
+{
+    return static_cast<std::int64_t>(getMask(type) >> 1);
+}
+
+constexpr std::int64_t getMin(IntegerType type)
+{
+    return -getMax(type) - 1;
+}
+
+// the value of a signed integer
+std::int64_t toSigned(const Integer& integer)
+{
+    const std::uint64_t signBit = std::uint64_t{1} << (getWidth(integer.type) - 1);
+
+    // sign-extended to 64 bits
+    return static_cast<std::int64_t>(((integer.bits & getMask(integer.type)) ^ signBit) - signBit);
+}
+
+// modulo 2^width, as the integral conversions
+Integer makeInteger(IntegerType type, std::uint64_t bits)
+{
+    return {.type = type, .bits = bits & getMask(type)};
+}
+
+Integer makeInteger(IntegerType type, std::int64_t value)
+{
+    return makeInteger(type, static_cast<std::uint64_t>(value));
+}
+
+Integer convert(const Integer& integer, IntegerType type)
+{
+    return isSigned(integer.type) ? makeInteger(type, toSigned(integer)) : makeInteger(type, integer.bits);
+}
+
+// the usual arithmetic conversions of two promoted integers
+IntegerType getCommonType(IntegerType lhs, IntegerType rhs)
+{
+    if (lhs == rhs)
+    {
+        return lhs;
+    }
+
+    if (isSigned(lhs) == isSigned(rhs))
+    {
+        return getRank(lhs) > getRank(rhs) ? lhs : rhs;
+    }
+
+    const IntegerType signedType = isSigned(lhs) ? lhs : rhs;
+    const IntegerType unsignedType = isSigned(lhs) ? rhs : lhs;
+
+    if (getRank(unsignedType) >= getRank(signedType))
+    {
+        return unsignedType;
+    }
+
+    if (getWidth(signedType) > getWidth(unsignedType))
+    {
+        return signedType;
+    }
+
+    return makeUnsigned(signedType);
+}
+
+bool isFloating(const Constant& value)
+{
+    return std::holds_alternative<double>(value);
+}
+
+// the booleans are promoted to int, nullopt for a floating
+std::optional<Integer> toInteger(const Constant& value)
+{
+    if (const bool* boolean = std::get_if<bool>(&value))
+    {
+        return Integer{.type = IntegerType::Int, .bits = *boolean ? 1U : 0U};
+    }
+
+    if (const Integer* integer = std::get_if<Integer>(&value))
+    {
+        return *integer;
+    }
+
+    return std::nullopt;
+}
+
+double toFloating(const Constant& value)
+{
+    if (const double* floating = std::get_if<double>(&value))
+    {
+        return *floating;
+    }
+
+    const Integer integer = *toInteger(value);
+
+    return isSigned(integer.type) ? static_cast<double>(toSigned(integer)) : static_cast<double>(integer.bits);
+}
+
+bool toBoolean(const Constant& value)
+{
+    if (const double* floating = std::get_if<double>(&value))
+    {
+        return *floating != 0.0;
+    }
+
+    return toInteger(value)->bits != 0;
+}
+
+// the first type of the literal which represents its magnitude, as [lex.icon], nullopt if none does
+std::optional<IntegerType> getLiteralType(std::uint64_t magnitude, bool isDecimal, bool isUnsigned, std::size_t longsCount)
+{
+    using enum IntegerType;
+
+    static constexpr std::array DecimalTypes{Int, Long, LongLong};
+    static constexpr std::array NonDecimalTypes{Int, UnsignedInt, Long, UnsignedLong, LongLong, UnsignedLongLong};
+
+    // a decimal literal is unsigned only by its suffix
+    const std::span<const IntegerType> types = isDecimal && !isUnsigned ? std::span<const IntegerType>{DecimalTypes} : std::span<const IntegerType>{NonDecimalTypes};
+
+    for (const IntegerType type : types)
+    {
+        if (getRank(type) < static_cast<int>(longsCount) || (isUnsigned && isSigned(type)))
+        {
+            continue;
+        }
+
+        if (magnitude <= (isSigned(type) ? static_cast<std::uint64_t>(getMax(type)) : getMask(type)))
+        {
+            return type;
+        }
+    }
+
+    return std::nullopt;
+}
+
+// the digits without the separators, then the integer-suffix
+// a negative folded literal has its sign in its text, the magnitude of its value is in its type
+std::optional<Integer> parseInteger(std::string_view text, std::size_t prefixSize, std::uint64_t base)
+{
+    const bool isNegative = !text.empty() && text.front() == '-';
+
+    if (isNegative)
+    {
+        text.remove_prefix(1);
+    }
+
+    text.remove_prefix(prefixSize);
+
+    const std::size_t suffixIndex = text.find_first_of("uUlL");
+    const std::string_view suffix = suffixIndex != std::string_view::npos ? text.substr(suffixIndex) : std::string_view{};
+
+    text = text.substr(0, suffixIndex);
+
+    std::uint64_t magnitude{0};
+
+    for (char c : text)
+    {
+        if (c == '\'')
+        {
+            continue;
+        }
+
+        std::uint64_t digit{0};
+
+        if (c >= '0' && c <= '9')
+        {
+            digit = static_cast<std::uint64_t>(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            digit = static_cast<std::uint64_t>(c - 'a' + 10);
+        }
+        else
+        {
+            digit = static_cast<std::uint64_t>(c - 'A' + 10);
+        }
+
+        if (magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / base)
+        {
+            return std::nullopt;
+        }
+
+        magnitude = magnitude * base + digit;
+    }
+
+    const bool isUnsigned = suffix.find_first_of("uU") != std::string_view::npos;
+    const std::size_t longsCount = static_cast<std::size_t>(std::ranges::count_if(suffix, [](char c) { return c == 'l' || c == 'L'; }));
+
+    const std::optional<IntegerType> type = getLiteralType(magnitude, base == 10, isUnsigned, longsCount);
+
+    if (!type)
+    {
+        return std::nullopt;
+    }
+
+    return makeInteger(*type, isNegative ? std::uint64_t{0} - magnitude : magnitude);
+}
+
+std::optional<double> parseFloating(std::string_view text)
+{
+    std::string digits;
+    std::ranges::copy_if(text, std::back_inserter(digits), [](char c) { return c != '\''; });
+
+    double value{0.0};
+
+    const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+
+    if (error != std::errc{} || end != digits.data() + digits.size())
+    {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+// a literal of the same type reads the value back, the minimum of a signed type has no literal
+bool isWritable(const Constant& value)
+{
+    const Integer* integer = std::get_if<Integer>(&value);
+
+    return integer == nullptr || !isSigned(integer->type) || toSigned(*integer) != getMin(integer->type);
+}
+
+std::string format(const Constant& value)
+{
+    if (const bool* boolean = std::get_if<bool>(&value))
+    {
+        return std::string(toStringView(*boolean ? BooleanLiteral::True : BooleanLiteral::False));
+    }
+
+    if (const Integer* integer = std::get_if<Integer>(&value))
+    {
+        if (isSigned(integer->type))
+        {
+            return fmt::format("{}{}", toSigned(*integer), getSuffix(integer->type));
+        }
+
+        return fmt::format("{}{}", integer->bits, getSuffix(integer->type));
+    }
+
+    // the shortest text read back as the same value, still a floating if it is integral
+    std::string text = fmt::format("{}", std::get<double>(value));
+
+    if (text.find_first_of(".e") == std::string::npos)
+    {
+        text += ".0";
+    }
+
+    return text;
+}
+
+Lexeme getLexeme(const Constant& value)
+{
+    if (const bool* boolean = std::get_if<bool>(&value))
+    {
+        return Lexeme{*boolean ? BooleanLiteral::True : BooleanLiteral::False};
+    }
+
+    if (isFloating(value))
+    {
+        return Lexeme{FloatingLiteral{}};
+    }
+
+    return Lexeme{DecimalLiteral{}};
+}
+
+constexpr std::int64_t MaxInteger{std::numeric_limits<std::int64_t>::max()};
+constexpr std::int64_t MinInteger{std::numeric_limits<std::int64_t>::min()};
+
+std::optional<std::int64_t> add(std::int64_t lhs, std::int64_t rhs)
+{
+    if ((rhs > 0 && lhs > MaxInteger - rhs) || (rhs < 0 && lhs < MinInteger - rhs))
+    {
+        return std::nullopt;
+    }
+
+    return lhs + rhs;
+}
+
+std::optional<std::int64_t> subtract(std::int64_t lhs, std::int64_t rhs)
+{
+    if ((rhs < 0 && lhs > MaxInteger + rhs) || (rhs > 0 && lhs < MinInteger + rhs))
+    {
+        return std::nullopt;
+    }
+
+    return lhs - rhs;
+}
+
+std::optional<std::int64_t> multiply(std::int64_t lhs, std::int64_t rhs)
+{
+    if (lhs == 0 || rhs == 0)
+    {
+        return 0;
+    }
+
+    // clang-format off
+    const bool overflows = lhs > 0 ? (rhs > 0 ? lhs > MaxInteger / rhs : rhs < MinInteger / lhs)
+                                   : (rhs > 0 ? lhs < MinInteger / rhs : rhs < MaxInteger / lhs);
+    // clang-format on
+
+    if (overflows)
+    {
+        return std::nullopt;
+    }
+
+    return lhs * rhs;
+}
+
+bool isIntegerLiteral(const Token& token)
+{
+    return token.lexeme.is<DecimalLiteral>() || token.lexeme.is<HexadecimalLiteral>() || token.lexeme.is<BinaryLiteral>();
+}
+
+// nullopt if token is not a number or boolean literal, or an integer too large for all the integer types
+std::optional<Constant> parseLiteral(const Token& token)
+{
+    std::optional<Integer> integer;
+
+    if (token.lexeme.is<BooleanLiteral>())
+    {
+        return token.lexeme.get<BooleanLiteral>() == BooleanLiteral::True;
+    }
+
+    if (token.lexeme.is<FloatingLiteral>())
+    {
+        return parseFloating(token.text);
+    }
+
+    if (token.lexeme.is<DecimalLiteral>())
+    {
+        integer = parseInteger(token.text, 0, 10);
+    }
+    else if (token.lexeme.is<HexadecimalLiteral>())
+    {
+        integer = parseInteger(token.text, 2, 16);
+    }
+    else if (token.lexeme.is<BinaryLiteral>())
+    {
+        integer = parseInteger(token.text, 2, 2);
+    }
+
+    if (!integer)
+    {
+        return std::nullopt;
+    }
+
+    return *integer;
+}
+
+// the token of the primary-expression, nullptr if it is not a token
+const Token* getLiteral(const BasicExpression& basic)
+{
+    return basic.primary->type.is<Token>() ? &basic.primary->type.as<Token>() : nullptr;
+}
+
+/**
+ * Folds the expressions, the nested ones first: a constant nested expression is already a single literal when the
+ * expression containing it is folded.
+ *
+ * The operations of an expression are in post-order: a single pass evaluates them, a reverse pass finds the ones
+ * under a folded operation, a last pass copies the others and replaces the folded ones by a literal.
+ */
+class ExpressionFolder : public Walker<ExpressionFolder>
+{
+public:
+    ExpressionFolder(Diagnosis& diagnosis, TranslationUnit::Allocator& allocator, ConstantFolder::Stats& stats);
+
+private:
+    friend class Walker<ExpressionFolder>;
+
+    void post(Expression& expression);
+
+    std::optional<Constant> evaluate(const BasicExpression& basic);
+    std::optional<Constant> evaluate(const Token& literal);
+    std::optional<Constant> evaluate(const Token& op, const Constant& operand);
+    std::optional<Constant> evaluate(const Expression::Operation& operation, const Constant& lhs, const Constant& rhs);
+
+    std::optional<Constant> evaluateArithmetic(const Token& op, const Constant& lhs, const Constant& rhs);
+    std::optional<Constant> evaluateShift(const Token& op, const Constant& lhs, const Constant& rhs);
+    std::optional<Constant> evaluateComparison(Punctuator punctuator, const Constant& lhs, const Constant& rhs);
+    std::optional<Constant> evaluateBitwise(Punctuator punctuator, const Constant& lhs, const Constant& rhs);
+
+    // the basic-expression which primary is a literal token of value
+    BasicExpression makeLiteral(const Constant& value, SourceLocation location);
+
+private:
+    Diagnosis& _diagnosis;
+    TranslationUnit::Allocator& _allocator;
+    ConstantFolder::Stats& _stats;
+};
+
+ExpressionFolder::ExpressionFolder(Diagnosis& diagnosis, TranslationUnit::Allocator& allocator, ConstantFolder::Stats& stats)
+    : _diagnosis(diagnosis)
+    , _allocator(allocator)
+    , _stats(stats)
+{
+}
+
+void ExpressionFolder::post(Expression& expression)
+{
+    const std::size_t operationsCount = expression.operations.size();
+
+    std::vector<std::optional<Constant>> values(operationsCount);
+
+    // the leftmost basic-expression of each operation, for the location of a literal replacing it
+    std::vector<std::uint32_t> firstBasics(operationsCount);
+
+    for (std::size_t i = 0; i < operationsCount; ++i)
+    {
+        const Expression::Operation& operation = expression.operations[i];
+
+        if (operation.kind == Expression::Kind::Basic)
+        {
+            values[i] = evaluate(expression.getBasic(operation));
+            firstBasics[i] = operation.lhs;
+
+            if (values[i] && !isWritable(*values[i]))
+            {
+                values[i].reset();
+            }
+        }
+        else
+        {
+            const std::optional<Constant>& lhs = values[operation.lhs];
+            const std::optional<Constant>& rhs = values[operation.rhs];
+
+            if (lhs && rhs)
+            {
+                values[i] = evaluate(operation, *lhs, *rhs);
+            }
+
+            // left to the compiler, as the literal for its text would have another type
+            if (values[i] && !isWritable(*values[i]))
+            {
+                values[i].reset();
+            }
+
+            firstBasics[i] = firstBasics[operation.lhs];
+        }
+    }
+
+    // a literal token without prefix is already folded
+    auto isReplaced = [&expression, &values](std::size_t i) {
+        const Expression::Operation& operation = expression.operations[i];
+
+        if (!values[i])
+        {
+            return false;
+        }
+
+        if (operation.kind != Expression::Kind::Basic)
+        {
+            return true;
+        }
+
+        const BasicExpression& basic = expression.getBasic(operation);
+
+        return !basic.prefix->ops.empty() || !basic.primary->type.is<Token>();
+    };
+
+    // the operations under a constant one are dropped with it
+    std::vector<bool> isDropped(operationsCount, false);
+    bool hasReplacement = false;
+
+    for (std::size_t i = operationsCount; i-- > 0;)
+    {
+        const Expression::Operation& operation = expression.operations[i];
+
+        if (!isDropped[i] && isReplaced(i))
+        {
+            hasReplacement = true;
+        }
+
+        if (operation.kind != Expression::Kind::Basic && (isDropped[i] || values[i]))
+        {
+            isDropped[operation.lhs] = true;
+            isDropped[operation.rhs] = true;
+        }
+    }
+
+    if (!hasReplacement)
+    {
+        return;
+    }
+
+    NodeArray<Expression::Operation> operations;
+    NodeArray<BasicExpression> basics;
+
+    std::vector<std::uint32_t> newIndexes(operationsCount);
+
+    for (std::size_t i = 0; i < operationsCount; ++i)
+    {
+        if (isDropped[i])
+        {
+            continue;
+        }
+
+        const Expression::Operation& operation = expression.operations[i];
+
+        newIndexes[i] = static_cast<std::uint32_t>(operations.size());
+
+        if (isReplaced(i))
+        {
+            const SourceLocation location = expression.basics[firstBasics[i]].getLocation();
+
+            operations.emplaceBack(_allocator, Expression::Operation{.kind = Expression::Kind::Basic, .lhs = static_cast<std::uint32_t>(basics.size())});
+            basics.emplaceBack(_allocator, makeLiteral(*values[i], location));
+
+            ++_stats.foldedCount;
+        }
+        else if (operation.kind == Expression::Kind::Basic)
+        {
+            operations.emplaceBack(_allocator, Expression::Operation{.kind = Expression::Kind::Basic, .lhs = static_cast<std::uint32_t>(basics.size())});
+            basics.emplaceBack(_allocator, std::move(expression.getBasic(operation)));
+        }
+        else
+        {
+            operations.emplaceBack(
+                _allocator,
+                Expression::Operation{.kind = operation.kind, .lhs = newIndexes[operation.lhs], .rhs = newIndexes[operation.rhs], .op = operation.op});
+        }
+    }
+
+    _stats.removedOperationsCount += operationsCount - operations.size();
+
+    expression.operations = std::move(operations);
+    expression.basics = std::move(basics);
+}
+
+std::optional<Constant> ExpressionFolder::evaluate(const BasicExpression& basic)
+{
+    if (basic.postfix && !basic.postfix->terms.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Constant> value;
+
+    if (const Token* literal = getLiteral(basic))
+    {
+        value = evaluate(*literal);
+    }
+    else if (basic.primary->type.is<ExpressionList>())
+    {
+        // a parenthesized constant, already folded
+        const ExpressionList& expressions = basic.primary->type.as<ExpressionList>();
+
+        if (expressions.size() == 1 && expressions[0].modifier == ParameterModifier::In && expressions[0].expression && expressions[0].expression->isBasic())
+        {
+            const Expression& nested = *expressions[0].expression;
+
+            const BasicExpression& nestedBasic = nested.getBasic(nested.getRoot());
+            const Token* nestedLiteral = getLiteral(nestedBasic);
+
+            if (nestedLiteral != nullptr && nestedBasic.prefix->ops.empty() && nestedBasic.postfix->terms.empty())
+            {
+                value = parseLiteral(*nestedLiteral);
+            }
+        }
+    }
+
+    const std::vector<TokenRef>& ops = basic.prefix->ops;
+
+    // the closest operator first
+    for (auto it = ops.rbegin(); it != ops.rend() && value; ++it)
+    {
+        value = evaluate(*it, *value);
+    }
+
+    return value;
+}
+
+std::optional<Constant> ExpressionFolder::evaluate(const Token& literal)
+{
+    std::optional<Constant> value = parseLiteral(literal);
+
+    if (!value && isIntegerLiteral(literal))
+    {
+        _diagnosis.warning(ConstantFolder::DiagnosisMessage::integerLiteralTooLarge(literal.text), literal.location);
+    }
+
+    return value;
+}
+
+std::optional<Constant> ExpressionFolder::evaluate(const Token& op, const Constant& operand)
+{
+    if (op.lexeme == Punctuator::Not)
+    {
+        return !toBoolean(operand);
+    }
+
+    if (isFloating(operand))
+    {
+        const double value = std::get<double>(operand);
+        return op.lexeme == Punctuator::Minus ? -value : value;
+    }
+
+    const Integer value = *toInteger(operand);
+
+    if (op.lexeme == Punctuator::Plus)
+    {
+        return value;
+    }
+
+    if (!isSigned(value.type))
+    {
+        return makeInteger(value.type, std::uint64_t{0} - value.bits);
+    }
+
+    if (toSigned(value) == getMin(value.type))
+    {
+        _diagnosis.warning(ConstantFolder::DiagnosisMessage::integerOverflow(op.text), op.location);
+        return std::nullopt;
+    }
+
+    return makeInteger(value.type, -toSigned(value));
+}
+
+std::optional<Constant> ExpressionFolder::evaluate(const Expression::Operation& operation, const Constant& lhs, const Constant& rhs)
+{
+    const Token& op = operation.op->get();
+
+    if (!op.lexeme.is<Punctuator>())
+    {
+        // is, as
+        return std::nullopt;
+    }
+
+    const Punctuator punctuator = op.lexeme.get<Punctuator>();
+
+    switch (operation.kind)
+    {
+    case Expression::Kind::Multiplicative:
+    case Expression::Kind::Additive:
+        return evaluateArithmetic(op, lhs, rhs);
+
+    case Expression::Kind::Shift:
+        return evaluateShift(op, lhs, rhs);
+
+    case Expression::Kind::Relational:
+    case Expression::Kind::Equality:
+        return evaluateComparison(punctuator, lhs, rhs);
+
+    case Expression::Kind::BitAnd:
+    case Expression::Kind::BitXor:
+    case Expression::Kind::BitOr:
+        return evaluateBitwise(punctuator, lhs, rhs);
+
+    case Expression::Kind::LogicalAnd:
+        return toBoolean(lhs) && toBoolean(rhs);
+
+    case Expression::Kind::LogicalOr:
+        return toBoolean(lhs) || toBoolean(rhs);
+
+    default:
+        // <=>, the assignments
+        return std::nullopt;
+    }
+}
+
+std::optional<Constant> ExpressionFolder::evaluateArithmetic(const Token& op, const Constant& lhs, const Constant& rhs)
+{
+    const Punctuator punctuator = op.lexeme.get<Punctuator>();
+
+    if (isFloating(lhs) || isFloating(rhs))
+    {
+        const double lhsValue = toFloating(lhs);
+        const double rhsValue = toFloating(rhs);
+
+        double value{0.0};
+
+        switch (punctuator)
+        {
+        case Punctuator::Plus: value = lhsValue + rhsValue; break;
+        case Punctuator::Minus: value = lhsValue - rhsValue; break;
+        case Punctuator::Multiply: value = lhsValue * rhsValue; break;
+        case Punctuator::Slash:
+            if (rhsValue == 0.0)
+            {
+                _diagnosis.warning(ConstantFolder::DiagnosisMessage::divisionByZero(), op.location);
+                return std::nullopt;
+            }
+
+            value = lhsValue / rhsValue;
+            break;
+
+        default:
+            // % is ill-formed, left to the compiler
+            return std::nullopt;
+        }
+
+        if (!std::isfinite(value))
+        {
+            _diagnosis.warning(ConstantFolder::DiagnosisMessage::floatingOverflow(op.text), op.location);
+            return std::nullopt;
+        }
+
+        return value;
+    }
+
+    const IntegerType type = getCommonType(toInteger(lhs)->type, toInteger(rhs)->type);
+
+    const Integer lhsInteger = convert(*toInteger(lhs), type);
+    const Integer rhsInteger = convert(*toInteger(rhs), type);
+
+    if ((punctuator == Punctuator::Slash || punctuator == Punctuator::Modulo) && rhsInteger.bits == 0)
+    {
+        _diagnosis.warning(ConstantFolder::DiagnosisMessage::divisionByZero(), op.location);
+        return std::nullopt;
+    }
+
+    // the unsigned arithmetic is modulo 2^width
+    if (!isSigned(type))
+    {
+        switch (punctuator)
+        {
+        case Punctuator::Plus: return makeInteger(type, lhsInteger.bits + rhsInteger.bits);
+        case Punctuator::Minus: return makeInteger(type, lhsInteger.bits - rhsInteger.bits);
+        case Punctuator::Multiply: return makeInteger(type, lhsInteger.bits * rhsInteger.bits);
+        case Punctuator::Slash: return makeInteger(type, lhsInteger.bits / rhsInteger.bits);
+        default: return makeInteger(type, lhsInteger.bits % rhsInteger.bits);
+        }
+    }
+
+    const std::int64_t lhsValue = toSigned(lhsInteger);
+    const std::int64_t rhsValue = toSigned(rhsInteger);
+
+    std::optional<std::int64_t> value;
+
+    switch (punctuator)
+    {
+    case Punctuator::Plus: value = add(lhsValue, rhsValue); break;
+    case Punctuator::Minus: value = subtract(lhsValue, rhsValue); break;
+    case Punctuator::Multiply: value = multiply(lhsValue, rhsValue); break;
+    default:
+        if (lhsValue != getMin(type) || rhsValue != -1)
+        {
+            value = punctuator == Punctuator::Slash ? lhsValue / rhsValue : lhsValue % rhsValue;
+        }
+        break;
+    }
+
+    // the signed overflow is undefined, in the width of the type
+    if (!value || *value < getMin(type) || *value > getMax(type))
+    {
+        _diagnosis.warning(ConstantFolder::DiagnosisMessage::integerOverflow(op.text), op.location);
+        return std::nullopt;
+    }
+
+    return makeInteger(type, *value);
+}
+
+std::optional<Constant> ExpressionFolder::evaluateShift(const Token& op, const Constant& lhs, const Constant& rhs)
+{
+    if (isFloating(lhs) || isFloating(rhs))
+    {
+        return std::nullopt;
+    }
+
+    // the type of the promoted left operand, the count is not converted to it
+    const Integer value = *toInteger(lhs);
+    const Integer count = *toInteger(rhs);
+
+    const int width = getWidth(value.type);
+
+    const bool isNegative = isSigned(count.type) && toSigned(count) < 0;
+
+    if (isNegative || count.bits >= static_cast<std::uint64_t>(width))
+    {
+        _diagnosis.warning(ConstantFolder::DiagnosisMessage::shiftCountOutOfRange(width), op.location);
+        return std::nullopt;
+    }
+
+    // as C++20, the left shift is modulo 2^width and the right shift of a signed value is arithmetic
+    if (op.lexeme == Punctuator::LeftShift)
+    {
+        return makeInteger(value.type, value.bits << count.bits);
+    }
+
+    if (isSigned(value.type))
+    {
+        return makeInteger(value.type, toSigned(value) >> count.bits);
+    }
+
+    return makeInteger(value.type, value.bits >> count.bits);
+}
+
+std::optional<Constant> ExpressionFolder::evaluateComparison(Punctuator punctuator, const Constant& lhs, const Constant& rhs)
+{
+    auto compare = [punctuator](auto lhsValue, auto rhsValue) -> std::optional<Constant> {
+        switch (punctuator)
+        {
+        case Punctuator::Less: return lhsValue < rhsValue;
+        case Punctuator::LessEqual: return lhsValue <= rhsValue;
+        case Punctuator::Greater: return lhsValue > rhsValue;
+        case Punctuator::GreaterEqual: return lhsValue >= rhsValue;
+        case Punctuator::CompareEqual: return lhsValue == rhsValue;
+        case Punctuator::CompareNotEqual: return lhsValue != rhsValue;
+        default: return std::nullopt;
+        }
+    };
+
+    if (isFloating(lhs) || isFloating(rhs))
+    {
+        return compare(toFloating(lhs), toFloating(rhs));
+    }
+
+    const IntegerType type = getCommonType(toInteger(lhs)->type, toInteger(rhs)->type);
+
+    const Integer lhsInteger = convert(*toInteger(lhs), type);
+    const Integer rhsInteger = convert(*toInteger(rhs), type);
+
+    if (isSigned(type))
+    {
+        return compare(toSigned(lhsInteger), toSigned(rhsInteger));
+    }
+
+    return compare(lhsInteger.bits, rhsInteger.bits);
+}
+
+std::optional<Constant> ExpressionFolder::evaluateBitwise(Punctuator punctuator, const Constant& lhs, const Constant& rhs)
+{
+    if (isFloating(lhs) || isFloating(rhs))
+    {
+        return std::nullopt;
+    }
+
+    const IntegerType type = getCommonType(toInteger(lhs)->type, toInteger(rhs)->type);
+
+    const std::uint64_t lhsBits = convert(*toInteger(lhs), type).bits;
+    const std::uint64_t rhsBits = convert(*toInteger(rhs), type).bits;
+
+    switch (punctuator)
+    {
+    case Punctuator::Ampersand: return makeInteger(type, lhsBits & rhsBits);
+    case Punctuator::Caret: return makeInteger(type, lhsBits ^ rhsBits);
+    default: return makeInteger(type, lhsBits | rhsBits);
+    }
+}
+
+BasicExpression ExpressionFolder::makeLiteral(const Constant& value, SourceLocation location)
+{
+    const std::string text = format(value);
+
+    auto* data = static_cast<char*>(_allocator.allocate(text.size(), alignof(char)));
+    std::ranges::copy(text, data);
+
+    Token* token = _allocator.allocate<Token>();
+    std::construct_at(token, getLexeme(value), location, std::string_view{data, text.size()});
+
+    BasicExpression basic;
+    basic.prefix = Node<PrefixExpression>{_allocator};
+    basic.primary = Node<PrimaryExpression>{_allocator};
+    basic.primary->type = *token;
+    basic.postfix = Node<PostfixExpression>{_allocator};
+
+    return basic;
+}
+
+} // namespace
+
+Diagnosis::Message ConstantFolder::DiagnosisMessage::divisionByZero()
+{
+    return "division by zero in a constant expression";
+}
+
+Diagnosis::Message ConstantFolder::DiagnosisMessage::floatingOverflow(std::string_view op)
+{
+    return {"floating-point overflow in a constant expression at {}", op};
+}
+
+Diagnosis::Message ConstantFolder::DiagnosisMessage::integerLiteralTooLarge(std::string_view text)
+{
+    return {"integer literal {} is too large to be represented in any integer type", text};
+}
+
+Diagnosis::Message ConstantFolder::DiagnosisMessage::integerOverflow(std::string_view op)
+{
+    return {"integer overflow in a constant expression at {}", op};
+}
+
+Diagnosis::Message ConstantFolder::DiagnosisMessage::shiftCountOutOfRange(int width)
+{
+    return {"shift count is negative or not less than {} in a constant expression", width};
+}
+
+ConstantFolder::ConstantFolder(Diagnosis& diagnosis, TranslationUnit& translationUnit)
+    : _diagnosis(diagnosis)
+    , _translationUnit(translationUnit)
+{
+}
+
+void ConstantFolder::fold()
+{
+    CPPS_TRACE_ZONE("ConstantFolder::fold");
+
+    ExpressionFolder{_diagnosis, _translationUnit.allocator, _stats}.walk(_translationUnit);
+}
+
+const ConstantFolder::Stats& ConstantFolder::getStats() const
+{
+    return _stats;
+}
+
+} // namespace CPPS::CST
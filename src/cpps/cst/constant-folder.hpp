@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "cpps/cst.hpp"
+#include "cpps/diagnosis.hpp"
+
+namespace CPPS::CST {
+
+/**
+ * Evaluates the constant subexpressions of a translation unit, and replaces each of them by a single literal.
+ *
+ * The constants are the integer, floating and boolean literals, and the results of the prefix operators ! + - and
+ * of the binary operators except the assignments, is, as and <=>. An integer literal has the type C++ gives it from
+ * its value, base and suffix, int, long or long long and their unsigned counterparts with the widths of the host, and
+ * an operation has the type of the usual arithmetic conversions. A subexpression with a floating operand is floating,
+ * the booleans are promoted to int by the arithmetic and bitwise operators.
+ *
+ * An operation which overflows its signed type, divides by zero or shifts by a negative count or one not less than the
+ * width of its promoted left operand is reported as a warning and kept, as is the whole expression containing it. An
+ * unsigned operation wraps. A result which no literal of its type can be written for, the minimum of a signed type, is
+ * kept without warning.
+ *
+ * A folded subexpression becomes a basic-expression which primary is a token written in the translation unit
+ * allocator, its location is the one of the subexpression. A negative result is written with its sign in the token text,
+ * an integer with the suffix of its type.
+ * These tokens are not in the Tokens, the IncrementalParser cannot reuse a folded translation unit.
+ */
+class ConstantFolder
+{
+public:
+    struct DiagnosisMessage
+    {
+        static Diagnosis::Message divisionByZero();
+        static Diagnosis::Message floatingOverflow(std::string_view op);
+        static Diagnosis::Message integerLiteralTooLarge(std::string_view text);
+        static Diagnosis::Message integerOverflow(std::string_view op);
+        static Diagnosis::Message shiftCountOutOfRange(int width);
+    };
+
+    struct Stats
+    {
+        // the subexpressions replaced by a literal
+        std::size_t foldedCount{0};
+
+        // the operations removed from the expressions by the replacements
+        std::size_t removedOperationsCount{0};
+    };
+
+public:
+    ConstantFolder(Diagnosis& diagnosis, TranslationUnit& translationUnit);
+
+    void fold();
+
+    [[nodiscard]] const Stats& getStats() const;
+
+private:
+    Diagnosis& _diagnosis;
+    TranslationUnit& _translationUnit;
+
+    Stats _stats;
+};
+
+} // namespace CPPS::CST
@@ -1,9 +1,16 @@
 #include "cpps/cst/declaration-list.hpp"
 
+#include <utility>
+
 #include "cpps/cst.hpp"
 
 namespace CPPS::CST {
 
 DeclarationList::~DeclarationList() = default;
 
+void DeclarationList::append(DeclarationList&& other)
+{
+    NodeList<Declaration>::append(std::move(other));
+}
+
 } // namespace CPPS::CST
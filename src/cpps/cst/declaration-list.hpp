@@ -15,6 +15,9 @@ struct DeclarationList : NodeList<Declaration>
     DeclarationList& operator=(DeclarationList&& other) = default;
 
     ~DeclarationList();
+
+    // out of line, Declaration is incomplete here
+    void append(DeclarationList&& other);
 };
 
 } // namespace CPPS::CST
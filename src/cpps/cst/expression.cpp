@@ -1,5 +1,7 @@
 #include "cpps/cst/expression.hpp"
 
+#include <cassert>
+
 #include "cpps/cst.hpp"
 #include "cpps/source-location.hpp"
 
@@ -7,7 +9,42 @@ namespace CPPS::CST {
 
 SourceLocation Expression::getLocation() const
 {
-    return assignment->getLocation();
+    assert(!basics.empty());
+    return basics[0].getLocation();
+}
+
+bool Expression::isBasic() const
+{
+    return operations.size() == 1;
+}
+
+const Expression::Operation& Expression::getRoot() const
+{
+    return operations.back();
+}
+
+const Expression::Operation& Expression::getLhs(const Operation& operation) const
+{
+    assert(operation.kind != Kind::Basic);
+    return operations[operation.lhs];
+}
+
+const Expression::Operation& Expression::getRhs(const Operation& operation) const
+{
+    assert(operation.kind != Kind::Basic);
+    return operations[operation.rhs];
+}
+
+const BasicExpression& Expression::getBasic(const Operation& operation) const
+{
+    assert(operation.kind == Kind::Basic);
+    return basics[operation.lhs];
+}
+
+BasicExpression& Expression::getBasic(const Operation& operation)
+{
+    assert(operation.kind == Kind::Basic);
+    return basics[operation.lhs];
 }
 
 } // namespace CPPS::CST
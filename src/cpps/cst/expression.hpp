@@ -1,6 +1,11 @@
 #pragma once
 
-#include "cpps/cst/node.hpp"
+#include <cstdint>
+#include <optional>
+
+#include "cpps/cst/basic-expression.hpp"
+#include "cpps/cst/node-array.hpp"
+#include "cpps/token-ref.hpp"
 
 namespace CPPS {
 
@@ -8,13 +13,65 @@ struct SourceLocation;
 
 namespace CST {
 
-struct AssignmentExpression;
-
+/**
+ * A binary expression tree stored flat, in two arrays of the translation unit allocator.
+ *
+ * The operations are in post-order, the root is the last one. A Basic operation is a leaf, a basic-expression,
+ * the others apply their operator to two operations stored before them.
+ * The operators of a level are left associative, except the assignments which are right associative.
+ *
+ * The typed view, AssignmentExpression down to BasicExpression, is built on demand by makeTypedExpression().
+ */
 struct Expression
 {
+    // from the highest to the lowest precedence, each level is a typed expression of binary-expression.hpp
+    enum class Kind : std::uint8_t
+    {
+        Basic,
+        IsAs,
+        Multiplicative,
+        Additive,
+        Shift,
+        Compare,
+        Relational,
+        Equality,
+        BitAnd,
+        BitXor,
+        BitOr,
+        LogicalAnd,
+        LogicalOr,
+        Assignment
+    };
+
+    struct Operation
+    {
+        Kind kind{Kind::Basic};
+
+        // the index of the basic-expression if kind is Basic, of the left operand otherwise
+        std::uint32_t lhs{0};
+
+        // the index of the right operand, unused if kind is Basic
+        std::uint32_t rhs{0};
+
+        // empty if kind is Basic
+        std::optional<TokenRef> op{};
+    };
+
     [[nodiscard]] SourceLocation getLocation() const;
 
-    Node<AssignmentExpression> assignment;
+    [[nodiscard]] bool isBasic() const;
+
+    [[nodiscard]] const Operation& getRoot() const;
+    [[nodiscard]] const Operation& getLhs(const Operation& operation) const;
+    [[nodiscard]] const Operation& getRhs(const Operation& operation) const;
+
+    [[nodiscard]] const BasicExpression& getBasic(const Operation& operation) const;
+    [[nodiscard]] BasicExpression& getBasic(const Operation& operation);
+
+    NodeArray<Operation> operations;
+
+    // in source order
+    NodeArray<BasicExpression> basics;
 };
 
 } // namespace CST
@@ -0,0 +1,663 @@
+#include "cpps/cst/incremental-parser.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "cpps/cst.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/utility/trace.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+bool isSameLine(const Source::Line& lhs, const Source::Line& rhs)
+{
+    return lhs.getType() == rhs.getType() && lhs.getText() == rhs.getText();
+}
+
+// the lexer starts the line inside the block comment
+bool isInsideComment(const Comment& comment, SourceLine line)
+{
+    return comment.type == Comment::Type::Block && comment.beginLocation.line < line && comment.endLocation.line >= line;
+}
+
+std::size_t findFirstTokenIndex(const Tokens& tokens, SourceLine line)
+{
+    const auto it = std::lower_bound(tokens.begin(), tokens.end(), line, [](const Token& token, SourceLine value) {
+        return token.location.line < value;
+    });
+
+    return static_cast<std::size_t>(it - tokens.begin());
+}
+
+std::size_t findTokenIndex(const Tokens& tokens, SourceLocation location)
+{
+    const auto it = std::lower_bound(tokens.begin(), tokens.end(), location, [](const Token& token, SourceLocation value) {
+        return token.location.line < value.line || (token.location.line == value.line && token.location.column < value.column);
+    });
+
+    return static_cast<std::size_t>(it - tokens.begin());
+}
+
+/**
+ * Moves the token references of a reused declaration from the previous tokens to the new ones, and shifts its locations.
+ * The declaration is entirely before or after the edit, its tokens are moved by the same offset.
+ */
+class DeclarationShifter
+{
+public:
+    DeclarationShifter(const Token* previousTokens, std::size_t previousBeginTokenIndex, const Tokens& tokens, std::size_t beginTokenIndex, std::int64_t linesDelta);
+
+    void shift(Declaration& declaration) const;
+
+private:
+    void shift(TokenRef& token) const;
+    void shift(std::optional<TokenRef>& token) const;
+    void shift(SourceLocation& location) const;
+
+    template<typename T>
+    void shift(Node<T>& node) const;
+
+    void shift(UnqualifiedIdentifier& identifier) const;
+    void shift(QualifiedIdentifier& identifier) const;
+    void shift(Identifier& identifier) const;
+    void shift(IdentifierExpression& expression) const;
+
+    void shift(FunctionSignature& signature) const;
+    void shift(ParameterDeclarationList& parameters) const;
+    void shift(ParameterDeclaration& parameter) const;
+
+    void shift(Statement& statement) const;
+    void shift(CompoundStatement& statement) const;
+    void shift(ExpressionStatement& statement) const;
+    void shift(ReturnStatement& statement) const;
+
+    void shift(Expression& expression) const;
+    void shift(ExpressionList& expressions) const;
+
+    void shift(BasicExpression& expression) const;
+    void shift(PrefixExpression& expression) const;
+    void shift(PrimaryExpression& expression) const;
+    void shift(PostfixExpression& expression) const;
+
+private:
+    const Token* _previousTokens;
+    std::size_t _previousBeginTokenIndex;
+
+    const Tokens& _tokens;
+    std::size_t _beginTokenIndex;
+
+    std::int64_t _linesDelta;
+};
+
+DeclarationShifter::DeclarationShifter(const Token* previousTokens, std::size_t previousBeginTokenIndex, const Tokens& tokens, std::size_t beginTokenIndex, std::int64_t linesDelta)
+    : _previousTokens(previousTokens)
+    , _previousBeginTokenIndex(previousBeginTokenIndex)
+    , _tokens(tokens)
+    , _beginTokenIndex(beginTokenIndex)
+    , _linesDelta(linesDelta)
+{
+}
+
+void DeclarationShifter::shift(Declaration& declaration) const
+{
+    shift(declaration.identifier);
+
+    if (FunctionSignature* signature = declaration.type.getIf<FunctionSignature>())
+    {
+        shift(*signature);
+    }
+    else if (IdentifierExpression* expression = declaration.type.getIf<IdentifierExpression>())
+    {
+        shift(*expression);
+    }
+
+    shift(declaration.pointerDeclaration);
+
+    if (declaration.initializer)
+    {
+        shift(*declaration.initializer);
+    }
+
+    shift(declaration.startLocation);
+    shift(declaration.endLocation);
+    shift(declaration.equalLocation);
+}
+
+void DeclarationShifter::shift(TokenRef& token) const
+{
+    const auto previousIndex = static_cast<std::size_t>(&token.get() - _previousTokens);
+
+    token = std::cref(_tokens.at(previousIndex - _previousBeginTokenIndex + _beginTokenIndex));
+}
+
+void DeclarationShifter::shift(std::optional<TokenRef>& token) const
+{
+    if (token)
+    {
+        shift(*token);
+    }
+}
+
+void DeclarationShifter::shift(SourceLocation& location) const
+{
+    if (location.line != InvalidSourceLine)
+    {
+        location.line = static_cast<SourceLine>(static_cast<std::int64_t>(location.line) + _linesDelta);
+    }
+}
+
+template<typename T>
+void DeclarationShifter::shift(Node<T>& node) const
+{
+    if (node)
+    {
+        shift(*node);
+    }
+}
+
+void DeclarationShifter::shift(UnqualifiedIdentifier& identifier) const
+{
+    shift(identifier.identifier);
+    shift(identifier.constIdentifier);
+}
+
+void DeclarationShifter::shift(QualifiedIdentifier& identifier) const
+{
+    for (QualifiedIdentifier::Term& term : identifier.terms)
+    {
+        shift(term.scope);
+        shift(term.identifier);
+    }
+}
+
+void DeclarationShifter::shift(Identifier& identifier) const
+{
+    if (QualifiedIdentifier* qualified = identifier.type.getIf<QualifiedIdentifier>())
+    {
+        shift(*qualified);
+    }
+    else if (UnqualifiedIdentifier* unqualified = identifier.type.getIf<UnqualifiedIdentifier>())
+    {
+        shift(*unqualified);
+    }
+}
+
+void DeclarationShifter::shift(IdentifierExpression& expression) const
+{
+    shift(expression.identifier);
+    shift(expression.location);
+}
+
+void DeclarationShifter::shift(FunctionSignature& signature) const
+{
+    shift(signature.parameters);
+
+    if (IdentifierExpression* expression = signature.returns.getIf<IdentifierExpression>())
+    {
+        shift(*expression);
+    }
+    else if (ParameterDeclarationList* parameters = signature.returns.getIf<ParameterDeclarationList>())
+    {
+        shift(*parameters);
+    }
+}
+
+void DeclarationShifter::shift(ParameterDeclarationList& parameters) const
+{
+    for (std::size_t i = 0; i < parameters.size(); ++i)
+    {
+        shift(parameters[i]);
+    }
+
+    shift(parameters.openParenthesisLocation);
+    shift(parameters.closeParenthesisLocation);
+}
+
+void DeclarationShifter::shift(ParameterDeclaration& parameter) const
+{
+    shift(parameter.declaration);
+    shift(parameter.location);
+}
+
+void DeclarationShifter::shift(Statement& statement) const
+{
+    if (Declaration* declaration = statement.type.getIf<Declaration>())
+    {
+        shift(*declaration);
+    }
+    else if (CompoundStatement* compound = statement.type.getIf<CompoundStatement>())
+    {
+        shift(*compound);
+    }
+    else if (ExpressionStatement* expression = statement.type.getIf<ExpressionStatement>())
+    {
+        shift(*expression);
+    }
+    else if (ReturnStatement* returnStatement = statement.type.getIf<ReturnStatement>())
+    {
+        shift(*returnStatement);
+    }
+}
+
+void DeclarationShifter::shift(CompoundStatement& statement) const
+{
+    for (std::size_t i = 0; i < statement.size(); ++i)
+    {
+        shift(statement[i]);
+    }
+
+    shift(statement.openBraceLocation);
+    shift(statement.closeBraceLocation);
+}
+
+void DeclarationShifter::shift(ExpressionStatement& statement) const
+{
+    shift(statement.expression);
+}
+
+void DeclarationShifter::shift(ReturnStatement& statement) const
+{
+    shift(statement.identifier);
+    shift(statement.expression);
+}
+
+void DeclarationShifter::shift(Expression& expression) const
+{
+    for (Expression::Operation& operation : expression.operations)
+    {
+        shift(operation.op);
+    }
+
+    for (BasicExpression& basic : expression.basics)
+    {
+        shift(basic);
+    }
+}
+
+void DeclarationShifter::shift(ExpressionList& expressions) const
+{
+    for (std::size_t i = 0; i < expressions.size(); ++i)
+    {
+        shift(expressions[i].expression);
+    }
+
+    shift(expressions.openParenthesisLocation);
+    shift(expressions.closeParenthesisLocation);
+}
+
+void DeclarationShifter::shift(BasicExpression& expression) const
+{
+    shift(expression.prefix);
+    shift(expression.primary);
+    shift(expression.postfix);
+}
+
+void DeclarationShifter::shift(PrefixExpression& expression) const
+{
+    for (TokenRef& op : expression.ops)
+    {
+        shift(op);
+    }
+}
+
+void DeclarationShifter::shift(PrimaryExpression& expression) const
+{
+    if (expression.type.is<Token>())
+    {
+        TokenRef token = std::as_const(expression.type).as<Token>();
+
+        shift(token);
+
+        expression.type = token.get();
+    }
+    else if (IdentifierExpression* identifier = expression.type.getIf<IdentifierExpression>())
+    {
+        shift(*identifier);
+    }
+    else if (Declaration* declaration = expression.type.getIf<Declaration>())
+    {
+        shift(*declaration);
+    }
+    else if (ExpressionList* expressions = expression.type.getIf<ExpressionList>())
+    {
+        shift(*expressions);
+    }
+}
+
+void DeclarationShifter::shift(PostfixExpression& expression) const
+{
+    for (PostfixExpression::Term& term : expression.terms)
+    {
+        shift(term.op);
+        shift(term.identifierExpression);
+
+        if (term.arguments)
+        {
+            shift(term.arguments->expressions);
+            shift(term.arguments->closeOp);
+        }
+    }
+}
+
+} // namespace
+
+IncrementalParser::IncrementalParser() = default;
+
+IncrementalParser::~IncrementalParser() = default;
+
+void IncrementalParser::update(Diagnosis& diagnosis, Source&& source)
+{
+    CPPS_TRACE_ZONE("IncrementalParser::update");
+
+    // the previous tokens view the previous source until the update ends
+    const Source previousSource = std::exchange(_source, std::move(source));
+
+    const bool canUpdateEdit = _isReusable && !diagnosis.shouldStop() && _tu.mergedAllocators.size() < MaxMergedAllocatorsCount;
+
+    if (!canUpdateEdit || !tryUpdateEdit(previousSource))
+    {
+        updateAll(diagnosis);
+    }
+}
+
+const Source& IncrementalParser::getSource() const
+{
+    return _source;
+}
+
+const Tokens& IncrementalParser::getTokens() const
+{
+    return _tokens;
+}
+
+const TranslationUnit& IncrementalParser::getTranslationUnit() const
+{
+    return _tu;
+}
+
+const IncrementalParser::Stats& IncrementalParser::getStats() const
+{
+    return _stats;
+}
+
+void IncrementalParser::updateAll(Diagnosis& diagnosis)
+{
+    const std::size_t errorsCount = diagnosis.getErrorsCount();
+
+    Lexer lexer{diagnosis, _source};
+
+    _tokens = lexer.lex();
+
+    Parser parser{diagnosis, _tokens};
+
+    _tu = parser.parse();
+
+    _isReusable = diagnosis.getErrorsCount() == errorsCount && !diagnosis.shouldStop();
+
+    _stats = {.isIncremental = false,
+              .lexedLinesCount = _source.size(),
+              .reusedDeclarationsCount = 0,
+              .parsedDeclarationsCount = _tu.declarations.size()};
+}
+
+// The lines [beginLine, previousEndLine) of the previous source are replaced by the lines [beginLine, endLine).
+// A declaration is reused if its tokens and the token following it, read by the parser to end it, are outside of the edit.
+// The parse of the edit starts at the first declaration not reused before the edit,
+// and stops on the first declaration reused after the edit, if it reaches its first token.
+// The lex and the parse of the edit are diagnosed apart, any error makes the update full to report the errors as a full one.
+bool IncrementalParser::tryUpdateEdit(const Source& previousSource)
+{
+    if (_tokens.empty())
+    {
+        return false;
+    }
+
+    const SourceLine commonLinesCount = std::min(previousSource.size(), _source.size());
+
+    SourceLine beginLine = 0;
+
+    while (beginLine < commonLinesCount && isSameLine(previousSource[beginLine], _source[beginLine]))
+    {
+        ++beginLine;
+    }
+
+    SourceLine endLinesCount = 0;
+
+    while (endLinesCount < commonLinesCount - beginLine && isSameLine(previousSource[previousSource.size() - 1 - endLinesCount], _source[_source.size() - 1 - endLinesCount]))
+    {
+        ++endLinesCount;
+    }
+
+    const SourceLine previousEndLine = previousSource.size() - endLinesCount;
+    const SourceLine endLine = _source.size() - endLinesCount;
+
+    const std::int64_t linesDelta = static_cast<std::int64_t>(endLine) - static_cast<std::int64_t>(previousEndLine);
+
+    const std::span<const Comment> previousComments = _tokens.comments();
+
+    if (std::any_of(previousComments.begin(), previousComments.end(), [beginLine, previousEndLine](const Comment& comment) {
+            return isInsideComment(comment, beginLine) || isInsideComment(comment, previousEndLine);
+        }))
+    {
+        return false;
+    }
+
+    // the tokens
+
+    const std::size_t beginTokenIndex = findFirstTokenIndex(_tokens, beginLine);
+    const std::size_t previousEndTokenIndex = findFirstTokenIndex(_tokens, previousEndLine);
+
+    std::vector<Token> editTokens;
+    std::vector<Comment> comments;
+
+    for (const Comment& comment : previousComments)
+    {
+        if (comment.beginLocation.line < beginLine)
+        {
+            comments.push_back(comment);
+        }
+    }
+
+    Diagnosis lexDiagnosis;
+    lexDiagnosis.setFailFast(true);
+
+    Lexer lexer{lexDiagnosis, _source};
+
+    if (!lexer.lex(beginLine, endLine, editTokens, comments) || lexDiagnosis.getErrorsCount() > 0)
+    {
+        return false;
+    }
+
+    for (const Comment& comment : previousComments)
+    {
+        if (comment.beginLocation.line >= previousEndLine)
+        {
+            Comment& shiftedComment = comments.emplace_back(comment);
+
+            shiftedComment.beginLocation.line = static_cast<SourceLine>(static_cast<std::int64_t>(comment.beginLocation.line) + linesDelta);
+            shiftedComment.endLocation.line = static_cast<SourceLine>(static_cast<std::int64_t>(comment.endLocation.line) + linesDelta);
+        }
+    }
+
+    // the index of the token following each previous declaration
+    const std::size_t declarationsCount = _tu.declarations.size();
+
+    std::vector<std::size_t> declarationEnds(declarationsCount);
+
+    for (std::size_t i = 0; i < declarationsCount; ++i)
+    {
+        declarationEnds[i] = findTokenIndex(_tokens, _tu.declarations[i].endLocation) + 1;
+    }
+
+    // the tokens are edited in place if they fit, the previous declarations keep pointing to the tokens before the edit
+    std::vector<Token> previousTokens = _tokens.release();
+
+    const Token* previousTokensData = previousTokens.data();
+    const std::size_t previousTokensCount = previousTokens.size();
+
+    const std::size_t endTokenIndex = beginTokenIndex + editTokens.size();
+    const std::size_t tokensCount = endTokenIndex + (previousTokensCount - previousEndTokenIndex);
+
+    const bool isInPlace = tokensCount <= previousTokens.capacity();
+
+    std::vector<Token> tokens;
+
+    if (isInPlace)
+    {
+        tokens = std::move(previousTokens);
+
+        if (endTokenIndex > previousEndTokenIndex)
+        {
+            tokens.resize(tokensCount);
+            std::move_backward(tokens.begin() + static_cast<std::ptrdiff_t>(previousEndTokenIndex), tokens.begin() + static_cast<std::ptrdiff_t>(previousTokensCount), tokens.end());
+        }
+        else
+        {
+            std::move(tokens.begin() + static_cast<std::ptrdiff_t>(previousEndTokenIndex), tokens.end(), tokens.begin() + static_cast<std::ptrdiff_t>(endTokenIndex));
+            tokens.resize(tokensCount);
+        }
+
+        std::copy(editTokens.begin(), editTokens.end(), tokens.begin() + static_cast<std::ptrdiff_t>(beginTokenIndex));
+    }
+    else
+    {
+        tokens.reserve(tokensCount);
+        tokens.insert(tokens.end(), previousTokens.begin(), previousTokens.begin() + static_cast<std::ptrdiff_t>(beginTokenIndex));
+        tokens.insert(tokens.end(), editTokens.begin(), editTokens.end());
+        tokens.insert(tokens.end(), previousTokens.begin() + static_cast<std::ptrdiff_t>(previousEndTokenIndex), previousTokens.end());
+    }
+
+    // the tokens view the new source
+    auto rebindToken = [this](Token& token, SourceLine line) {
+        token.location.line = line;
+        token.text = std::string_view{_source[line].getText()}.substr(token.location.column, token.text.size());
+    };
+
+    for (std::size_t i = 0; i < beginTokenIndex; ++i)
+    {
+        rebindToken(tokens[i], tokens[i].location.line);
+    }
+
+    for (std::size_t i = endTokenIndex; i < tokensCount; ++i)
+    {
+        rebindToken(tokens[i], static_cast<SourceLine>(static_cast<std::int64_t>(tokens[i].location.line) + linesDelta));
+    }
+
+    Tokens newTokens{std::move(tokens), std::move(comments)};
+
+    // the declarations
+
+    std::size_t firstParsedIndex = 0;
+
+    while (firstParsedIndex < declarationsCount && declarationEnds[firstParsedIndex] < beginTokenIndex)
+    {
+        ++firstParsedIndex;
+    }
+
+    // the first token of the declarations after the edit, in the new tokens
+    std::size_t firstReusedIndex = firstParsedIndex;
+    std::vector<std::size_t> boundaries;
+
+    for (std::size_t i = firstParsedIndex; i < declarationsCount; ++i)
+    {
+        const std::size_t previousTokenIndex = i == 0 ? 0 : declarationEnds[i - 1];
+
+        if (previousTokenIndex < previousEndTokenIndex)
+        {
+            firstReusedIndex = i + 1;
+            continue;
+        }
+
+        boundaries.push_back(previousTokenIndex - previousEndTokenIndex + endTokenIndex);
+    }
+
+    const std::size_t parseTokenIndex = firstParsedIndex == 0 ? 0 : declarationEnds[firstParsedIndex - 1];
+
+    Diagnosis parseDiagnosis;
+    parseDiagnosis.setFailFast(true);
+
+    Parser parser{parseDiagnosis, newTokens, parseTokenIndex, newTokens.size()};
+
+    const std::optional<std::size_t> reachedBoundary = parser.parseDeclarationsUntil(boundaries);
+
+    if (!reachedBoundary || parseDiagnosis.getErrorsCount() > 0)
+    {
+        return false;
+    }
+
+    // the update cannot fail anymore, the reused declarations are moved to the new tokens
+
+    firstReusedIndex += *reachedBoundary;
+
+    std::vector<Node<Declaration>> previousDeclarations = _tu.declarations.release();
+    std::vector<Node<Declaration>> parsedDeclarations = parser._tu.declarations.release();
+
+    std::vector<Node<Declaration>> declarations;
+    declarations.reserve(firstParsedIndex + parsedDeclarations.size() + (declarationsCount - firstReusedIndex));
+
+    // in place, the tokens before the edit did not move
+    const bool mustShiftBefore = !isInPlace;
+    const bool mustShiftAfter = !isInPlace || endTokenIndex != previousEndTokenIndex || linesDelta != 0;
+
+    const DeclarationShifter beforeShifter{previousTokensData, 0, newTokens, 0, 0};
+
+    for (std::size_t i = 0; i < firstParsedIndex; ++i)
+    {
+        if (mustShiftBefore)
+        {
+            beforeShifter.shift(*previousDeclarations[i]);
+        }
+
+        declarations.push_back(std::move(previousDeclarations[i]));
+    }
+
+    for (Node<Declaration>& declaration : parsedDeclarations)
+    {
+        declarations.push_back(std::move(declaration));
+    }
+
+    const DeclarationShifter afterShifter{previousTokensData, previousEndTokenIndex, newTokens, endTokenIndex, linesDelta};
+
+    for (std::size_t i = firstReusedIndex; i < declarationsCount; ++i)
+    {
+        if (mustShiftAfter)
+        {
+            afterShifter.shift(*previousDeclarations[i]);
+        }
+
+        declarations.push_back(std::move(previousDeclarations[i]));
+    }
+
+    _stats = {.isIncremental = true,
+              .lexedLinesCount = endLine - beginLine,
+              .reusedDeclarationsCount = declarations.size() - parsedDeclarations.size(),
+              .parsedDeclarationsCount = parsedDeclarations.size()};
+
+    // the replaced declarations are destroyed with previousDeclarations, their allocators are kept
+    TranslationUnit tu = std::move(parser._tu);
+
+    tu.declarations = DeclarationList{std::move(declarations)};
+    tu.mergedAllocators.push_back(std::move(_tu.allocator));
+
+    for (TranslationUnit::Allocator& allocator : _tu.mergedAllocators)
+    {
+        tu.mergedAllocators.push_back(std::move(allocator));
+    }
+
+    _tu.mergedAllocators.clear();
+
+    _tokens = std::move(newTokens);
+    _tu = std::move(tu);
+
+    return true;
+}
+
+} // namespace CPPS::CST
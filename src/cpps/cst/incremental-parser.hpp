@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+
+#include "cpps/cst/translation-unit.hpp"
+#include "cpps/source.hpp"
+#include "cpps/tokens.hpp"
+
+namespace CPPS {
+
+class Diagnosis;
+
+namespace CST {
+
+/**
+ * Keeps the Source, Tokens and TranslationUnit of a file, and updates them when the file is edited.
+ *
+ * The edit is the range of lines differing between the previous and the new source, only these lines are lexed again.
+ * Only the top-level declarations overlapping the edit are parsed again, the others are reused:
+ * their nodes are moved to the new translation unit, with their tokens and locations shifted.
+ *
+ * The result is always the one of a full lex and parse of the new source. An update is full if the previous one had errors,
+ * if the edit starts or ends inside a block comment, or if the lex or the parse of the edit reports an error.
+ */
+class IncrementalParser
+{
+public:
+    struct Stats
+    {
+        bool isIncremental{false};
+
+        std::size_t lexedLinesCount{0};
+        std::size_t reusedDeclarationsCount{0};
+        std::size_t parsedDeclarationsCount{0};
+    };
+
+    // the nodes of the replaced declarations stay in the allocators of the previous updates, a full update releases them
+    static constexpr std::size_t MaxMergedAllocatorsCount{16};
+
+public:
+    // out of line, the nodes are incomplete here
+    IncrementalParser();
+    ~IncrementalParser();
+
+    IncrementalParser(const IncrementalParser&) = delete;
+    IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+    // the first update is full
+    void update(Diagnosis& diagnosis, Source&& source);
+
+    [[nodiscard]] const Source& getSource() const;
+    [[nodiscard]] const Tokens& getTokens() const;
+    [[nodiscard]] const TranslationUnit& getTranslationUnit() const;
+
+    // of the last update
+    [[nodiscard]] const Stats& getStats() const;
+
+private:
+    void updateAll(Diagnosis& diagnosis);
+
+    // false if the update cannot be incremental, the tokens and the translation unit are then left to a full update
+    bool tryUpdateEdit(const Source& previousSource);
+
+private:
+    Source _source;
+    Tokens _tokens;
+    TranslationUnit _tu;
+
+    Stats _stats;
+
+    // the last update had no error, its declarations cover all the tokens
+    bool _isReusable{false};
+};
+
+} // namespace CST
+} // namespace CPPS
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "cpps/utility/bump-pointer-allocator.hpp"
+
+namespace CPPS::CST {
+
+/**
+ * Contiguous Ts stored in a BumpPointerAllocator, for the small lists built once by the parser.
+ *
+ * The array doubles its capacity in the allocator when full, the previous storage is given back to the allocator,
+ * which only reclaims it if nothing was allocated since.
+ * The NodeArray is responsible to call the ctor and dtor of each T, as Node, the memory is owned by the allocator.
+ */
+template<typename T>
+class NodeArray
+{
+public:
+    NodeArray() = default;
+    NodeArray(NodeArray&& other) noexcept;
+    NodeArray& operator=(NodeArray&& other) noexcept;
+    ~NodeArray();
+
+    NodeArray(const NodeArray&) = delete;
+    NodeArray& operator=(const NodeArray&) = delete;
+
+    template<typename AllocatorT, typename... ArgsT>
+    requires(IsBumpPointerAllocatorV<AllocatorT>)
+    T& emplaceBack(AllocatorT& allocator, ArgsT&&... args);
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] const T& operator[](std::size_t index) const;
+    [[nodiscard]] T& operator[](std::size_t index);
+
+    [[nodiscard]] const T& back() const;
+    [[nodiscard]] T& back();
+
+    [[nodiscard]] const T* begin() const;
+    [[nodiscard]] const T* end() const;
+
+    [[nodiscard]] T* begin();
+    [[nodiscard]] T* end();
+
+private:
+    void clear();
+
+private:
+    T* _data{nullptr};
+    std::uint32_t _size{0};
+    std::uint32_t _capacity{0};
+};
+
+template<typename T>
+NodeArray<T>::NodeArray(NodeArray&& other) noexcept
+    : _data(std::exchange(other._data, nullptr))
+    , _size(std::exchange(other._size, 0))
+    , _capacity(std::exchange(other._capacity, 0))
+{
+}
+
+template<typename T>
+NodeArray<T>& NodeArray<T>::operator=(NodeArray&& other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _capacity = std::exchange(other._capacity, 0);
+    }
+
+    return *this;
+}
+
+template<typename T>
+NodeArray<T>::~NodeArray()
+{
+    clear();
+}
+
+template<typename T>
+template<typename AllocatorT, typename... ArgsT>
+requires(IsBumpPointerAllocatorV<AllocatorT>)
+T& NodeArray<T>::emplaceBack(AllocatorT& allocator, ArgsT&&... args)
+{
+    if (_size != _capacity)
+    {
+        T* value = new (_data + _size) T(std::forward<ArgsT>(args)...);
+
+        ++_size;
+
+        return *value;
+    }
+
+    const std::uint32_t capacity = _capacity == 0 ? 1 : 2 * _capacity;
+
+    T* data = static_cast<T*>(allocator.allocate(sizeof(T) * capacity, alignof(T)));
+
+    // args may refer to an element, which must be alive until the new one is constructed
+    T* value = new (data + _size) T(std::forward<ArgsT>(args)...);
+
+    for (std::uint32_t i = 0; i < _size; ++i)
+    {
+        new (data + i) T(std::move(_data[i]));
+        _data[i].~T();
+    }
+
+    if (_data != nullptr)
+    {
+        allocator.deallocate(_data, sizeof(T) * _capacity, alignof(T));
+    }
+
+    _data = data;
+    _capacity = capacity;
+
+    ++_size;
+
+    return *value;
+}
+
+template<typename T>
+bool NodeArray<T>::empty() const
+{
+    return _size == 0;
+}
+
+template<typename T>
+std::size_t NodeArray<T>::size() const
+{
+    return _size;
+}
+
+template<typename T>
+const T& NodeArray<T>::operator[](std::size_t index) const
+{
+    assert(index < _size);
+    return _data[index];
+}
+
+template<typename T>
+T& NodeArray<T>::operator[](std::size_t index)
+{
+    assert(index < _size);
+    return _data[index];
+}
+
+template<typename T>
+const T& NodeArray<T>::back() const
+{
+    assert(_size > 0);
+    return _data[_size - 1];
+}
+
+template<typename T>
+T& NodeArray<T>::back()
+{
+    assert(_size > 0);
+    return _data[_size - 1];
+}
+
+template<typename T>
+const T* NodeArray<T>::begin() const
+{
+    return _data;
+}
+
+template<typename T>
+const T* NodeArray<T>::end() const
+{
+    return _data + _size;
+}
+
+template<typename T>
+T* NodeArray<T>::begin()
+{
+    return _data;
+}
+
+template<typename T>
+T* NodeArray<T>::end()
+{
+    return _data + _size;
+}
+
+template<typename T>
+void NodeArray<T>::clear()
+{
+    std::destroy_n(_data, _size);
+
+    _data = nullptr;
+    _size = 0;
+    _capacity = 0;
+}
+
+} // namespace CPPS::CST
@@ -53,6 +53,12 @@ public:
 
     void add(Node<T>&& node);
 
+    // moves the nodes of other at the end
+    void append(NodeList&& other);
+
+    // moves the nodes out, the list is left empty
+    [[nodiscard]] std::vector<Node<T>> release();
+
     [[nodiscard]] bool empty() const;
     [[nodiscard]] std::size_t size() const;
 
@@ -146,6 +152,19 @@ void NodeList<T>::add(Node<T>&& node)
     _nodes.emplace_back(std::move(node));
 }
 
+template<typename T>
+void NodeList<T>::append(NodeList&& other)
+{
+    _nodes.insert(_nodes.end(), std::make_move_iterator(other._nodes.begin()), std::make_move_iterator(other._nodes.end()));
+    other._nodes.clear();
+}
+
+template<typename T>
+std::vector<Node<T>> NodeList<T>::release()
+{
+    return std::exchange(_nodes, {});
+}
+
 template<typename T>
 bool NodeList<T>::empty() const
 {
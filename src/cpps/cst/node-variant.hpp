@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
@@ -21,6 +25,8 @@ template<typename... TypesT>
 class NodeVariant
 {
 public:
+    using Types = TypeList<TypesT...>;
+
     template<typename T>
     using NodeType = typename NodeType<T>::Type;
 
@@ -44,14 +50,42 @@ public:
     template<typename T>
     [[nodiscard]] bool is() const;
 
+    // the position of the held alternative in TypesT
+    [[nodiscard]] std::size_t index() const;
+
+    // throws std::bad_variant_access if the variant does not hold a T node
     template<typename T>
     [[nodiscard]] const T& as() const;
 
     template<typename T>
     [[nodiscard]] T& as();
 
+    // nullptr if the variant does not hold a T node, or holds a null one
+    template<typename T>
+    [[nodiscard]] T* getIf();
+
+    template<typename T>
+    [[nodiscard]] const T* getIf() const;
+
+    // calls visitor with the held T& node, or const Token&, nothing for std::monostate or a null node
+    // dispatched through a table indexed by the alternative, without the checks and exception path of std::visit
+    template<typename VisitorT>
+    void visit(VisitorT&& visitor);
+
+    template<typename VisitorT>
+    void visit(VisitorT&& visitor) const;
+
+private:
+    using Variant = std::variant<NodeType<TypesT>...>;
+
+    template<std::size_t IndexT, typename VariantT, typename VisitorT>
+    static void visitAlternative(VariantT& variant, VisitorT& visitor);
+
+    template<typename VariantT, typename VisitorT, std::size_t... IndexesT>
+    static void visit(VariantT& variant, VisitorT& visitor, std::index_sequence<IndexesT...>);
+
 private:
-    std::variant<NodeType<TypesT>...> _variant;
+    Variant _variant;
 };
 
 template<typename T>
@@ -103,6 +137,12 @@ template<typename T>
     return std::holds_alternative<NodeType<T>>(_variant);
 }
 
+template<typename... TypesT>
+[[nodiscard]] std::size_t NodeVariant<TypesT...>::index() const
+{
+    return _variant.index();
+}
+
 template<typename... TypesT>
 template<typename T>
 [[nodiscard]] const T& NodeVariant<TypesT...>::as() const
@@ -117,4 +157,71 @@ template<typename T>
     return std::get<NodeType<T>>(_variant).get();
 }
 
+template<typename... TypesT>
+template<typename T>
+[[nodiscard]] T* NodeVariant<TypesT...>::getIf()
+{
+    Node<T>* node = std::get_if<Node<T>>(&_variant);
+
+    return node != nullptr && *node ? &node->get() : nullptr;
+}
+
+template<typename... TypesT>
+template<typename T>
+[[nodiscard]] const T* NodeVariant<TypesT...>::getIf() const
+{
+    const Node<T>* node = std::get_if<Node<T>>(&_variant);
+
+    return node != nullptr && *node ? &node->get() : nullptr;
+}
+
+template<typename... TypesT>
+template<typename VisitorT>
+void NodeVariant<TypesT...>::visit(VisitorT&& visitor)
+{
+    visit(_variant, visitor, std::index_sequence_for<TypesT...>{});
+}
+
+template<typename... TypesT>
+template<typename VisitorT>
+void NodeVariant<TypesT...>::visit(VisitorT&& visitor) const
+{
+    visit(_variant, visitor, std::index_sequence_for<TypesT...>{});
+}
+
+template<typename... TypesT>
+template<std::size_t IndexT, typename VariantT, typename VisitorT>
+void NodeVariant<TypesT...>::visitAlternative(VariantT& variant, VisitorT& visitor)
+{
+    // the table already selected the alternative
+    auto& value = *std::get_if<IndexT>(&variant);
+
+    using ValueT = std::remove_cvref_t<decltype(value)>;
+
+    if constexpr (std::is_same_v<ValueT, TokenRef>)
+    {
+        visitor(value.get());
+    }
+    else if constexpr (!std::is_same_v<ValueT, std::monostate>)
+    {
+        if (value)
+        {
+            visitor(*value);
+        }
+    }
+}
+
+template<typename... TypesT>
+template<typename VariantT, typename VisitorT, std::size_t... IndexesT>
+void NodeVariant<TypesT...>::visit(VariantT& variant, VisitorT& visitor, std::index_sequence<IndexesT...>)
+{
+    using Function = void (*)(VariantT&, VisitorT&);
+
+    static constexpr std::array<Function, sizeof...(IndexesT)> Functions{&visitAlternative<IndexesT, VariantT, VisitorT>...};
+
+    assert(variant.index() < Functions.size());
+
+    Functions[variant.index()](variant, visitor);
+}
+
 } // namespace CPPS::CST
@@ -19,8 +19,9 @@ public:
     Node& operator=(const Node&) = delete;
 
 public:
-    template<std::size_t AllocatorBlockCapacityT, typename... ArgsT>
-    explicit Node(BumpPointerAllocator<AllocatorBlockCapacityT>& allocator, ArgsT&&... args);
+    template<typename AllocatorT, typename... ArgsT>
+    requires(IsBumpPointerAllocatorV<AllocatorT>)
+    explicit Node(AllocatorT& allocator, ArgsT&&... args);
 
     Node(Node&& other);
     Node& operator=(Node&& other) noexcept;
@@ -38,11 +39,13 @@ public:
     [[nodiscard]] T* operator->();
 
 public:
-    template<std::size_t AllocatorBlockCapacityT, typename... ArgsT>
-    void create(BumpPointerAllocator<AllocatorBlockCapacityT>& allocator, ArgsT&&... args);
+    template<typename AllocatorT, typename... ArgsT>
+    requires(IsBumpPointerAllocatorV<AllocatorT>)
+    void create(AllocatorT& allocator, ArgsT&&... args);
 
-    template<std::size_t AllocatorBlockCapacityT>
-    void destroy(BumpPointerAllocator<AllocatorBlockCapacityT>& allocator); // calling destroy is optional
+    template<typename AllocatorT>
+    requires(IsBumpPointerAllocatorV<AllocatorT>)
+    void destroy(AllocatorT& allocator); // calling destroy is optional
 
 private:
     template<typename... ArgsT>
@@ -54,8 +57,9 @@ private:
 };
 
 template<typename T>
-template<std::size_t AllocatorBlockCapacityT, typename... ArgsT>
-Node<T>::Node(BumpPointerAllocator<AllocatorBlockCapacityT>& allocator, ArgsT&&... args)
+template<typename AllocatorT, typename... ArgsT>
+requires(IsBumpPointerAllocatorV<AllocatorT>)
+Node<T>::Node(AllocatorT& allocator, ArgsT&&... args)
 {
     create(allocator, std::forward<ArgsT>(args)...);
 }
@@ -143,8 +147,9 @@ T* Node<T>::operator->()
 }
 
 template<typename T>
-template<std::size_t AllocatorBlockCapacityT, typename... ArgsT>
-void Node<T>::create(BumpPointerAllocator<AllocatorBlockCapacityT>& allocator, ArgsT&&... args)
+template<typename AllocatorT, typename... ArgsT>
+requires(IsBumpPointerAllocatorV<AllocatorT>)
+void Node<T>::create(AllocatorT& allocator, ArgsT&&... args)
 {
     assert(_node == nullptr);
 
@@ -154,8 +159,9 @@ void Node<T>::create(BumpPointerAllocator<AllocatorBlockCapacityT>& allocator, A
 }
 
 template<typename T>
-template<std::size_t AllocatorBlockCapacityT>
-void Node<T>::destroy(BumpPointerAllocator<AllocatorBlockCapacityT>& allocator)
+template<typename AllocatorT>
+requires(IsBumpPointerAllocatorV<AllocatorT>)
+void Node<T>::destroy(AllocatorT& allocator)
 {
     assert(_node != nullptr);
 
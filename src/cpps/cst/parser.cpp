@@ -1,14 +1,30 @@
 #include "cpps/cst/parser.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <latch>
 #include <utility>
+#include <vector>
 
 #include "cpps/diagnosis.hpp"
 #include "cpps/tokens.hpp"
+#include "cpps/utility/thread-pool.hpp"
+#include "cpps/utility/trace.hpp"
 
 namespace CPPS::CST {
 
 namespace {
 
+// below, a group is not worth a task
+constexpr std::size_t MinGroupTokensCount{4096};
+
+// more groups than threads, to balance the uneven declarations
+constexpr std::size_t GroupsPerThread{4};
+
+// the recovery budget, in tokens scanned per token of the stream
+constexpr std::size_t RecoveryTokensPerToken{4};
+
 template<Punctuator... PunctuatorsT>
 constexpr bool anyTokenPunctuator(const Token& token)
 {
@@ -35,111 +51,245 @@ constexpr bool anyTokenKeyword(const Token& token)
     return ((keyword == KeywordsT) || ...);
 }
 
+// Basic if token is not a binary operator
+Expression::Kind getBinaryKind(const Token& token, bool allowRelationalComparison)
+{
+    using Kind = Expression::Kind;
+
+    // clang-format off
+    if (anyTokenPunctuator<
+            Punctuator::AmpersandEqual,
+            Punctuator::Assignment,
+            Punctuator::CaretEqual,
+            Punctuator::LeftShiftEqual,
+            Punctuator::MinusEqual,
+            Punctuator::ModuloEqual,
+            Punctuator::MultiplyEqual,
+            Punctuator::PipeEqual,
+            Punctuator::PlusEqual,
+            Punctuator::RightShiftEqual,
+            Punctuator::SlashEqual>(token))
+    {
+        return Kind::Assignment;
+    }
+    // clang-format on
+
+    if (anyTokenPunctuator<Punctuator::LogicalOr>(token))
+    {
+        return Kind::LogicalOr;
+    }
+
+    if (anyTokenPunctuator<Punctuator::LogicalAnd>(token))
+    {
+        return Kind::LogicalAnd;
+    }
+
+    if (anyTokenPunctuator<Punctuator::Pipe>(token))
+    {
+        return Kind::BitOr;
+    }
+
+    if (anyTokenPunctuator<Punctuator::Caret>(token))
+    {
+        return Kind::BitXor;
+    }
+
+    if (anyTokenPunctuator<Punctuator::Ampersand>(token))
+    {
+        return Kind::BitAnd;
+    }
+
+    if (anyTokenPunctuator<Punctuator::CompareEqual, Punctuator::CompareNotEqual>(token))
+    {
+        return Kind::Equality;
+    }
+
+    if (allowRelationalComparison && anyTokenPunctuator<Punctuator::Less, Punctuator::LessEqual, Punctuator::Greater, Punctuator::GreaterEqual>(token))
+    {
+        return Kind::Relational;
+    }
+
+    if (anyTokenPunctuator<Punctuator::Spaceship>(token))
+    {
+        return Kind::Compare;
+    }
+
+    if (anyTokenPunctuator<Punctuator::LeftShift, Punctuator::RightShift>(token))
+    {
+        return Kind::Shift;
+    }
+
+    if (anyTokenPunctuator<Punctuator::Plus, Punctuator::Minus>(token))
+    {
+        return Kind::Additive;
+    }
+
+    if (anyTokenPunctuator<Punctuator::Multiply, Punctuator::Slash, Punctuator::Modulo>(token))
+    {
+        return Kind::Multiplicative;
+    }
+
+    if (anyTokenKeyword<Keyword::As, Keyword::Is>(token))
+    {
+        return Kind::IsAs;
+    }
+
+    return Kind::Basic;
+}
+
 } // namespace
 
-std::string Parser::DiagnosisMessage::dotMustFollowedByValidMemberName()
+Diagnosis::Message Parser::DiagnosisMessage::dotMustFollowedByValidMemberName()
 {
     return "'.' must be followed by a valid member name";
 }
 
-std::string Parser::DiagnosisMessage::illFormedInitializer()
+Diagnosis::Message Parser::DiagnosisMessage::illFormedInitializer()
 {
     return "ill-formed initializer";
 }
 
-std::string Parser::DiagnosisMessage::invalidExpressionAfter(std::string_view token)
+Diagnosis::Message Parser::DiagnosisMessage::invalidDeclaration()
 {
-    return fmt::format("invalid expression after {}", token);
+    return "invalid declaration";
 }
 
-std::string Parser::DiagnosisMessage::invalidReturnParameterModifier(ParameterModifier modifier)
+Diagnosis::Message Parser::DiagnosisMessage::invalidExpressionAfter(std::string_view token)
 {
-    return fmt::format("a return value cannot be '{}'", modifier);
+    return {"invalid expression after {}", token};
 }
 
-std::string Parser::DiagnosisMessage::invalidReturnExpression()
+Diagnosis::Message Parser::DiagnosisMessage::invalidReturnParameterModifier(ParameterModifier modifier)
+{
+    return {"a return value cannot be '{}'", toStringView(modifier)};
+}
+
+Diagnosis::Message Parser::DiagnosisMessage::invalidReturnExpression()
 {
     return "invalid return expression";
 }
 
-std::string Parser::DiagnosisMessage::invalidStatementInCompoundStatement()
+Diagnosis::Message Parser::DiagnosisMessage::invalidStatementInCompoundStatement()
 {
     return "invalid statement in compound-statement";
 }
 
-std::string Parser::DiagnosisMessage::invalidTextInExpressionList()
+Diagnosis::Message Parser::DiagnosisMessage::invalidTextInExpressionList()
 {
     return "invalid text in expression list";
 }
 
-std::string Parser::DiagnosisMessage::missingCloseParenthesisForParameterList()
+Diagnosis::Message Parser::DiagnosisMessage::missingCloseParenthesisForParameterList()
 {
     return "missing close parenthesis in parameter list";
 }
 
-std::string Parser::DiagnosisMessage::missingCommaBetweenParameterDeclarations()
+Diagnosis::Message Parser::DiagnosisMessage::missingCommaBetweenParameterDeclarations()
 {
     return "missing comma between parameter declarations";
 }
 
-std::string Parser::DiagnosisMessage::missingEqualBeforeFunctionBody()
+Diagnosis::Message Parser::DiagnosisMessage::missingEqualBeforeFunctionBody()
 {
     return "missing = before function body";
 }
 
-std::string Parser::DiagnosisMessage::missingFunctionReturnAfterArrow()
+Diagnosis::Message Parser::DiagnosisMessage::missingFunctionReturnAfterArrow()
 {
     return "missing function return after ->";
 }
 
-std::string Parser::DiagnosisMessage::missingSemicolonAtEndDeclaration()
+Diagnosis::Message Parser::DiagnosisMessage::missingSemicolonAtEndDeclaration()
 {
     return "missing ';' at end of the declaration";
 }
 
-std::string Parser::DiagnosisMessage::missingSemicolonAtEndStatement()
+Diagnosis::Message Parser::DiagnosisMessage::missingSemicolonAtEndStatement()
 {
     return "missing ';' at the end of the statement";
 }
 
-std::string Parser::DiagnosisMessage::subscriptExpressionBracketEmpty()
+Diagnosis::Message Parser::DiagnosisMessage::nestingTooDeep(std::size_t maxDepth)
+{
+    return {"nesting exceeds the maximum depth of {}", maxDepth};
+}
+
+Diagnosis::Message Parser::DiagnosisMessage::recoveryBudgetExceeded()
+{
+    return "too many errors to recover from, the rest of the file is skipped";
+}
+
+Diagnosis::Message Parser::DiagnosisMessage::subscriptExpressionBracketEmpty()
 {
     return "subscript expression [ ] must not be empty";
 }
 
-std::string Parser::DiagnosisMessage::unexpectedTextAfterExpressionList()
+Diagnosis::Message Parser::DiagnosisMessage::unexpectedTextAfterExpressionList()
 {
     return "unexpected text after expression-list";
 }
 
-std::string Parser::DiagnosisMessage::unexpectedTextAfterOpenParenthesis()
+Diagnosis::Message Parser::DiagnosisMessage::unexpectedTextAfterOpenParenthesis()
 {
     return "unexpected text - ( is not followed by an expression-list";
 }
 
-std::string Parser::DiagnosisMessage::unexpectedTextBracketDoesNotMatch()
+Diagnosis::Message Parser::DiagnosisMessage::unexpectedTextBracketDoesNotMatch()
 {
     return "unexpected text - [ is not properly matched by ]";
 }
 
-std::string Parser::DiagnosisMessage::unexpectedTextParenthesisDoesNotMatch()
+Diagnosis::Message Parser::DiagnosisMessage::unexpectedTextParenthesisDoesNotMatch()
 {
     return "unexpected text - ( is not properly matched by )";
 }
 
-std::string Parser::DiagnosisMessage::unnamedDeclarationAtExpressionScopeMustBeFunction()
+Diagnosis::Message Parser::DiagnosisMessage::unnamedDeclarationAtExpressionScopeMustBeFunction()
 {
     return "an unnamed declaration at expression scope must be a function";
 }
 
-std::string Parser::DiagnosisMessage::unnamedFunctionAtExpressionScopeCannotReturnsMultipleValues()
+Diagnosis::Message Parser::DiagnosisMessage::unnamedFunctionAtExpressionScopeCannotReturnsMultipleValues()
 {
     return "an unnamed function at expression scope currently cannot return multiple values";
 }
 
+Parser::NestingGuard::NestingGuard(Parser& parser)
+    : _parser(parser)
+{
+    ++_parser._nestingDepth;
+
+    if (_parser._nestingDepth == MaxNestingDepth + 1)
+    {
+        _parser.error(DiagnosisMessage::nestingTooDeep(MaxNestingDepth));
+        _parser._isNestingTooDeep = true;
+    }
+}
+
+Parser::NestingGuard::~NestingGuard()
+{
+    --_parser._nestingDepth;
+}
+
+bool Parser::NestingGuard::isTooDeep() const
+{
+    return _parser._nestingDepth > MaxNestingDepth;
+}
+
 Parser::Parser(Diagnosis& diagnosis, const Tokens& tokens)
     : _diagnosis(diagnosis)
     , _tokens(tokens)
+    , _endTokenIndex(tokens.size())
+    , _recoveryBudget(RecoveryTokensPerToken * tokens.size())
+{
+}
+
+Parser::Parser(Diagnosis& diagnosis, const Tokens& tokens, std::size_t beginTokenIndex, std::size_t endTokenIndex)
+    : _diagnosis(diagnosis)
+    , _tokens(tokens)
+    , _currentTokenIndex(beginTokenIndex)
+    , _endTokenIndex(endTokenIndex)
+    , _recoveryBudget(RecoveryTokensPerToken * (endTokenIndex - beginTokenIndex))
 {
 }
 
@@ -149,18 +299,322 @@ Parser::Parser(Diagnosis& diagnosis, const Tokens& tokens)
 //          declaration_seq declaration
 TranslationUnit Parser::parse()
 {
-    while (Node node = parseDeclaration())
+    CPPS_TRACE_ZONE("Parser::parse");
+
+    parseDeclarations(_endTokenIndex);
+
+    if (!isEnd())
     {
-        _tu.declarations.add(std::move(node));
+        _diagnosis.skip(Diagnosis::Phase::Parse, {.processedCount = _currentTokenIndex, .skippedCount = _tokens.size() - _currentTokenIndex});
+    }
+
+    return std::move(_tu);
+}
+
+// Each group is parsed alone, in its own translation unit and diagnosis.
+// The groups are merged in order while they start where the previous one ended and parse without error.
+// Otherwise the parse resumes serially from the end of the previous group, on the whole stream and the caller diagnosis,
+// so an error, a declaration crossing a group end or a stop of the diagnosis are handled as by parse().
+TranslationUnit Parser::parse(ThreadPool& pool)
+{
+    CPPS_TRACE_ZONE("Parser::parse(ThreadPool&)");
+
+    const std::size_t groupTokensCount = std::max(MinGroupTokensCount, _tokens.size() / (pool.getThreadsCount() * GroupsPerThread));
+
+    const std::vector<std::size_t> boundaries = splitDeclarations(groupTokensCount);
+
+    const std::size_t groupsCount = boundaries.size() - 1;
+
+    if (groupsCount <= 1)
+    {
+        return parse();
+    }
+
+    struct Group
+    {
+        Diagnosis diagnosis;
+        TranslationUnit tu;
+        bool isComplete{false};
+        std::exception_ptr exception;
+    };
+
+    std::vector<Group> groups(groupsCount);
+
+    std::latch groupsParsed{static_cast<std::ptrdiff_t>(groupsCount)};
+
+    for (std::size_t i = 0; i < groupsCount; ++i)
+    {
+        pool.submit([this, &groups, &groupsParsed, &boundaries, i] {
+            Group& group = groups[i];
+
+            try
+            {
+                Parser parser{group.diagnosis, _tokens, boundaries[i], boundaries[i + 1]};
+
+                group.isComplete = parser.parseDeclarations(boundaries[i + 1]) && group.diagnosis.getErrorsCount() == 0;
+                group.tu = std::move(parser._tu);
+            }
+            catch (...)
+            {
+                group.exception = std::current_exception();
+            }
+
+            groupsParsed.count_down();
+        });
+    }
+
+    groupsParsed.wait();
+
+    for (Group& group : groups)
+    {
+        if (group.exception)
+        {
+            std::rethrow_exception(group.exception);
+        }
+    }
+
+    for (std::size_t i = 0; i < groupsCount && !_diagnosis.shouldStop(); ++i)
+    {
+        Group& group = groups[i];
+
+        if (_currentTokenIndex == boundaries[i] && group.isComplete)
+        {
+            for (const Diagnosis::Entry& warning : group.diagnosis.getWarnings())
+            {
+                _diagnosis.warning(warning);
+            }
+
+            _tu.merge(std::move(group.tu));
+            _currentTokenIndex = boundaries[i + 1];
+
+            continue;
+        }
+
+        // the group is already covered by the serial parse of the previous one
+        if (_currentTokenIndex >= boundaries[i + 1])
+        {
+            continue;
+        }
+
+        Parser parser{_diagnosis, _tokens, _currentTokenIndex, _tokens.size()};
+        parser._recoveryBudget = _recoveryBudget;
+
+        const bool isParsed = parser.parseDeclarations(boundaries[i + 1]);
+
+        _tu.merge(std::move(parser._tu));
+        _currentTokenIndex = parser._currentTokenIndex;
+        _recoveryBudget = parser._recoveryBudget;
+
+        if (!isParsed)
+        {
+            break;
+        }
+    }
+
+    if (!isEnd())
+    {
+        _diagnosis.skip(Diagnosis::Phase::Parse, {.processedCount = _currentTokenIndex, .skippedCount = _tokens.size() - _currentTokenIndex});
     }
 
     return std::move(_tu);
 }
 
+// A top-level declaration ends with ';' or '}' outside of any bracket.
+// A group ends there if the next tokens start a declaration, 'identifier :', so an expression is never split.
+// A declaration starting a line also ends a group, so an unbalanced bracket does not prevent the next groups.
+// The groups are only a guess, the parse of each group checks it.
+std::vector<std::size_t> Parser::splitDeclarations(std::size_t groupTokensCount) const
+{
+    std::vector<std::size_t> boundaries{_currentTokenIndex};
+
+    std::size_t depth = 0;
+
+    for (std::size_t i = _currentTokenIndex; i < _endTokenIndex; ++i)
+    {
+        const Token& token = _tokens.at(i);
+
+        if (!token.lexeme.is<Punctuator>())
+        {
+            continue;
+        }
+
+        const Punctuator punctuator = token.lexeme.get<Punctuator>();
+
+        if (punctuator == Punctuator::OpenBrace || punctuator == Punctuator::OpenBracket || punctuator == Punctuator::OpenParenthesis)
+        {
+            ++depth;
+            continue;
+        }
+
+        if (punctuator == Punctuator::CloseBrace || punctuator == Punctuator::CloseBracket || punctuator == Punctuator::CloseParenthesis)
+        {
+            depth = depth > 0 ? depth - 1 : 0;
+        }
+
+        const bool isDeclarationEnd = punctuator == Punctuator::Semicolon || punctuator == Punctuator::CloseBrace;
+
+        if (!isDeclarationEnd || i + 1 - boundaries.back() < groupTokensCount || i + 2 >= _endTokenIndex)
+        {
+            continue;
+        }
+
+        const Token& next = _tokens.at(i + 1);
+
+        if ((depth == 0 || next.location.column == 0) && next.lexeme.is<CPPS::Identifier>() && _tokens.at(i + 2).lexeme == Punctuator::Colon)
+        {
+            boundaries.push_back(i + 1);
+            depth = 0;
+        }
+    }
+
+    boundaries.push_back(_endTokenIndex);
+
+    return boundaries;
+}
+
+bool Parser::parseDeclarations(std::size_t endTokenIndex)
+{
+    while (_currentTokenIndex < endTokenIndex)
+    {
+        if (_diagnosis.shouldStop())
+        {
+            return false;
+        }
+
+        const std::size_t startTokenIndex = _currentTokenIndex;
+        const std::size_t errorsCount = _diagnosis.getErrorsCount();
+
+        _failedTokenIndex = startTokenIndex;
+        _isNestingTooDeep = false;
+
+        if (Node node = parseDeclaration())
+        {
+            _tu.declarations.add(std::move(node));
+            continue;
+        }
+
+        // some declarations fail without error, e.g. an identifier not followed by ':'
+        if (_diagnosis.getErrorsCount() == errorsCount)
+        {
+            error(DiagnosisMessage::invalidDeclaration(), current().location);
+        }
+
+        if (_diagnosis.shouldStop() || !recover(startTokenIndex, _failedTokenIndex))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Panic mode: the parse resumes after the first ';' or '}' closing the brackets opened since the declaration start,
+// or before the next declaration, 'identifier :' outside of any bracket or starting a line, as in splitDeclarations().
+// A declaration missing its ';' or '}' then only damages itself, and the next ones report their own errors.
+// Each token is scanned once by the skip, but a failed parse may scan beyond the next declaration which is then parsed again,
+// so the work of each failed declaration is taken from the budget.
+bool Parser::recover(std::size_t startTokenIndex, std::size_t failedTokenIndex)
+{
+    std::size_t depth = 0;
+    std::size_t i = startTokenIndex;
+
+    for (; i < _endTokenIndex; ++i)
+    {
+        const Token& token = _tokens.at(i);
+
+        if (i > startTokenIndex && (depth == 0 || token.location.column == 0) && token.lexeme.is<CPPS::Identifier>() && i + 1 < _endTokenIndex &&
+            _tokens.at(i + 1).lexeme == Punctuator::Colon)
+        {
+            break;
+        }
+
+        if (!token.lexeme.is<Punctuator>())
+        {
+            continue;
+        }
+
+        const Punctuator punctuator = token.lexeme.get<Punctuator>();
+
+        if (punctuator == Punctuator::OpenBrace || punctuator == Punctuator::OpenBracket || punctuator == Punctuator::OpenParenthesis)
+        {
+            ++depth;
+            continue;
+        }
+
+        if (punctuator == Punctuator::CloseBrace || punctuator == Punctuator::CloseBracket || punctuator == Punctuator::CloseParenthesis)
+        {
+            depth = depth > 0 ? depth - 1 : 0;
+        }
+
+        if ((punctuator == Punctuator::Semicolon || punctuator == Punctuator::CloseBrace) && depth == 0)
+        {
+            ++i;
+            break;
+        }
+    }
+
+    const std::size_t work = std::max(i, failedTokenIndex) - startTokenIndex;
+
+    if (work > _recoveryBudget)
+    {
+        _diagnosis.error(DiagnosisMessage::recoveryBudgetExceeded(), _tokens.at(startTokenIndex).location);
+
+        _tu.damagedRegions.push_back({.beginLocation = _tokens.at(startTokenIndex).location, .endLocation = _tokens.at(_endTokenIndex - 1).location});
+
+        return false;
+    }
+
+    _recoveryBudget -= work;
+
+    _tu.damagedRegions.push_back({.beginLocation = _tokens.at(startTokenIndex).location, .endLocation = _tokens.at(i - 1).location});
+
+    _currentTokenIndex = i;
+
+    return true;
+}
+
+std::optional<std::size_t> Parser::parseDeclarationsUntil(std::span<const std::size_t> boundaries)
+{
+    std::size_t boundaryIndex = 0;
+
+    while (!isEnd())
+    {
+        while (boundaryIndex < boundaries.size() && boundaries[boundaryIndex] < _currentTokenIndex)
+        {
+            ++boundaryIndex;
+        }
+
+        if (boundaryIndex < boundaries.size() && boundaries[boundaryIndex] == _currentTokenIndex)
+        {
+            return boundaryIndex;
+        }
+
+        if (_diagnosis.shouldStop())
+        {
+            return std::nullopt;
+        }
+
+        _isNestingTooDeep = false;
+
+        Node node = parseDeclaration();
+
+        if (!node)
+        {
+            return std::nullopt;
+        }
+
+        _tu.declarations.add(std::move(node));
+    }
+
+    return boundaries.size();
+}
+
 // declaration:
 //    identifier unnamed-declaration
 Node<Declaration> Parser::parseDeclaration(bool mustEndWithSemicolon)
 {
+    CPPS_TRACE_ZONE("Parser::parseDeclaration");
+
     if (isEnd())
     {
         return {};
@@ -177,6 +631,7 @@ Node<Declaration> Parser::parseDeclaration(bool mustEndWithSemicolon)
         }
         else
         {
+            _failedTokenIndex = std::max(_failedTokenIndex, _currentTokenIndex);
             _currentTokenIndex = startIndex;
         }
     }
@@ -378,6 +833,13 @@ Node<ParameterDeclaration> Parser::parseParameterDeclaration(bool returns)
         }
     }
 
+    const NestingGuard nestingGuard{*this};
+
+    if (nestingGuard.isTooDeep())
+    {
+        return {};
+    }
+
     Node decl = parseDeclaration(false);
 
     if (!decl)
@@ -397,15 +859,22 @@ Node<ParameterDeclaration> Parser::parseParameterDeclaration(bool returns)
 // TODO    try expression
 Node<Expression> Parser::parseExpression(bool allowRelationalComparison)
 {
-    Node<AssignmentExpression> assignment{allocator()};
+    CPPS_TRACE_ZONE("Parser::parseExpression");
 
-    if (!parseAssignmentExpression(*assignment, allowRelationalComparison))
+    const NestingGuard nestingGuard{*this};
+
+    if (nestingGuard.isTooDeep())
     {
         return {};
     }
 
     Node<Expression> expression{allocator()};
-    expression->assignment = std::move(assignment);
+
+    if (!parseBinaryExpression(*expression, Expression::Kind::Assignment, allowRelationalComparison))
+    {
+        return {};
+    }
+
     return expression;
 }
 
@@ -535,8 +1004,7 @@ Node<PostfixExpression> Parser::parsePostfixExpression()
             return {};
         }
 
-        postfix->terms.emplace_back(current());
-        PostfixExpression::Term& term{postfix->terms.back()};
+        PostfixExpression::Term& term{postfix->terms.emplaceBack(allocator(), current())};
 
         next();
 
@@ -544,9 +1012,9 @@ Node<PostfixExpression> Parser::parsePostfixExpression()
                                               Punctuator closeLexeme,
                                               auto errMsgExpressionsNullptrGetter,
                                               auto errMsgNotMatchCloseGetter) {
-            term.expressions = parseExpressionList(term.op.get().location);
+            std::optional<ExpressionList> expressions = parseExpressionList(term.op.get().location);
 
-            if (term.expressions == std::nullopt || (closeLexeme == Punctuator::CloseBracket && term.expressions->empty()))
+            if (expressions == std::nullopt || (closeLexeme == Punctuator::CloseBracket && expressions->empty()))
             {
                 error(errMsgExpressionsNullptrGetter(), term.op.get().location);
                 return false;
@@ -560,8 +1028,8 @@ Node<PostfixExpression> Parser::parsePostfixExpression()
                 return false;
             }
 
-            term.expressions.value().closeParenthesisLocation = closeToken.location;
-            term.closeOp = closeToken;
+            expressions.value().closeParenthesisLocation = closeToken.location;
+            term.arguments = Node<PostfixExpression::Arguments>{allocator(), std::move(expressions.value()), closeToken};
 
             next();
 
@@ -619,6 +1087,7 @@ Node<PrimaryExpression> Parser::parsePrimaryExpression()
                token.lexeme.is<CharacterLiteral>() ||
                token.lexeme.is<DecimalLiteral>() ||
                token.lexeme.is<FloatingLiteral>() ||
+               token.lexeme.is<HexadecimalLiteral>() ||
                token.lexeme.is<CPPS::Identifier>() ||
                token.lexeme.is<Keyword>() ||
                token.lexeme.is<PointerLiteral>() ||
@@ -730,6 +1199,8 @@ Node<IterationStatement> Parser::parseIterationStatement()
 
 Node<FunctionSignature> Parser::parseFunctionSignature()
 {
+    CPPS_TRACE_ZONE("Parser::parseFunctionSignature");
+
     ParameterDeclarationList parameters;
     if (!parseParameterDeclarationList(parameters))
     {
@@ -778,228 +1249,168 @@ Node<FunctionSignature> Parser::parseFunctionSignature()
     return functionSignature;
 }
 
-template<typename BinaryExpressionT, typename... Args>
-bool Parser::parseBinaryExpression(BinaryExpressionT& binaryExpression, auto parseExpressionMethod, auto isValidTokenFunctor, Args... args)
+// assignment-expression:
+//     logical-or-expression
+//     assignment-expression assignment-operator assignment-expression
+// constant-expression:    // don't need intermediate production, just use:
+// conditional-expression: // don't need intermediate production, just use:
+// logical-or-expression:
+//     logical-and-expression
+//     logical-or-expression || logical-and-expression
+// logical-and-expression:
+//     bit-or-expression
+//     logical-and-expression && bit-or-expression
+// bit-or-expression:
+//     bit-xor-expression
+//     bit-or-expression | bit-xor-expression
+// bit-xor-expression:
+//     bit-and-expression
+//     bit-xor-expression ^ bit-and-expression
+// bit-and-expression:
+//     equality-expression
+//     bit-and-expression & equality-expression
+// equality-expression:
+//    relational-expression
+//    equality-expression == relational-expression
+//    equality-expression != relational-expression
+// relational-expression:
+//     compare-expression
+//     relational-expression <  compare-expression
+//     relational-expression >  compare-expression
+//     relational-expression <= compare-expression
+//     relational-expression >= compare-expression
+// compare-expression:
+//    shift-expression
+//    compare-expression <=> shift-expression
+// shift-expression:
+//     additive-expression
+//     shift-expression << additive-expression
+//     shift-expression >> additive-expression
+// additive-expression:
+//     multiplicative-expression
+//     additive-expression + multiplicative-expression
+//     additive-expression - multiplicative-expression
+// multiplicative-expression:
+//     is-as-expression
+//     multiplicative-expression * is-as-expression
+//     multiplicative-expression / is-as-expression
+//     multiplicative-expression % is-as-expression
+// is-as-expression:
+//     basic-expression
+// TODO    is-as-expression is-expression-constraint
+// TODO    is-as-expression as-type-cast
+// TODO    type-id is-type-constraint
+//
+// Precedence climbing: the right operand of an operator only takes the higher precedence operators.
+// The assignments are the lowest precedence, their chain is parsed left to right and folded right to left.
+std::optional<std::uint32_t> Parser::parseBinaryExpression(Expression& expression, Expression::Kind maxKind, bool allowRelationalComparison)
 {
-    if (!(this->*parseExpressionMethod)(binaryExpression, args...))
+    std::optional<std::uint32_t> lhs = parseBasicExpression(expression);
+
+    if (!lhs)
     {
-        return false;
+        return std::nullopt;
     }
 
-    while (isValidTokenFunctor(current()))
+    while (true)
     {
-        // add the token
-        binaryExpression.terms.add(Node<typename BinaryExpressionT::Term>{allocator(), current()});
+        const Expression::Kind kind = getBinaryKind(current(), allowRelationalComparison);
+
+        if (kind == Expression::Kind::Basic || kind > maxKind)
+        {
+            return lhs;
+        }
 
-        // skip the operand
+        if (kind == Expression::Kind::Assignment)
+        {
+            return parseAssignmentChain(expression, *lhs, allowRelationalComparison);
+        }
+
+        const Token& op = current();
+
+        // skip the operator
         next();
 
-        // parse the expression
-        if (!(this->*parseExpressionMethod)(binaryExpression.terms.back(), args...))
+        const auto rhsMaxKind = static_cast<Expression::Kind>(static_cast<std::uint8_t>(kind) - 1);
+
+        const std::optional<std::uint32_t> rhs = parseBinaryExpression(expression, rhsMaxKind, allowRelationalComparison);
+
+        if (!rhs)
         {
-            error(DiagnosisMessage::invalidExpressionAfter(binaryExpression.terms.back().op.get().text));
-            return false;
+            error(DiagnosisMessage::invalidExpressionAfter(op.text));
+            return std::nullopt;
         }
-    }
 
-    return true;
-}
+        const auto index = static_cast<std::uint32_t>(expression.operations.size());
 
-// additive-expression:
-//     multiplicative-expression
-//     additive-expression + multiplicative-expression
-//     additive-expression - multiplicative-expression
-bool Parser::parseAdditiveExpression(AdditiveExpression& expr)
-{
-    return parseBinaryExpression(expr, &Parser::parseMultiplicativeExpression, &anyTokenPunctuator<Punctuator::Plus, Punctuator::Minus>);
+        expression.operations.emplaceBack(allocator(), Expression::Operation{.kind = kind, .lhs = *lhs, .rhs = *rhs, .op = op});
+
+        lhs = index;
+    }
 }
 
-// basic-expression:
-//     prefix-expression primary-expression postfix-expression
-bool Parser::parseBasicExpression(BasicExpression& expr)
+std::optional<std::uint32_t> Parser::parseAssignmentChain(Expression& expression, std::uint32_t lhs, bool allowRelationalComparison)
 {
-    expr.prefix = parsePrefixExpression();
-    expr.primary = parsePrimaryExpression();
+    std::vector<std::pair<std::optional<TokenRef>, std::uint32_t>> chain{{std::nullopt, lhs}};
 
-    if (!expr.primary)
+    while (getBinaryKind(current(), allowRelationalComparison) == Expression::Kind::Assignment)
     {
-        return false;
-    }
+        const Token& op = current();
 
-    expr.postfix = parsePostfixExpression();
+        // skip the operator
+        next();
 
-    return true;
-}
+        const std::optional<std::uint32_t> rhs = parseBinaryExpression(expression, Expression::Kind::LogicalOr, allowRelationalComparison);
 
-// assignment-expression:
-//     logical-or-expression
-//     assignment-expression assignment-operator assignment-expression
-bool Parser::parseAssignmentExpression(AssignmentExpression& expr, bool allowRelationalComparison)
-{
-    // clang-format off
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseLogicalOrExpression,
-        &anyTokenPunctuator<
-            Punctuator::AmpersandEqual,
-            Punctuator::Assignment,
-            Punctuator::CaretEqual,
-            Punctuator::LeftShiftEqual,
-            Punctuator::MinusEqual,
-            Punctuator::ModuloEqual,
-            Punctuator::MultiplyEqual,
-            Punctuator::PipeEqual,
-            Punctuator::PlusEqual,
-            Punctuator::RightShiftEqual,
-            Punctuator::SlashEqual>,
-        allowRelationalComparison);
-    // clang-format on
-}
+        if (!rhs)
+        {
+            error(DiagnosisMessage::invalidExpressionAfter(op.text));
+            return std::nullopt;
+        }
 
-// bit-and-expression:
-//     equality-expression
-//     bit-and-expression & equality-expression
-bool Parser::parseBitAndExpression(BitAndExpression& expr, bool allowRelationalComparison)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseEqualityExpression,
-        &anyTokenPunctuator<Punctuator::Ampersand>,
-        allowRelationalComparison);
-}
+        chain.emplace_back(op, *rhs);
+    }
 
-// bit-or-expression:
-//     bit-xor-expression
-//     bit-or-expression & bit-xor-expression
-bool Parser::parseBitOrExpression(BitOrExpression& expr, bool allowRelationalComparison)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseBitXorExpression,
-        &anyTokenPunctuator<Punctuator::Pipe>,
-        allowRelationalComparison);
-}
+    // a = b = c is a = (b = c)
+    std::uint32_t rhs = chain.back().second;
 
-// bit-xor-expression:
-//     bit-and-expression
-//     bit-xor-expression & bit-and-expression
-bool Parser::parseBitXorExpression(BitXorExpression& expr, bool allowRelationalComparison)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseBitAndExpression,
-        &anyTokenPunctuator<Punctuator::Caret>,
-        allowRelationalComparison);
-}
+    for (std::size_t i = chain.size() - 1; i > 0; --i)
+    {
+        const auto index = static_cast<std::uint32_t>(expression.operations.size());
 
-// compare-expression:
-//    shift-expression
-//    compare-expression <=> shift-expression
-bool Parser::parseCompareExpression(CompareExpression& expr)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseShiftExpression,
-        &anyTokenPunctuator<Punctuator::Spaceship>);
-}
+        expression.operations.emplaceBack(
+            allocator(),
+            Expression::Operation{.kind = Expression::Kind::Assignment, .lhs = chain[i - 1].second, .rhs = rhs, .op = chain[i].first});
 
-// equality-expression:
-//    relational-expression
-//    equality-expression == relational-expression
-//    equality-expression != relational-expression
-bool Parser::parseEqualityExpression(EqualityExpression& expr, bool allowRelationalComparison)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseRelationalExpression,
-        &anyTokenPunctuator<Punctuator::CompareEqual, Punctuator::CompareNotEqual>,
-        allowRelationalComparison);
-}
+        rhs = index;
+    }
 
-// is-as-expression:
-//     basic-expression
-// TODO    is-as-expression is-expression-constraint
-// TODO    is-as-expression as-type-cast
-// TODO    type-id is-type-constraint
-bool Parser::parseIsAsExpression(IsAsExpression& expr)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseBasicExpression,
-        &anyTokenKeyword<Keyword::As, Keyword::Is>);
+    return rhs;
 }
 
-// logical-and-expression:
-//     bit-or-expression
-//     logical-and-expression && bit-or-expression
-bool Parser::parseLogicalAndExpression(LogicalAndExpression& expr, bool allowRelationalComparison)
+// basic-expression:
+//     prefix-expression primary-expression postfix-expression
+std::optional<std::uint32_t> Parser::parseBasicExpression(Expression& expression)
 {
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseBitOrExpression,
-        &anyTokenPunctuator<Punctuator::LogicalAnd>,
-        allowRelationalComparison);
-}
+    const auto basicIndex = static_cast<std::uint32_t>(expression.basics.size());
 
-// constant-expression:    // don't need intermediate production, just use:
-// conditional-expression: // don't need intermediate production, just use:
-// logical-or-expression:
-//     logical-and-expression
-//     logical-or-expression || logical-and-expression
-bool Parser::parseLogicalOrExpression(LogicalOrExpression& expr, bool allowRelationalComparison)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseLogicalAndExpression,
-        &anyTokenPunctuator<Punctuator::LogicalOr>,
-        allowRelationalComparison);
-}
+    BasicExpression& basic = expression.basics.emplaceBack(allocator());
 
-// multiplicative-expression:
-//     is-as-expression
-//     multiplicative-expression * is-as-expression
-//     multiplicative-expression / is-as-expression
-//     multiplicative-expression % is-as-expression
-bool Parser::parseMultiplicativeExpression(MultiplicativeExpression& expr)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseIsAsExpression,
-        &anyTokenPunctuator<Punctuator::Multiply, Punctuator::Slash, Punctuator::Modulo>);
-}
+    basic.prefix = parsePrefixExpression();
+    basic.primary = parsePrimaryExpression();
 
-// relational-expression:
-//     compare-expression
-//     relational-expression <  compare-expression
-//     relational-expression >  compare-expression
-//     relational-expression <= compare-expression
-//     relational-expression >= compare-expression
-bool Parser::parseRelationalExpression(RelationalExpression& expr, bool allowRelationalComparison)
-{
-    if (allowRelationalComparison)
+    if (!basic.primary)
     {
-        return parseBinaryExpression(
-            expr,
-            &Parser::parseCompareExpression,
-            &anyTokenPunctuator<Punctuator::Less, Punctuator::LessEqual, Punctuator::Greater, Punctuator::GreaterEqual>);
+        return std::nullopt;
     }
 
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseCompareExpression,
-        [](const Token&) { return false; });
-}
+    basic.postfix = parsePostfixExpression();
 
-// shift-expression:
-//     additive-expression
-//     shift-expression << additive-expression
-//     shift-expression >> additive-expression
-bool Parser::parseShiftExpression(ShiftExpression& expr)
-{
-    return parseBinaryExpression(
-        expr,
-        &Parser::parseAdditiveExpression,
-        &anyTokenPunctuator<Punctuator::LeftShift, Punctuator::RightShift>);
+    const auto index = static_cast<std::uint32_t>(expression.operations.size());
+
+    expression.operations.emplaceBack(allocator(), Expression::Operation{.kind = Expression::Kind::Basic, .lhs = basicIndex});
+
+    return index;
 }
 
 // statement:
@@ -1015,13 +1426,27 @@ bool Parser::parseShiftExpression(ShiftExpression& expr)
 // TODO     try-block
 Node<Statement> Parser::parseStatement(bool mustEndWithSemicolon, SourceLocation equalLocation)
 {
-    auto makeStatementIfParseSucceed = [this]<typename... ArgsT>(auto parseStatementMethod, ArgsT&&... args) -> Node<Statement> {
+    CPPS_TRACE_ZONE("Parser::parseStatement");
+
+    const NestingGuard nestingGuard{*this};
+
+    if (nestingGuard.isTooDeep())
+    {
+        return {};
+    }
+
+    const std::size_t startIndex = _currentTokenIndex;
+
+    // a failed alternative is undone, the next one starting where it stopped would parse its tokens again
+    auto makeStatementIfParseSucceed = [this, startIndex]<typename... ArgsT>(auto parseStatementMethod, ArgsT&&... args) -> Node<Statement> {
         if (Node stmtType = (this->*parseStatementMethod)(std::forward<ArgsT>(args)...))
         {
             Node<Statement> stmt{allocator()};
             stmt->type = std::move(stmtType);
             return stmt;
         }
+        _failedTokenIndex = std::max(_failedTokenIndex, _currentTokenIndex);
+        _currentTokenIndex = startIndex;
         return {};
     };
 
@@ -1139,13 +1564,13 @@ Node<ReturnStatement> Parser::parseReturnStatement()
 
     if (!expression)
     {
-        _diagnosis.error(DiagnosisMessage::invalidReturnExpression(), current().location);
+        error(DiagnosisMessage::invalidReturnExpression(), current().location);
         return {};
     }
 
     if (current().lexeme != Punctuator::Semicolon)
     {
-        _diagnosis.error(DiagnosisMessage::missingSemicolonAtEndStatement(), current().location);
+        error(DiagnosisMessage::missingSemicolonAtEndStatement(), current().location);
 
         next();
 
@@ -1204,7 +1629,7 @@ Node<UnqualifiedIdentifier> Parser::parseUnqualifiedIdentifier()
 
 bool Parser::isEnd() const
 {
-    return _currentTokenIndex >= _tokens.size();
+    return _currentTokenIndex >= _endTokenIndex;
 }
 
 const Token& Parser::current() const
@@ -1228,13 +1653,19 @@ void Parser::next()
     ++_currentTokenIndex;
 }
 
-void Parser::error(std::string message)
+void Parser::error(Diagnosis::Message message)
 {
     error(std::move(message), isEnd() ? peekBack(1).location : current().location);
 }
 
-void Parser::error(std::string message, SourceLocation location)
+void Parser::error(Diagnosis::Message message, SourceLocation location)
 {
+    // the failures of the enclosing levels only follow from the too deep one
+    if (_isNestingTooDeep)
+    {
+        return;
+    }
+
     _diagnosis.error(std::move(message), location);
 }
 
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 #include "cpps/cst.hpp"
+#include "cpps/diagnosis.hpp"
 
 namespace CPPS {
 
-class Diagnosis;
+class ThreadPool;
 class Tokens;
 
 namespace CST {
@@ -16,33 +22,82 @@ class Parser
 public:
     struct DiagnosisMessage
     {
-        static std::string dotMustFollowedByValidMemberName();
-        static std::string illFormedInitializer();
-        static std::string invalidExpressionAfter(std::string_view token);
-        static std::string invalidReturnExpression();
-        static std::string invalidReturnParameterModifier(ParameterModifier modifier);
-        static std::string invalidStatementInCompoundStatement();
-        static std::string invalidTextInExpressionList();
-        static std::string missingCloseParenthesisForParameterList();
-        static std::string missingCommaBetweenParameterDeclarations();
-        static std::string missingEqualBeforeFunctionBody();
-        static std::string missingFunctionReturnAfterArrow();
-        static std::string missingSemicolonAtEndDeclaration();
-        static std::string missingSemicolonAtEndStatement();
-        static std::string subscriptExpressionBracketEmpty();
-        static std::string unexpectedTextAfterExpressionList();
-        static std::string unexpectedTextAfterOpenParenthesis();
-        static std::string unexpectedTextBracketDoesNotMatch();
-        static std::string unexpectedTextParenthesisDoesNotMatch();
-        static std::string unnamedDeclarationAtExpressionScopeMustBeFunction();
-        static std::string unnamedFunctionAtExpressionScopeCannotReturnsMultipleValues();
+        static Diagnosis::Message dotMustFollowedByValidMemberName();
+        static Diagnosis::Message illFormedInitializer();
+        static Diagnosis::Message invalidDeclaration();
+        static Diagnosis::Message invalidExpressionAfter(std::string_view token);
+        static Diagnosis::Message invalidReturnExpression();
+        static Diagnosis::Message invalidReturnParameterModifier(ParameterModifier modifier);
+        static Diagnosis::Message invalidStatementInCompoundStatement();
+        static Diagnosis::Message invalidTextInExpressionList();
+        static Diagnosis::Message missingCloseParenthesisForParameterList();
+        static Diagnosis::Message missingCommaBetweenParameterDeclarations();
+        static Diagnosis::Message missingEqualBeforeFunctionBody();
+        static Diagnosis::Message missingFunctionReturnAfterArrow();
+        static Diagnosis::Message missingSemicolonAtEndDeclaration();
+        static Diagnosis::Message missingSemicolonAtEndStatement();
+        static Diagnosis::Message nestingTooDeep(std::size_t maxDepth);
+        static Diagnosis::Message recoveryBudgetExceeded();
+        static Diagnosis::Message subscriptExpressionBracketEmpty();
+        static Diagnosis::Message unexpectedTextAfterExpressionList();
+        static Diagnosis::Message unexpectedTextAfterOpenParenthesis();
+        static Diagnosis::Message unexpectedTextBracketDoesNotMatch();
+        static Diagnosis::Message unexpectedTextParenthesisDoesNotMatch();
+        static Diagnosis::Message unnamedDeclarationAtExpressionScopeMustBeFunction();
+        static Diagnosis::Message unnamedFunctionAtExpressionScopeCannotReturnsMultipleValues();
     };
 
+    // the nested expressions, statements and parameter declarations, a deeper one is an error
+    static constexpr std::size_t MaxNestingDepth{256};
+
 public:
     Parser(Diagnosis& diagnosis, const Tokens& tokens);
 
     TranslationUnit parse();
 
+    // parses groups of top-level declarations on the pool workers, the result is identical to parse()
+    // blocks until the groups are parsed, must not be called from a worker of the pool
+    TranslationUnit parse(ThreadPool& pool);
+
+private:
+    friend class IncrementalParser;
+
+    // the tokens [beginTokenIndex, endTokenIndex) are parsed as if they were the whole stream
+    Parser(Diagnosis& diagnosis, const Tokens& tokens, std::size_t beginTokenIndex, std::size_t endTokenIndex);
+
+    // the first token index of each group of top-level declarations, then the tokens count
+    [[nodiscard]] std::vector<std::size_t> splitDeclarations(std::size_t groupTokensCount) const;
+
+    // a declaration which cannot be parsed is skipped by recover()
+    // false if the diagnosis stops the parse or the recovery budget is spent before endTokenIndex
+    bool parseDeclarations(std::size_t endTokenIndex);
+
+    // skips the declaration starting at startTokenIndex which parse failed at failedTokenIndex, and records the damaged region
+    // false if the work of the failed parse and of the skip exceeds the recovery budget, the current token is then unchanged,
+    // an error is reported and the rest of the stream is recorded as damaged
+    bool recover(std::size_t startTokenIndex, std::size_t failedTokenIndex);
+
+    // parses declarations until the current token is one of the sorted boundaries or the end
+    // the index of the reached boundary, boundaries.size() at the end, nullopt if a declaration cannot be parsed
+    std::optional<std::size_t> parseDeclarationsUntil(std::span<const std::size_t> boundaries);
+
+private:
+    // counts a nesting level while alive, the level beyond MaxNestingDepth reports the error and fails the parse
+    class NestingGuard
+    {
+    public:
+        explicit NestingGuard(Parser& parser);
+        ~NestingGuard();
+
+        NestingGuard(const NestingGuard&) = delete;
+        NestingGuard& operator=(const NestingGuard&) = delete;
+
+        [[nodiscard]] bool isTooDeep() const;
+
+    private:
+        Parser& _parser;
+    };
+
 private:
     Node<Declaration> parseDeclaration(bool mustEndWithSemicolon = true);
 
@@ -66,23 +121,10 @@ private:
     Node<IterationStatement> parseIterationStatement();
 
 private:
-    template<typename BinaryExpressionT, typename... Args>
-    bool parseBinaryExpression(BinaryExpressionT& binaryExpression, auto parseExpressionMethod, auto isValidTokenFunctor, Args... args);
-
-    bool parseAssignmentExpression(AssignmentExpression& expr, bool allowRelationalComparison = true);
-    bool parseAdditiveExpression(AdditiveExpression& expr);
-    bool parseBasicExpression(BasicExpression& expr);
-    bool parseBitAndExpression(BitAndExpression& expr, bool allowRelationalComparison = true);
-    bool parseBitOrExpression(BitOrExpression& expr, bool allowRelationalComparison = true);
-    bool parseBitXorExpression(BitXorExpression& expr, bool allowRelationalComparison = true);
-    bool parseCompareExpression(CompareExpression& expr);
-    bool parseEqualityExpression(EqualityExpression& expr, bool allowRelationalComparison = true);
-    bool parseIsAsExpression(IsAsExpression& expr);
-    bool parseLogicalAndExpression(LogicalAndExpression& expr, bool allowRelationalComparison = true);
-    bool parseLogicalOrExpression(LogicalOrExpression& expr, bool allowRelationalComparison = true);
-    bool parseMultiplicativeExpression(MultiplicativeExpression& expr);
-    bool parseRelationalExpression(RelationalExpression& expr, bool allowRelationalComparison = true);
-    bool parseShiftExpression(ShiftExpression& expr);
+    // the index of the root operation of the parsed binary expression, which kind is maxKind or a higher precedence one
+    std::optional<std::uint32_t> parseBinaryExpression(Expression& expression, Expression::Kind maxKind, bool allowRelationalComparison);
+    std::optional<std::uint32_t> parseAssignmentChain(Expression& expression, std::uint32_t lhs, bool allowRelationalComparison);
+    std::optional<std::uint32_t> parseBasicExpression(Expression& expression);
 
 private:
     Node<Statement> parseStatement(bool mustEndWithSemicolon, SourceLocation equalLocation = {});
@@ -103,8 +145,8 @@ private:
     [[nodiscard]] const Token& peekBack(std::size_t offset) const;
     void next();
 
-    void error(std::string message);
-    void error(std::string message, SourceLocation location);
+    void error(Diagnosis::Message message);
+    void error(Diagnosis::Message message, SourceLocation location);
 
     [[nodiscard]] TranslationUnit::Allocator& allocator();
 
@@ -115,6 +157,18 @@ private:
     TranslationUnit _tu;
 
     std::size_t _currentTokenIndex{0};
+    std::size_t _endTokenIndex;
+
+    // where the last failed declaration stopped, before parseDeclaration() rewinds it
+    std::size_t _failedTokenIndex{0};
+
+    // the tokens the failed declarations and their recoveries can still scan, keeps the recovery linear
+    std::size_t _recoveryBudget;
+
+    std::size_t _nestingDepth{0};
+
+    // set by a too deep nesting until the next top-level declaration, the errors of the enclosing levels are not reported
+    bool _isNestingTooDeep{false};
 };
 
 } // namespace CST
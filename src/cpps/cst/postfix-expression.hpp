@@ -1,9 +1,7 @@
 #pragma once
 
-#include <optional>
-#include <vector>
-
 #include "cpps/cst/expression-list.hpp"
+#include "cpps/cst/node-array.hpp"
 #include "cpps/cst/node.hpp"
 #include "cpps/cst/primary-expression.hpp"
 #include "cpps/token-ref.hpp"
@@ -14,29 +12,43 @@ struct IdentifierExpression;
 
 struct PostfixExpression
 {
+    // The expression-list of a [ or ( term, with its closing token
+    struct Arguments
+    {
+        Arguments(ExpressionList&& expressionList, const Token& token);
+
+        ExpressionList expressions;
+
+        TokenRef closeOp;
+    };
+
+    // The operands are out of line, a term is an operator and two pointers
     struct Term
     {
         explicit Term(const Token& token);
 
         TokenRef op;
 
-        // This is used if *_operator is .
+        // This is used if op is .
         Node<IdentifierExpression> identifierExpression;
 
-        // These is used if *_operator is [ or (
-        std::optional<ExpressionList> expressions;
-
-        // This is used if *_operator is [ or (
-        std::optional<TokenRef> closeOp;
+        // This is used if op is [ or (
+        Node<Arguments> arguments;
     };
 
-    std::vector<Term> terms;
+    // Stored in the translation unit allocator
+    NodeArray<Term> terms;
 };
 
+inline PostfixExpression::Arguments::Arguments(ExpressionList&& expressionList, const Token& token)
+    : expressions(std::move(expressionList))
+    , closeOp(token)
+{
+}
+
 inline PostfixExpression::Term::Term(const Token& token)
     : op(token)
 {
-
 }
 
 } // namespace CPPS::CST
@@ -0,0 +1,22 @@
+#include "cpps/cst/translation-unit.hpp"
+
+#include <utility>
+
+#include "cpps/cst.hpp"
+
+namespace CPPS::CST {
+
+TranslationUnit& TranslationUnit::operator=(TranslationUnit&& other)
+{
+    if (this != &other)
+    {
+        declarations = std::move(other.declarations);
+        allocator = std::move(other.allocator);
+        mergedAllocators = std::move(other.mergedAllocators);
+        damagedRegions = std::move(other.damagedRegions);
+    }
+
+    return *this;
+}
+
+} // namespace CPPS::CST
@@ -1,22 +1,100 @@
 #pragma once
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "cpps/cst/declaration-list.hpp"
+#include "cpps/source-location.hpp"
+#include "cpps/utility/allocator-stats.hpp"
 #include "cpps/utility/bump-pointer-allocator.hpp"
 
 namespace CPPS::CST {
 
 struct TranslationUnit
 {
-    using Allocator = BumpPointerAllocator<1024ULL * 50ULL>;
+#if defined(CPPS_ENABLE_ALLOCATOR_STATS)
+    using AllocatorStatsPolicy = AllocatorStats;
+#else
+    using AllocatorStatsPolicy = NoAllocatorStats;
+#endif
+
+    using Allocator = BumpPointerAllocator<1024ULL * 50ULL, HeapBlockPolicy, AllocatorStatsPolicy>;
+
+    // the tokens skipped by the parser after a declaration which cannot be parsed, from the first to the last one
+    struct DamagedRegion
+    {
+        SourceLocation beginLocation;
+        SourceLocation endLocation;
+    };
 
     TranslationUnit() = default;
     TranslationUnit(TranslationUnit&&) = default;
-    TranslationUnit& operator=(TranslationUnit&&) = default;
+
+    // the previous declarations are destroyed before their allocators
+    TranslationUnit& operator=(TranslationUnit&& other);
+
+#if defined(CPPS_ENABLE_ALLOCATOR_STATS)
+    // the stats of allocator and of the merged allocators
+    [[nodiscard]] AllocatorStats getAllocatorStats() const;
+#endif
+
+    // empty if CPPS_ENABLE_ALLOCATOR_STATS is not defined
+    [[nodiscard]] std::string dumpAllocatorStats() const;
+
+    // appends the declarations of other, which allocators are kept alive
+    void merge(TranslationUnit&& other);
 
     // Must stay first to be destroyed last
     Allocator allocator;
 
+    // the allocators of the merged translation units
+    std::vector<Allocator> mergedAllocators;
+
     DeclarationList declarations;
+
+    // in source order, no declaration is parsed from them
+    std::vector<DamagedRegion> damagedRegions;
 };
 
+#if defined(CPPS_ENABLE_ALLOCATOR_STATS)
+inline AllocatorStats TranslationUnit::getAllocatorStats() const
+{
+    AllocatorStats stats = allocator.getStats();
+
+    for (const Allocator& mergedAllocator : mergedAllocators)
+    {
+        stats.add(mergedAllocator.getStats());
+    }
+
+    return stats;
+}
+#endif
+
+inline std::string TranslationUnit::dumpAllocatorStats() const
+{
+#if defined(CPPS_ENABLE_ALLOCATOR_STATS)
+    return getAllocatorStats().dump();
+#else
+    return {};
+#endif
+}
+
+inline void TranslationUnit::merge(TranslationUnit&& other)
+{
+    declarations.append(std::move(other.declarations));
+
+    mergedAllocators.push_back(std::move(other.allocator));
+
+    for (Allocator& mergedAllocator : other.mergedAllocators)
+    {
+        mergedAllocators.push_back(std::move(mergedAllocator));
+    }
+
+    other.mergedAllocators.clear();
+
+    damagedRegions.insert(damagedRegions.end(), other.damagedRegions.begin(), other.damagedRegions.end());
+    other.damagedRegions.clear();
+}
+
 } // namespace CPPS::CST
@@ -0,0 +1,125 @@
+#include "cpps/cst/typed-expression.hpp"
+
+#include <type_traits>
+#include <vector>
+
+#include "cpps/cst.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+template<typename T>
+constexpr Expression::Kind getKind()
+{
+    using Kind = Expression::Kind;
+
+    // clang-format off
+    if constexpr (std::is_same_v<T, BasicExpressionRef>) { return Kind::Basic; }
+    else if constexpr (std::is_same_v<T, IsAsExpression>) { return Kind::IsAs; }
+    else if constexpr (std::is_same_v<T, MultiplicativeExpression>) { return Kind::Multiplicative; }
+    else if constexpr (std::is_same_v<T, AdditiveExpression>) { return Kind::Additive; }
+    else if constexpr (std::is_same_v<T, ShiftExpression>) { return Kind::Shift; }
+    else if constexpr (std::is_same_v<T, CompareExpression>) { return Kind::Compare; }
+    else if constexpr (std::is_same_v<T, RelationalExpression>) { return Kind::Relational; }
+    else if constexpr (std::is_same_v<T, EqualityExpression>) { return Kind::Equality; }
+    else if constexpr (std::is_same_v<T, BitAndExpression>) { return Kind::BitAnd; }
+    else if constexpr (std::is_same_v<T, BitXorExpression>) { return Kind::BitXor; }
+    else if constexpr (std::is_same_v<T, BitOrExpression>) { return Kind::BitOr; }
+    else if constexpr (std::is_same_v<T, LogicalAndExpression>) { return Kind::LogicalAnd; }
+    else if constexpr (std::is_same_v<T, LogicalOrExpression>) { return Kind::LogicalOr; }
+    else { static_assert(std::is_same_v<T, AssignmentExpression>); return Kind::Assignment; }
+    // clang-format on
+}
+
+class TypedExpressionBuilder
+{
+public:
+    TypedExpressionBuilder(TranslationUnit::Allocator& allocator, const Expression& expression);
+
+    // fills the level T of the typed view from operation, which kind is T's or a higher precedence one
+    template<typename T>
+    void build(T& typed, const Expression::Operation& operation);
+
+private:
+    TranslationUnit::Allocator& _allocator;
+    const Expression& _expression;
+};
+
+TypedExpressionBuilder::TypedExpressionBuilder(TranslationUnit::Allocator& allocator, const Expression& expression)
+    : _allocator(allocator)
+    , _expression(expression)
+{
+}
+
+template<typename T>
+void TypedExpressionBuilder::build(T& typed, const Expression::Operation& operation)
+{
+    if constexpr (std::is_same_v<T, BasicExpressionRef>)
+    {
+        typed.basic = &_expression.getBasic(operation);
+    }
+    else
+    {
+        using OperandT = typename T::Operand;
+
+        if (operation.kind != getKind<T>())
+        {
+            build(static_cast<OperandT&>(typed), operation);
+            return;
+        }
+
+        auto addTerm = [this, &typed](const Expression::Operation& op, const Expression::Operation& operand) {
+            typed.terms.add(Node<typename T::Term>{_allocator, op.op->get()});
+            build(static_cast<OperandT&>(typed.terms.back()), operand);
+        };
+
+        if (operation.kind == Expression::Kind::Assignment)
+        {
+            // a = (b = c), the chain is the right spine
+            build(static_cast<OperandT&>(typed), _expression.getLhs(operation));
+
+            const Expression::Operation* current = &operation;
+
+            while (_expression.getRhs(*current).kind == Expression::Kind::Assignment)
+            {
+                const Expression::Operation& rhs = _expression.getRhs(*current);
+
+                addTerm(*current, _expression.getLhs(rhs));
+                current = &rhs;
+            }
+
+            addTerm(*current, _expression.getRhs(*current));
+        }
+        else
+        {
+            // (a - b) - c, the chain is the left spine
+            std::vector<const Expression::Operation*> chain{&operation};
+
+            while (_expression.getLhs(*chain.back()).kind == operation.kind)
+            {
+                chain.push_back(&_expression.getLhs(*chain.back()));
+            }
+
+            build(static_cast<OperandT&>(typed), _expression.getLhs(*chain.back()));
+
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            {
+                addTerm(**it, _expression.getRhs(**it));
+            }
+        }
+    }
+}
+
+} // namespace
+
+Node<AssignmentExpression> makeTypedExpression(TranslationUnit::Allocator& allocator, const Expression& expression)
+{
+    Node<AssignmentExpression> typed{allocator};
+
+    TypedExpressionBuilder{allocator, expression}.build(*typed, expression.getRoot());
+
+    return typed;
+}
+
+} // namespace CPPS::CST
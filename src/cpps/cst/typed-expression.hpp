@@ -0,0 +1,15 @@
+#pragma once
+
+#include "cpps/cst/binary-expression.hpp"
+#include "cpps/cst/expression.hpp"
+#include "cpps/cst/node.hpp"
+#include "cpps/cst/translation-unit.hpp"
+
+namespace CPPS::CST {
+
+// Builds the typed view of expression, one level per precedence, as the consumers written against it expect:
+// the operands of a level are flattened, a - b - c is an AdditiveExpression with the terms - b and - c.
+// The typed view references the basic-expressions of expression, which is unchanged and must outlive it.
+[[nodiscard]] Node<AssignmentExpression> makeTypedExpression(TranslationUnit::Allocator& allocator, const Expression& expression);
+
+} // namespace CPPS::CST
@@ -0,0 +1,485 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+#include "cpps/cst.hpp"
+#include "cpps/utility/arena-stack.hpp"
+#include "cpps/utility/type-list.hpp"
+
+namespace CPPS::CST {
+
+/**
+ * Walks the nodes depth first in source order, with static dispatch: DerivedT is called without virtual call,
+ * and the alternatives of the NodeVariants are dispatched by NodeVariant::visit.
+ *
+ * DerivedT declares the hooks it needs, for any node type T (const T if IsConstT):
+ *  - bool pre(T& node) is called before the children of node, false skips them and post(node)
+ *  - void pre(T& node) is called before the children of node, which are always walked
+ *  - void post(T& node) is called after the children of node
+ * A node without hook is walked through, the hooks can be private with Walker as a friend. A hook declared for a type
+ * which is not one of the Nodes would never be called, as a hook for a non-const node in a ConstWalker: it fails the
+ * static_assert of walk. Two such hooks make the check ambiguous and pass it, as a template hook hides them.
+ *
+ * The basic-expressions of an Expression are walked in source order, the operations between them are not nodes.
+ *
+ * The walk is iterative: the nodes to enter and to leave are frames of an ArenaStack, so the depth of the tree is
+ * not bounded by the native stack. The stack is kept between the walks of a Walker.
+ */
+template<typename DerivedT, bool IsConstT = false>
+class Walker
+{
+public:
+    template<typename T>
+    using NodeT = std::conditional_t<IsConstT, const T, T>;
+
+    // the types of the walked nodes, the tokens are always const
+    using Nodes = TypeList<
+        NodeT<TranslationUnit>,
+        NodeT<Declaration>,
+        NodeT<FunctionSignature>,
+        NodeT<ParameterDeclarationList>,
+        NodeT<ParameterDeclaration>,
+        NodeT<Identifier>,
+        NodeT<IdentifierExpression>,
+        NodeT<QualifiedIdentifier>,
+        NodeT<UnqualifiedIdentifier>,
+        NodeT<Statement>,
+        NodeT<CompoundStatement>,
+        NodeT<ExpressionStatement>,
+        NodeT<IterationStatement>,
+        NodeT<ReturnStatement>,
+        NodeT<SelectionStatement>,
+        NodeT<Expression>,
+        NodeT<ExpressionList>,
+        NodeT<ExpressionTerm>,
+        NodeT<BasicExpression>,
+        NodeT<PrefixExpression>,
+        NodeT<PrimaryExpression>,
+        NodeT<PostfixExpression>,
+        const Token>;
+
+public:
+    // node is a node type or a const Token, a hook may walk another tree
+    template<typename T>
+    void walk(T& node);
+
+    // false if DerivedT declares a hook which none of the Nodes can be passed to
+    static consteval bool hasCallableHooks();
+
+private:
+    // converts to a reference to any type but the Nodes, so only a hook for another type accepts it
+    // the conversion deduces T without const, a non-const hook for a const node is checked by isConstMismatched
+    template<typename NodesT>
+    struct UnwalkedNode;
+
+    template<typename... NodesT>
+    struct UnwalkedNode<TypeList<NodesT...>>
+    {
+        template<typename T>
+        requires(!(std::is_convertible_v<NodesT&, const T&> || ...))
+        operator T&() const; // NOLINT(google-explicit-constructor)
+    };
+
+    // accepted only by a template hook
+    struct UnrelatedNode
+    {
+    };
+
+    // true if a hook takes the const node T as non-const
+    template<typename T>
+    static consteval bool isConstMismatched();
+
+    // a node to enter, or to leave once its children are walked
+    // the step costs an indirect call per frame, predicted as the node types repeat, a switch on a node type tag
+    // with the steps inlined was measured slower by the walkerWalk benchmark
+    struct Frame
+    {
+        const void* node;
+        void (*step)(Walker& walker, const void* node);
+    };
+
+    template<typename T>
+    static void enterStep(Walker& walker, const void* node);
+
+    template<typename T>
+    static void leaveStep(Walker& walker, const void* node);
+
+private:
+    template<typename T>
+    void push(T& node);
+
+    template<typename T>
+    void pushIf(Node<T>& node);
+
+    template<typename T>
+    void pushIf(const Node<T>& node);
+
+    template<typename VariantT>
+    void pushAlternative(VariantT& variant);
+
+    // the children are pushed last to first, so they are walked in source order
+    void pushChildren(NodeT<TranslationUnit>& translationUnit);
+
+    void pushChildren(NodeT<Declaration>& declaration);
+    void pushChildren(NodeT<FunctionSignature>& signature);
+    void pushChildren(NodeT<ParameterDeclarationList>& parameters);
+    void pushChildren(NodeT<ParameterDeclaration>& parameter);
+
+    void pushChildren(NodeT<Identifier>& identifier);
+    void pushChildren(NodeT<IdentifierExpression>& expression);
+    void pushChildren(NodeT<QualifiedIdentifier>& identifier);
+    void pushChildren(NodeT<UnqualifiedIdentifier>& identifier);
+
+    void pushChildren(NodeT<Statement>& statement);
+    void pushChildren(NodeT<CompoundStatement>& statement);
+    void pushChildren(NodeT<ExpressionStatement>& statement);
+    void pushChildren(NodeT<IterationStatement>& statement);
+    void pushChildren(NodeT<ReturnStatement>& statement);
+    void pushChildren(NodeT<SelectionStatement>& statement);
+
+    void pushChildren(NodeT<Expression>& expression);
+    void pushChildren(NodeT<ExpressionList>& expressions);
+    void pushChildren(NodeT<ExpressionTerm>& term);
+
+    void pushChildren(NodeT<BasicExpression>& expression);
+    void pushChildren(NodeT<PrefixExpression>& expression);
+    void pushChildren(NodeT<PrimaryExpression>& expression);
+    void pushChildren(NodeT<PostfixExpression>& expression);
+
+    void pushChildren(const Token& token);
+
+    // false if the children must be skipped
+    template<typename T>
+    bool enter(T& node);
+
+    template<typename T>
+    void leave(T& node);
+
+    DerivedT& derived();
+
+private:
+    ArenaStack<Frame> _stack;
+};
+
+template<typename DerivedT>
+using ConstWalker = Walker<DerivedT, true>;
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+void Walker<DerivedT, IsConstT>::walk(T& node)
+{
+    static_assert(hasCallableHooks(), "a pre or post hook of the walker cannot be called with any walked node");
+
+    const std::size_t baseSize = _stack.size();
+
+    push(static_cast<std::conditional_t<IsConstT, const T, T>&>(node));
+
+    while (_stack.size() > baseSize)
+    {
+        const Frame frame = _stack.pop();
+
+        frame.step(*this, frame.node);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+consteval bool Walker<DerivedT, IsConstT>::hasCallableHooks()
+{
+    using Probe = UnwalkedNode<Nodes>;
+
+    constexpr bool isPreMismatched = requires(DerivedT& derived, Probe& probe, UnrelatedNode& unrelated) {
+        derived.pre(probe);
+        requires !requires { derived.pre(unrelated); };
+    };
+
+    constexpr bool isPostMismatched = requires(DerivedT& derived, Probe& probe, UnrelatedNode& unrelated) {
+        derived.post(probe);
+        requires !requires { derived.post(unrelated); };
+    };
+
+    const bool isConstMismatched = []<typename... NodesT>(TypeList<NodesT...>) {
+        return (Walker::isConstMismatched<NodesT>() || ...);
+    }(Nodes{});
+
+    return !isPreMismatched && !isPostMismatched && !isConstMismatched;
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+consteval bool Walker<DerivedT, IsConstT>::isConstMismatched()
+{
+    using MutableT = std::remove_const_t<T>;
+
+    constexpr bool isPreMismatched = requires(DerivedT& derived, MutableT& mutableNode, T& node) {
+        derived.pre(mutableNode);
+        requires !requires { derived.pre(node); };
+    };
+
+    constexpr bool isPostMismatched = requires(DerivedT& derived, MutableT& mutableNode, T& node) {
+        derived.post(mutableNode);
+        requires !requires { derived.post(node); };
+    };
+
+    return isPreMismatched || isPostMismatched;
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+void Walker<DerivedT, IsConstT>::enterStep(Walker& walker, const void* node)
+{
+    // the node was pushed as a T
+    T& typedNode = *static_cast<T*>(const_cast<void*>(node)); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+
+    if (walker.enter(typedNode))
+    {
+        walker._stack.push({.node = node, .step = &leaveStep<T>});
+        walker.pushChildren(typedNode);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+void Walker<DerivedT, IsConstT>::leaveStep(Walker& walker, const void* node)
+{
+    walker.leave(*static_cast<T*>(const_cast<void*>(node))); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+void Walker<DerivedT, IsConstT>::push(T& node)
+{
+    _stack.push({.node = &node, .step = &enterStep<T>});
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+void Walker<DerivedT, IsConstT>::pushIf(Node<T>& node)
+{
+    if (node)
+    {
+        push(*node);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+void Walker<DerivedT, IsConstT>::pushIf(const Node<T>& node)
+{
+    if (node)
+    {
+        push(*node);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename VariantT>
+void Walker<DerivedT, IsConstT>::pushAlternative(VariantT& variant)
+{
+    variant.visit([this](auto& node) { push(node); });
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<TranslationUnit>& translationUnit)
+{
+    for (std::size_t i = translationUnit.declarations.size(); i-- > 0;)
+    {
+        push(translationUnit.declarations[i]);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<Declaration>& declaration)
+{
+    if (declaration.initializer)
+    {
+        pushIf(*declaration.initializer);
+    }
+
+    pushAlternative(declaration.type);
+    pushIf(declaration.identifier);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<FunctionSignature>& signature)
+{
+    pushAlternative(signature.returns);
+    push(signature.parameters);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<ParameterDeclarationList>& parameters)
+{
+    for (std::size_t i = parameters.size(); i-- > 0;)
+    {
+        push(parameters[i]);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<ParameterDeclaration>& parameter)
+{
+    pushIf(parameter.declaration);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<Identifier>& identifier)
+{
+    pushAlternative(identifier.type);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<IdentifierExpression>& expression)
+{
+    push(expression.identifier);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<QualifiedIdentifier>& identifier)
+{
+    for (std::size_t i = identifier.terms.size(); i-- > 0;)
+    {
+        push(identifier.terms[i].identifier);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<UnqualifiedIdentifier>&)
+{
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<Statement>& statement)
+{
+    pushAlternative(statement.type);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<CompoundStatement>& statement)
+{
+    for (std::size_t i = statement.size(); i-- > 0;)
+    {
+        push(statement[i]);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<ExpressionStatement>& statement)
+{
+    pushIf(statement.expression);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<IterationStatement>&)
+{
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<ReturnStatement>& statement)
+{
+    pushIf(statement.expression);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<SelectionStatement>&)
+{
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<Expression>& expression)
+{
+    for (std::size_t i = expression.basics.size(); i-- > 0;)
+    {
+        push(expression.basics[i]);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<ExpressionList>& expressions)
+{
+    for (std::size_t i = expressions.size(); i-- > 0;)
+    {
+        push(expressions[i]);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<ExpressionTerm>& term)
+{
+    pushIf(term.expression);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<BasicExpression>& expression)
+{
+    pushIf(expression.postfix);
+    pushIf(expression.primary);
+    pushIf(expression.prefix);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<PrefixExpression>&)
+{
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<PrimaryExpression>& expression)
+{
+    pushAlternative(expression.type);
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(NodeT<PostfixExpression>& expression)
+{
+    for (std::size_t i = expression.terms.size(); i-- > 0;)
+    {
+        auto& term = expression.terms[i];
+
+        if (term.arguments)
+        {
+            push(term.arguments->expressions);
+        }
+
+        pushIf(term.identifierExpression);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+void Walker<DerivedT, IsConstT>::pushChildren(const Token&)
+{
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+bool Walker<DerivedT, IsConstT>::enter(T& node)
+{
+    if constexpr (requires(DerivedT& derived) { { derived.pre(node) } -> std::same_as<bool>; })
+    {
+        return derived().pre(node);
+    }
+    else if constexpr (requires(DerivedT& derived) { derived.pre(node); })
+    {
+        derived().pre(node);
+    }
+
+    return true;
+}
+
+template<typename DerivedT, bool IsConstT>
+template<typename T>
+void Walker<DerivedT, IsConstT>::leave(T& node)
+{
+    if constexpr (requires(DerivedT& derived) { derived.post(node); })
+    {
+        derived().post(node);
+    }
+}
+
+template<typename DerivedT, bool IsConstT>
+DerivedT& Walker<DerivedT, IsConstT>::derived()
+{
+    return static_cast<DerivedT&>(*this);
+}
+
+} // namespace CPPS::CST
@@ -0,0 +1,102 @@
+#include "cpps/diagnosis.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+#include <fmt/args.h>
+
+namespace CPPS {
+
+std::string Diagnosis::Message::str() const
+{
+    if (std::holds_alternative<std::monostate>(_arguments[0]))
+    {
+        return _format.empty() ? _text : std::string{_format};
+    }
+
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+
+    for (const Argument& argument : _arguments)
+    {
+        std::visit(
+            [&store](const auto& value) {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(value)>, std::monostate>)
+                {
+                    store.push_back(value);
+                }
+            },
+            argument);
+    }
+
+    return fmt::vformat(_format, store);
+}
+
+void Diagnosis::Message::detach()
+{
+    const bool hasView = std::any_of(_arguments.begin(), _arguments.end(), [](const Argument& argument) { return std::holds_alternative<std::string_view>(argument); });
+
+    if (hasView)
+    {
+        _text = str();
+        _format = {};
+        _arguments = {};
+    }
+}
+
+void Diagnosis::detachMessages()
+{
+    for (Entry& entry : _errors)
+    {
+        entry.message.detach();
+    }
+
+    for (Entry& entry : _warnings)
+    {
+        entry.message.detach();
+    }
+}
+
+bool operator==(const Diagnosis::Message& lhs, const Diagnosis::Message& rhs)
+{
+    return lhs.str() == rhs.str();
+}
+
+std::ostream& operator<<(std::ostream& os, const Diagnosis::Message& value)
+{
+    return os << value.str();
+}
+
+std::string Diagnosis::getSkippedWorkSummary() const
+{
+    std::string summary;
+
+    auto out = std::back_inserter(summary);
+
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+    {
+        if (const std::optional<SkippedWork>& work = _skippedWorks[i])
+        {
+            fmt::format_to(out, "{}\n", formatSkippedWork(static_cast<Phase>(i), *work));
+        }
+    }
+
+    if (_droppedErrorsCount > 0)
+    {
+        fmt::format_to(out, "{} errors not reported (limit is {})\n", _droppedErrorsCount, _errorLimit);
+    }
+
+    return summary;
+}
+
+std::string Diagnosis::formatSkippedWork(Phase phase, SkippedWork work)
+{
+    constexpr std::array<std::string_view, PhaseCount> PhaseNames{"read", "lex", "parse"};
+    constexpr std::array<std::string_view, PhaseCount> PhaseUnits{"bytes", "lines", "tokens"};
+
+    const std::size_t index = static_cast<std::size_t>(phase);
+
+    return fmt::format("{}: stopped after {} {}, {} {} skipped", PhaseNames[index], work.processedCount, PhaseUnits[index], work.skippedCount, PhaseUnits[index]);
+}
+
+} // namespace CPPS
@@ -1,110 +1,316 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <ostream>
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "cpps/source-location.hpp"
 
 namespace CPPS {
 
+inline constexpr std::size_t DiagnosisMessageArgumentsCapacity{2};
+
+// the arguments are kept by value or by view, an owning string would dangle
+template<typename T>
+concept DiagnosisMessageArgument = std::is_integral_v<T> || std::is_same_v<T, std::string_view> || std::is_same_v<T, const char*>;
+
 class Diagnosis
 {
 public:
+    /**
+     * The message text is only built when requested, most callers only need the diagnosis count.
+     *
+     * A message is either a static text, an owned text, or a static fmt format string, checked at compile time, with its arguments.
+     * The string_view arguments are not copied, they must outlive the message (ie point to the Source or a literal).
+     */
+    class Message
+    {
+    public:
+        using Argument = std::variant<std::monostate, char, std::uint64_t, std::string_view>;
+
+    public:
+        template<std::size_t SizeT>
+        constexpr Message(const char (&text)[SizeT]); // NOLINT(google-explicit-constructor, cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+        constexpr Message(std::string text);          // NOLINT(google-explicit-constructor)
+
+        template<DiagnosisMessageArgument... ArgsT>
+        requires(sizeof...(ArgsT) > 0 && sizeof...(ArgsT) <= DiagnosisMessageArgumentsCapacity)
+        constexpr Message(fmt::format_string<ArgsT...> format, ArgsT... args);
+
+        [[nodiscard]] std::string str() const;
+
+        // formats the message if an argument is a string_view, to outlive the viewed text
+        void detach();
+
+        friend bool operator==(const Message& lhs, const Message& rhs);
+
+    private:
+        template<typename T>
+        static constexpr Argument toArgument(T value);
+
+    private:
+        std::string_view _format;
+        std::array<Argument, DiagnosisMessageArgumentsCapacity> _arguments;
+        std::string _text;
+    };
+
     struct Entry
     {
-        std::string message;
+        Message message;
         std::optional<std::string> fixMessage;
         std::optional<SourceLocation> location;
     };
 
+    enum class Phase : std::uint8_t
+    {
+        Read,
+        Lex,
+        Parse
+    };
+
+    static constexpr std::size_t PhaseCount{3};
+
+    // the unit depends on the phase: bytes for Read, lines for Lex and tokens for Parse
+    struct SkippedWork
+    {
+        std::size_t processedCount{0};
+        std::size_t skippedCount{0};
+    };
+
+    static constexpr std::size_t NoErrorLimit{std::numeric_limits<std::size_t>::max()};
+
     constexpr Diagnosis() = default;
 
-    constexpr void error(std::string message);
-    constexpr void error(std::string message, SourceLine line);
-    constexpr void error(std::string message, SourceLocation location);
-    constexpr void error(std::string message, std::string fixMessage);
-    constexpr void error(std::string message, std::string fixMessage, SourceLine line);
-    constexpr void error(std::string message, std::string fixMessage, SourceLocation location);
+    // the errors after the limit are counted but not stored
+    constexpr void setErrorLimit(std::size_t limit);
+    [[nodiscard]] constexpr std::size_t getErrorLimit() const;
+
+    // the phases stop once the error limit is reached, or at the first error without limit
+    constexpr void setFailFast(bool failFast);
+    [[nodiscard]] constexpr bool isFailFast() const;
+
+    // fail-fast counts the errors of all the diagnoses sharing count, see ConcurrentDiagnosis
+    // the count must outlive the diagnosis, nullptr to count only this diagnosis errors
+    constexpr void setSharedErrorsCount(std::atomic<std::size_t>* count);
+
+    [[nodiscard]] constexpr bool shouldStop() const;
+
+    // called by a phase stopped before its end
+    constexpr void skip(Phase phase, SkippedWork work);
+
+    constexpr void error(Message message);
+    constexpr void error(Message message, SourceLine line);
+    constexpr void error(Message message, SourceLocation location);
+    constexpr void error(Message message, std::string fixMessage);
+    constexpr void error(Message message, std::string fixMessage, SourceLine line);
+    constexpr void error(Message message, std::string fixMessage, SourceLocation location);
+    constexpr void error(Entry entry);
 
-    constexpr void warning(std::string message);
-    constexpr void warning(std::string message, SourceLine line);
-    constexpr void warning(std::string message, SourceLocation location);
-    constexpr void warning(std::string message, std::string fixMessage);
-    constexpr void warning(std::string message, std::string fixMessage, SourceLine line);
-    constexpr void warning(std::string message, std::string fixMessage, SourceLocation location);
+    constexpr void warning(Message message);
+    constexpr void warning(Message message, SourceLine line);
+    constexpr void warning(Message message, SourceLocation location);
+    constexpr void warning(Message message, std::string fixMessage);
+    constexpr void warning(Message message, std::string fixMessage, SourceLine line);
+    constexpr void warning(Message message, std::string fixMessage, SourceLocation location);
+    constexpr void warning(Entry entry);
 
     [[nodiscard]] constexpr std::span<const Entry> getErrors() const;
     [[nodiscard]] constexpr std::span<const Entry> getWarnings() const;
 
+    // see Message::detach, must be called before the source is destroyed if the diagnosis outlives it
+    void detachMessages();
+
+    // stored and dropped errors
+    [[nodiscard]] constexpr std::size_t getErrorsCount() const;
+    [[nodiscard]] constexpr std::size_t getDroppedErrorsCount() const;
+
+    [[nodiscard]] constexpr std::optional<SkippedWork> getSkippedWork(Phase phase) const;
+    [[nodiscard]] std::string getSkippedWorkSummary() const;
+
+    // "<phase>: stopped after <processed> <unit>, <skipped> <unit> skipped"
+    [[nodiscard]] static std::string formatSkippedWork(Phase phase, SkippedWork work);
+
+private:
+    constexpr void addError(Entry entry);
+
 private:
     std::vector<Entry> _errors;
     std::vector<Entry> _warnings;
+
+    std::size_t _errorLimit{NoErrorLimit};
+    std::size_t _droppedErrorsCount{0};
+
+    std::array<std::optional<SkippedWork>, PhaseCount> _skippedWorks;
+
+    std::atomic<std::size_t>* _sharedErrorsCount{nullptr};
+
+    bool _isFailFast{false};
 };
 
-constexpr void Diagnosis::error(std::string message)
+template<std::size_t SizeT>
+constexpr Diagnosis::Message::Message(const char (&text)[SizeT]) // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+    : _format(text, SizeT - 1)
+{
+}
+
+constexpr Diagnosis::Message::Message(std::string text)
+    : _text(std::move(text))
 {
-    _errors.push_back(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = std::nullopt});
 }
 
-constexpr void Diagnosis::error(std::string message, SourceLine line)
+template<DiagnosisMessageArgument... ArgsT>
+requires(sizeof...(ArgsT) > 0 && sizeof...(ArgsT) <= DiagnosisMessageArgumentsCapacity)
+constexpr Diagnosis::Message::Message(fmt::format_string<ArgsT...> format, ArgsT... args)
+    : _arguments{toArgument(args)...}
 {
-    _errors.push_back(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = SourceLocation{.line = line, .column = InvalidSourceColumn}});
+    const fmt::string_view checkedFormat = format;
+
+    _format = {checkedFormat.data(), checkedFormat.size()};
+}
+
+template<typename T>
+constexpr Diagnosis::Message::Argument Diagnosis::Message::toArgument(T value)
+{
+    if constexpr (std::is_same_v<T, char>)
+    {
+        return value;
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        return Argument{std::in_place_type<std::uint64_t>, value};
+    }
+    else
+    {
+        return std::string_view{value};
+    }
 }
 
-constexpr void Diagnosis::error(std::string message, SourceLocation location)
+constexpr void Diagnosis::setErrorLimit(std::size_t limit)
 {
-    _errors.push_back(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = location});
+    _errorLimit = limit;
 }
 
-constexpr void Diagnosis::error(std::string message, std::string fixMessage)
+constexpr std::size_t Diagnosis::getErrorLimit() const
 {
-    _errors.push_back(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = std::nullopt});
+    return _errorLimit;
 }
 
-constexpr void Diagnosis::error(std::string message, std::string fixMessage, SourceLine line)
+constexpr void Diagnosis::setFailFast(bool failFast)
 {
-    _errors.push_back(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = SourceLocation{.line = line, .column = InvalidSourceColumn}});
+    _isFailFast = failFast;
 }
 
-constexpr void Diagnosis::error(std::string message, std::string fixMessage, SourceLocation location)
+constexpr bool Diagnosis::isFailFast() const
 {
-    _errors.push_back(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = location});
+    return _isFailFast;
 }
 
-constexpr void Diagnosis::warning(std::string message)
+constexpr void Diagnosis::setSharedErrorsCount(std::atomic<std::size_t>* count)
+{
+    _sharedErrorsCount = count;
+}
+
+constexpr bool Diagnosis::shouldStop() const
+{
+    if (!_isFailFast)
+    {
+        return false;
+    }
+
+    const std::size_t stopCount = _errorLimit == NoErrorLimit ? 1 : std::max(_errorLimit, std::size_t{1});
+    const std::size_t errorsCount = _sharedErrorsCount != nullptr ? _sharedErrorsCount->load(std::memory_order_relaxed) : getErrorsCount();
+
+    return errorsCount >= stopCount;
+}
+
+constexpr void Diagnosis::skip(Phase phase, SkippedWork work)
+{
+    _skippedWorks[static_cast<std::size_t>(phase)] = work;
+}
+
+constexpr void Diagnosis::error(Message message)
+{
+    addError(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = std::nullopt});
+}
+
+constexpr void Diagnosis::error(Message message, SourceLine line)
+{
+    addError(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = SourceLocation{.line = line, .column = InvalidSourceColumn}});
+}
+
+constexpr void Diagnosis::error(Message message, SourceLocation location)
+{
+    addError(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = location});
+}
+
+constexpr void Diagnosis::error(Message message, std::string fixMessage)
+{
+    addError(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = std::nullopt});
+}
+
+constexpr void Diagnosis::error(Message message, std::string fixMessage, SourceLine line)
+{
+    addError(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = SourceLocation{.line = line, .column = InvalidSourceColumn}});
+}
+
+constexpr void Diagnosis::error(Message message, std::string fixMessage, SourceLocation location)
+{
+    addError(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = location});
+}
+
+constexpr void Diagnosis::error(Entry entry)
+{
+    addError(std::move(entry));
+}
+
+constexpr void Diagnosis::warning(Message message)
 {
     _warnings.push_back(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = std::nullopt});
 }
 
-constexpr void Diagnosis::warning(std::string message, SourceLine line)
+constexpr void Diagnosis::warning(Message message, SourceLine line)
 {
     _warnings.push_back(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = SourceLocation{.line = line, .column = InvalidSourceColumn}});
 }
 
-constexpr void Diagnosis::warning(std::string message, SourceLocation location)
+constexpr void Diagnosis::warning(Message message, SourceLocation location)
 {
     _warnings.push_back(Entry{.message = std::move(message), .fixMessage = std::nullopt, .location = location});
 }
 
-constexpr void Diagnosis::warning(std::string message, std::string fixMessage)
+constexpr void Diagnosis::warning(Message message, std::string fixMessage)
 {
     _warnings.push_back(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = std::nullopt});
 }
 
-constexpr void Diagnosis::warning(std::string message, std::string fixMessage, SourceLine line)
+constexpr void Diagnosis::warning(Message message, std::string fixMessage, SourceLine line)
 {
     _warnings.push_back(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = SourceLocation{.line = line, .column = InvalidSourceColumn}});
 }
 
-constexpr void Diagnosis::warning(std::string message, std::string fixMessage, SourceLocation location)
+constexpr void Diagnosis::warning(Message message, std::string fixMessage, SourceLocation location)
 {
     _warnings.push_back(Entry{.message = std::move(message), .fixMessage = std::move(fixMessage), .location = location});
 }
 
+constexpr void Diagnosis::warning(Entry entry)
+{
+    _warnings.push_back(std::move(entry));
+}
+
 constexpr std::span<const Diagnosis::Entry> Diagnosis::getErrors() const
 {
     return _errors;
@@ -115,4 +321,48 @@ constexpr std::span<const Diagnosis::Entry> Diagnosis::getWarnings() const
     return _warnings;
 }
 
+constexpr std::size_t Diagnosis::getErrorsCount() const
+{
+    return _errors.size() + _droppedErrorsCount;
+}
+
+constexpr std::size_t Diagnosis::getDroppedErrorsCount() const
+{
+    return _droppedErrorsCount;
+}
+
+constexpr std::optional<Diagnosis::SkippedWork> Diagnosis::getSkippedWork(Phase phase) const
+{
+    return _skippedWorks[static_cast<std::size_t>(phase)];
+}
+
+constexpr void Diagnosis::addError(Entry entry)
+{
+    if (_sharedErrorsCount != nullptr)
+    {
+        _sharedErrorsCount->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (_errors.size() < _errorLimit)
+    {
+        _errors.push_back(std::move(entry));
+    }
+    else
+    {
+        ++_droppedErrorsCount;
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, const Diagnosis::Message& value);
+
 } // namespace CPPS
+
+template<>
+struct fmt::formatter<CPPS::Diagnosis::Message> : formatter<std::string>
+{
+    template<typename FormatContext>
+    auto format(const CPPS::Diagnosis::Message& message, FormatContext& ctx) const
+    {
+        return formatter<std::string>::format(message.str(), ctx);
+    }
+};
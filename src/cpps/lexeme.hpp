@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <ostream>
 #include <string>
+#include <type_traits>
 
 #include <fmt/format.h>
 
@@ -65,7 +67,18 @@ public:
     template<Lexemable T>
     constexpr void set(T value);
 
+    // the encoded type and value, for the serialization
+    [[nodiscard]] constexpr std::uint16_t getData() const;
+    [[nodiscard]] static constexpr Lexeme fromData(std::uint16_t data);
+
+    // true if data encodes a value of one of the LexemeTypes or the invalid lexeme, to check deserialized data
+    [[nodiscard]] static constexpr bool isData(std::uint16_t data);
+
 private:
+    // the literals and the identifiers have a single value
+    template<Lexemable T>
+    static constexpr std::size_t getValuesCount();
+
     using Data = std::uint16_t;
 
     static constexpr Data DataTypeMask = 0x00FF;
@@ -113,6 +126,66 @@ constexpr void Lexeme::set(T value)
     _data = static_cast<Data>(IndexOfFromTypeListV<T, LexemeTypes>) | static_cast<Data>(static_cast<Data>(value) << 8u);
 }
 
+constexpr std::uint16_t Lexeme::getData() const
+{
+    return _data;
+}
+
+constexpr Lexeme Lexeme::fromData(std::uint16_t data)
+{
+    Lexeme lexeme;
+    lexeme._data = data;
+    return lexeme;
+}
+
+constexpr bool Lexeme::isData(std::uint16_t data)
+{
+    if (data == InvalidData)
+    {
+        return true;
+    }
+
+    const std::size_t type = data & DataTypeMask;
+    const std::size_t value = static_cast<std::size_t>((data & DataTypeValueMask) >> 8u);
+
+    return [type, value]<typename... TypesT>(TypeList<TypesT...>) {
+        return ((type == IndexOfFromTypeListV<TypesT, LexemeTypes> && value < getValuesCount<TypesT>()) || ...);
+    }(LexemeTypes{});
+}
+
+template<Lexemable T>
+constexpr std::size_t Lexeme::getValuesCount()
+{
+    if constexpr (std::is_same_v<T, BooleanLiteral>)
+    {
+        return BooleanLiteralCount;
+    }
+    else if constexpr (std::is_same_v<T, FunctionModifier>)
+    {
+        return FunctionModifierCount;
+    }
+    else if constexpr (std::is_same_v<T, Keyword>)
+    {
+        return KeywordCount;
+    }
+    else if constexpr (std::is_same_v<T, ParameterModifier>)
+    {
+        return ParameterModifierCount;
+    }
+    else if constexpr (std::is_same_v<T, PointerLiteral>)
+    {
+        return PointerLiteralCount;
+    }
+    else if constexpr (std::is_same_v<T, Punctuator>)
+    {
+        return PunctuatorCount;
+    }
+    else
+    {
+        return 1;
+    }
+}
+
 } // namespace CPPS
 
 template<>
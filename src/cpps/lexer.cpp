@@ -2,56 +2,55 @@
 
 #include <utility>
 
-#include <fmt/format.h>
-
 #include "cpps/diagnosis.hpp"
 #include "cpps/source.hpp"
 #include "cpps/tokens.hpp"
+#include "cpps/utility/trace.hpp"
 
 namespace CPPS {
 
 constexpr std::size_t SmallUniversalCharacterNameLength{4};
 constexpr std::size_t BigUniversalCharacterNameLength{8};
 
-std::string Lexer::DiagnosisMessage::binaryLiteralInvalidFormat()
+Diagnosis::Message Lexer::DiagnosisMessage::binaryLiteralInvalidFormat()
 {
     return "binary literal cannot be empty, 0b (or 0B) must be followed by binary digits";
 }
 
-std::string Lexer::DiagnosisMessage::characterLiteralEmpty()
+Diagnosis::Message Lexer::DiagnosisMessage::characterLiteralEmpty()
 {
     return "empty character constant";
 }
 
-std::string Lexer::DiagnosisMessage::characterLiteralMissingClosingQuote()
+Diagnosis::Message Lexer::DiagnosisMessage::characterLiteralMissingClosingQuote()
 {
     return "character literal {} is missing its closing";
 }
 
-std::string Lexer::DiagnosisMessage::floatingLiteralInvalidFormat(std::string_view text)
+Diagnosis::Message Lexer::DiagnosisMessage::floatingLiteralInvalidFormat(std::string_view text)
 {
-    return fmt::format("floating point literal {} fractional part cannot be empty (if floating point was intended, use .0)", text);
+    return {"floating point literal {} fractional part cannot be empty (if floating point was intended, use .0)", text};
 }
 
-std::string Lexer::DiagnosisMessage::hexadecimalLiteralInvalidFormat()
+Diagnosis::Message Lexer::DiagnosisMessage::hexadecimalLiteralInvalidFormat()
 {
     return "hexadecimal literal cannot be empty, 0x (or 0X) must be followed by hexadecimal digits";
 }
 
-std::string Lexer::DiagnosisMessage::stringLiteralMissingClosingQuote()
+Diagnosis::Message Lexer::DiagnosisMessage::stringLiteralMissingClosingQuote()
 {
     return "string literal {} is missing its closing";
 }
 
-std::string Lexer::DiagnosisMessage::unexpectedCharacter(char c)
+Diagnosis::Message Lexer::DiagnosisMessage::unexpectedCharacter(char c)
 {
-    return fmt::format("unexpected text '{}'", c);
+    return {"unexpected text '{}'", c};
 }
 
-std::string Lexer::DiagnosisMessage::universalCharacterNameInvalidFormat(char c)
+Diagnosis::Message Lexer::DiagnosisMessage::universalCharacterNameInvalidFormat(char c)
 {
     assert(c == 'u' || c == 'U');
-    return fmt::format("invalid universal character name (\\{} must be followed by {} hexadecimal digits)", c, c == 'u' ? SmallUniversalCharacterNameLength : BigUniversalCharacterNameLength);
+    return {"invalid universal character name (\\{} must be followed by {} hexadecimal digits)", c, c == 'u' ? SmallUniversalCharacterNameLength : BigUniversalCharacterNameLength};
 }
 
 Lexer::Lexer(Diagnosis& diagnosis, const Source& source)
@@ -62,12 +61,47 @@ Lexer::Lexer(Diagnosis& diagnosis, const Source& source)
 
 Tokens Lexer::lex()
 {
+    CPPS_TRACE_ZONE("Lexer::lex");
+
     if (!_source.hasCpps())
     {
         return {};
     }
 
-    for (_currentLineIndex = 0; _currentLineIndex < _source.size(); ++_currentLineIndex)
+    lexLines(0, _source.size());
+
+    if (_currentLineIndex < _source.size())
+    {
+        _diagnosis.skip(Diagnosis::Phase::Lex, {.processedCount = _currentLineIndex, .skippedCount = _source.size() - _currentLineIndex});
+
+        return Tokens{std::move(_tokens), std::move(_comments)};
+    }
+
+    assert(!_isInComment);
+
+    return Tokens{std::move(_tokens), std::move(_comments)};
+}
+
+bool Lexer::lex(SourceLine beginLine, SourceLine endLine, std::vector<Token>& tokens, std::vector<Comment>& comments)
+{
+    CPPS_TRACE_ZONE("Lexer::lex(SourceLine, SourceLine)");
+
+    assert(beginLine <= endLine && endLine <= _source.size());
+
+    _tokens = std::move(tokens);
+    _comments = std::move(comments);
+
+    lexLines(beginLine, endLine);
+
+    tokens = std::move(_tokens);
+    comments = std::move(_comments);
+
+    return _currentLineIndex == endLine && !_isInComment;
+}
+
+void Lexer::lexLines(SourceLine beginLine, SourceLine endLine)
+{
+    for (_currentLineIndex = beginLine; _currentLineIndex < endLine && !_diagnosis.shouldStop(); ++_currentLineIndex)
     {
         const Source::Line& line = _source[static_cast<SourceLine>(_currentLineIndex)];
 
@@ -81,10 +115,6 @@ Tokens Lexer::lex()
             lexLine();
         }
     }
-
-    assert(!_isInComment);
-
-    return Tokens{std::move(_tokens), std::move(_comments)};
 }
 
 void Lexer::lexLine()
@@ -477,9 +507,12 @@ bool Lexer::tryLexCharacterLiteral()
 
 // floating-point-literal   { ' | digit }* . { ' | digit }*
 // integer-literal
-//   binary-literal         { ' | binary-digit }*
-//   decimal-literal        { ' | digit }*
-//   hexadecimal-literal    { ' | hexadecimal-digit }*
+//   binary-literal         { ' | binary-digit }* integer-suffix-opt
+//   decimal-literal        { ' | digit }* integer-suffix-opt
+//   hexadecimal-literal    { ' | hexadecimal-digit }* integer-suffix-opt
+// integer-suffix
+//   { u | U } { l | L | ll | LL }-opt
+//   { l | L | ll | LL } { u | U }-opt
 bool Lexer::tryLexNumberLiteral()
 {
     auto findFirstNotLiteral = [this](auto predicate, std::size_t offset) {
@@ -491,6 +524,39 @@ bool Lexer::tryLexNumberLiteral()
         return (index != std::string_view::npos ? index : _currentLine.size()) - _currentColumnIndex;
     };
 
+    // the offset after the integer-suffix, unchanged if there is none
+    auto findIntegerSuffixEnd = [this](std::size_t offset) {
+        auto isUnsignedSuffix = [](char c) { return c == 'u' || c == 'U'; };
+
+        auto skipLongSuffix = [this](std::size_t index) {
+            if (peek(index) != 'l' && peek(index) != 'L')
+            {
+                return index;
+            }
+
+            return peek(index + 1) == peek(index) ? index + 2 : index + 1;
+        };
+
+        std::size_t end = offset;
+
+        if (isUnsignedSuffix(peek(end)))
+        {
+            end = skipLongSuffix(end + 1);
+        }
+        else
+        {
+            end = skipLongSuffix(end);
+
+            if (end != offset && isUnsignedSuffix(peek(end)))
+            {
+                ++end;
+            }
+        }
+
+        // followed by an identifier, a user-defined-literal is not supported
+        return isAlphanumeric(peek(end)) || peek(end) == '_' ? offset : end;
+    };
+
     // could be 0b.. or 0x..
     if (current() == '0')
     {
@@ -500,7 +566,7 @@ bool Lexer::tryLexNumberLiteral()
         case 'B':
             if (isBinaryDigit(peek(2)))
             {
-                addToken(findFirstNotLiteral(isBinaryDigit, 3), Lexeme{BinaryLiteral{}});
+                addToken(findIntegerSuffixEnd(findFirstNotLiteral(isBinaryDigit, 3)), Lexeme{BinaryLiteral{}});
             }
             else
             {
@@ -513,7 +579,7 @@ bool Lexer::tryLexNumberLiteral()
         case 'X':
             if (isHexadecimalDigit(peek(2)))
             {
-                addToken(findFirstNotLiteral(isHexadecimalDigit, 3), Lexeme{HexadecimalLiteral{}});
+                addToken(findIntegerSuffixEnd(findFirstNotLiteral(isHexadecimalDigit, 3)), Lexeme{HexadecimalLiteral{}});
             }
             else
             {
@@ -533,7 +599,7 @@ bool Lexer::tryLexNumberLiteral()
 
     if (peek(offset) != '.')
     {
-        addToken(offset, Lexeme{DecimalLiteral{}});
+        addToken(findIntegerSuffixEnd(offset), Lexeme{DecimalLiteral{}});
     }
     else
     {
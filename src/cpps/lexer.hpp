@@ -4,11 +4,11 @@
 #include <vector>
 
 #include "cpps/comment.hpp"
+#include "cpps/diagnosis.hpp"
 #include "cpps/token.hpp"
 
 namespace CPPS {
 
-class Diagnosis;
 class Source;
 class Tokens;
 
@@ -19,14 +19,14 @@ class Lexer
 public:
     struct DiagnosisMessage
     {
-        static std::string binaryLiteralInvalidFormat();
-        static std::string characterLiteralEmpty();
-        static std::string characterLiteralMissingClosingQuote();
-        static std::string floatingLiteralInvalidFormat(std::string_view text);
-        static std::string hexadecimalLiteralInvalidFormat();
-        static std::string stringLiteralMissingClosingQuote();
-        static std::string unexpectedCharacter(char c);
-        static std::string universalCharacterNameInvalidFormat(char c);
+        static Diagnosis::Message binaryLiteralInvalidFormat();
+        static Diagnosis::Message characterLiteralEmpty();
+        static Diagnosis::Message characterLiteralMissingClosingQuote();
+        static Diagnosis::Message floatingLiteralInvalidFormat(std::string_view text);
+        static Diagnosis::Message hexadecimalLiteralInvalidFormat();
+        static Diagnosis::Message stringLiteralMissingClosingQuote();
+        static Diagnosis::Message unexpectedCharacter(char c);
+        static Diagnosis::Message universalCharacterNameInvalidFormat(char c);
     };
 
 public:
@@ -34,7 +34,12 @@ public:
 
     [[nodiscard]] Tokens lex();
 
+    // lexes the lines [beginLine, endLine) only, starting outside of a comment, and appends their tokens and comments
+    // false if the lines end inside a comment or the diagnosis stops the lex, the next lines would not be lexed as before
+    [[nodiscard]] bool lex(SourceLine beginLine, SourceLine endLine, std::vector<Token>& tokens, std::vector<Comment>& comments);
+
 private:
+    void lexLines(SourceLine beginLine, SourceLine endLine);
     void lexLine();
 
     void lexInComment();
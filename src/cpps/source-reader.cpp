@@ -7,6 +7,7 @@
 
 #include "cpps/diagnosis.hpp"
 #include "cpps/grammar/identifier.hpp"
+#include "cpps/utility/trace.hpp"
 
 namespace CPPS {
 
@@ -36,27 +37,27 @@ thread_local std::array<char, SourceReader::BufferCapacity> Buffer{'\0'};
 
 } // namespace Details
 
-std::string SourceReader::DiagnosisMessage::endNotFound()
+Diagnosis::Message SourceReader::DiagnosisMessage::endNotFound()
 {
     return "source end not found";
 }
 
-std::string SourceReader::DiagnosisMessage::lineTooLong()
+Diagnosis::Message SourceReader::DiagnosisMessage::lineTooLong()
 {
-    return fmt::format("source line is too long (maximum length is {})", Details::Buffer.size());
+    return {"source line is too long (maximum length is {})", Details::Buffer.size()};
 }
 
-std::string SourceReader::DiagnosisMessage::unexpectedCloseBrace()
+Diagnosis::Message SourceReader::DiagnosisMessage::unexpectedCloseBrace()
 {
     return "unexpected }";
 }
 
-std::string SourceReader::DiagnosisMessage::unexpectedCharAfterCppsDefinition(char c)
+Diagnosis::Message SourceReader::DiagnosisMessage::unexpectedCharAfterCppsDefinition(char c)
 {
-    return fmt::format("unexpected char '{}'- after CPPS definition closing ; or }}", c);
+    return {"unexpected char '{}'- after CPPS definition closing ; or }}", c};
 }
 
-std::string SourceReader::DiagnosisMessage::unreadableLine()
+Diagnosis::Message SourceReader::DiagnosisMessage::unreadableLine()
 {
     return "source line is unreadable";
 }
@@ -69,7 +70,9 @@ SourceReader::SourceReader(Diagnosis& diagnosis, Stream& stream)
 
 std::optional<Source> SourceReader::read()
 {
-    while (nextLine())
+    CPPS_TRACE_ZONE("SourceReader::read");
+
+    while (!_diagnosis.shouldStop() && nextLine())
     {
         const bool succeeded = readAsEmpty() || readAsPreprocessor() || readAsCpps() || readAsImport() || readAsCommentOrCpp();
 
@@ -80,6 +83,12 @@ std::optional<Source> SourceReader::read()
         }
     }
 
+    if (_diagnosis.shouldStop())
+    {
+        skipRemainingBytes();
+        return std::nullopt;
+    }
+
     const std::size_t previousLineSize = static_cast<std::size_t>(_stream.gcount());
 
     if (previousLineSize >= Details::Buffer.size() - 1U)
@@ -97,6 +106,26 @@ std::optional<Source> SourceReader::read()
     return std::move(_source);
 }
 
+void SourceReader::skipRemainingBytes()
+{
+    // the stream may not be seekable, then the skipped bytes are unknown
+    const std::streamoff position = _stream.tellg();
+
+    _stream.seekg(0, std::ios::end);
+
+    const std::streamoff end = _stream.tellg();
+
+    Diagnosis::SkippedWork work;
+
+    if (position >= 0)
+    {
+        work.processedCount = static_cast<std::size_t>(position);
+        work.skippedCount = end > position ? static_cast<std::size_t>(end - position) : 0;
+    }
+
+    _diagnosis.skip(Diagnosis::Phase::Read, work);
+}
+
 bool SourceReader::nextLine()
 {
     if (_stream.getline(Details::Buffer.data(), static_cast<std::streamsize>(Details::Buffer.size())))
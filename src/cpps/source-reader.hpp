@@ -6,13 +6,12 @@
 #include <string_view>
 #include <vector>
 
+#include "cpps/diagnosis.hpp"
 #include "cpps/source-location.hpp"
 #include "cpps/source.hpp"
 
 namespace CPPS {
 
-class Diagnosis;
-
 class SourceReader
 {
 public:
@@ -20,11 +19,11 @@ public:
 
     struct DiagnosisMessage
     {
-        static std::string endNotFound();
-        static std::string lineTooLong();
-        static std::string unexpectedCloseBrace();
-        static std::string unexpectedCharAfterCppsDefinition(char c);
-        static std::string unreadableLine();
+        static Diagnosis::Message endNotFound();
+        static Diagnosis::Message lineTooLong();
+        static Diagnosis::Message unexpectedCloseBrace();
+        static Diagnosis::Message unexpectedCharAfterCppsDefinition(char c);
+        static Diagnosis::Message unreadableLine();
     };
 
     static constexpr std::size_t BufferCapacity{90ULL * 1024ULL};
@@ -32,10 +31,12 @@ public:
 public:
     SourceReader(Diagnosis& diagnosis, Stream& stream);
 
+    // nullopt if the source is invalid or if the diagnosis requests to stop
     std::optional<Source> read();
 
 private:
     bool nextLine();
+    void skipRemainingBytes();
 
     bool readAsEmpty();
     bool readAsPreprocessor();
@@ -38,6 +38,9 @@ public:
 
     [[nodiscard]] constexpr std::span<const Comment> comments() const;
 
+    // moves the tokens out and leaves this empty, their memory is kept to edit them in place
+    [[nodiscard]] constexpr std::vector<Token> release();
+
 private:
     static constexpr std::size_t InvalidIndex{std::numeric_limits<std::size_t>::max()};
 
@@ -143,4 +146,13 @@ constexpr std::span<const Comment> Tokens::comments() const
     return _comments;
 }
 
+constexpr std::vector<Token> Tokens::release()
+{
+    _sparse.clear();
+    _dense.clear();
+    _comments.clear();
+
+    return std::exchange(_tokens, {});
+}
+
 } // namespace CPPS
@@ -0,0 +1,35 @@
+#include "cpps/utility/allocation-counter.hpp"
+
+#include <new>
+
+namespace CPPS {
+
+namespace {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local AllocationCount ThreadCount;
+
+} // namespace
+
+void AllocationCounter::onAllocate(std::size_t size) noexcept
+{
+    ++ThreadCount.count;
+    ThreadCount.bytesCount += size;
+}
+
+AllocationCount AllocationCounter::getThreadCount() noexcept
+{
+    return ThreadCount;
+}
+
+bool AllocationCounter::isHooked() noexcept
+{
+    const std::size_t count = ThreadCount.count;
+
+    // unlike a new-expression, a direct call cannot be elided
+    ::operator delete(::operator new(1));
+
+    return ThreadCount.count != count;
+}
+
+} // namespace CPPS
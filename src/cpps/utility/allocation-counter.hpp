@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CPPS {
+
+struct AllocationCount
+{
+    std::size_t count{0};
+    std::size_t bytesCount{0};
+
+    constexpr AllocationCount& operator+=(const AllocationCount& other);
+
+    constexpr friend AllocationCount operator-(const AllocationCount& lhs, const AllocationCount& rhs);
+    constexpr friend bool operator==(const AllocationCount& lhs, const AllocationCount& rhs) = default;
+};
+
+/**
+ * Counts the heap allocations of the calling thread.
+ *
+ * The counter is fed by the global operator new replacement of allocation-hooks.cpp,
+ * an executable wanting the counts must compile that file, the counts stay zero otherwise.
+ */
+class AllocationCounter
+{
+public:
+    static void onAllocate(std::size_t size) noexcept;
+
+    [[nodiscard]] static AllocationCount getThreadCount() noexcept;
+
+    // false if allocation-hooks.cpp is not linked in the executable
+    [[nodiscard]] static bool isHooked() noexcept;
+};
+
+// the allocations of the calling thread since the construction
+class ScopedAllocationCount
+{
+public:
+    [[nodiscard]] AllocationCount get() const noexcept;
+
+private:
+    AllocationCount _start{AllocationCounter::getThreadCount()};
+};
+
+constexpr AllocationCount& AllocationCount::operator+=(const AllocationCount& other)
+{
+    count += other.count;
+    bytesCount += other.bytesCount;
+    return *this;
+}
+
+constexpr AllocationCount operator-(const AllocationCount& lhs, const AllocationCount& rhs)
+{
+    return AllocationCount{.count = lhs.count - rhs.count, .bytesCount = lhs.bytesCount - rhs.bytesCount};
+}
+
+inline AllocationCount ScopedAllocationCount::get() const noexcept
+{
+    return AllocationCounter::getThreadCount() - _start;
+}
+
+} // namespace CPPS
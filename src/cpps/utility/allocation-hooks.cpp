@@ -0,0 +1,74 @@
+// Global operator new replacement feeding AllocationCounter.
+// Not part of the cpps library, the executables wanting the allocation counts add it to their sources.
+
+#include <cstdlib>
+#include <new>
+
+#include "cpps/utility/allocation-counter.hpp"
+
+namespace {
+
+void* allocate(std::size_t size)
+{
+    CPPS::AllocationCounter::onAllocate(size);
+
+    // malloc(0) may return nullptr
+    return std::malloc(size == 0 ? 1 : size); // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (void* ptr = allocate(size))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
@@ -0,0 +1,179 @@
+#include "cpps/utility/allocator-stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+#include <fmt/format.h>
+
+namespace CPPS {
+
+namespace Details {
+
+std::size_t nextAllocatorStatsTypeIndex()
+{
+    static std::atomic<std::size_t> NextIndex{0};
+    return NextIndex++;
+}
+
+} // namespace Details
+
+void AllocatorStats::onDeallocate(std::size_t size, bool reclaimed)
+{
+    if (reclaimed)
+    {
+        std::size_t padding = 0;
+
+        if (!_paddings.empty())
+        {
+            padding = _paddings.back();
+            _paddings.pop_back();
+        }
+
+        _reclaimedBytesCount += size;
+        _liveBytesCount -= std::min(size + padding, _liveBytesCount);
+    }
+    else
+    {
+        _abandonedBytesCount += size;
+    }
+}
+
+void AllocatorStats::onNewBlock(std::size_t unusedBytesCount)
+{
+    _fragmentationBytesCount += unusedBytesCount;
+}
+
+void AllocatorStats::add(const AllocatorStats& other)
+{
+    if (other._types.size() > _types.size())
+    {
+        _types.resize(other._types.size());
+    }
+
+    for (std::size_t i = 0; i < other._types.size(); ++i)
+    {
+        const TypeStats& otherType = other._types[i];
+
+        if (otherType.allocationsCount > 0)
+        {
+            _types[i].name = otherType.name;
+            _types[i].allocationsCount += otherType.allocationsCount;
+            _types[i].bytesCount += otherType.bytesCount;
+        }
+    }
+
+    _allocationsCount += other._allocationsCount;
+    _allocatedBytesCount += other._allocatedBytesCount;
+    _paddingBytesCount += other._paddingBytesCount;
+    _fragmentationBytesCount += other._fragmentationBytesCount;
+    _reclaimedBytesCount += other._reclaimedBytesCount;
+    _abandonedBytesCount += other._abandonedBytesCount;
+
+    _liveBytesCount += other._liveBytesCount;
+    _peakBytesCount += other._peakBytesCount;
+}
+
+std::size_t AllocatorStats::getAllocationsCount() const
+{
+    return _allocationsCount;
+}
+
+std::size_t AllocatorStats::getAllocatedBytesCount() const
+{
+    return _allocatedBytesCount;
+}
+
+std::size_t AllocatorStats::getPaddingBytesCount() const
+{
+    return _paddingBytesCount;
+}
+
+std::size_t AllocatorStats::getFragmentationBytesCount() const
+{
+    return _fragmentationBytesCount;
+}
+
+std::size_t AllocatorStats::getReclaimedBytesCount() const
+{
+    return _reclaimedBytesCount;
+}
+
+std::size_t AllocatorStats::getAbandonedBytesCount() const
+{
+    return _abandonedBytesCount;
+}
+
+std::size_t AllocatorStats::getLiveBytesCount() const
+{
+    return _liveBytesCount;
+}
+
+std::size_t AllocatorStats::getPeakBytesCount() const
+{
+    return _peakBytesCount;
+}
+
+std::vector<AllocatorStats::TypeStats> AllocatorStats::getTypeStats() const
+{
+    std::vector<TypeStats> types;
+
+    std::copy_if(_types.begin(), _types.end(), std::back_inserter(types), [](const TypeStats& type) { return type.allocationsCount > 0; });
+
+    std::stable_sort(types.begin(), types.end(), [](const TypeStats& lhs, const TypeStats& rhs) { return lhs.bytesCount > rhs.bytesCount; });
+
+    return types;
+}
+
+std::string AllocatorStats::dump() const
+{
+    std::string text;
+
+    auto out = std::back_inserter(text);
+
+    fmt::format_to(out, "allocations:   {} ({} bytes)\n", _allocationsCount, _allocatedBytesCount);
+    fmt::format_to(out, "peak:          {} bytes\n", _peakBytesCount);
+    fmt::format_to(out, "padding:       {} bytes\n", _paddingBytesCount);
+    fmt::format_to(out, "fragmentation: {} bytes\n", _fragmentationBytesCount);
+    fmt::format_to(out, "reclaimed:     {} bytes\n", _reclaimedBytesCount);
+    fmt::format_to(out, "abandoned:     {} bytes\n", _abandonedBytesCount);
+
+    const std::vector<TypeStats> types = getTypeStats();
+
+    if (!types.empty())
+    {
+        fmt::format_to(out, "{:<48} {:>12} {:>12}\n", "type", "allocations", "bytes");
+
+        for (const TypeStats& type : types)
+        {
+            fmt::format_to(out, "{:<48} {:>12} {:>12}\n", type.name, type.allocationsCount, type.bytesCount);
+        }
+    }
+
+    return text;
+}
+
+void AllocatorStats::onAllocate(std::size_t typeIndex, std::string_view typeName, std::size_t size, std::size_t padding)
+{
+    if (typeIndex >= _types.size())
+    {
+        _types.resize(typeIndex + 1);
+    }
+
+    TypeStats& type = _types[typeIndex];
+
+    type.name = typeName;
+    ++type.allocationsCount;
+    type.bytesCount += size;
+
+    ++_allocationsCount;
+    _allocatedBytesCount += size;
+    _paddingBytesCount += padding;
+
+    _paddings.push_back(padding);
+
+    _liveBytesCount += size + padding;
+    _peakBytesCount = std::max(_peakBytesCount, _liveBytesCount);
+}
+
+} // namespace CPPS
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cpps/utility/type-name.hpp"
+
+namespace CPPS {
+
+/*
+ * A stats policy is notified of the BumpPointerAllocator activity.
+ * T is the allocated type, void if the allocation is untyped.
+ */
+template<typename T>
+concept AllocatorStatsPolicy = requires(T stats, std::size_t size, bool reclaimed) {
+    stats.template onAllocate<int>(size, size);
+    stats.onDeallocate(size, reclaimed);
+    stats.onNewBlock(size);
+};
+
+struct NoAllocatorStats
+{
+    template<typename T>
+    constexpr void onAllocate(std::size_t, std::size_t) {}
+    constexpr void onDeallocate(std::size_t, bool) {}
+    constexpr void onNewBlock(std::size_t) {}
+};
+
+class AllocatorStats
+{
+public:
+    struct TypeStats
+    {
+        std::string_view name;
+        std::size_t allocationsCount{0};
+        std::size_t bytesCount{0};
+    };
+
+public:
+    template<typename T>
+    void onAllocate(std::size_t size, std::size_t padding);
+    void onDeallocate(std::size_t size, bool reclaimed);
+    void onNewBlock(std::size_t unusedBytesCount);
+
+    // adds the stats of other, the peaks are summed
+    void add(const AllocatorStats& other);
+
+    [[nodiscard]] std::size_t getAllocationsCount() const;
+    [[nodiscard]] std::size_t getAllocatedBytesCount() const;
+
+    // bytes lost to align the allocations
+    [[nodiscard]] std::size_t getPaddingBytesCount() const;
+
+    // bytes left unused at the end of a block when a new one is required
+    [[nodiscard]] std::size_t getFragmentationBytesCount() const;
+
+    // deallocated bytes given back to the allocator, only the last allocation can be reclaimed
+    [[nodiscard]] std::size_t getReclaimedBytesCount() const;
+
+    // deallocated bytes that cannot be given back to the allocator
+    [[nodiscard]] std::size_t getAbandonedBytesCount() const;
+
+    // bytes of the allocations, with their padding, not reclaimed yet
+    [[nodiscard]] std::size_t getLiveBytesCount() const;
+
+    [[nodiscard]] std::size_t getPeakBytesCount() const;
+
+    // sorted by bytes count, the biggest first
+    [[nodiscard]] std::vector<TypeStats> getTypeStats() const;
+
+    [[nodiscard]] std::string dump() const;
+
+private:
+    void onAllocate(std::size_t typeIndex, std::string_view typeName, std::size_t size, std::size_t padding);
+
+private:
+    std::vector<TypeStats> _types;
+
+    // of the allocations not reclaimed yet, the last one is the next which can be reclaimed
+    std::vector<std::size_t> _paddings;
+
+    std::size_t _allocationsCount{0};
+    std::size_t _allocatedBytesCount{0};
+    std::size_t _paddingBytesCount{0};
+    std::size_t _fragmentationBytesCount{0};
+    std::size_t _reclaimedBytesCount{0};
+    std::size_t _abandonedBytesCount{0};
+
+    std::size_t _liveBytesCount{0};
+    std::size_t _peakBytesCount{0};
+};
+
+namespace Details {
+
+std::size_t nextAllocatorStatsTypeIndex();
+
+template<typename T>
+std::size_t getAllocatorStatsTypeIndex()
+{
+    static const std::size_t Index{nextAllocatorStatsTypeIndex()};
+    return Index;
+}
+
+} // namespace Details
+
+template<typename T>
+void AllocatorStats::onAllocate(std::size_t size, std::size_t padding)
+{
+    onAllocate(Details::getAllocatorStatsTypeIndex<T>(), getTypeName<T>(), size, padding);
+}
+
+} // namespace CPPS
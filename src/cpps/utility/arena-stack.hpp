@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "cpps/utility/bump-pointer-allocator.hpp"
+
+namespace CPPS {
+
+/**
+ * A LIFO of trivial Ts stored in chunks of ChunkCapacityT values, allocated in an owned BumpPointerAllocator.
+ *
+ * The stack never moves its values, a full chunk is followed by a new one, so the push is O(1) and the depth is only
+ * bounded by the memory. The chunks are kept when the stack shrinks, a stack reused for many traversals stops allocating
+ * once its deepest one is reached.
+ */
+template<typename T, std::size_t ChunkCapacityT = 256>
+requires(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && ChunkCapacityT > 0)
+class ArenaStack
+{
+public:
+    ArenaStack() = default;
+
+    ArenaStack(const ArenaStack&) = delete;
+    ArenaStack& operator=(const ArenaStack&) = delete;
+
+    void push(const T& value);
+
+    // removes and returns the top value
+    T pop();
+
+    [[nodiscard]] const T& top() const;
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] std::size_t getChunkCount() const;
+
+private:
+    struct Chunk
+    {
+        Chunk* previous{nullptr};
+        Chunk* next{nullptr};
+
+        std::array<T, ChunkCapacityT> values;
+    };
+
+    static constexpr std::size_t ChunksPerBlock{16};
+
+private:
+    BumpPointerAllocator<sizeof(Chunk) * ChunksPerBlock> _allocator;
+
+    Chunk* _chunk{nullptr};
+
+    // the values in _chunk, the previous chunks are full
+    std::size_t _chunkSize{0};
+
+    std::size_t _size{0};
+    std::size_t _chunkCount{0};
+};
+
+template<typename T, std::size_t ChunkCapacityT>
+requires(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && ChunkCapacityT > 0)
+void ArenaStack<T, ChunkCapacityT>::push(const T& value)
+{
+    if (_chunk == nullptr || _chunkSize == ChunkCapacityT)
+    {
+        if (_chunk == nullptr || _chunk->next == nullptr)
+        {
+            // the values are not initialized
+            Chunk* chunk = new (_allocator.template allocate<Chunk>()) Chunk;
+            chunk->previous = _chunk;
+
+            if (_chunk != nullptr)
+            {
+                _chunk->next = chunk;
+            }
+
+            _chunk = chunk;
+
+            ++_chunkCount;
+        }
+        else
+        {
+            _chunk = _chunk->next;
+        }
+
+        _chunkSize = 0;
+    }
+
+    _chunk->values[_chunkSize] = value;
+
+    ++_chunkSize;
+    ++_size;
+}
+
+template<typename T, std::size_t ChunkCapacityT>
+requires(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && ChunkCapacityT > 0)
+T ArenaStack<T, ChunkCapacityT>::pop()
+{
+    assert(_size > 0);
+
+    if (_chunkSize == 0)
+    {
+        _chunk = _chunk->previous;
+        _chunkSize = ChunkCapacityT;
+    }
+
+    --_chunkSize;
+    --_size;
+
+    return _chunk->values[_chunkSize];
+}
+
+template<typename T, std::size_t ChunkCapacityT>
+requires(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && ChunkCapacityT > 0)
+const T& ArenaStack<T, ChunkCapacityT>::top() const
+{
+    assert(_size > 0);
+
+    return _chunkSize > 0 ? _chunk->values[_chunkSize - 1] : _chunk->previous->values[ChunkCapacityT - 1];
+}
+
+template<typename T, std::size_t ChunkCapacityT>
+requires(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && ChunkCapacityT > 0)
+bool ArenaStack<T, ChunkCapacityT>::empty() const
+{
+    return _size == 0;
+}
+
+template<typename T, std::size_t ChunkCapacityT>
+requires(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && ChunkCapacityT > 0)
+std::size_t ArenaStack<T, ChunkCapacityT>::size() const
+{
+    return _size;
+}
+
+template<typename T, std::size_t ChunkCapacityT>
+requires(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && ChunkCapacityT > 0)
+std::size_t ArenaStack<T, ChunkCapacityT>::getChunkCount() const
+{
+    return _chunkCount;
+}
+
+} // namespace CPPS
@@ -0,0 +1,141 @@
+#include "cpps/utility/block-policy.hpp"
+
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace CPPS {
+
+namespace {
+
+[[maybe_unused]] std::size_t roundUpToHugePageSize(std::size_t size)
+{
+    return (size + HugePageSize - 1) & ~(HugePageSize - 1);
+}
+
+#if defined(__linux__)
+
+// faults the pages of a mapping advised MADV_HUGEPAGE, as huge pages when available
+void prefault(std::byte* data, std::size_t size)
+{
+#if defined(MADV_POPULATE_WRITE)
+    if (madvise(data, size, MADV_POPULATE_WRITE) == 0)
+    {
+        return;
+    }
+#endif
+
+    // before Linux 5.14, a write to each page faults it
+    const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+    for (std::size_t offset = 0; offset < size; offset += pageSize)
+    {
+        *static_cast<volatile std::byte*>(data + offset) = std::byte{0};
+    }
+}
+
+#endif
+
+} // namespace
+
+std::byte* HeapBlockPolicy::allocate(std::size_t size)
+{
+    return new std::byte[size];
+}
+
+void HeapBlockPolicy::deallocate(std::byte* data, std::size_t)
+{
+    delete[] data;
+}
+
+#if defined(__linux__)
+
+std::byte* allocateHugePages(std::size_t size, HugePages hugePages, bool populate)
+{
+    if (!isHugePageBlock(size))
+    {
+        return HeapBlockPolicy::allocate(size);
+    }
+
+    const std::size_t mappingSize = roundUpToHugePageSize(size);
+
+    const int protection = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (hugePages == HugePages::Explicit)
+    {
+        // the explicit huge pages are aligned by the kernel and pre-faulted as huge pages
+        void* data = mmap(nullptr, mappingSize, protection, flags | MAP_HUGETLB | (populate ? MAP_POPULATE : 0), -1, 0);
+
+        if (data != MAP_FAILED)
+        {
+            return static_cast<std::byte*>(data);
+        }
+
+        // the huge pages pool is empty or not configured, fallback to transparent huge pages
+    }
+
+    // over-mapped to align the start, transparent huge pages only back the aligned 2 MiB ranges
+    void* mapping = mmap(nullptr, mappingSize + HugePageSize, protection, flags, -1, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+
+    auto* begin = static_cast<std::byte*>(mapping);
+    auto* data = begin + (roundUpToHugePageSize(reinterpret_cast<std::uintptr_t>(begin)) - reinterpret_cast<std::uintptr_t>(begin));
+    std::byte* end = begin + mappingSize + HugePageSize;
+
+    if (data != begin)
+    {
+        (void)munmap(begin, static_cast<std::size_t>(data - begin));
+    }
+
+    if (data + mappingSize != end)
+    {
+        (void)munmap(data + mappingSize, static_cast<std::size_t>(end - (data + mappingSize)));
+    }
+
+    // only a hint, normal pages are used if transparent huge pages are disabled
+    // given before the first fault, MAP_POPULATE would fault normal pages
+    (void)madvise(data, mappingSize, MADV_HUGEPAGE);
+
+    if (populate)
+    {
+        prefault(data, mappingSize);
+    }
+
+    return data;
+}
+
+void deallocateHugePages(std::byte* data, std::size_t size)
+{
+    if (!isHugePageBlock(size))
+    {
+        HeapBlockPolicy::deallocate(data, size);
+        return;
+    }
+
+    (void)munmap(data, roundUpToHugePageSize(size));
+}
+
+#else
+
+std::byte* allocateHugePages(std::size_t size, HugePages, bool)
+{
+    return HeapBlockPolicy::allocate(size);
+}
+
+void deallocateHugePages(std::byte* data, std::size_t size)
+{
+    HeapBlockPolicy::deallocate(data, size);
+}
+
+#endif
+
+} // namespace CPPS
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+
+namespace CPPS {
+
+/**
+ * A block policy provides the memory blocks of a BumpPointerAllocator.
+ * deallocate is always called with the size given to allocate.
+ */
+template<typename T>
+concept BlockPolicy = requires(std::byte* data, std::size_t size) {
+    { T::allocate(size) } -> std::same_as<std::byte*>;
+    { T::deallocate(data, size) } -> std::same_as<void>;
+};
+
+// Blocks are allocated on the heap, the memory is not initialized.
+struct HeapBlockPolicy
+{
+    [[nodiscard]] static std::byte* allocate(std::size_t size);
+    static void deallocate(std::byte* data, std::size_t size);
+};
+
+enum class HugePages
+{
+    // 2 MiB transparent huge pages, madvise(MADV_HUGEPAGE)
+    Transparent,
+
+    // 2 MiB explicit huge pages, mmap(MAP_HUGETLB), fallback to Transparent if the pool is empty
+    Explicit
+};
+
+inline constexpr std::size_t HugePageSize{2ULL * 1024ULL * 1024ULL};
+
+/**
+ * Blocks of at least HugePageSize are mapped with huge pages, optionally pre-faulted.
+ * Mappings are rounded up to HugePageSize and aligned to it, the block capacity should be a multiple of it.
+ * Smaller blocks would waste most of their mapping, they are allocated by HeapBlockPolicy.
+ * Fallback to normal pages when huge pages are unavailable, and to HeapBlockPolicy on non Linux platforms.
+ */
+template<HugePages HugePagesT = HugePages::Transparent, bool PopulateT = false>
+struct HugePageBlockPolicy
+{
+    [[nodiscard]] static std::byte* allocate(std::size_t size);
+    static void deallocate(std::byte* data, std::size_t size);
+};
+
+// false if a block of size is allocated by HeapBlockPolicy
+[[nodiscard]] constexpr bool isHugePageBlock(std::size_t size)
+{
+    return size >= HugePageSize;
+}
+
+[[nodiscard]] std::byte* allocateHugePages(std::size_t size, HugePages hugePages, bool populate);
+void deallocateHugePages(std::byte* data, std::size_t size);
+
+template<HugePages HugePagesT, bool PopulateT>
+std::byte* HugePageBlockPolicy<HugePagesT, PopulateT>::allocate(std::size_t size)
+{
+    return allocateHugePages(size, HugePagesT, PopulateT);
+}
+
+template<HugePages HugePagesT, bool PopulateT>
+void HugePageBlockPolicy<HugePagesT, PopulateT>::deallocate(std::byte* data, std::size_t size)
+{
+    deallocateHugePages(data, size);
+}
+
+} // namespace CPPS
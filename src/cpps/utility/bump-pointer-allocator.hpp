@@ -1,19 +1,28 @@
 #pragma once
 
-#include <array>
 #include <cassert>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
+#include "cpps/utility/allocator-stats.hpp"
+#include "cpps/utility/block-policy.hpp"
+
 namespace CPPS {
 
 /**
  * ref https://fitzgeraldnick.com/2019/11/01/always-bump-downwards.html
+ *
+ * The memory of the blocks is provided by BlockPolicyT, see block-policy.hpp.
+ * The activity is reported to StatsPolicyT, see allocator-stats.hpp.
  */
-template<std::size_t BlockCapacityT = 500'000>
+template<std::size_t BlockCapacityT = 500'000, BlockPolicy BlockPolicyT = HeapBlockPolicy, AllocatorStatsPolicy StatsPolicyT = NoAllocatorStats>
 requires(BlockCapacityT > 0)
 class BumpPointerAllocator
 {
+public:
+    using StatsPolicy = StatsPolicyT;
+
 public:
     BumpPointerAllocator() = default;
     BumpPointerAllocator(BumpPointerAllocator&&) = default;
@@ -38,73 +47,73 @@ public:
     [[nodiscard]] std::size_t getAllocatedBytesCount() const;
     [[nodiscard]] std::size_t getUsedBytesCount() const;
 
+    [[nodiscard]] const StatsPolicyT& getStats() const;
+
 private:
+    template<typename T>
+    [[nodiscard]] void* allocateAs(std::size_t size, std::size_t align);
+
     static bool isValid(std::size_t size, std::size_t align);
 
 private:
-    using Block = std::array<std::byte, BlockCapacityT>;
-    using BlockPtr = std::unique_ptr<Block>;
+    struct BlockDeleter
+    {
+        void operator()(std::byte* data) const;
+    };
+
+    using BlockPtr = std::unique_ptr<std::byte[], BlockDeleter>; // NOLINT(cppcoreguidelines-avoid-c-arrays)
     using Blocks = std::vector<BlockPtr>;
 
+    static BlockPtr makeBlock();
+
 private:
-    Blocks _blocks{[] {Blocks blocks; blocks.emplace_back(std::make_unique<Block>()); return blocks; }()};
-    std::byte* _ptr{_blocks.back()->data() + BlockCapacityT};
+    Blocks _blocks{[] {Blocks blocks; blocks.emplace_back(makeBlock()); return blocks; }()};
+    std::byte* _ptr{_blocks.back().get() + BlockCapacityT};
+
+    [[no_unique_address]] StatsPolicyT _stats;
 };
 
-template<std::size_t BlockCapacityT>
+template<typename T>
+struct IsBumpPointerAllocator : std::false_type { };
+
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
+struct IsBumpPointerAllocator<BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>> : std::true_type { };
+
+template<typename T>
+inline constexpr bool IsBumpPointerAllocatorV = IsBumpPointerAllocator<T>::value;
+
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
 requires(BlockCapacityT > 0)
 template<typename T>
 requires(sizeof(T) <= BlockCapacityT)
-T* BumpPointerAllocator<BlockCapacityT>::allocate()
+T* BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::allocate()
 {
-    return static_cast<T*>(allocate(sizeof(T), alignof(T)));
+    return static_cast<T*>(allocateAs<T>(sizeof(T), alignof(T)));
 }
 
-template<std::size_t BlockCapacityT>
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
 requires(BlockCapacityT > 0)
 template<typename T>
-void BumpPointerAllocator<BlockCapacityT>::deallocate(const T* ptr)
+void BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::deallocate(const T* ptr)
 {
     deallocate(ptr, sizeof(T), alignof(T));
 }
 
-template<std::size_t BlockCapacityT>
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
 requires(BlockCapacityT > 0)
-void* BumpPointerAllocator<BlockCapacityT>::allocate(std::size_t size, std::size_t align)
+void* BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::allocate(std::size_t size, std::size_t align)
 {
-    assert(isValid(size, align));
-
-    auto getNextAligned = [align, size](std::byte* ptr) -> std::byte* {
-        const std::uintptr_t intPtr = reinterpret_cast<std::uintptr_t>(ptr);
-        const std::uintptr_t newIntPtr = intPtr - size;
-        const std::uintptr_t alignedIntPtr = newIntPtr & ~(align - 1);
-        return static_cast<std::byte*>(reinterpret_cast<void*>(alignedIntPtr)); // NOLINT(performance-no-int-to-ptr)
-    };
-
-    std::byte* data = _blocks.back()->data();
-
-    std::byte* newPtr = getNextAligned(_ptr);
-
-    if (newPtr < data)
-    {
-        _blocks.emplace_back(std::make_unique<Block>());
-
-        data = _blocks.back()->data();
-
-        newPtr = getNextAligned(data + BlockCapacityT);
-    }
-
-    _ptr = newPtr;
-
-    return _ptr;
+    return allocateAs<void>(size, align);
 }
 
-template<std::size_t BlockCapacityT>
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
 requires(BlockCapacityT > 0)
-void BumpPointerAllocator<BlockCapacityT>::deallocate(const void* ptr, std::size_t size, std::size_t align)
+void BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::deallocate(const void* ptr, std::size_t size, std::size_t align)
 {
     assert(isValid(size, align));
 
+    _stats.onDeallocate(size, ptr == _ptr);
+
     if (ptr == _ptr)
     {
         const std::uintptr_t intPtr = reinterpret_cast<std::uintptr_t>(_ptr);
@@ -115,44 +124,103 @@ void BumpPointerAllocator<BlockCapacityT>::deallocate(const void* ptr, std::size
     }
 }
 
-template<std::size_t BlockCapacityT>
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
 requires(BlockCapacityT > 0)
-[[nodiscard]] std::size_t BumpPointerAllocator<BlockCapacityT>::getBlockCapacity() const
+[[nodiscard]] std::size_t BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::getBlockCapacity() const
 {
     return BlockCapacityT;
 }
 
-template<std::size_t BlockCapacityT>
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
 requires(BlockCapacityT > 0)
-[[nodiscard]] std::size_t BumpPointerAllocator<BlockCapacityT>::getBlockCount() const
+[[nodiscard]] std::size_t BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::getBlockCount() const
 {
     return _blocks.size();
 }
 
-template<std::size_t BlockCapacityT>
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
 requires(BlockCapacityT > 0)
-[[nodiscard]] std::size_t BumpPointerAllocator<BlockCapacityT>::getAllocatedBytesCount() const
+[[nodiscard]] std::size_t BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::getAllocatedBytesCount() const
 {
     return _blocks.size() * BlockCapacityT;
 }
 
-template<std::size_t BlockCapacityT>
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
 requires(BlockCapacityT > 0)
-[[nodiscard]] std::size_t BumpPointerAllocator<BlockCapacityT>::getUsedBytesCount() const
+[[nodiscard]] std::size_t BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::getUsedBytesCount() const
 {
-    assert(_ptr >= _blocks.back()->data() && _ptr < _blocks.back()->data() + BlockCapacityT);
+    assert(_ptr >= _blocks.back().get() && _ptr < _blocks.back().get() + BlockCapacityT);
 
     const std::size_t filledBlockBytesCount = (_blocks.size() - 1) * BlockCapacityT;
-    const std::size_t remainingBlockBytesCount = reinterpret_cast<std::uintptr_t>(_blocks.back()->data()) + BlockCapacityT - reinterpret_cast<std::uintptr_t>(_ptr);
+    const std::size_t remainingBlockBytesCount = reinterpret_cast<std::uintptr_t>(_blocks.back().get()) + BlockCapacityT - reinterpret_cast<std::uintptr_t>(_ptr);
 
     return filledBlockBytesCount + remainingBlockBytesCount;
 }
 
-template<std::size_t BlockCapacityT>
-requires(BlockCapacityT > 0) bool
-BumpPointerAllocator<BlockCapacityT>::isValid(std::size_t size, std::size_t align)
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
+requires(BlockCapacityT > 0)
+const StatsPolicyT& BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::getStats() const
+{
+    return _stats;
+}
+
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
+requires(BlockCapacityT > 0)
+template<typename T>
+void* BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::allocateAs(std::size_t size, std::size_t align)
+{
+    assert(isValid(size, align));
+
+    auto getNextAligned = [align, size](std::byte* ptr) -> std::byte* {
+        const std::uintptr_t intPtr = reinterpret_cast<std::uintptr_t>(ptr);
+        const std::uintptr_t newIntPtr = intPtr - size;
+        const std::uintptr_t alignedIntPtr = newIntPtr & ~(align - 1);
+        return static_cast<std::byte*>(reinterpret_cast<void*>(alignedIntPtr)); // NOLINT(performance-no-int-to-ptr)
+    };
+
+    std::byte* data = _blocks.back().get();
+
+    std::byte* end = _ptr;
+    std::byte* newPtr = getNextAligned(end);
+
+    if (newPtr < data)
+    {
+        _stats.onNewBlock(static_cast<std::size_t>(_ptr - data));
+
+        _blocks.emplace_back(makeBlock());
+
+        data = _blocks.back().get();
+
+        end = data + BlockCapacityT;
+        newPtr = getNextAligned(end);
+    }
+
+    _stats.template onAllocate<T>(size, static_cast<std::size_t>(end - newPtr) - size);
+
+    _ptr = newPtr;
+
+    return _ptr;
+}
+
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
+requires(BlockCapacityT > 0)
+bool BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::isValid(std::size_t size, std::size_t align)
 {
     return size <= BlockCapacityT && align > 0 && (align & (align - 1)) == 0;
 }
 
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
+requires(BlockCapacityT > 0)
+typename BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::BlockPtr BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::makeBlock()
+{
+    return BlockPtr{BlockPolicyT::allocate(BlockCapacityT)};
+}
+
+template<std::size_t BlockCapacityT, BlockPolicy BlockPolicyT, AllocatorStatsPolicy StatsPolicyT>
+requires(BlockCapacityT > 0)
+void BumpPointerAllocator<BlockCapacityT, BlockPolicyT, StatsPolicyT>::BlockDeleter::operator()(std::byte* data) const
+{
+    BlockPolicyT::deallocate(data, BlockCapacityT);
+}
+
 } // namespace CPPS
@@ -0,0 +1,146 @@
+#include "cpps/utility/output-sink.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace CPPS {
+
+namespace {
+
+#if defined(__unix__) || defined(__APPLE__)
+// writes the buffers in order, retrying the partial writes
+bool writeAll(int fd, std::array<iovec, 2> buffers)
+{
+    std::size_t first = 0;
+
+    while (first < buffers.size())
+    {
+        if (buffers[first].iov_len == 0)
+        {
+            ++first;
+            continue;
+        }
+
+        const ssize_t written = ::writev(fd, &buffers[first], static_cast<int>(buffers.size() - first));
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        auto remaining = static_cast<std::size_t>(written);
+
+        for (; first < buffers.size() && remaining >= buffers[first].iov_len; ++first)
+        {
+            remaining -= buffers[first].iov_len;
+        }
+
+        if (remaining > 0)
+        {
+            buffers[first].iov_base = static_cast<char*>(buffers[first].iov_base) + remaining;
+            buffers[first].iov_len -= remaining;
+        }
+    }
+
+    return true;
+}
+#endif
+
+} // namespace
+
+OutputSink::OutputSink(std::FILE* file, std::size_t capacity)
+    : _file(file)
+    , _buffer(capacity)
+{
+    assert(capacity > 0);
+}
+
+OutputSink::~OutputSink()
+{
+    flush();
+}
+
+void OutputSink::write(std::string_view text)
+{
+    if (text.size() <= _buffer.size() - _bufferSize)
+    {
+        std::memcpy(_buffer.data() + _bufferSize, text.data(), text.size());
+        _bufferSize += text.size();
+        return;
+    }
+
+    if (text.size() >= _buffer.size())
+    {
+        writeToFile(text);
+        return;
+    }
+
+    flush();
+
+    std::memcpy(_buffer.data(), text.data(), text.size());
+    _bufferSize = text.size();
+}
+
+bool OutputSink::flush()
+{
+    if (_bufferSize > 0)
+    {
+        writeToFile({});
+    }
+
+    return !_hasFailed;
+}
+
+bool OutputSink::hasFailed() const
+{
+    return _hasFailed;
+}
+
+std::size_t OutputSink::getSize() const
+{
+    return _flushedSize + _bufferSize;
+}
+
+void OutputSink::writeToFile(std::string_view text)
+{
+    const std::string_view buffered{_buffer.data(), _bufferSize};
+
+    _flushedSize += buffered.size() + text.size();
+    _bufferSize = 0;
+
+    if (_hasFailed)
+    {
+        return;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    // the text written to the file before the sink comes first
+    if (std::fflush(_file) != 0)
+    {
+        _hasFailed = true;
+        return;
+    }
+
+    const std::array<iovec, 2> buffers{
+        iovec{.iov_base = const_cast<char*>(buffered.data()), .iov_len = buffered.size()},
+        iovec{.iov_base = const_cast<char*>(text.data()), .iov_len = text.size()}};
+
+    _hasFailed = !writeAll(::fileno(_file), buffers);
+#else
+    _hasFailed = std::fwrite(buffered.data(), 1, buffered.size(), _file) != buffered.size() || std::fwrite(text.data(), 1, text.size(), _file) != text.size();
+#endif
+}
+
+} // namespace CPPS
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace CPPS {
+
+/**
+ * A large buffer in front of a file: a write is a memcpy, the file is only written when the buffer is full.
+ *
+ * A text at least as large as the buffer is not copied, it is written with the buffered text in a single writev on
+ * POSIX. After a failed write the following ones are dropped, hasFailed tells it.
+ */
+class OutputSink
+{
+public:
+    static constexpr std::size_t DefaultCapacity{1024ULL * 1024ULL};
+
+public:
+    // the file is not owned, it must outlive the sink
+    explicit OutputSink(std::FILE* file, std::size_t capacity = DefaultCapacity);
+
+    // flushes
+    ~OutputSink();
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    void write(std::string_view text);
+    void write(char c);
+
+    // writes the buffered text to the file, false if a write failed
+    bool flush();
+
+    [[nodiscard]] bool hasFailed() const;
+
+    // the bytes written so far, buffered included
+    [[nodiscard]] std::size_t getSize() const;
+
+private:
+    void writeToFile(std::string_view text);
+
+private:
+    std::FILE* _file;
+
+    std::vector<char> _buffer;
+    std::size_t _bufferSize{0};
+
+    std::size_t _flushedSize{0};
+
+    bool _hasFailed{false};
+};
+
+inline void OutputSink::write(char c)
+{
+    if (_bufferSize == _buffer.size())
+    {
+        flush();
+    }
+
+    _buffer[_bufferSize] = c;
+
+    ++_bufferSize;
+}
+
+} // namespace CPPS
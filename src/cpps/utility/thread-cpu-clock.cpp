@@ -0,0 +1,43 @@
+#include "cpps/utility/thread-cpu-clock.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <ctime>
+#endif
+
+namespace CPPS {
+
+ThreadCpuClock::time_point ThreadCpuClock::now() noexcept
+{
+#if defined(_WIN32)
+    FILETIME creationTime;
+    FILETIME exitTime;
+    FILETIME kernelTime;
+    FILETIME userTime;
+
+    if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime) == 0)
+    {
+        return time_point{};
+    }
+
+    auto toTicks = [](FILETIME time) { return (static_cast<rep>(time.dwHighDateTime) << 32) | static_cast<rep>(time.dwLowDateTime); };
+
+    // FILETIME ticks are 100 nanoseconds
+    return time_point{duration{(toTicks(kernelTime) + toTicks(userTime)) * 100}};
+#elif defined(__unix__) || defined(__APPLE__)
+    timespec time{};
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+    {
+        return time_point{};
+    }
+
+    return time_point{std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec}};
+#else
+    return time_point{};
+#endif
+}
+
+} // namespace CPPS
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <chrono>
+
+namespace CPPS {
+
+// CPU time consumed by the calling thread, zero if the platform does not support it
+struct ThreadCpuClock
+{
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<ThreadCpuClock>;
+
+    static constexpr bool is_steady = true; // NOLINT(readability-identifier-naming)
+
+    static time_point now() noexcept;
+};
+
+} // namespace CPPS
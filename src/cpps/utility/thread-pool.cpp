@@ -0,0 +1,195 @@
+#include "cpps/utility/thread-pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace CPPS {
+
+namespace {
+
+struct CurrentWorker
+{
+    const ThreadPool* pool{nullptr};
+    std::size_t index{0};
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local CurrentWorker Current;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threadsCount)
+{
+    threadsCount = std::max(threadsCount, std::size_t{1});
+
+    _workers.reserve(threadsCount);
+
+    for (std::size_t i = 0; i < threadsCount; ++i)
+    {
+        _workers.emplace_back(std::make_unique<Worker>());
+    }
+
+    _threads.reserve(threadsCount);
+
+    for (std::size_t i = 0; i < threadsCount; ++i)
+    {
+        _threads.emplace_back([this, i] { run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock lock{_sleepMutex};
+        _tasksDone.wait(lock, [this] { return _pendingCount == 0; });
+        _isStopping = true;
+    }
+
+    _taskQueued.notify_all();
+
+    for (std::thread& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    const std::size_t workerIndex = Current.pool == this ? Current.index : _nextWorkerIndex++ % _workers.size();
+
+    ++_pendingCount;
+
+    // counted before the push, a task must never be taken before being counted
+    {
+        const std::scoped_lock lock{_sleepMutex};
+        ++_queuedCount;
+    }
+
+    {
+        Worker& worker = *_workers[workerIndex];
+
+        const std::scoped_lock lock{worker.mutex};
+        worker.tasks.push_back(std::move(task));
+    }
+
+    _taskQueued.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock{_sleepMutex};
+
+    _tasksDone.wait(lock, [this] { return _pendingCount == 0; });
+
+    if (_exception)
+    {
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+std::size_t ThreadPool::getThreadsCount() const
+{
+    return _threads.size();
+}
+
+std::size_t ThreadPool::getDefaultThreadsCount()
+{
+    return std::max(std::size_t{std::thread::hardware_concurrency()}, std::size_t{1});
+}
+
+void ThreadPool::run(std::size_t workerIndex)
+{
+    Current = CurrentWorker{.pool = this, .index = workerIndex};
+
+    Task task;
+
+    while (true)
+    {
+        if (tryPop(workerIndex, task) || trySteal(workerIndex, task))
+        {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock lock{_sleepMutex};
+
+        // a counted task may not be pushed yet, then the worker loops until it is
+        _taskQueued.wait(lock, [this] { return _queuedCount > 0 || _isStopping; });
+
+        if (_isStopping && _queuedCount == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::tryPop(std::size_t workerIndex, Task& task)
+{
+    Worker& worker = *_workers[workerIndex];
+
+    const std::scoped_lock lock{worker.mutex};
+
+    if (worker.tasks.empty())
+    {
+        return false;
+    }
+
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+
+    return true;
+}
+
+bool ThreadPool::trySteal(std::size_t workerIndex, Task& task)
+{
+    for (std::size_t offset = 1; offset < _workers.size(); ++offset)
+    {
+        Worker& worker = *_workers[(workerIndex + offset) % _workers.size()];
+
+        const std::scoped_lock lock{worker.mutex};
+
+        if (!worker.tasks.empty())
+        {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::execute(Task& task)
+{
+    {
+        const std::scoped_lock lock{_sleepMutex};
+        assert(_queuedCount > 0);
+        --_queuedCount;
+    }
+
+    try
+    {
+        task();
+    }
+    catch (...)
+    {
+        const std::scoped_lock lock{_sleepMutex};
+
+        if (!_exception)
+        {
+            _exception = std::current_exception();
+        }
+    }
+
+    task = {};
+
+    if (--_pendingCount == 0)
+    {
+        const std::scoped_lock lock{_sleepMutex};
+        _tasksDone.notify_all();
+    }
+}
+
+} // namespace CPPS
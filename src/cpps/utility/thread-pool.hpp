@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CPPS {
+
+/**
+ * Work-stealing thread pool.
+ *
+ * Each worker owns a task queue, it takes its own tasks from the back and steals the other workers tasks from the front.
+ * The tasks submitted from a worker are queued on that worker, the others are distributed round robin.
+ */
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+public:
+    explicit ThreadPool(std::size_t threadsCount = getDefaultThreadsCount());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    void submit(Task task);
+
+    // blocks until all the submitted tasks are done, rethrows the first exception thrown by a task
+    void wait();
+
+    [[nodiscard]] std::size_t getThreadsCount() const;
+
+    // hardware concurrency, at least 1
+    [[nodiscard]] static std::size_t getDefaultThreadsCount();
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(std::size_t workerIndex);
+
+    bool tryPop(std::size_t workerIndex, Task& task);
+    bool trySteal(std::size_t workerIndex, Task& task);
+
+    void execute(Task& task);
+
+private:
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+
+    std::atomic<std::size_t> _nextWorkerIndex{0};
+
+    // tasks submitted and not done
+    std::atomic<std::size_t> _pendingCount{0};
+
+    // tasks submitted and not taken yet, guarded by _sleepMutex
+    std::size_t _queuedCount{0};
+
+    std::mutex _sleepMutex;
+    std::condition_variable _taskQueued;
+    std::condition_variable _tasksDone;
+
+    std::exception_ptr _exception;
+
+    bool _isStopping{false};
+};
+
+} // namespace CPPS
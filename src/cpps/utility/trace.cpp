@@ -0,0 +1,186 @@
+#include "cpps/utility/trace.hpp"
+
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace CPPS {
+
+namespace {
+
+struct Zone
+{
+    std::string_view name;
+    std::string detail;
+    Trace::Clock::time_point begin;
+    Trace::Clock::time_point end;
+};
+
+// the mutex is only contended while the trace is started again or formatted
+struct ThreadBuffer
+{
+    std::uint32_t threadId{0};
+
+    std::mutex mutex;
+    std::vector<Zone> zones;
+};
+
+// the buffers outlive their thread, their zones are written after the threads are joined
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    Trace::Clock::time_point origin;
+};
+
+Registry& getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+ThreadBuffer& getThreadBuffer()
+{
+    thread_local ThreadBuffer* buffer = [] {
+        Registry& registry = getRegistry();
+
+        const std::scoped_lock lock{registry.mutex};
+
+        ThreadBuffer* threadBuffer = registry.buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+        threadBuffer->threadId = static_cast<std::uint32_t>(registry.buffers.size() - 1);
+
+        return threadBuffer;
+    }();
+
+    return *buffer;
+}
+
+void formatJsonString(std::back_insert_iterator<std::string> out, std::string_view text)
+{
+    *out++ = '"';
+
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            *out++ = '\\';
+            *out++ = c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            fmt::format_to(out, "\\u{:04x}", static_cast<unsigned char>(c));
+        }
+        else
+        {
+            *out++ = c;
+        }
+    }
+
+    *out++ = '"';
+}
+
+double toMicroseconds(Trace::Clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // namespace
+
+std::atomic<bool> Trace::_isStarted{false}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void Trace::start()
+{
+    Registry& registry = getRegistry();
+
+    {
+        const std::scoped_lock lock{registry.mutex};
+
+        for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers)
+        {
+            const std::scoped_lock bufferLock{buffer->mutex};
+            buffer->zones.clear();
+        }
+
+        registry.origin = Clock::now();
+    }
+
+    _isStarted.store(true, std::memory_order_relaxed);
+}
+
+void Trace::stop()
+{
+    _isStarted.store(false, std::memory_order_relaxed);
+}
+
+std::string Trace::formatChromeJson()
+{
+    Registry& registry = getRegistry();
+
+    const std::scoped_lock lock{registry.mutex};
+
+    std::string json;
+
+    auto out = std::back_inserter(json);
+
+    fmt::format_to(out, R"({{"displayTimeUnit":"ms","traceEvents":[)");
+
+    bool isFirst = true;
+
+    auto separate = [&out, &isFirst] {
+        if (!isFirst)
+        {
+            *out++ = ',';
+        }
+
+        *out++ = '\n';
+        isFirst = false;
+    };
+
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers)
+    {
+        const std::scoped_lock bufferLock{buffer->mutex};
+
+        if (buffer->zones.empty())
+        {
+            continue;
+        }
+
+        separate();
+        fmt::format_to(out, R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"thread {}"}}}})", buffer->threadId, buffer->threadId);
+
+        for (const Zone& zone : buffer->zones)
+        {
+            separate();
+            fmt::format_to(out, R"({{"name":)");
+            formatJsonString(out, zone.name);
+            fmt::format_to(out, R"(,"ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f})", buffer->threadId, toMicroseconds(zone.begin - registry.origin), toMicroseconds(zone.end - zone.begin));
+
+            if (!zone.detail.empty())
+            {
+                fmt::format_to(out, R"(,"args":{{"detail":)");
+                formatJsonString(out, zone.detail);
+                *out++ = '}';
+            }
+
+            *out++ = '}';
+        }
+    }
+
+    fmt::format_to(out, "\n]}}\n");
+
+    return json;
+}
+
+void Trace::addZone(std::string_view name, std::string detail, Clock::time_point begin, Clock::time_point end)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+
+    const std::scoped_lock lock{buffer.mutex};
+    buffer.zones.push_back(Zone{.name = name, .detail = std::move(detail), .begin = begin, .end = end});
+}
+
+} // namespace CPPS
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace CPPS {
+
+/**
+ * Scoped zones recorded per thread and written as Chrome Trace Event json (chrome://tracing, ui.perfetto.dev).
+ *
+ * The zones cost a single relaxed load when the trace is not started,
+ * and nothing if CPPS_ENABLE_TRACE is not defined (see CPPS_TRACE_ZONE).
+ * The detail of a zone is made by a callable, only called when the trace is started.
+ */
+class Trace
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // clears the previous events
+    static void start();
+    static void stop();
+
+    [[nodiscard]] static bool isStarted() noexcept;
+
+    // must not be called while a zone is recorded
+    [[nodiscard]] static std::string formatChromeJson();
+
+    // the name must be a literal, the detail is shown as the zone args
+    // thread-safe, may be called while the trace is started again
+    static void addZone(std::string_view name, std::string detail, Clock::time_point begin, Clock::time_point end);
+
+private:
+    static std::atomic<bool> _isStarted; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+};
+
+class ScopedTraceZone
+{
+public:
+    explicit ScopedTraceZone(std::string_view name);
+
+    // makeDetail returns the detail as a std::string, it is not called if the trace is not started
+    template<typename MakeDetailT>
+    requires std::convertible_to<std::invoke_result_t<MakeDetailT>, std::string>
+    ScopedTraceZone(std::string_view name, MakeDetailT&& makeDetail);
+    ~ScopedTraceZone();
+
+    ScopedTraceZone(const ScopedTraceZone&) = delete;
+    ScopedTraceZone& operator=(const ScopedTraceZone&) = delete;
+    ScopedTraceZone(ScopedTraceZone&&) = delete;
+    ScopedTraceZone& operator=(ScopedTraceZone&&) = delete;
+
+private:
+    std::string_view _name;
+    std::string _detail;
+    Trace::Clock::time_point _begin;
+    bool _isRecording;
+};
+
+inline bool Trace::isStarted() noexcept
+{
+    return _isStarted.load(std::memory_order_relaxed);
+}
+
+inline ScopedTraceZone::ScopedTraceZone(std::string_view name)
+    : _name(name)
+    , _isRecording(Trace::isStarted())
+{
+    if (_isRecording)
+    {
+        _begin = Trace::Clock::now();
+    }
+}
+
+template<typename MakeDetailT>
+requires std::convertible_to<std::invoke_result_t<MakeDetailT>, std::string>
+ScopedTraceZone::ScopedTraceZone(std::string_view name, MakeDetailT&& makeDetail)
+    : _name(name)
+    , _isRecording(Trace::isStarted())
+{
+    if (_isRecording)
+    {
+        _detail = std::forward<MakeDetailT>(makeDetail)();
+        _begin = Trace::Clock::now();
+    }
+}
+
+inline ScopedTraceZone::~ScopedTraceZone()
+{
+    if (_isRecording)
+    {
+        Trace::addZone(_name, std::move(_detail), _begin, Trace::Clock::now());
+    }
+}
+
+} // namespace CPPS
+
+#define CPPS_TRACE_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define CPPS_TRACE_CONCAT(lhs, rhs) CPPS_TRACE_CONCAT_IMPL(lhs, rhs)
+
+#if defined(CPPS_ENABLE_TRACE)
+#define CPPS_TRACE_ZONE(...) const ::CPPS::ScopedTraceZone CPPS_TRACE_CONCAT(cppsTraceZone, __LINE__){__VA_ARGS__}
+#else
+#define CPPS_TRACE_ZONE(...) static_cast<void>(0)
+#endif
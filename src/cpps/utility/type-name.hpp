@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string_view>
+
+namespace CPPS {
+
+namespace Details {
+
+template<typename T>
+constexpr std::string_view getPrettyFunction()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
+
+// the pretty function of a known type is used to find where the type name is located
+inline constexpr std::string_view ProbePrettyFunction{getPrettyFunction<double>()};
+inline constexpr std::size_t TypeNamePrefixSize{ProbePrettyFunction.find("double")};
+inline constexpr std::size_t TypeNameSuffixSize{ProbePrettyFunction.size() - TypeNamePrefixSize - std::string_view{"double"}.size()};
+
+} // namespace Details
+
+// returns the compiler name of T, ie "CPPS::CST::Declaration"
+template<typename T>
+constexpr std::string_view getTypeName()
+{
+    constexpr std::string_view prettyFunction = Details::getPrettyFunction<T>();
+
+    std::string_view name = prettyFunction.substr(Details::TypeNamePrefixSize, prettyFunction.size() - Details::TypeNamePrefixSize - Details::TypeNameSuffixSize);
+
+    // msvc prefixes the name by its kind
+    for (std::string_view kind : {"struct ", "class ", "enum ", "union "})
+    {
+        if (name.starts_with(kind))
+        {
+            name.remove_prefix(kind.size());
+        }
+    }
+
+    return name;
+}
+
+} // namespace CPPS
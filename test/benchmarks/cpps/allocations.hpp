@@ -0,0 +1,18 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "cpps/utility/allocation-counter.hpp"
+
+namespace CPPS::Benchmarks {
+
+// heap allocations per iteration, zero if cpps-allocation-hooks is not linked
+inline void setAllocationsCounters(benchmark::State& state, const ScopedAllocationCount& allocations)
+{
+    const AllocationCount count = allocations.get();
+
+    state.counters["allocations"] = benchmark::Counter(static_cast<double>(count.count), benchmark::Counter::kAvgIterations);
+    state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(count.bytesCount), benchmark::Counter::kAvgIterations);
+}
+
+} // namespace CPPS::Benchmarks
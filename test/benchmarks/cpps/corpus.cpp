@@ -0,0 +1,111 @@
+#include "corpus.hpp"
+
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+
+namespace CPPS::Benchmarks {
+
+namespace {
+
+constexpr std::string_view CorpusPattern{
+    R"(#include <vector>
+
+// free functions
+int cpp_function(int value) { return value * 2; }
+
+add: (a: int, b: int) -> int = { return a + b; }
+counter: int = 0;
+pointer: *int = nullptr;
+flag: bool = true;
+letter: char = 'c';
+compute: (in x: int, out y: int) -> int = { y = x * 2 + (x - 1) / 3; return y; }
+value: int = my_obj.member(a, b)[0];
+is_valid: (x: int) -> bool = { return x == 10 && x != 0 || flag; }
+call: int = compute(move counter, out value);
+negated: int = -counter * !flag;
+address: *int = value&;
+dereferenced: int = pointer*;
+
+/* a block comment
+   spanning lines */
+)"};
+
+constexpr std::string_view KeywordsPattern{
+    R"(alignas_value: bool = true;
+constexpr_value: int = 0;
+is_const: bool = false;
+return_value: (in x: int) -> int = { return x; }
+static_value: int = 2;
+thread_local_value: int = 3;
+decltype_value: int = 4;
+namespace_id: int = 5;
+nullptr_value: *int = nullptr;
+while_count: (inout x: int) -> int = { return x; }
+)"};
+
+std::string repeat(std::string_view pattern, std::size_t bytesCount)
+{
+    std::string corpus;
+    corpus.reserve(bytesCount + pattern.size());
+
+    while (corpus.size() < bytesCount)
+    {
+        corpus += pattern;
+    }
+
+    return corpus;
+}
+
+} // namespace
+
+std::string makeCorpus(std::size_t bytesCount)
+{
+    return repeat(CorpusPattern, bytesCount);
+}
+
+std::string makeKeywordsCorpus(std::size_t bytesCount)
+{
+    return repeat(KeywordsPattern, bytesCount);
+}
+
+Source readCorpus(const std::string& corpus)
+{
+    Diagnosis diagnosis;
+
+    std::istringstream stream{corpus};
+
+    SourceReader reader{diagnosis, stream};
+
+    std::optional<Source> source = reader.read();
+
+    if (!source || !diagnosis.getErrors().empty())
+    {
+        throw std::runtime_error("the benchmark corpus cannot be read");
+    }
+
+    return std::move(*source);
+}
+
+Tokens lexCorpus(const Source& source)
+{
+    Diagnosis diagnosis;
+
+    Lexer lexer{diagnosis, source};
+
+    Tokens tokens = lexer.lex();
+
+    if (!diagnosis.getErrors().empty())
+    {
+        throw std::runtime_error("the benchmark corpus cannot be lexed");
+    }
+
+    return tokens;
+}
+
+} // namespace CPPS::Benchmarks
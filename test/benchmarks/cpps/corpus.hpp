@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "cpps/source.hpp"
+#include "cpps/tokens.hpp"
+
+namespace CPPS::Benchmarks {
+
+// a realistic mix of cpps declarations, C++ code, comments and empty lines,
+// the pattern is repeated until the corpus reaches at least bytesCount bytes
+[[nodiscard]] std::string makeCorpus(std::size_t bytesCount);
+
+// a corpus made mostly of keywords and identifiers looking like keywords
+[[nodiscard]] std::string makeKeywordsCorpus(std::size_t bytesCount);
+
+// the results of the earlier stages, to benchmark a stage alone
+// the tokens refer to the text of the source, which must outlive them
+[[nodiscard]] Source readCorpus(const std::string& corpus);
+[[nodiscard]] Tokens lexCorpus(const Source& source);
+
+} // namespace CPPS::Benchmarks
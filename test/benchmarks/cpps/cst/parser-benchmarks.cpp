@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <stdexcept>
+
+#include "allocations.hpp"
+#include "corpus.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "perf-counters.hpp"
+
+namespace CPPS::Benchmarks {
+
+namespace {
+
+void parserParse(benchmark::State& state)
+{
+    const std::string corpus = makeCorpus(static_cast<std::size_t>(state.range(0)));
+
+    const Source source = readCorpus(corpus);
+    const Tokens tokens = lexCorpus(source);
+
+    {
+        Diagnosis diagnosis;
+
+        CST::Parser parser{diagnosis, tokens};
+
+        benchmark::DoNotOptimize(parser.parse());
+
+        if (!diagnosis.getErrors().empty())
+        {
+            throw std::runtime_error("the benchmark corpus cannot be parsed");
+        }
+    }
+
+    const ScopedAllocationCount allocations;
+    const PerfCounters perfCounters;
+
+    for (auto _ : state)
+    {
+        Diagnosis diagnosis;
+
+        CST::Parser parser{diagnosis, tokens};
+
+        CST::TranslationUnit translationUnit = parser.parse();
+
+        benchmark::DoNotOptimize(translationUnit);
+    }
+
+    setAllocationsCounters(state, allocations);
+    setPerfCounters(state, perfCounters, corpus.size(), tokens.size());
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens.size()), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+} // namespace
+
+BENCHMARK(parserParse)->Arg(16 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMicrosecond);
+
+} // namespace CPPS::Benchmarks
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "corpus.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/cst/walker.hpp"
+#include "cpps/diagnosis.hpp"
+#include "perf-counters.hpp"
+
+namespace CPPS::Benchmarks {
+
+namespace {
+
+// the cheapest hooks, so the benchmark measures the frames and their dispatch
+class NodeCounter : public CST::ConstWalker<NodeCounter>
+{
+private:
+    friend class CST::Walker<NodeCounter, true>;
+
+    void pre(const CST::BasicExpression&)
+    {
+        ++count;
+    }
+
+    void post(const CST::Declaration&)
+    {
+        ++count;
+    }
+
+public:
+    std::size_t count{0};
+};
+
+void walkerWalk(benchmark::State& state)
+{
+    const std::string corpus = makeCorpus(static_cast<std::size_t>(state.range(0)));
+
+    const Source source = readCorpus(corpus);
+    const Tokens tokens = lexCorpus(source);
+
+    Diagnosis diagnosis;
+
+    CST::Parser parser{diagnosis, tokens};
+
+    const CST::TranslationUnit translationUnit = parser.parse();
+
+    if (!diagnosis.getErrors().empty())
+    {
+        throw std::runtime_error("the benchmark corpus cannot be parsed");
+    }
+
+    // the stack chunks are allocated by the first walk
+    NodeCounter counter;
+    counter.walk(translationUnit);
+
+    const PerfCounters perfCounters;
+
+    for (auto _ : state)
+    {
+        counter.walk(translationUnit);
+
+        benchmark::DoNotOptimize(counter.count);
+    }
+
+    setPerfCounters(state, perfCounters, corpus.size(), tokens.size());
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(corpus.size()));
+}
+
+} // namespace
+
+BENCHMARK(walkerWalk)->Arg(16 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMicrosecond);
+
+} // namespace CPPS::Benchmarks
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+#include "allocations.hpp"
+#include "corpus.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+#include "cpps-corpus-generator/generator.hpp"
+#include "perf-counters.hpp"
+
+namespace CPPS::Benchmarks {
+
+namespace {
+
+// read, lex and parse, the complexity is charted against the scaled option
+void compile(benchmark::State& state, const Corpus::GeneratorOptions& options, std::size_t scale)
+{
+    const Corpus::GeneratedCorpus corpus = Corpus::Generator{options}.generate();
+
+    const Source source = readCorpus(corpus.text);
+    const std::size_t tokensCount = lexCorpus(source).size();
+
+    std::istringstream stream{corpus.text};
+
+    const ScopedAllocationCount allocations;
+    const PerfCounters perfCounters;
+
+    for (auto _ : state)
+    {
+        stream.clear();
+        stream.seekg(0);
+
+        Diagnosis diagnosis;
+
+        SourceReader reader{diagnosis, stream};
+
+        std::optional<Source> readSource = reader.read();
+
+        if (!readSource)
+        {
+            state.SkipWithError("the generated corpus cannot be read");
+            break;
+        }
+
+        Lexer lexer{diagnosis, *readSource};
+
+        Tokens tokens = lexer.lex();
+
+        CST::Parser parser{diagnosis, tokens};
+
+        CST::TranslationUnit translationUnit = parser.parse();
+
+        benchmark::DoNotOptimize(translationUnit);
+
+        if (!diagnosis.getErrors().empty())
+        {
+            state.SkipWithError("the generated corpus cannot be compiled");
+            break;
+        }
+    }
+
+    setAllocationsCounters(state, allocations);
+    setPerfCounters(state, perfCounters, corpus.text.size(), tokensCount);
+
+    state.SetComplexityN(static_cast<std::int64_t>(scale));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(corpus.text.size()));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokensCount), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void compileGeneratedLines(benchmark::State& state)
+{
+    Corpus::GeneratorOptions options;
+    options.linesCount = static_cast<std::size_t>(state.range(0));
+
+    compile(state, options, options.linesCount);
+}
+
+void compileGeneratedExpressionDepth(benchmark::State& state)
+{
+    Corpus::GeneratorOptions options;
+    options.expressionDepth = static_cast<std::size_t>(state.range(0));
+
+    compile(state, options, options.expressionDepth);
+}
+
+void compileGeneratedStatementDepth(benchmark::State& state)
+{
+    Corpus::GeneratorOptions options;
+    options.statementDepth = static_cast<std::size_t>(state.range(0));
+
+    compile(state, options, options.statementDepth);
+}
+
+void compileGeneratedParameters(benchmark::State& state)
+{
+    Corpus::GeneratorOptions options;
+    options.parametersCount = static_cast<std::size_t>(state.range(0));
+
+    compile(state, options, options.parametersCount);
+}
+
+} // namespace
+
+BENCHMARK(compileGeneratedLines)->RangeMultiplier(4)->Range(256, 64 * 1024)->Complexity(benchmark::oN)->Unit(benchmark::kMillisecond);
+BENCHMARK(compileGeneratedExpressionDepth)->RangeMultiplier(4)->Range(1, 256)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(compileGeneratedStatementDepth)->RangeMultiplier(4)->Range(1, 256)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(compileGeneratedParameters)->RangeMultiplier(4)->Range(1, 256)->Complexity()->Unit(benchmark::kMillisecond);
+
+} // namespace CPPS::Benchmarks
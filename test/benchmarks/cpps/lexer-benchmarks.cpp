@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include "allocations.hpp"
+#include "corpus.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "perf-counters.hpp"
+
+namespace CPPS::Benchmarks {
+
+namespace {
+
+void lex(benchmark::State& state, const std::string& corpus)
+{
+    const Source source = readCorpus(corpus);
+    const std::size_t tokensCount = lexCorpus(source).size();
+
+    const ScopedAllocationCount allocations;
+    const PerfCounters perfCounters;
+
+    for (auto _ : state)
+    {
+        Diagnosis diagnosis;
+
+        Lexer lexer{diagnosis, source};
+
+        Tokens tokens = lexer.lex();
+
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    setAllocationsCounters(state, allocations);
+    setPerfCounters(state, perfCounters, corpus.size(), tokensCount);
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokensCount), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void lexerLex(benchmark::State& state)
+{
+    lex(state, makeCorpus(static_cast<std::size_t>(state.range(0))));
+}
+
+// Lexer::tryLexKeyword is private, it is measured through a corpus made mostly of keywords
+void lexerLexKeywords(benchmark::State& state)
+{
+    lex(state, makeKeywordsCorpus(static_cast<std::size_t>(state.range(0))));
+}
+
+} // namespace
+
+BENCHMARK(lexerLex)->Arg(16 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(lexerLexKeywords)->Arg(16 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMicrosecond);
+
+} // namespace CPPS::Benchmarks
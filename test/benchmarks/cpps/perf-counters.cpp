@@ -0,0 +1,202 @@
+#include "perf-counters.hpp"
+
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace CPPS::Benchmarks {
+
+#if defined(__linux__)
+
+namespace {
+
+perf_event_attr makeAttributes(PerfEvent event)
+{
+    perf_event_attr attributes{};
+
+    attributes.size = sizeof(perf_event_attr);
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (event)
+    {
+    case PerfEvent::Cycles:
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PerfEvent::Instructions:
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PerfEvent::BranchMisses:
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case PerfEvent::L1DataMisses:
+        attributes.type = PERF_TYPE_HW_CACHE;
+        attributes.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8U) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U);
+        break;
+    case PerfEvent::LastLevelCacheMisses:
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    }
+
+    return attributes;
+}
+
+int open(PerfEvent event)
+{
+    perf_event_attr attributes = makeAttributes(event);
+
+    // the calling thread, on any cpu
+    const long fd = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    ioctl(static_cast<int>(fd), PERF_EVENT_IOC_RESET, 0);
+    ioctl(static_cast<int>(fd), PERF_EVENT_IOC_ENABLE, 0);
+
+    return static_cast<int>(fd);
+}
+
+} // namespace
+
+PerfCounters::PerfCounters()
+{
+    for (std::size_t i = 0; i < PerfEventCount; ++i)
+    {
+        _fds[i] = open(static_cast<PerfEvent>(i));
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (const int fd : _fds)
+    {
+        if (fd != InvalidFd)
+        {
+            close(fd);
+        }
+    }
+}
+
+std::optional<std::uint64_t> PerfCounters::read(PerfEvent event) const
+{
+    const int fd = _fds[static_cast<std::size_t>(event)];
+
+    if (fd == InvalidFd)
+    {
+        return std::nullopt;
+    }
+
+    struct
+    {
+        std::uint64_t value;
+        std::uint64_t timeEnabled;
+        std::uint64_t timeRunning;
+    } values{};
+
+    if (::read(fd, &values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values.timeRunning == 0)
+    {
+        return std::nullopt;
+    }
+
+    if (values.timeRunning == values.timeEnabled)
+    {
+        return values.value;
+    }
+
+    return static_cast<std::uint64_t>(static_cast<double>(values.value) * static_cast<double>(values.timeEnabled) / static_cast<double>(values.timeRunning));
+}
+
+#else
+
+PerfCounters::PerfCounters()
+{
+    _fds.fill(InvalidFd);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+std::optional<std::uint64_t> PerfCounters::read(PerfEvent) const
+{
+    return std::nullopt;
+}
+
+#endif
+
+std::string_view PerfCounters::getName(PerfEvent event)
+{
+    switch (event)
+    {
+    case PerfEvent::Cycles:
+        return "cycles";
+    case PerfEvent::Instructions:
+        return "instructions";
+    case PerfEvent::BranchMisses:
+        return "branch_misses";
+    case PerfEvent::L1DataMisses:
+        return "l1d_misses";
+    case PerfEvent::LastLevelCacheMisses:
+        return "llc_misses";
+    }
+
+    return {};
+}
+
+void setPerfCounters(benchmark::State& state, const PerfCounters& counters, std::size_t bytesCount, std::size_t tokensCount)
+{
+    if (state.iterations() == 0)
+    {
+        return;
+    }
+
+    const auto iterationsCount = static_cast<double>(state.iterations());
+
+    for (std::size_t i = 0; i < PerfEventCount; ++i)
+    {
+        const auto event = static_cast<PerfEvent>(i);
+        const std::optional<std::uint64_t> value = counters.read(event);
+
+        if (!value)
+        {
+            continue;
+        }
+
+        const std::string name{PerfCounters::getName(event)};
+        const double perIteration = static_cast<double>(*value) / iterationsCount;
+
+        state.counters[name] = perIteration;
+
+        if (bytesCount > 0)
+        {
+            state.counters[name + "/byte"] = perIteration / static_cast<double>(bytesCount);
+        }
+
+        if (tokensCount > 0)
+        {
+            state.counters[name + "/token"] = perIteration / static_cast<double>(tokensCount);
+        }
+    }
+
+    const std::optional<std::uint64_t> cycles = counters.read(PerfEvent::Cycles);
+    const std::optional<std::uint64_t> instructions = counters.read(PerfEvent::Instructions);
+
+    if (cycles && instructions && *cycles > 0)
+    {
+        state.counters["ipc"] = static_cast<double>(*instructions) / static_cast<double>(*cycles);
+    }
+}
+
+} // namespace CPPS::Benchmarks
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace CPPS::Benchmarks {
+
+enum class PerfEvent : std::uint8_t
+{
+    Cycles,
+    Instructions,
+    BranchMisses,
+    L1DataMisses,
+    LastLevelCacheMisses
+};
+
+inline constexpr std::size_t PerfEventCount{5};
+
+/**
+ * Hardware counters of the calling thread, read through perf_event_open since the construction.
+ *
+ * A counter is unsupported if the kernel or the hardware refuses it, as often inside containers
+ * or with a restrictive perf_event_paranoid, and always outside of Linux.
+ */
+class PerfCounters
+{
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    PerfCounters(PerfCounters&&) = delete;
+    PerfCounters& operator=(PerfCounters&&) = delete;
+
+    // nullopt if the counter is not supported, scaled if the counters had to be multiplexed
+    [[nodiscard]] std::optional<std::uint64_t> read(PerfEvent event) const;
+
+    [[nodiscard]] static std::string_view getName(PerfEvent event);
+
+private:
+    static constexpr int InvalidFd{-1};
+
+    std::array<int, PerfEventCount> _fds{};
+};
+
+// per iteration values and, when the counts are not zero, per byte and per token ratios of the supported counters
+void setPerfCounters(benchmark::State& state, const PerfCounters& counters, std::size_t bytesCount, std::size_t tokensCount = 0);
+
+} // namespace CPPS::Benchmarks
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <optional>
+#include <sstream>
+
+#include "allocations.hpp"
+#include "corpus.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/source-reader.hpp"
+#include "perf-counters.hpp"
+
+namespace CPPS::Benchmarks {
+
+namespace {
+
+void sourceReaderRead(benchmark::State& state)
+{
+    const std::string corpus = makeCorpus(static_cast<std::size_t>(state.range(0)));
+
+    std::istringstream stream{corpus};
+
+    const ScopedAllocationCount allocations;
+    const PerfCounters perfCounters;
+
+    for (auto _ : state)
+    {
+        stream.clear();
+        stream.seekg(0);
+
+        Diagnosis diagnosis;
+
+        SourceReader reader{diagnosis, stream};
+
+        std::optional<Source> source = reader.read();
+
+        benchmark::DoNotOptimize(source);
+    }
+
+    setAllocationsCounters(state, allocations);
+    setPerfCounters(state, perfCounters, corpus.size());
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(corpus.size()));
+}
+
+} // namespace
+
+BENCHMARK(sourceReaderRead)->Arg(16 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMicrosecond);
+
+} // namespace CPPS::Benchmarks
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+#include "cpps/utility/bump-pointer-allocator.hpp"
+
+namespace CPPS::Benchmarks {
+
+namespace {
+
+struct SmallObject
+{
+    std::uint64_t value{0};
+};
+
+struct NodeLikeObject
+{
+    void* pointers[3]{}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::uint32_t kind{0};
+};
+
+template<typename T>
+void bumpPointerAllocatorAllocate(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        BumpPointerAllocator<1024ULL * 50ULL> allocator;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            benchmark::DoNotOptimize(allocator.allocate<T>());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(T)));
+}
+
+void bumpPointerAllocatorAllocateMixed(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        BumpPointerAllocator<1024ULL * 50ULL> allocator;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            benchmark::DoNotOptimize(allocator.allocate(1 + i % 32, std::size_t{1} << (i % 4)));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(bumpPointerAllocatorAllocate, SmallObject)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK_TEMPLATE(bumpPointerAllocatorAllocate, NodeLikeObject)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK(bumpPointerAllocatorAllocateMixed)->RangeMultiplier(16)->Range(16, 65536);
+
+} // namespace CPPS::Benchmarks
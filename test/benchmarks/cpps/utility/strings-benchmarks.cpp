@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "cpps/grammar/character-literal.hpp"
+#include "cpps/grammar/identifier.hpp"
+#include "cpps/utility/strings.hpp"
+
+namespace CPPS::Benchmarks {
+
+namespace {
+
+void findFirstNotOfSpace(benchmark::State& state)
+{
+    const std::string text = std::string(static_cast<std::size_t>(state.range(0)), ' ') + "value";
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findFirstNotOf(text, isSpace));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void findFirstIdentifierEnd(benchmark::State& state)
+{
+    const std::string text = std::string(static_cast<std::size_t>(state.range(0)), 'a') + ": int = 0;";
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(CPPS::findFirstIdentifierEnd(text));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(findFirstNotOfSpace)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK(findFirstIdentifierEnd)->RangeMultiplier(4)->Range(4, 4096);
+
+} // namespace CPPS::Benchmarks
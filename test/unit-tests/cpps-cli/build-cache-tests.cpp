@@ -0,0 +1,322 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "cpps/diagnosis.hpp"
+#include "cpps-cli/build-cache.hpp"
+#include "cpps-cli/temporary-directory.hpp"
+
+namespace CPPS::CLI {
+
+namespace {
+
+Diagnosis makeDiagnosis(std::string_view name)
+{
+    Diagnosis diagnosis;
+
+    diagnosis.error(fmt::format("{} error", name), SourceLocation{1, 2});
+    diagnosis.error(fmt::format("{} error without location", name), std::string{"the fix"});
+    diagnosis.warning(fmt::format("{} warning", name), SourceLine{3});
+
+    return diagnosis;
+}
+
+// the entries as text, to compare two diagnoses
+std::string format(const Diagnosis& diagnosis)
+{
+    std::string text;
+
+    auto formatEntries = [&text](std::span<const Diagnosis::Entry> entries, std::string_view type) {
+        for (const Diagnosis::Entry& entry : entries)
+        {
+            text += fmt::format("{}: {} {} {}\n",
+                                type,
+                                entry.message,
+                                entry.location ? fmt::format("{}:{}", entry.location->line, entry.location->column) : "-",
+                                entry.fixMessage.value_or("-"));
+        }
+    };
+
+    formatEntries(diagnosis.getErrors(), "error");
+    formatEntries(diagnosis.getWarnings(), "warning");
+
+    return text;
+}
+
+std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream stream{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& content)
+{
+    std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+    stream << content;
+}
+
+bool open(BuildCache& cache)
+{
+    Diagnosis diagnosis;
+
+    const bool isOpened = cache.open(diagnosis);
+
+    CHECK(diagnosis.getErrors().empty());
+
+    return isOpened;
+}
+
+bool flush(BuildCache& cache)
+{
+    Diagnosis diagnosis;
+
+    const bool isFlushed = cache.flush(diagnosis);
+
+    CHECK(diagnosis.getErrors().empty());
+
+    return isFlushed;
+}
+
+} // namespace
+
+TEST_CASE("BuildCache", "[BuildCache]")
+{
+    const TemporaryDirectory directory;
+
+    const Diagnosis settings;
+
+    const BuildCache::Key key = BuildCache::makeKey("a: int = 0;", settings);
+    const Diagnosis diagnosis = makeDiagnosis("a");
+
+    SECTION("key")
+    {
+        CHECK(BuildCache::makeKey("a: int = 0;", settings).hash == key.hash);
+        CHECK(BuildCache::makeKey("a: int = 1;", settings).hash != key.hash);
+        CHECK(key.contentSize == 11);
+        CHECK_FALSE(BuildCache::getBuildId().empty());
+    }
+
+    SECTION("the diagnosis settings are part of the key")
+    {
+        Diagnosis limited;
+        limited.setErrorLimit(1);
+
+        Diagnosis failFast;
+        failFast.setFailFast(true);
+
+        CHECK(BuildCache::makeKey("a: int = 0;", limited).hash != key.hash);
+        CHECK(BuildCache::makeKey("a: int = 0;", failFast).hash != key.hash);
+        CHECK(BuildCache::makeKey("a: int = 0;", failFast).hash != BuildCache::makeKey("a: int = 0;", limited).hash);
+    }
+
+    SECTION("replayed after flush")
+    {
+        BuildCache cache{directory.getPath()};
+        REQUIRE(open(cache));
+
+        cache.add(key, diagnosis);
+
+        Diagnosis replayed;
+
+        CHECK_FALSE(cache.replay(key, replayed));
+
+        REQUIRE(flush(cache));
+
+        REQUIRE(cache.replay(key, replayed));
+        CHECK(format(replayed) == format(diagnosis));
+    }
+
+    SECTION("replayed by another cache")
+    {
+        {
+            BuildCache cache{directory.getPath()};
+            REQUIRE(open(cache));
+
+            cache.add(key, diagnosis);
+            cache.add(BuildCache::makeKey("b", settings), makeDiagnosis("b"));
+
+            REQUIRE(flush(cache));
+        }
+
+        BuildCache cache{directory.getPath()};
+        REQUIRE(open(cache));
+
+        Diagnosis replayed;
+
+        REQUIRE(cache.replay(key, replayed));
+        CHECK(format(replayed) == format(diagnosis));
+
+        Diagnosis otherReplayed;
+
+        REQUIRE(cache.replay(BuildCache::makeKey("b", settings), otherReplayed));
+        CHECK(format(otherReplayed) == format(makeDiagnosis("b")));
+
+        Diagnosis missed;
+
+        CHECK_FALSE(cache.replay(BuildCache::makeKey("c", settings), missed));
+        CHECK(missed.getErrors().empty());
+    }
+
+    SECTION("corrupted data")
+    {
+        {
+            BuildCache cache{directory.getPath()};
+            REQUIRE(open(cache));
+
+            cache.add(key, diagnosis);
+
+            REQUIRE(flush(cache));
+        }
+
+        std::string data = readFile(directory.getPath() / "data");
+        REQUIRE(data.size() > 8);
+
+        data[data.size() / 2] = static_cast<char>(~data[data.size() / 2]);
+        writeFile(directory.getPath() / "data", data);
+
+        BuildCache cache{directory.getPath()};
+        REQUIRE(open(cache));
+
+        // the checksum does not match, nothing is added
+        Diagnosis replayed;
+
+        CHECK_FALSE(cache.replay(key, replayed));
+        CHECK(replayed.getErrors().empty());
+        CHECK(replayed.getWarnings().empty());
+    }
+
+    SECTION("torn index record")
+    {
+        const BuildCache::Key otherKey = BuildCache::makeKey("b", settings);
+
+        {
+            BuildCache cache{directory.getPath()};
+            REQUIRE(open(cache));
+
+            cache.add(key, diagnosis);
+            REQUIRE(flush(cache));
+
+            cache.add(otherKey, makeDiagnosis("b"));
+            REQUIRE(flush(cache));
+        }
+
+        // the last record is partially written
+        const std::string index = readFile(directory.getPath() / "index");
+        writeFile(directory.getPath() / "index", index.substr(0, index.size() - 3));
+
+        BuildCache cache{directory.getPath()};
+        REQUIRE(open(cache));
+
+        Diagnosis replayed;
+
+        CHECK(cache.replay(key, replayed));
+        CHECK_FALSE(cache.replay(otherKey, replayed));
+
+        // the next append truncates the partial record
+        cache.add(otherKey, makeDiagnosis("b"));
+        REQUIRE(flush(cache));
+
+        CHECK(std::filesystem::file_size(directory.getPath() / "index") == index.size());
+
+        BuildCache reopened{directory.getPath()};
+        REQUIRE(open(reopened));
+
+        Diagnosis otherReplayed;
+
+        REQUIRE(reopened.replay(otherKey, otherReplayed));
+        CHECK(format(otherReplayed) == format(makeDiagnosis("b")));
+    }
+
+    SECTION("invalid index header")
+    {
+        writeFile(directory.getPath() / "index", "not a cache index, long enough to hold a header");
+
+        BuildCache cache{directory.getPath()};
+        REQUIRE(open(cache));
+
+        Diagnosis replayed;
+
+        CHECK_FALSE(cache.replay(key, replayed));
+
+        // the cache starts over
+        cache.add(key, diagnosis);
+        REQUIRE(flush(cache));
+
+        BuildCache reopened{directory.getPath()};
+        REQUIRE(open(reopened));
+
+        CHECK(reopened.replay(key, replayed));
+    }
+
+    SECTION("concurrent flushes")
+    {
+        constexpr std::size_t CachesCount{4};
+        constexpr std::size_t EntriesCount{50};
+
+        auto makeName = [](std::size_t cacheIndex, std::size_t entryIndex) { return fmt::format("{} {}", cacheIndex, entryIndex); };
+
+        {
+            std::vector<std::jthread> threads;
+
+            for (std::size_t i = 0; i < CachesCount; ++i)
+            {
+                threads.emplace_back([&directory, &settings, &makeName, i] {
+                    // each cache has its own file descriptors, they are locked as by different processes
+                    BuildCache cache{directory.getPath()};
+
+                    Diagnosis cacheDiagnosis;
+
+                    if (!cache.open(cacheDiagnosis))
+                    {
+                        return;
+                    }
+
+                    for (std::size_t j = 0; j < EntriesCount; ++j)
+                    {
+                        const std::string name = makeName(i, j);
+
+                        cache.add(BuildCache::makeKey(name, settings), makeDiagnosis(name));
+
+                        if (!cache.flush(cacheDiagnosis))
+                        {
+                            return;
+                        }
+                    }
+                });
+            }
+        }
+
+        BuildCache cache{directory.getPath()};
+        REQUIRE(open(cache));
+
+        std::size_t replayedCount = 0;
+
+        for (std::size_t i = 0; i < CachesCount; ++i)
+        {
+            for (std::size_t j = 0; j < EntriesCount; ++j)
+            {
+                const std::string name = makeName(i, j);
+
+                Diagnosis replayed;
+
+                if (cache.replay(BuildCache::makeKey(name, settings), replayed) && format(replayed) == format(makeDiagnosis(name)))
+                {
+                    ++replayedCount;
+                }
+            }
+        }
+
+        CHECK(replayedCount == CachesCount * EntriesCount);
+    }
+}
+
+} // namespace CPPS::CLI
@@ -0,0 +1,301 @@
+#include <catch2/catch_test_macros.hpp>
+
+#if !defined(_WIN32)
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "cpps-cli/compile-server.hpp"
+#include "cpps-cli/temporary-directory.hpp"
+
+namespace CPPS::CLI {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct FileCloser
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+// a raw connection to the server, to send partial requests
+class Connection
+{
+public:
+    explicit Connection(const std::filesystem::path& socketPath)
+        : _fd(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0))
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        socketPath.native().copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+        _isConnected = _fd >= 0 && connect(_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    }
+
+    ~Connection()
+    {
+        close();
+    }
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+    Connection(Connection&&) = delete;
+    Connection& operator=(Connection&&) = delete;
+
+    [[nodiscard]] bool isConnected() const
+    {
+        return _isConnected;
+    }
+
+    bool send(const void* data, std::size_t size) const
+    {
+        return ::send(_fd, data, size, MSG_NOSIGNAL) == static_cast<ssize_t>(size);
+    }
+
+    // the response exit code, nullopt if the server closed the connection without responding
+    [[nodiscard]] std::optional<std::int32_t> receiveExitCode() const
+    {
+        std::int32_t exitCode = 0;
+
+        if (recv(_fd, &exitCode, sizeof(exitCode), MSG_WAITALL) != static_cast<ssize_t>(sizeof(exitCode)))
+        {
+            return std::nullopt;
+        }
+
+        return exitCode;
+    }
+
+    void close()
+    {
+        if (_fd >= 0)
+        {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+private:
+    int _fd;
+    bool _isConnected{false};
+};
+
+// runs a server until destroyed
+class ServerRunner
+{
+public:
+    ServerRunner(const std::filesystem::path& socketPath, std::size_t connectionsCount, std::chrono::milliseconds receiveTimeout)
+        : _server(socketPath, connectionsCount, receiveTimeout)
+        , _exitCode(std::async(std::launch::async, [this] { return _server.run(); }))
+    {
+        // listening once a connection succeeds
+        for (auto time = 0ms; time < 5s && !Connection{socketPath}.isConnected(); time += 10ms)
+        {
+            std::this_thread::sleep_for(10ms);
+        }
+    }
+
+    ~ServerRunner()
+    {
+        _server.stop();
+    }
+
+    ServerRunner(const ServerRunner&) = delete;
+    ServerRunner& operator=(const ServerRunner&) = delete;
+    ServerRunner(ServerRunner&&) = delete;
+    ServerRunner& operator=(ServerRunner&&) = delete;
+
+    [[nodiscard]] CompileServer& getServer()
+    {
+        return _server;
+    }
+
+    [[nodiscard]] std::future<int>& getExitCode()
+    {
+        return _exitCode;
+    }
+
+private:
+    CompileServer _server;
+    std::future<int> _exitCode;
+};
+
+struct ClientResult
+{
+    int exitCode;
+    std::string output;
+};
+
+ClientResult runClient(const std::filesystem::path& socketPath, const std::vector<std::string>& arguments)
+{
+    const std::unique_ptr<std::FILE, FileCloser> file{std::tmpfile()};
+    REQUIRE(file != nullptr);
+
+    CompileClient client{socketPath, file.get()};
+
+    ClientResult result{.exitCode = client.run(arguments), .output = {}};
+
+    std::rewind(file.get());
+
+    for (int c = std::fgetc(file.get()); c != EOF; c = std::fgetc(file.get()))
+    {
+        result.output += static_cast<char>(c);
+    }
+
+    return result;
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& content)
+{
+    std::ofstream stream{path};
+    stream << content;
+}
+
+} // namespace
+
+TEST_CASE("CompileServer", "[CompileServer]")
+{
+    const TemporaryDirectory directory;
+
+    const std::filesystem::path socketPath = directory.getPath() / "server.socket";
+    const std::filesystem::path valid = directory.getPath() / "valid.cpp2";
+    const std::filesystem::path invalid = directory.getPath() / "invalid.cpp2";
+
+    writeFile(valid, "a: int = 0;\n");
+    writeFile(invalid, "a: int = @;\n");
+
+    SECTION("round trip")
+    {
+        ServerRunner runner{socketPath, 2, CompileServer::DefaultReceiveTimeout};
+
+        const ClientResult validResult = runClient(socketPath, {"cpps-cli", valid.string()});
+
+        CHECK(validResult.exitCode == 0);
+        CHECK(validResult.output == "1 files, 0 errors, 0 warnings\n");
+
+        const ClientResult invalidResult = runClient(socketPath, {"cpps-cli", invalid.string(), valid.string()});
+
+        CHECK(invalidResult.exitCode == 1);
+        CHECK(invalidResult.output.starts_with(invalid.string() + ":1:8: error: "));
+        CHECK(invalidResult.output.ends_with("2 files, 2 errors, 0 warnings\n"));
+
+        const ClientResult rejectedResult = runClient(socketPath, {"cpps-cli", "--watch", valid.string()});
+
+        CHECK(rejectedResult.exitCode == 1);
+        CHECK(rejectedResult.output.find("not supported by the compile server") != std::string::npos);
+
+        const ClientResult rejectedOutputResult = runClient(socketPath, {"cpps-cli", "--watch", "--output-dir", "out", valid.string()});
+
+        CHECK(rejectedOutputResult.exitCode == 1);
+        CHECK(rejectedOutputResult.output.find("--output-dir is not supported with --watch") != std::string::npos);
+    }
+
+    SECTION("concurrent clients")
+    {
+        ServerRunner runner{socketPath, 2, CompileServer::DefaultReceiveTimeout};
+
+        std::vector<std::future<ClientResult>> results;
+
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            results.push_back(std::async(std::launch::async, [&socketPath, &invalid, &valid] {
+                return runClient(socketPath, {"cpps-cli", "-j", "4", invalid.string(), valid.string()});
+            }));
+        }
+
+        for (std::future<ClientResult>& result : results)
+        {
+            const ClientResult clientResult = result.get();
+
+            CHECK(clientResult.exitCode == 1);
+            CHECK(clientResult.output.ends_with("2 files, 2 errors, 0 warnings\n"));
+        }
+    }
+
+    SECTION("client disconnected during its request")
+    {
+        ServerRunner runner{socketPath, 1, CompileServer::DefaultReceiveTimeout};
+
+        {
+            Connection connection{socketPath};
+            REQUIRE(connection.isConnected());
+
+            // the payload is announced larger than sent
+            const std::array<std::uint32_t, 2> header{CompileServer::ProtocolVersion, 100};
+
+            REQUIRE(connection.send(header.data(), sizeof(header)));
+            REQUIRE(connection.send("/tmp", 4));
+        }
+
+        const ClientResult result = runClient(socketPath, {"cpps-cli", valid.string()});
+
+        CHECK(result.exitCode == 0);
+    }
+
+    SECTION("mismatched protocol version")
+    {
+        ServerRunner runner{socketPath, 1, CompileServer::DefaultReceiveTimeout};
+
+        Connection connection{socketPath};
+        REQUIRE(connection.isConnected());
+
+        const std::array<std::uint32_t, 2> header{CompileServer::ProtocolVersion + 1, 0};
+
+        REQUIRE(connection.send(header.data(), sizeof(header)));
+
+        CHECK(connection.receiveExitCode() == 1);
+    }
+
+    SECTION("idle client disconnected after the receive timeout")
+    {
+        ServerRunner runner{socketPath, 1, 100ms};
+
+        Connection idle{socketPath};
+        REQUIRE(idle.isConnected());
+
+        // served by the single connection thread once the idle client timed out
+        const ClientResult result = runClient(socketPath, {"cpps-cli", valid.string()});
+
+        CHECK(result.exitCode == 0);
+        CHECK_FALSE(idle.receiveExitCode().has_value());
+    }
+
+    SECTION("stopped with an idle client")
+    {
+        ServerRunner runner{socketPath, 1, 60s};
+
+        Connection idle{socketPath};
+        REQUIRE(idle.isConnected());
+
+        // the connection is served
+        std::this_thread::sleep_for(50ms);
+
+        runner.getServer().stop();
+
+        REQUIRE(runner.getExitCode().wait_for(5s) == std::future_status::ready);
+        CHECK(runner.getExitCode().get() == 0);
+
+        CHECK_FALSE(std::filesystem::exists(socketPath));
+    }
+}
+
+} // namespace CPPS::CLI
+
+#endif
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "cpps/diagnosis.hpp"
+#include "cpps-cli/build-cache.hpp"
+#include "cpps-cli/driver.hpp"
+#include "cpps-cli/temporary-directory.hpp"
+
+namespace CPPS::CLI {
+
+namespace {
+
+struct FileCloser
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+struct DriverResult
+{
+    int exitCode;
+    std::string output;
+};
+
+std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream stream{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& content)
+{
+    std::filesystem::create_directories(path.parent_path());
+
+    std::ofstream stream{path, std::ios::trunc};
+    stream << content;
+}
+
+DriverOptions makeOptions(const std::filesystem::path& directory, std::vector<std::filesystem::path> inputs)
+{
+    DriverOptions options;
+    options.inputs = std::move(inputs);
+    options.threadsCount = 1;
+    options.workingDirectory = directory;
+
+    return options;
+}
+
+DriverResult runDriver(DriverOptions options, BuildCache* cache = nullptr)
+{
+    const std::unique_ptr<std::FILE, FileCloser> file{std::tmpfile()};
+    REQUIRE(file != nullptr);
+
+    Driver driver{std::move(options), file.get(), cache};
+
+    DriverResult result{.exitCode = driver.run(), .output = {}};
+
+    std::rewind(file.get());
+
+    for (int c = std::fgetc(file.get()); c != EOF; c = std::fgetc(file.get()))
+    {
+        result.output += static_cast<char>(c);
+    }
+
+    return result;
+}
+
+// generates to the "out" directory
+DriverResult runDriver(const std::filesystem::path& directory, std::vector<std::filesystem::path> inputs)
+{
+    DriverOptions options = makeOptions(directory, std::move(inputs));
+    options.outputDirectory = "out";
+
+    return runDriver(std::move(options));
+}
+
+std::size_t countLines(const std::string& text, std::string_view pattern)
+{
+    std::size_t count = 0;
+
+    for (std::size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + pattern.size()))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+// the files left in the output directory, relative to it
+std::vector<std::filesystem::path> listOutputs(const std::filesystem::path& directory)
+{
+    std::vector<std::filesystem::path> outputs;
+
+    if (!std::filesystem::exists(directory / "out"))
+    {
+        return outputs;
+    }
+
+    for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator{directory / "out"})
+    {
+        if (entry.is_regular_file())
+        {
+            outputs.push_back(entry.path().lexically_relative(directory / "out"));
+        }
+    }
+
+    std::sort(outputs.begin(), outputs.end());
+
+    return outputs;
+}
+
+} // namespace
+
+TEST_CASE("Driver output directory", "[Driver]")
+{
+    const TemporaryDirectory temporaryDirectory;
+
+    const std::filesystem::path& directory = temporaryDirectory.getPath();
+
+    writeFile(directory / "src" / "a" / "x.cpp2", "a: int = 0;\n");
+    writeFile(directory / "src" / "b" / "x.cpp2", "b: int = 0;\n");
+    writeFile(directory / "src" / "b" / "y.h2", "y: int = 0;\n");
+
+    SECTION("the files of an input directory keep their relative paths")
+    {
+        const DriverResult result = runDriver(directory, {"src"});
+
+        CHECK(result.exitCode == 0);
+        CHECK(listOutputs(directory) == std::vector<std::filesystem::path>{"a/x.cpp", "b/x.cpp", "b/y.h"});
+
+        const std::string output = readFile(directory / "out" / "a" / "x.cpp");
+        CHECK(output.starts_with("#line 1 \"" + (directory / "src" / "a" / "x.cpp2").string() + "\"\n"));
+        CHECK(output.ends_with("int a = 0;\n"));
+    }
+
+    SECTION("inputs generated to the same file")
+    {
+        const DriverResult result = runDriver(directory, {"src/a/x.cpp2", "src/b/x.cpp2"});
+
+        CHECK(result.exitCode == 1);
+        CHECK(result.output.find("inputs src/a/x.cpp2 and src/b/x.cpp2 are both generated to") != std::string::npos);
+        CHECK(listOutputs(directory) == std::vector<std::filesystem::path>{"x.cpp"});
+        CHECK(readFile(directory / "out" / "x.cpp").ends_with("int a = 0;\n"));
+    }
+
+    SECTION("the output of an input with errors is removed")
+    {
+        REQUIRE(runDriver(directory, {"src/a"}).exitCode == 0);
+        REQUIRE(listOutputs(directory) == std::vector<std::filesystem::path>{"x.cpp"});
+
+        writeFile(directory / "src" / "a" / "x.cpp2", "a: int = @;\n");
+
+        CHECK(runDriver(directory, {"src/a"}).exitCode == 1);
+        CHECK(listOutputs(directory).empty());
+    }
+
+    SECTION("an input which cannot be generated leaves no output")
+    {
+        writeFile(directory / "src" / "a" / "x.cpp2", "f: () -> (out r: int) = {}\n");
+
+        CHECK(runDriver(directory, {"src/a"}).exitCode == 1);
+        CHECK(listOutputs(directory).empty());
+    }
+}
+
+TEST_CASE("Driver error limit", "[Driver]")
+{
+    const TemporaryDirectory temporaryDirectory;
+
+    const std::filesystem::path& directory = temporaryDirectory.getPath();
+
+    std::string source;
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        source += fmt::format("a{}: int = @;\n", i);
+    }
+
+    writeFile(directory / "x.cpp2", source);
+
+    DriverOptions options = makeOptions(directory, {"x.cpp2"});
+    options.errorLimit = 3;
+
+    SECTION("the errors after the limit are not reported")
+    {
+        const DriverResult result = runDriver(std::move(options));
+
+        CHECK(result.exitCode == 1);
+        CHECK(countLines(result.output, ": error: ") == 3);
+        CHECK(result.output.find("stopped after") == std::string::npos);
+        CHECK(result.output.ends_with("1 files, 200 errors, 0 warnings\n197 errors not reported (limit is 3)\n"));
+    }
+
+    SECTION("fail-fast stops at the limit")
+    {
+        options.failFast = true;
+
+        const DriverResult result = runDriver(std::move(options));
+
+        CHECK(result.exitCode == 1);
+        CHECK(countLines(result.output, ": error: ") == 3);
+        CHECK(result.output.find("x.cpp2: lex: stopped after 3 lines, 97 lines skipped\n") != std::string::npos);
+        CHECK(result.output.ends_with("1 files, 3 errors, 0 warnings\n"));
+    }
+}
+
+TEST_CASE("Driver error limit cache", "[Driver]")
+{
+    const TemporaryDirectory temporaryDirectory;
+
+    const std::filesystem::path& directory = temporaryDirectory.getPath();
+
+    std::string source;
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        source += fmt::format("a{}: int = @;\n", i);
+    }
+
+    writeFile(directory / "x.cpp2", source);
+
+    BuildCache cache{directory / "cache"};
+
+    Diagnosis cacheDiagnosis;
+    REQUIRE(cache.open(cacheDiagnosis));
+
+    auto run = [&directory, &cache](std::size_t errorLimit) {
+        DriverOptions options = makeOptions(directory, {"x.cpp2"});
+        options.errorLimit = errorLimit;
+        options.timeReport = true;
+
+        return runDriver(std::move(options), &cache);
+    };
+
+    const DriverResult first = run(3);
+
+    CHECK(countLines(first.output, ": error: ") == 3);
+    CHECK(first.output.find("build cache: 0 hits, 1 misses\n") != std::string::npos);
+
+    SECTION("the same limit replays the diagnoses")
+    {
+        const DriverResult second = run(3);
+
+        CHECK(countLines(second.output, ": error: ") == 3);
+        CHECK(second.output.find("build cache: 1 hits, 0 misses\n") != std::string::npos);
+    }
+
+    SECTION("another limit does not replay the diagnoses")
+    {
+        const DriverResult second = run(5);
+
+        CHECK(countLines(second.output, ": error: ") == 5);
+        CHECK(second.output.find("build cache: 0 hits, 1 misses\n") != std::string::npos);
+    }
+}
+
+} // namespace CPPS::CLI
@@ -0,0 +1,44 @@
+#include "cpps-cli/temporary-directory.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <system_error>
+
+#include <fmt/format.h>
+
+namespace CPPS::CLI {
+
+namespace {
+
+// unique between the test processes running in parallel, and between the directories of a process
+std::string makeDirectoryName()
+{
+    static std::atomic<std::size_t> counter{0};
+    static const unsigned processKey = std::random_device{}();
+
+    return fmt::format("cpps-cli-tests-{:08x}-{}", processKey, counter++);
+}
+
+} // namespace
+
+TemporaryDirectory::TemporaryDirectory()
+    : _path(std::filesystem::temp_directory_path() / makeDirectoryName())
+{
+    std::filesystem::remove_all(_path);
+    std::filesystem::create_directories(_path);
+}
+
+TemporaryDirectory::~TemporaryDirectory()
+{
+    std::error_code error;
+    std::filesystem::remove_all(_path, error);
+}
+
+const std::filesystem::path& TemporaryDirectory::getPath() const
+{
+    return _path;
+}
+
+} // namespace CPPS::CLI
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+
+namespace CPPS::CLI {
+
+// a new empty directory, removed with its content on destruction
+class TemporaryDirectory
+{
+public:
+    TemporaryDirectory();
+    ~TemporaryDirectory();
+
+    TemporaryDirectory(const TemporaryDirectory&) = delete;
+    TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+    TemporaryDirectory(TemporaryDirectory&&) = delete;
+    TemporaryDirectory& operator=(TemporaryDirectory&&) = delete;
+
+    [[nodiscard]] const std::filesystem::path& getPath() const;
+
+private:
+    std::filesystem::path _path;
+};
+
+} // namespace CPPS::CLI
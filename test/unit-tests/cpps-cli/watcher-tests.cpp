@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+
+#if defined(__linux__)
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "cpps-cli/driver.hpp"
+#include "cpps-cli/temporary-directory.hpp"
+#include "cpps-cli/watcher.hpp"
+
+namespace CPPS::CLI {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+void writeFile(const std::filesystem::path& path, const std::string& content)
+{
+    std::ofstream stream{path, std::ios::trunc};
+    stream << content;
+}
+
+DriverOptions makeOptions(const std::filesystem::path& input)
+{
+    DriverOptions options;
+    options.inputs = {input};
+    options.threadsCount = 1;
+
+    return options;
+}
+
+// the changes of the next events, waited for at most a second
+std::set<std::filesystem::path> waitForChanges(Watcher& watcher)
+{
+    std::set<std::filesystem::path> changedFiles;
+
+    CHECK(watcher.waitForChanges(changedFiles, 1s));
+
+    return changedFiles;
+}
+
+} // namespace
+
+TEST_CASE("Watcher", "[Watcher]")
+{
+    const TemporaryDirectory temporaryDirectory;
+
+    const std::filesystem::path directory = std::filesystem::canonical(temporaryDirectory.getPath());
+    const std::filesystem::path a = directory / "a.cpp2";
+    const std::filesystem::path b = directory / "b.cpp2";
+
+    std::filesystem::create_directory(directory / "sub");
+    std::filesystem::create_directory_symlink(directory, directory / "link");
+
+    writeFile(a, "a: int = 0;\n");
+    writeFile(b, "b: int = 0;\n");
+
+    SECTION("input file given with dot segments")
+    {
+        Watcher watcher{makeOptions(directory / "sub" / ".." / "." / "a.cpp2")};
+        REQUIRE(watcher.start());
+
+        writeFile(a, "a: int = 1;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{a});
+
+        // only the input file of its directory is watched
+        writeFile(b, "b: int = 1;\n");
+
+        CHECK(waitForChanges(watcher).empty());
+    }
+
+    SECTION("input file given through a symbolic link")
+    {
+        Watcher watcher{makeOptions(directory / "link" / "a.cpp2")};
+        REQUIRE(watcher.start());
+
+        writeFile(a, "a: int = 1;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{a});
+
+        writeFile(directory / "link" / "a.cpp2", "a: int = 2;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{a});
+    }
+
+    SECTION("input directory given through a symbolic link")
+    {
+        Watcher watcher{makeOptions(directory / "link")};
+        REQUIRE(watcher.start());
+
+        writeFile(directory / "sub" / "c.cpp2", "c: int = 0;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{directory / "sub" / "c.cpp2"});
+
+        writeFile(directory / "link" / "b.cpp2", "b: int = 1;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{b});
+    }
+
+    SECTION("relative input file")
+    {
+        DriverOptions options = makeOptions("../a.cpp2");
+        options.workingDirectory = directory / "sub";
+
+        Watcher watcher{std::move(options)};
+        REQUIRE(watcher.start());
+
+        writeFile(a, "a: int = 1;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{a});
+    }
+
+    SECTION("debounced")
+    {
+        Watcher watcher{makeOptions(directory), 300ms};
+        REQUIRE(watcher.start());
+
+        // written within the debounce time, collected together
+        writeFile(a, "a: int = 1;\n");
+        std::this_thread::sleep_for(50ms);
+        writeFile(b, "b: int = 1;\n");
+        std::this_thread::sleep_for(50ms);
+        writeFile(a, "a: int = 2;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{a, b});
+
+        // nothing is left
+        CHECK(waitForChanges(watcher).empty());
+    }
+
+    SECTION("not debounced")
+    {
+        Watcher watcher{makeOptions(directory), 0ms};
+        REQUIRE(watcher.start());
+
+        writeFile(a, "a: int = 1;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{a});
+
+        std::this_thread::sleep_for(100ms);
+        writeFile(b, "b: int = 1;\n");
+
+        CHECK(waitForChanges(watcher) == std::set{b});
+    }
+
+    SECTION("timeout")
+    {
+        Watcher watcher{makeOptions(directory)};
+        REQUIRE(watcher.start());
+
+        std::set<std::filesystem::path> changedFiles;
+
+        const auto startTime = std::chrono::steady_clock::now();
+
+        CHECK(watcher.waitForChanges(changedFiles, 50ms));
+        CHECK(changedFiles.empty());
+        CHECK(std::chrono::steady_clock::now() - startTime >= 50ms);
+    }
+}
+
+} // namespace CPPS::CLI
+
+#endif
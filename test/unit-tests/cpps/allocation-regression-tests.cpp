@@ -0,0 +1,195 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <fmt/format.h>
+#include <optional>
+#include <sstream>
+
+#include "cpps/check-diagnosis.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+#include "cpps/tokens.hpp"
+#include "cpps/utility/allocation-counter.hpp"
+
+namespace CPPS {
+
+namespace {
+
+// allocations of the vectors growing geometrically up to size elements
+std::size_t getGrowthAllocationsCount(std::size_t vectorsCount, std::size_t size)
+{
+    std::size_t growthsCount = 1;
+
+    for (std::size_t capacity = 1; capacity < size; capacity *= 2)
+    {
+        ++growthsCount;
+    }
+
+    return vectorsCount * growthsCount + 16;
+}
+
+std::string repeatLine(std::string_view line, std::size_t count)
+{
+    std::string text;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        fmt::format_to(std::back_inserter(text), "{}\n", line);
+    }
+
+    return text;
+}
+
+Source read(const std::string& text)
+{
+    Diagnosis diagnosis;
+
+    std::istringstream stream{text};
+
+    SourceReader reader{diagnosis, stream};
+
+    std::optional<Source> source = reader.read();
+
+    checkNoErrorOrWarning(diagnosis);
+    REQUIRE(source);
+
+    return std::move(*source);
+}
+
+} // namespace
+
+// the bounds describe the current behavior, lower them when an allocation is removed from a hot path
+TEST_CASE("Allocation regressions", "[Allocations]")
+{
+    REQUIRE(AllocationCounter::isHooked());
+
+    const std::size_t linesCount = GENERATE(as<std::size_t>{}, 100, 1000, 10000);
+
+    SECTION("SourceReader allocates one string per line")
+    {
+        const std::string text = repeatLine("a_long_variable_name: int = a + b * c;", linesCount);
+
+        Diagnosis diagnosis;
+
+        std::istringstream stream{text};
+
+        SourceReader reader{diagnosis, stream};
+
+        const ScopedAllocationCount allocations;
+
+        std::optional<Source> source = reader.read();
+
+        const AllocationCount count = allocations.get();
+
+        REQUIRE(source);
+        CHECK(count.count <= linesCount + getGrowthAllocationsCount(1, linesCount));
+    }
+
+    SECTION("Lexer allocations only grow the token vectors")
+    {
+        const Source source = read(repeatLine("value: int = a + b * c;", linesCount));
+
+        Diagnosis diagnosis;
+
+        Lexer lexer{diagnosis, source};
+
+        const ScopedAllocationCount allocations;
+
+        Tokens tokens = lexer.lex();
+
+        const AllocationCount count = allocations.get();
+
+        checkNoErrorOrWarning(diagnosis);
+        CHECK(count.count <= getGrowthAllocationsCount(4, tokens.size()));
+    }
+
+    SECTION("Lexer allocates the comment texts")
+    {
+        const Source source = read(repeatLine("value: int = /* a comment longer than a short string */ 1;", linesCount));
+
+        Diagnosis diagnosis;
+
+        Lexer lexer{diagnosis, source};
+
+        const ScopedAllocationCount allocations;
+
+        Tokens tokens = lexer.lex();
+
+        const AllocationCount count = allocations.get();
+
+        checkNoErrorOrWarning(diagnosis);
+        REQUIRE(tokens.comments().size() == linesCount);
+
+        // the text is appended char by char, growing a few times per comment
+        CHECK(count.count <= 4 * linesCount + getGrowthAllocationsCount(4, tokens.size()));
+    }
+
+    SECTION("Parser allocates the node lists of the expressions")
+    {
+        const Source source = read(repeatLine("value: int = a + b * c;", linesCount));
+
+        Diagnosis diagnosis;
+
+        Lexer lexer{diagnosis, source};
+
+        Tokens tokens = lexer.lex();
+
+        CST::Parser parser{diagnosis, tokens};
+
+        const ScopedAllocationCount allocations;
+
+        CST::TranslationUnit translationUnit = parser.parse();
+
+        const AllocationCount count = allocations.get();
+
+        checkNoErrorOrWarning(diagnosis);
+        REQUIRE(translationUnit.declarations.size() == linesCount);
+
+        // one NodeList per binary expression, each with its vector
+        CHECK(count.count <= 2 * linesCount + translationUnit.allocator.getBlockCount() + getGrowthAllocationsCount(1, linesCount));
+    }
+
+    SECTION("Parser stores the postfix terms in the allocator")
+    {
+        const Source source = read(repeatLine("value: int = a.b.c++--;", linesCount));
+
+        Diagnosis diagnosis;
+
+        Lexer lexer{diagnosis, source};
+
+        Tokens tokens = lexer.lex();
+
+        CST::Parser parser{diagnosis, tokens};
+
+        const ScopedAllocationCount allocations;
+
+        CST::TranslationUnit translationUnit = parser.parse();
+
+        const AllocationCount count = allocations.get();
+
+        checkNoErrorOrWarning(diagnosis);
+        REQUIRE(translationUnit.declarations.size() == linesCount);
+
+        CHECK(count.count <= translationUnit.allocator.getBlockCount() + getGrowthAllocationsCount(1, linesCount));
+    }
+
+    SECTION("Diagnosis messages are not formatted when added")
+    {
+        Diagnosis diagnosis;
+
+        const ScopedAllocationCount allocations;
+
+        for (SourceLine line = 0; line < linesCount; ++line)
+        {
+            diagnosis.error("literal message", SourceLocation{line, 0});
+            diagnosis.warning(Diagnosis::Message{"unexpected char '{}'", 'c'}, SourceLocation{line, 0});
+        }
+
+        const AllocationCount count = allocations.get();
+
+        CHECK(count.count <= getGrowthAllocationsCount(2, linesCount));
+    }
+}
+
+} // namespace CPPS
@@ -61,7 +61,7 @@ void checkNoErrorOrWarning(const Diagnosis& diagnosis)
     }
 }
 
-void checkDiagnosis(std::span<const Diagnosis::Entry> entries, std::string_view type, std::string_view msg, SourceLocation location)
+void checkDiagnosis(std::span<const Diagnosis::Entry> entries, std::string_view type, const Diagnosis::Message& msg, SourceLocation location)
 {
     REQUIRE_FALSE(entries.empty());
 
@@ -77,12 +77,12 @@ void checkDiagnosis(std::span<const Diagnosis::Entry> entries, std::string_view
     }
 }
 
-void checkError(const Diagnosis& diagnosis, const std::string& msg, SourceLocation location)
+void checkError(const Diagnosis& diagnosis, const Diagnosis::Message& msg, SourceLocation location)
 {
     checkDiagnosis(diagnosis.getErrors(), "error", msg, location);
 }
 
-void checkWarning(const Diagnosis& diagnosis, const std::string& msg, SourceLocation location)
+void checkWarning(const Diagnosis& diagnosis, const Diagnosis::Message& msg, SourceLocation location)
 {
     checkDiagnosis(diagnosis.getWarnings(), "warning", msg, location);
 }
@@ -2,16 +2,14 @@
 
 #include <string>
 
-namespace CPPS {
-
-class Diagnosis;
+#include "cpps/diagnosis.hpp"
 
-struct SourceLocation;
+namespace CPPS {
 
 void checkNoWarning(const Diagnosis& diagnosis);
 void checkNoError(const Diagnosis& diagnosis);
 void checkNoErrorOrWarning(const Diagnosis& diagnosis);
-void checkError(const Diagnosis& diagnosis, const std::string& msg, SourceLocation location);
-void checkWarning(const Diagnosis& diagnosis, const std::string& msg, SourceLocation location);
+void checkError(const Diagnosis& diagnosis, const Diagnosis::Message& msg, SourceLocation location);
+void checkWarning(const Diagnosis& diagnosis, const Diagnosis::Message& msg, SourceLocation location);
 
 } // namespace CPPS
@@ -0,0 +1,239 @@
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <thread>
+
+#include "cpps/concurrent-diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source.hpp"
+#include "cpps/tokens.hpp"
+
+namespace CPPS {
+
+namespace {
+
+std::vector<Source> makeSources()
+{
+    std::vector<Source> sources;
+
+    for (std::size_t file = 0; file < 16; ++file)
+    {
+        Source& source = sources.emplace_back();
+
+        for (std::size_t line = 0; line < 8; ++line)
+        {
+            source.add(line % 3 == file % 3 ? std::string{"a: int = @;"} : std::string{"a: int = 0;"}, Source::Line::Type::Cpps);
+        }
+
+        source.add("b: int = 0x;", Source::Line::Type::Cpps);
+    }
+
+    return sources;
+}
+
+std::string lexAndMerge(const std::vector<Source>& sources, std::size_t threadsCount)
+{
+    ConcurrentDiagnosis diagnosis;
+
+    {
+        std::vector<std::jthread> threads;
+
+        for (std::size_t t = 0; t < threadsCount; ++t)
+        {
+            threads.emplace_back([&diagnosis, &sources, t, threadsCount] {
+                // reverse order to create the shards out of file order
+                for (std::size_t i = sources.size(); i-- > 0;)
+                {
+                    if (i % threadsCount == t)
+                    {
+                        Lexer lexer{diagnosis.createShard(i), sources[i]};
+                        [[maybe_unused]] const Tokens tokens = lexer.lex();
+                    }
+                }
+            });
+        }
+    }
+
+    const ConcurrentDiagnosis::Merged merged = diagnosis.merge();
+
+    CHECK(merged.errors.size() == diagnosis.getErrorsCount());
+
+    std::string text;
+
+    for (const ConcurrentDiagnosis::Entry& entry : merged.errors)
+    {
+        text += fmt::format("{} ({}): {}\n", entry.file, *entry.entry.location, entry.entry.message);
+    }
+
+    return text;
+}
+
+} // namespace
+
+TEST_CASE("ConcurrentDiagnosis merge order", "[Diagnosis], [ConcurrentDiagnosis]")
+{
+    ConcurrentDiagnosis diagnosis;
+
+    Diagnosis& file1 = diagnosis.createShard(1);
+    Diagnosis& file0part1 = diagnosis.createShard(0, 1);
+    Diagnosis& file0part0 = diagnosis.createShard(0, 0);
+
+    file1.error("file 1", SourceLocation{0, 0});
+    file0part1.error("file 0 part 1 line 2", SourceLocation{2, 0});
+    file0part0.error("file 0 part 0 line 3", SourceLocation{3, 0});
+    file0part0.error("file 0 part 0 line 1 column 5", SourceLocation{1, 5});
+    file0part0.error("file 0 part 0 line 1 column 5 again", SourceLocation{1, 5});
+    file0part0.error("file 0 part 0 no location");
+    file0part0.warning("file 0 warning");
+
+    const ConcurrentDiagnosis::Merged merged = diagnosis.merge();
+
+    REQUIRE(merged.errors.size() == 6);
+    REQUIRE(merged.warnings.size() == 1);
+
+    CHECK(merged.errors[0].entry.message == "file 0 part 0 no location");
+    CHECK(merged.errors[1].entry.message == "file 0 part 0 line 1 column 5");
+    CHECK(merged.errors[2].entry.message == "file 0 part 0 line 1 column 5 again");
+    CHECK(merged.errors[3].entry.message == "file 0 part 1 line 2");
+    CHECK(merged.errors[4].entry.message == "file 0 part 0 line 3");
+    CHECK(merged.errors[5].entry.message == "file 1");
+    CHECK(merged.errors[5].file == 1);
+
+    CHECK(merged.warnings[0].entry.message == "file 0 warning");
+}
+
+TEST_CASE("ConcurrentDiagnosis skipped works", "[Diagnosis], [ConcurrentDiagnosis]")
+{
+    ConcurrentDiagnosis diagnosis;
+
+    Diagnosis& file1 = diagnosis.createShard(1);
+    Diagnosis& file0part1 = diagnosis.createShard(0, 1);
+    Diagnosis& file0part0 = diagnosis.createShard(0, 0);
+
+    file1.skip(Diagnosis::Phase::Lex, {.processedCount = 1, .skippedCount = 2});
+    file0part1.skip(Diagnosis::Phase::Parse, {.processedCount = 3, .skippedCount = 4});
+    file0part0.skip(Diagnosis::Phase::Parse, {.processedCount = 5, .skippedCount = 6});
+    file0part0.skip(Diagnosis::Phase::Read, {.processedCount = 7, .skippedCount = 8});
+
+    const ConcurrentDiagnosis::Merged merged = diagnosis.merge();
+
+    REQUIRE(merged.skippedWorks.size() == 3);
+
+    CHECK(merged.skippedWorks[0].file == 0);
+    CHECK(merged.skippedWorks[0].phase == Diagnosis::Phase::Read);
+    CHECK(merged.skippedWorks[0].work.processedCount == 7);
+
+    CHECK(merged.skippedWorks[1].file == 0);
+    CHECK(merged.skippedWorks[1].phase == Diagnosis::Phase::Parse);
+    CHECK(merged.skippedWorks[1].work.processedCount == 8);
+    CHECK(merged.skippedWorks[1].work.skippedCount == 10);
+
+    CHECK(merged.skippedWorks[2].file == 1);
+    CHECK(merged.skippedWorks[2].phase == Diagnosis::Phase::Lex);
+
+    CHECK(Diagnosis::formatSkippedWork(merged.skippedWorks[2].phase, merged.skippedWorks[2].work) == "lex: stopped after 1 lines, 2 lines skipped");
+}
+
+TEST_CASE("ConcurrentDiagnosis shard settings", "[Diagnosis], [ConcurrentDiagnosis]")
+{
+    ConcurrentDiagnosis diagnosis;
+
+    diagnosis.setErrorLimit(1);
+    diagnosis.setFailFast(true);
+
+    Diagnosis& shard = diagnosis.createShard(0);
+
+    CHECK(shard.getErrorLimit() == 1);
+    CHECK(shard.isFailFast());
+}
+
+TEST_CASE("ConcurrentDiagnosis shared error limit", "[Diagnosis], [ConcurrentDiagnosis]")
+{
+    ConcurrentDiagnosis diagnosis;
+
+    SECTION("the limit applies to all the shards")
+    {
+        diagnosis.setErrorLimit(3);
+
+        Diagnosis& file1 = diagnosis.createShard(1);
+        Diagnosis& file0 = diagnosis.createShard(0);
+
+        for (SourceLine line = 0; line < 3; ++line)
+        {
+            file1.error("file 1", SourceLocation{line, 0});
+            file0.error("file 0", SourceLocation{line, 0});
+        }
+
+        CHECK(diagnosis.getErrorsCount() == 6);
+
+        const ConcurrentDiagnosis::Merged merged = diagnosis.merge();
+
+        REQUIRE(merged.errors.size() == 3);
+        CHECK(merged.droppedErrorsCount == 3);
+
+        for (const ConcurrentDiagnosis::Entry& entry : merged.errors)
+        {
+            CHECK(entry.file == 0);
+        }
+    }
+
+    SECTION("fail-fast stops the other shards")
+    {
+        diagnosis.setErrorLimit(2);
+        diagnosis.setFailFast(true);
+
+        Diagnosis& file0 = diagnosis.createShard(0);
+        Diagnosis& file1 = diagnosis.createShard(1);
+
+        file0.error("file 0");
+
+        CHECK_FALSE(file0.shouldStop());
+        CHECK_FALSE(file1.shouldStop());
+
+        file1.error("file 1");
+
+        CHECK(file0.shouldStop());
+        CHECK(file1.shouldStop());
+    }
+
+    SECTION("fail-fast across threads")
+    {
+        diagnosis.setFailFast(true);
+
+        const std::vector<Source> sources = makeSources();
+
+        {
+            std::vector<std::jthread> threads;
+
+            for (std::size_t i = 0; i < sources.size(); ++i)
+            {
+                threads.emplace_back([&diagnosis, &sources, i] {
+                    Lexer lexer{diagnosis.createShard(i), sources[i]};
+                    [[maybe_unused]] const Tokens tokens = lexer.lex();
+                });
+            }
+        }
+
+        // each lexer stops at its first error, or before its first line once another one reported an error
+        CHECK(diagnosis.getErrorsCount() >= 1);
+        CHECK(diagnosis.getErrorsCount() <= sources.size());
+        CHECK(diagnosis.merge().errors.size() == diagnosis.getErrorsCount());
+    }
+}
+
+TEST_CASE("ConcurrentDiagnosis thread count independence", "[Diagnosis], [ConcurrentDiagnosis]")
+{
+    const std::vector<Source> sources = makeSources();
+
+    const std::string expected = lexAndMerge(sources, 1);
+
+    CHECK_FALSE(expected.empty());
+
+    for (std::size_t threadsCount : {2UL, 3UL, 4UL, 8UL})
+    {
+        INFO(fmt::format("{} threads", threadsCount));
+
+        CHECK(lexAndMerge(sources, threadsCount) == expected);
+    }
+}
+
+} // namespace CPPS
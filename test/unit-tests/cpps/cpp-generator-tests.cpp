@@ -0,0 +1,290 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "cpps/check-diagnosis.hpp"
+#include "cpps/cpp-generator.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+#include "cpps/tokens.hpp"
+#include "cpps/utility/output-sink.hpp"
+#include "cpps-corpus-generator/generator.hpp"
+
+namespace CPPS {
+
+namespace {
+
+struct FileCloser
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+// the C++ generated from text, the diagnosis must be checked, without #line directives if fileName is empty
+std::string generate(Diagnosis& diagnosis, const std::string& text, std::string_view fileName = {})
+{
+    std::istringstream stream{text};
+
+    SourceReader reader{diagnosis, stream};
+
+    std::optional<Source> source = reader.read();
+
+    REQUIRE(source.has_value());
+
+    Lexer lexer{diagnosis, *source};
+    Tokens tokens = lexer.lex();
+
+    CST::Parser parser{diagnosis, tokens};
+    const CST::TranslationUnit translationUnit = parser.parse();
+
+    checkNoErrorOrWarning(diagnosis);
+
+    const std::unique_ptr<std::FILE, FileCloser> file{std::tmpfile()};
+    REQUIRE(file != nullptr);
+
+    {
+        OutputSink sink{file.get(), 64};
+
+        CppGenerator generator{diagnosis, *source, translationUnit, sink, fileName};
+        generator.generate();
+
+        REQUIRE(sink.flush());
+    }
+
+    std::rewind(file.get());
+
+    std::string output;
+
+    for (int c = std::fgetc(file.get()); c != EOF; c = std::fgetc(file.get()))
+    {
+        output += static_cast<char>(c);
+    }
+
+    return output;
+}
+
+std::string generate(const std::string& text)
+{
+    Diagnosis diagnosis;
+
+    std::string output = generate(diagnosis, text);
+
+    checkNoErrorOrWarning(diagnosis);
+
+    return output;
+}
+
+} // namespace
+
+TEST_CASE("CppGenerator pass-through", "[CppGenerator]")
+{
+    const std::string cpp = "#include <vector>\n"
+                            "\n"
+                            "// a comment\n"
+                            "int main()\n"
+                            "{\n"
+                            "    return  0 ;\n"
+                            "}\n";
+
+    CHECK(generate(cpp) == cpp);
+}
+
+TEST_CASE("CppGenerator objects", "[CppGenerator]")
+{
+    CHECK(generate("a: int = 1 + b * 2;\n") == "int a = 1 + b * 2;\n");
+    CHECK(generate("a: int;\n") == "int a;\n");
+    CHECK(generate("p: *int = nullptr;\n") == "int* p = nullptr;\n");
+    CHECK(generate("b: bool = !!c || -(-d) < e;\n") == "bool b = !!c || -(-d) < e;\n");
+    CHECK(generate("x: int = - -y;\n") == "int x = - -y;\n");
+}
+
+TEST_CASE("CppGenerator postfix", "[CppGenerator]")
+{
+    CHECK(generate("a: int = p*;\n") == "int a = (*p);\n");
+    CHECK(generate("a: int = p**.x;\n") == "int a = (*(*p)).x;\n");
+    CHECK(generate("b: *int = a&;\n") == "int* b = (&a);\n");
+    CHECK(generate("a: int = f(1, g[2])* + v.size();\n") == "int a = (*f(1, g[2])) + v.size();\n");
+    CHECK(generate("a: int = f(move x, out z);\n") == "int a = f(std::move(x), z);\n");
+}
+
+TEST_CASE("CppGenerator functions", "[CppGenerator]")
+{
+    SECTION("body")
+    {
+        CHECK(generate("f: (x: int) -> int = {\n"
+                       "    y: int = x * 2;\n"
+                       "    g(y);\n"
+                       "    {\n"
+                       "        return y;\n"
+                       "    }\n"
+                       "}\n") ==
+              "auto f(int const& x) noexcept -> int\n"
+              "{\n"
+              "    int y = x * 2;\n"
+              "    g(y);\n"
+              "    {\n"
+              "        return y;\n"
+              "    }\n"
+              "}\n");
+    }
+
+    SECTION("parameters")
+    {
+        CHECK(generate("f: (in a: int, copy b: int, inout c: int, out d: int, move e: int, forward f: int) throws = {}\n") ==
+              "auto f(int const& a, int b, int& c, int& d, int&& e, int&& f) -> void\n"
+              "{\n"
+              "}\n");
+    }
+
+    SECTION("expression body")
+    {
+        CHECK(generate("f: () -> int = 42;\n") == "auto f() noexcept -> int\n{\n    return 42;\n}\n");
+        CHECK(generate("f: () = g();\n") == "auto f() noexcept -> void\n{\n    g();\n}\n");
+    }
+
+    SECTION("local function and lambda")
+    {
+        CHECK(generate("f: () = {\n"
+                       "    g: (x: int) -> int = { return x; }\n"
+                       "    h(:(y: int) -> int = y;);\n"
+                       "}\n") ==
+              "auto f() noexcept -> void\n"
+              "{\n"
+              "    auto g = [&](int const& x) noexcept -> int\n"
+              "    {\n"
+              "        return x;\n"
+              "    };\n"
+              "    h([&](int const& y) noexcept -> int\n"
+              "    {\n"
+              "        return y;\n"
+              "    });\n"
+              "}\n");
+    }
+
+    SECTION("named returns")
+    {
+        Diagnosis diagnosis;
+
+        const std::string output = generate(diagnosis, "f: () -> (out a: int) = {}\n");
+
+        checkError(diagnosis, CppGenerator::DiagnosisMessage::unsupportedNamedReturns(), {0, 9});
+    }
+}
+
+TEST_CASE("CppGenerator mixed source", "[CppGenerator]")
+{
+    CHECK(generate("#include <cstdio>\n"
+                   "\n"
+                   "square: (x: int) -> int = x * x;\n"
+                   "\n"
+                   "int main()\n"
+                   "{\n"
+                   "    std::printf(\"%d\", square(3));\n"
+                   "}\n") ==
+          "#include <cstdio>\n"
+          "\n"
+          "auto square(int const& x) noexcept -> int\n"
+          "{\n"
+          "    return x * x;\n"
+          "}\n"
+          "\n"
+          "int main()\n"
+          "{\n"
+          "    std::printf(\"%d\", square(3));\n"
+          "}\n");
+}
+
+TEST_CASE("CppGenerator line directives", "[CppGenerator]")
+{
+    Diagnosis diagnosis;
+
+    SECTION("declarations and copied lines")
+    {
+        const std::string output = generate(diagnosis,
+                                             "#include <cstdio>\n"
+                                             "a: int = 1;\n"
+                                             "b: int = 2;\n"
+                                             "\n"
+                                             "square: (x: int) -> int = x * x;\n"
+                                             "int main() {}\n",
+                                             "a.cpp2");
+
+        CHECK(output == "#line 1 \"a.cpp2\"\n"
+                        "#include <cstdio>\n"
+                        "#line 2 \"a.cpp2\"\n"
+                        "int a = 1;\n"
+                        "#line 3 \"a.cpp2\"\n"
+                        "int b = 2;\n"
+                        "#line 4 \"a.cpp2\"\n"
+                        "\n"
+                        "#line 5 \"a.cpp2\"\n"
+                        "auto square(int const& x) noexcept -> int\n"
+                        "{\n"
+                        "    return x * x;\n"
+                        "}\n"
+                        "#line 6 \"a.cpp2\"\n"
+                        "int main() {}\n");
+    }
+
+    SECTION("escaped file name")
+    {
+        CHECK(generate(diagnosis, "a: int = 1;\n", R"(C:\dir\"a".cpp2)") == "#line 1 \"C:\\\\dir\\\\\\\"a\\\".cpp2\"\nint a = 1;\n");
+    }
+
+    checkNoErrorOrWarning(diagnosis);
+}
+
+TEST_CASE("CppGenerator generated corpus", "[CppGenerator]")
+{
+    Corpus::GeneratorOptions options;
+    options.seed = GENERATE(as<std::uint64_t>{}, 1, 2);
+    options.linesCount = 300;
+
+    const std::string text = Corpus::Generator{options}.generate().text;
+
+    Diagnosis diagnosis;
+
+    const std::string output = generate(diagnosis, text);
+
+    checkNoErrorOrWarning(diagnosis);
+
+    // the C++ lines are kept in order
+    std::istringstream source{text};
+    std::istringstream generated{output};
+
+    std::string line;
+    std::string generatedLine;
+
+    std::size_t cppLinesCount = 0;
+
+    while (std::getline(source, line))
+    {
+        if (line.starts_with("#") || line.starts_with("//"))
+        {
+            bool found = false;
+
+            while (!found && std::getline(generated, generatedLine))
+            {
+                found = generatedLine == line;
+            }
+
+            CHECK(found);
+
+            ++cppLinesCount;
+        }
+    }
+
+    CHECK(cppLinesCount > 0);
+}
+
+} // namespace CPPS
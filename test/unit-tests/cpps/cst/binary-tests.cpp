@@ -0,0 +1,596 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "cpps/check-diagnosis.hpp"
+#include "cpps/cst.hpp"
+#include "cpps/cst/binary-reader.hpp"
+#include "cpps/cst/binary-writer.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/cst/walker.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+#include "cpps/source.hpp"
+#include "cpps/tokens.hpp"
+#include "cpps-corpus-generator/generator.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+struct Parsed
+{
+    Source source;
+    Tokens tokens;
+    TranslationUnit translationUnit;
+};
+
+void checkOnlyError(const Diagnosis& diagnosis, const Diagnosis::Message& message)
+{
+    REQUIRE(diagnosis.getErrors().size() == 1);
+    CHECK(diagnosis.getErrors()[0].message == message);
+    CHECK_FALSE(diagnosis.getErrors()[0].location.has_value());
+}
+
+void parse(Parsed& parsed, std::string_view code)
+{
+    Diagnosis diagnosis;
+
+    parsed.source.add(std::string(code), Source::Line::Type::Cpps);
+
+    Lexer lexer{diagnosis, parsed.source};
+    parsed.tokens = lexer.lex();
+
+    Parser parser{diagnosis, parsed.tokens};
+    parsed.translationUnit = parser.parse();
+}
+
+// the buffer copied to a 4-byte aligned storage, like a mapped file
+struct Buffer
+{
+    explicit Buffer(const std::vector<std::byte>& bytes)
+        : words((bytes.size() + 3) / 4)
+        , size(bytes.size())
+    {
+        if (!bytes.empty())
+        {
+            std::memcpy(words.data(), bytes.data(), bytes.size());
+        }
+    }
+
+    [[nodiscard]] std::span<const std::byte> getBytes() const
+    {
+        return {reinterpret_cast<const std::byte*>(words.data()), size};
+    }
+
+    std::vector<std::uint32_t> words;
+    std::size_t size;
+};
+
+// the expressions and the primary tokens, "text@line:column", in source order
+struct Trace
+{
+    std::size_t expressionCount{0};
+    std::string tokens;
+
+    void add(std::string_view text, SourceLocation location)
+    {
+        tokens += fmt::format("{}@{}:{} ", text, location.line, location.column);
+    }
+};
+
+class TraceWalker : public ConstWalker<TraceWalker>
+{
+public:
+    Trace trace;
+
+private:
+    friend class Walker<TraceWalker, true>;
+
+    void pre(const Expression&)
+    {
+        ++trace.expressionCount;
+    }
+
+    void pre(const Token& token)
+    {
+        trace.add(token.text, token.location);
+    }
+};
+
+void traceView(Trace& trace, const BinaryView<Declaration>& declaration);
+void traceView(Trace& trace, const BinaryView<Statement>& statement);
+void traceView(Trace& trace, const BinaryView<Expression>& expression);
+
+void traceView(Trace& trace, const BinaryView<ParameterDeclarationList>& parameters)
+{
+    for (std::size_t i = 0; i < parameters.size(); ++i)
+    {
+        traceView(trace, parameters[i].declaration());
+    }
+}
+
+void traceView(Trace& trace, const BinaryView<ExpressionList>& expressions)
+{
+    for (std::size_t i = 0; i < expressions.size(); ++i)
+    {
+        traceView(trace, expressions[i].expression());
+    }
+}
+
+void traceView(Trace& trace, const BinaryView<Declaration>& declaration)
+{
+    if (declaration.type().is<FunctionSignature>())
+    {
+        const BinaryView<FunctionSignature> signature = declaration.type().as<FunctionSignature>();
+
+        traceView(trace, signature.parameters());
+
+        if (signature.returns().is<ParameterDeclarationList>())
+        {
+            traceView(trace, signature.returns().as<ParameterDeclarationList>());
+        }
+    }
+
+    if (declaration.initializer())
+    {
+        traceView(trace, declaration.initializer());
+    }
+}
+
+void traceView(Trace& trace, const BinaryView<Statement>& statement)
+{
+    const BinaryVariantView<Statement::Type> type = statement.type();
+
+    if (type.is<Declaration>())
+    {
+        traceView(trace, type.as<Declaration>());
+    }
+    else if (type.is<CompoundStatement>())
+    {
+        const BinaryView<CompoundStatement> statements = type.as<CompoundStatement>();
+
+        for (std::size_t i = 0; i < statements.size(); ++i)
+        {
+            traceView(trace, statements[i]);
+        }
+    }
+    else if (type.is<ExpressionStatement>() && type.as<ExpressionStatement>().expression())
+    {
+        traceView(trace, type.as<ExpressionStatement>().expression());
+    }
+    else if (type.is<ReturnStatement>() && type.as<ReturnStatement>().expression())
+    {
+        traceView(trace, type.as<ReturnStatement>().expression());
+    }
+}
+
+void traceView(Trace& trace, const BinaryView<Expression>& expression)
+{
+    ++trace.expressionCount;
+
+    const BinaryArrayView<BasicExpression> basics = expression.basics();
+
+    for (std::size_t i = 0; i < basics.size(); ++i)
+    {
+        if (const BinaryView<PrimaryExpression> primary = basics[i].primary())
+        {
+            const BinaryVariantView<PrimaryExpression::Type> type = primary.type();
+
+            if (type.is<Token>())
+            {
+                trace.add(type.as<Token>().text(), type.as<Token>().location());
+            }
+            else if (type.is<Declaration>())
+            {
+                traceView(trace, type.as<Declaration>());
+            }
+            else if (type.is<ExpressionList>())
+            {
+                traceView(trace, type.as<ExpressionList>());
+            }
+        }
+
+        if (const BinaryView<PostfixExpression> postfix = basics[i].postfix())
+        {
+            const BinaryArrayView<PostfixExpression::Term> terms = postfix.terms();
+
+            for (std::size_t j = 0; j < terms.size(); ++j)
+            {
+                if (terms[j].arguments())
+                {
+                    traceView(trace, terms[j].arguments());
+                }
+            }
+        }
+    }
+}
+
+Trace traceCST(const TranslationUnit& translationUnit)
+{
+    TraceWalker walker;
+    walker.walk(translationUnit);
+
+    return walker.trace;
+}
+
+Trace traceBinary(const BinaryReader& reader)
+{
+    Trace trace;
+
+    const BinaryListView<Declaration> declarations = reader.getDeclarations();
+
+    for (std::size_t i = 0; i < declarations.size(); ++i)
+    {
+        traceView(trace, declarations[i]);
+    }
+
+    return trace;
+}
+
+} // namespace
+
+TEST_CASE("Binary CST round trip", "[Binary], [CST]")
+{
+    Parsed parsed;
+    parse(parsed, "a: int = 1 + b * 2; f: (in x: int, inout y: *int) -> int = { return x * g(3, \"s\"); } h: () throws = {}");
+
+    const std::vector<std::byte> bytes = BinaryWriter{parsed.translationUnit}.write();
+
+    Buffer buffer{bytes};
+    BinaryReader reader{buffer.getBytes()};
+
+    Diagnosis diagnosis;
+    REQUIRE(reader.open(diagnosis));
+    checkNoErrorOrWarning(diagnosis);
+
+    const BinaryListView<Declaration> declarations = reader.getDeclarations();
+    REQUIRE(declarations.size() == 3);
+    CHECK(reader.getDamagedRegions().empty());
+
+    SECTION("declaration")
+    {
+        const BinaryView<Declaration> declaration = declarations[0];
+
+        CHECK(declaration.identifier().identifier().text() == "a");
+        CHECK(declaration.identifier().identifier().lexeme().is<CPPS::Identifier>());
+        CHECK(declaration.startLocation() == parsed.translationUnit.declarations[0].startLocation);
+        CHECK(declaration.equalLocation() == parsed.translationUnit.declarations[0].equalLocation);
+        CHECK_FALSE(declaration.pointerDeclaration());
+
+        REQUIRE(declaration.type().is<IdentifierExpression>());
+        const BinaryVariantView<Identifier::Type> type = declaration.type().as<IdentifierExpression>().identifier().type();
+        REQUIRE(type.is<UnqualifiedIdentifier>());
+        CHECK(type.as<UnqualifiedIdentifier>().identifier().text() == "int");
+    }
+
+    SECTION("expression operations")
+    {
+        const BinaryView<Statement> initializer = declarations[0].initializer();
+        REQUIRE(initializer.type().is<ExpressionStatement>());
+        CHECK(initializer.type().as<ExpressionStatement>().hasSemicolon());
+
+        const BinaryView<Expression> expression = initializer.type().as<ExpressionStatement>().expression();
+        const Expression& expected = *(*parsed.translationUnit.declarations[0].initializer)->type.as<ExpressionStatement>().expression;
+
+        REQUIRE(expression.operations().size() == expected.operations.size());
+        REQUIRE(expression.basics().size() == 3);
+        CHECK_FALSE(expression.isBasic());
+
+        // 1 + (b * 2)
+        const BinaryView<Expression::Operation> root = expression.getRoot();
+        CHECK(root.kind() == Expression::Kind::Additive);
+        CHECK(root.op().text() == "+");
+        CHECK(expression.getLhs(root).kind() == Expression::Kind::Basic);
+        CHECK(expression.getRhs(root).kind() == Expression::Kind::Multiplicative);
+
+        const BinaryView<Token> literal = expression.getBasic(expression.getLhs(root)).primary().type().as<Token>();
+        CHECK(literal.lexeme().is<DecimalLiteral>());
+        CHECK(literal.text() == "1");
+
+        const Token token = literal.get();
+        const Token& expectedToken = expected.getBasic(expected.getLhs(expected.getRoot())).primary->type.as<Token>();
+        CHECK(token.lexeme == expectedToken.lexeme);
+        CHECK(token.location == expectedToken.location);
+        CHECK(token.text == expectedToken.text);
+    }
+
+    SECTION("function signature")
+    {
+        const BinaryView<Declaration> declaration = declarations[1];
+        REQUIRE(declaration.type().is<FunctionSignature>());
+
+        const BinaryView<FunctionSignature> signature = declaration.type().as<FunctionSignature>();
+        CHECK_FALSE(signature.throws());
+        REQUIRE(signature.returns().is<IdentifierExpression>());
+
+        const BinaryView<ParameterDeclarationList> parameters = signature.parameters();
+        REQUIRE(parameters.size() == 2);
+        CHECK(parameters[0].modifier() == ParameterModifier::In);
+        CHECK(parameters[0].declaration().identifier().identifier().text() == "x");
+        CHECK(parameters[1].modifier() == ParameterModifier::InOut);
+        CHECK(parameters[1].declaration().pointerDeclaration().text() == "*");
+
+        const BinaryView<CompoundStatement> body = declaration.initializer().type().as<CompoundStatement>();
+        REQUIRE(body.size() == 1);
+
+        const BinaryView<ReturnStatement> statement = body[0].type().as<ReturnStatement>();
+        CHECK(statement.identifier().text() == "return");
+
+        // x * g(3, "s")
+        const BinaryView<Expression> expression = statement.expression();
+        const BinaryView<BasicExpression> call = expression.getBasic(expression.getRhs(expression.getRoot()));
+        CHECK(call.primary().type().as<IdentifierExpression>().identifier().type().as<UnqualifiedIdentifier>().identifier().text() == "g");
+
+        const BinaryArrayView<PostfixExpression::Term> terms = call.postfix().terms();
+        REQUIRE(terms.size() == 1);
+        CHECK(terms[0].op().text() == "(");
+        CHECK(terms[0].closeOp().text() == ")");
+
+        const BinaryView<ExpressionList> arguments = terms[0].arguments();
+        REQUIRE(arguments.size() == 2);
+        CHECK(arguments[1].expression().getBasic(arguments[1].expression().getRoot()).primary().type().as<Token>().text() == "\"s\"");
+    }
+
+    SECTION("function without returns")
+    {
+        const BinaryView<FunctionSignature> signature = declarations[2].type().as<FunctionSignature>();
+
+        CHECK(signature.throws());
+        CHECK(signature.parameters().empty());
+        CHECK(signature.returns().is<std::monostate>());
+        CHECK(declarations[2].initializer().type().as<CompoundStatement>().empty());
+    }
+
+    SECTION("same trace")
+    {
+        const Trace expected = traceCST(parsed.translationUnit);
+        const Trace trace = traceBinary(reader);
+
+        CHECK(trace.expressionCount == expected.expressionCount);
+        CHECK(trace.tokens == expected.tokens);
+    }
+}
+
+TEST_CASE("Binary CST damaged regions", "[Binary], [CST]")
+{
+    Parsed parsed;
+    parse(parsed, "a: int = 1;\nb: = = ;\nc: int = 2;");
+
+    REQUIRE_FALSE(parsed.translationUnit.damagedRegions.empty());
+
+    const std::vector<std::byte> bytes = BinaryWriter{parsed.translationUnit}.write();
+
+    Buffer buffer{bytes};
+    BinaryReader reader{buffer.getBytes()};
+
+    Diagnosis diagnosis;
+    REQUIRE(reader.open(diagnosis));
+
+    const BinaryArrayView<TranslationUnit::DamagedRegion> regions = reader.getDamagedRegions();
+    REQUIRE(regions.size() == parsed.translationUnit.damagedRegions.size());
+
+    for (std::size_t i = 0; i < regions.size(); ++i)
+    {
+        CHECK(regions[i].beginLocation() == parsed.translationUnit.damagedRegions[i].beginLocation);
+        CHECK(regions[i].endLocation() == parsed.translationUnit.damagedRegions[i].endLocation);
+    }
+
+    CHECK(reader.getDeclarations().size() == parsed.translationUnit.declarations.size());
+}
+
+TEST_CASE("Binary CST header", "[Binary], [CST]")
+{
+    Parsed parsed;
+    parse(parsed, "a: int = 1;");
+
+    std::vector<std::byte> bytes = BinaryWriter{parsed.translationUnit}.write();
+
+    SECTION("deterministic")
+    {
+        CHECK(BinaryWriter{parsed.translationUnit}.write() == bytes);
+    }
+
+    SECTION("invalid magic")
+    {
+        bytes[0] = std::byte{'X'};
+
+        Buffer buffer{bytes};
+        BinaryReader reader{buffer.getBytes()};
+
+        Diagnosis diagnosis;
+        CHECK_FALSE(reader.open(diagnosis));
+        checkOnlyError(diagnosis, BinaryReader::DiagnosisMessage::invalidMagic());
+    }
+
+    SECTION("unsupported version")
+    {
+        const std::uint32_t version = BinaryFormat::FormatVersion + 1;
+        std::memcpy(bytes.data() + offsetof(BinaryFormat::Header, version), &version, sizeof(version));
+
+        Buffer buffer{bytes};
+        BinaryReader reader{buffer.getBytes()};
+
+        Diagnosis diagnosis;
+        CHECK_FALSE(reader.open(diagnosis));
+        checkOnlyError(diagnosis, BinaryReader::DiagnosisMessage::unsupportedVersion(version));
+    }
+
+    SECTION("byte order mismatch")
+    {
+        const std::uint32_t byteOrderMark = 0x04030201;
+        std::memcpy(bytes.data() + offsetof(BinaryFormat::Header, byteOrderMark), &byteOrderMark, sizeof(byteOrderMark));
+
+        Buffer buffer{bytes};
+        BinaryReader reader{buffer.getBytes()};
+
+        Diagnosis diagnosis;
+        CHECK_FALSE(reader.open(diagnosis));
+        checkOnlyError(diagnosis, BinaryReader::DiagnosisMessage::byteOrderMismatch());
+    }
+
+    SECTION("truncated")
+    {
+        const std::size_t size = bytes.size();
+        bytes.resize(GENERATE(as<std::size_t>{}, 0, 8, 40));
+
+        Buffer buffer{bytes};
+        BinaryReader reader{buffer.getBytes()};
+
+        Diagnosis diagnosis;
+        CHECK_FALSE(reader.open(diagnosis));
+        checkOnlyError(diagnosis, BinaryReader::DiagnosisMessage::truncatedBuffer(bytes.size(), bytes.size() < sizeof(BinaryFormat::Header) ? sizeof(BinaryFormat::Header) : size));
+    }
+}
+
+TEST_CASE("Binary CST corrupted records", "[Binary], [CST]")
+{
+    Parsed parsed;
+    parse(parsed, "a: int = -b;");
+
+    std::vector<std::byte> bytes = BinaryWriter{parsed.translationUnit}.write();
+
+    auto loadAt = [&bytes]<typename T>(std::size_t offset, T& value) { std::memcpy(&value, bytes.data() + offset, sizeof(T)); };
+    auto storeAt = [&bytes]<typename T>(std::size_t offset, const T& value) { std::memcpy(bytes.data() + offset, &value, sizeof(T)); };
+
+    BinaryFormat::Header header{};
+    loadAt(0, header);
+
+    BinaryFormat::Ref declarationRef;
+    loadAt(static_cast<std::size_t>(header.declarations.data.offset), declarationRef);
+
+    const auto declarationOffset = static_cast<std::size_t>(header.declarations.data.offset + declarationRef.offset);
+
+    BinaryFormat::DeclarationRecord declaration{};
+    loadAt(declarationOffset, declaration);
+
+    BinaryFormat::UnqualifiedIdentifierRecord identifier{};
+    const std::size_t identifierOffset = declarationOffset + static_cast<std::size_t>(declaration.identifier.offset);
+    loadAt(identifierOffset, identifier);
+
+    auto checkInvalidRecord = [&bytes](std::size_t offset) {
+        Buffer buffer{bytes};
+        BinaryReader reader{buffer.getBytes()};
+
+        Diagnosis diagnosis;
+        CHECK_FALSE(reader.open(diagnosis));
+        checkOnlyError(diagnosis, BinaryReader::DiagnosisMessage::invalidRecord(offset));
+    };
+
+    SECTION("valid")
+    {
+        Buffer buffer{bytes};
+        BinaryReader reader{buffer.getBytes()};
+
+        Diagnosis diagnosis;
+        CHECK(reader.open(diagnosis));
+        checkNoErrorOrWarning(diagnosis);
+    }
+
+    SECTION("ref out of the buffer")
+    {
+        const auto offset = static_cast<std::int32_t>(GENERATE_COPY(bytes.size(), bytes.size() + 4, 0x7FFFFFF0));
+
+        storeAt(declarationOffset + offsetof(BinaryFormat::DeclarationRecord, initializer), BinaryFormat::Ref{offset});
+        checkInvalidRecord(declarationOffset);
+    }
+
+    SECTION("ref to a node before it")
+    {
+        // a Ref to the previous record could make a cycle
+        storeAt(declarationOffset + offsetof(BinaryFormat::DeclarationRecord, initializer), BinaryFormat::Ref{-4});
+        checkInvalidRecord(declarationOffset);
+    }
+
+    SECTION("misaligned ref")
+    {
+        storeAt(declarationOffset + offsetof(BinaryFormat::DeclarationRecord, identifier), BinaryFormat::Ref{declaration.identifier.offset + 2});
+        checkInvalidRecord(declarationOffset);
+    }
+
+    SECTION("missing required ref")
+    {
+        storeAt(identifierOffset + offsetof(BinaryFormat::UnqualifiedIdentifierRecord, identifier), BinaryFormat::Ref{});
+        checkInvalidRecord(identifierOffset);
+    }
+
+    SECTION("invalid variant index")
+    {
+        storeAt(declarationOffset + offsetof(BinaryFormat::DeclarationRecord, type), BinaryFormat::VariantRef{.index = 2, .node = declaration.type.node});
+        checkInvalidRecord(declarationOffset);
+    }
+
+    SECTION("invalid lexeme")
+    {
+        const std::size_t tokenOffset = identifierOffset + static_cast<std::size_t>(identifier.identifier.offset);
+
+        storeAt(tokenOffset + offsetof(BinaryFormat::TokenRecord, lexeme), std::uint16_t{0x00FE});
+        checkInvalidRecord(identifierOffset);
+    }
+
+    SECTION("token text out of the buffer")
+    {
+        const std::size_t tokenOffset = identifierOffset + static_cast<std::size_t>(identifier.identifier.offset);
+
+        BinaryFormat::TokenRecord token{};
+        loadAt(tokenOffset, token);
+
+        storeAt(tokenOffset + offsetof(BinaryFormat::TokenRecord, text), BinaryFormat::ArrayRef{.count = static_cast<std::uint32_t>(bytes.size()), .data = token.text.data});
+        checkInvalidRecord(identifierOffset);
+    }
+
+    SECTION("too many declarations")
+    {
+        storeAt(offsetof(BinaryFormat::Header, declarations), BinaryFormat::ArrayRef{.count = 0x40000000, .data = header.declarations.data});
+        checkInvalidRecord(0);
+    }
+}
+
+TEST_CASE("Binary CST generated corpus", "[Binary], [CST]")
+{
+    Corpus::GeneratorOptions options;
+    options.seed = GENERATE(as<std::uint64_t>{}, 1, 2);
+    options.linesCount = 300;
+
+    Diagnosis diagnosis;
+
+    std::istringstream stream{Corpus::Generator{options}.generate().text};
+
+    SourceReader sourceReader{diagnosis, stream};
+
+    std::optional<Source> source = sourceReader.read();
+    REQUIRE(source);
+
+    Lexer lexer{diagnosis, *source};
+    Tokens tokens = lexer.lex();
+
+    Parser parser{diagnosis, tokens};
+    TranslationUnit translationUnit = parser.parse();
+
+    checkNoErrorOrWarning(diagnosis);
+
+    Buffer buffer{BinaryWriter{translationUnit}.write()};
+    BinaryReader reader{buffer.getBytes()};
+
+    REQUIRE(reader.open(diagnosis));
+
+    const Trace expected = traceCST(translationUnit);
+    const Trace trace = traceBinary(reader);
+
+    CHECK(trace.expressionCount == expected.expressionCount);
+    CHECK(trace.tokens == expected.tokens);
+}
+
+} // namespace CPPS::CST
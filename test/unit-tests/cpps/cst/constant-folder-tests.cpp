@@ -0,0 +1,240 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
+
+#include "cpps/check-diagnosis.hpp"
+#include "cpps/cst.hpp"
+#include "cpps/cst/constant-folder.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source.hpp"
+#include "cpps/tokens.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+// the initializer is at column 9
+constexpr std::string_view DeclarationPrefix{"v: int = "};
+
+std::string toString(const Expression& expression, const Expression::Operation& operation)
+{
+    if (operation.kind != Expression::Kind::Basic)
+    {
+        return "(" + toString(expression, expression.getLhs(operation)) + " " + std::string(operation.op->get().text) + " " + toString(expression, expression.getRhs(operation)) + ")";
+    }
+
+    const BasicExpression& basic = expression.getBasic(operation);
+
+    std::string text;
+
+    for (const TokenRef& op : basic.prefix->ops)
+    {
+        text += op.get().text;
+    }
+
+    if (basic.primary->type.is<Token>())
+    {
+        text += basic.primary->type.as<Token>().text;
+    }
+    else if (basic.primary->type.is<IdentifierExpression>())
+    {
+        text += basic.primary->type.as<IdentifierExpression>().identifier.type.as<UnqualifiedIdentifier>().identifier.get().text;
+    }
+    else
+    {
+        text += "(...)";
+    }
+
+    if (!basic.postfix->terms.empty())
+    {
+        text += "...";
+    }
+
+    return text;
+}
+
+struct FoldResult
+{
+    std::string text;
+    ConstantFolder::Stats stats;
+};
+
+FoldResult fold(Diagnosis& diagnosis, std::string_view code)
+{
+    Source source;
+    source.add(std::string(DeclarationPrefix) + std::string(code) + ";", Source::Line::Type::Cpps);
+
+    Lexer lexer{diagnosis, source};
+
+    const Tokens tokens = lexer.lex();
+
+    Parser parser{diagnosis, tokens};
+
+    TranslationUnit tu = parser.parse();
+
+    checkNoError(diagnosis);
+
+    ConstantFolder folder{diagnosis, tu};
+    folder.fold();
+
+    REQUIRE(tu.declarations.size() == 1);
+
+    const Expression& expression = *tu.declarations[0].initializer.value()->type.as<ExpressionStatement>().expression;
+
+    // the messages view the source
+    diagnosis.detachMessages();
+
+    return {toString(expression, expression.getRoot()), folder.getStats()};
+}
+
+void checkFold(std::string_view code, std::string_view expected)
+{
+    INFO(code);
+
+    Diagnosis diagnosis;
+
+    CHECK(fold(diagnosis, code).text == expected);
+
+    checkNoErrorOrWarning(diagnosis);
+}
+
+} // namespace
+
+TEST_CASE("ConstantFolder integer", "[ConstantFolder], [CST]")
+{
+    checkFold("1 << 12", "4096");
+    checkFold("4 * 1024", "4096");
+    checkFold("1 + 2 * 3 - 4", "3");
+    checkFold("(1 + 2) * 3", "9");
+    checkFold("7 / 2", "3");
+    checkFold("-7 % 3", "-1");
+    checkFold("-(2 - 5)", "3");
+    checkFold("- -1", "1");
+    checkFold("0x10 + 0b11 + 1'000", "1019");
+    checkFold("0xf0 & 0x3c | 1 ^ 3", "50");
+    checkFold("-8 >> 1", "-4");
+    checkFold("1LL << 62", "4611686018427387904LL");
+    checkFold("5", "5");
+}
+
+TEST_CASE("ConstantFolder integer types", "[ConstantFolder], [CST]")
+{
+    // the first type of the literal which represents its value
+    checkFold("2147483647 + 0", "2147483647");
+    checkFold("2147483648 + 1", "2147483649L");
+    checkFold("0x8000'0000 + 1", "2147483649U");
+    checkFold("1u + 1", "2U");
+    checkFold("1l + 1", "2L");
+    checkFold("1ul + 1", "2UL");
+    checkFold("1ll + 1", "2LL");
+    checkFold("1ull + 1", "2ULL");
+    checkFold("0xffff'ffff'ffff'ffff + 0", "18446744073709551615UL");
+    checkFold("1LL << 40", "1099511627776LL");
+
+    // the unsigned operations wrap
+    checkFold("4294967295u + 1", "0U");
+    checkFold("0u - 1", "4294967295U");
+    checkFold("0xffff'ffff'ffff'ffff + 1", "0UL");
+    checkFold("-1u", "4294967295U");
+
+    // the usual arithmetic conversions
+    checkFold("-1 < 1u", "false");
+    checkFold("-1 < 1l", "true");
+    checkFold("-1l < 1u", "true");
+    checkFold("1u - 2l", "-1L");
+    checkFold("-1 & 0xffu", "255U");
+    checkFold("-8u >> 1", "2147483644U");
+
+    // the minimum of a signed type has no literal, it is left to the compiler
+    checkFold("-2147483647 - 1", "(-2147483647 - 1)");
+    checkFold("-9223372036854775807 - 1", "(-9223372036854775807L - 1)");
+    checkFold("-2147483648", "-2147483648L");
+}
+
+TEST_CASE("ConstantFolder floating and boolean", "[ConstantFolder], [CST]")
+{
+    checkFold("1.5 * 2", "3.0");
+    checkFold("1 / 2.0", "0.5");
+    checkFold("-0.25 + 1", "0.75");
+    checkFold("true && !false", "true");
+    checkFold("1 < 2 == false", "false");
+    checkFold("2.5 >= 2", "true");
+    checkFold("true + true", "2");
+    checkFold("!0.0 || false", "true");
+}
+
+TEST_CASE("ConstantFolder keeps the non constant operations", "[ConstantFolder], [CST]")
+{
+    checkFold("4 * 1024 + x", "(4096 + x)");
+    checkFold("x + 4 * 1024", "(x + 4096)");
+    checkFold("x * (2 + 3)", "(x * 5)");
+
+    // left associative, x - 1 is not a constant
+    checkFold("x - 1 - 2", "((x - 1) - 2)");
+
+    checkFold("x = 1 + 2", "(x = 3)");
+    checkFold("f(1 + 2) + 4", "(f... + 4)");
+    checkFold("1 <=> 2", "(1 <=> 2)");
+    checkFold("1 % 2.0", "(1 % 2.0)");
+    checkFold("1.0 << 2", "(1.0 << 2)");
+    checkFold("\"a\" == \"a\"", "(\"a\" == \"a\")");
+}
+
+TEST_CASE("ConstantFolder stats", "[ConstantFolder], [CST]")
+{
+    Diagnosis diagnosis;
+
+    const FoldResult result = fold(diagnosis, "(1 + 2) * x + 3 * 4");
+
+    CHECK(result.text == "((3 * x) + 12)");
+
+    // 1 + 2 inside the parentheses, (3) and 3 * 4
+    CHECK(result.stats.foldedCount == 3);
+
+    // the operations of 1 + 2 and 3 * 4
+    CHECK(result.stats.removedOperationsCount == 4);
+}
+
+TEST_CASE("ConstantFolder diagnosis", "[ConstantFolder], [CST]")
+{
+    auto check = [](std::string_view code, std::string_view expected, const Diagnosis::Message& message, std::size_t column) {
+        INFO(code);
+
+        Diagnosis diagnosis;
+
+        CHECK(fold(diagnosis, code).text == expected);
+
+        checkWarning(diagnosis, message, SourceLocation{0, static_cast<SourceColumn>(DeclarationPrefix.size() + column)});
+    };
+
+    using Message = ConstantFolder::DiagnosisMessage;
+
+    // the overflows of int
+    check("2147483647 + 1", "(2147483647 + 1)", Message::integerOverflow("+"), 11);
+    check("0x7fff'ffff + 1", "(0x7fff'ffff + 1)", Message::integerOverflow("+"), 12);
+    check("-2147483647 - 2", "(-2147483647 - 2)", Message::integerOverflow("-"), 12);
+    check("1'000'000 * 1'000'000", "(1'000'000 * 1'000'000)", Message::integerOverflow("*"), 10);
+
+    // the overflows of long
+    check("9223372036854775807 + 1", "(9223372036854775807 + 1)", Message::integerOverflow("+"), 20);
+    check("-9223372036854775807 - 2", "(-9223372036854775807L - 2)", Message::integerOverflow("-"), 21);
+    check("4294967296 * 4294967296", "(4294967296 * 4294967296)", Message::integerOverflow("*"), 11);
+
+    check("1 / 0", "(1 / 0)", Message::divisionByZero(), 2);
+    check("1 % (1 - 1)", "(1 % 0)", Message::divisionByZero(), 2);
+    check("1.0 / 0", "(1.0 / 0)", Message::divisionByZero(), 4);
+
+    // the count is checked against the width of the promoted left operand
+    check("1 << 40", "(1 << 40)", Message::shiftCountOutOfRange(32), 2);
+    check("true << 32", "(true << 32)", Message::shiftCountOutOfRange(32), 5);
+    check("1 << 64", "(1 << 64)", Message::shiftCountOutOfRange(32), 2);
+    check("1LL << 64", "(1LL << 64)", Message::shiftCountOutOfRange(64), 4);
+    check("1 >> -1", "(1 >> -1)", Message::shiftCountOutOfRange(32), 2);
+
+    check("0x1'0000'0000'0000'0000 + 1", "(0x1'0000'0000'0000'0000 + 1)", Message::integerLiteralTooLarge("0x1'0000'0000'0000'0000"), 0);
+    check("18446744073709551615 + 1", "(18446744073709551615 + 1)", Message::integerLiteralTooLarge("18446744073709551615"), 0);
+}
+
+} // namespace CPPS::CST
@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include "cpps/check-diagnosis.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+#include "cpps/tokens.hpp"
+#include "cpps-corpus-generator/generator.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+// returns the top level declarations count, 0 if the source cannot be read
+std::size_t compile(Diagnosis& diagnosis, const std::string& text, bool& hasCpp)
+{
+    std::istringstream stream{text};
+
+    SourceReader reader{diagnosis, stream};
+
+    std::optional<Source> source = reader.read();
+
+    if (!source)
+    {
+        return 0;
+    }
+
+    hasCpp = source->hasCpp();
+
+    Lexer lexer{diagnosis, *source};
+
+    Tokens tokens = lexer.lex();
+
+    Parser parser{diagnosis, tokens};
+
+    return parser.parse().declarations.size();
+}
+
+} // namespace
+
+TEST_CASE("Generated corpus", "[CST]")
+{
+    Corpus::GeneratorOptions options;
+    options.seed = GENERATE(as<std::uint64_t>{}, 1, 2, 3);
+    options.linesCount = 500;
+
+    SECTION("same seed, same corpus")
+    {
+        CHECK(Corpus::Generator{options}.generate().text == Corpus::Generator{options}.generate().text);
+    }
+
+    SECTION("valid")
+    {
+        options.expressionDepth = GENERATE(as<std::size_t>{}, 0, 3, 32);
+        options.statementDepth = GENERATE(as<std::size_t>{}, 0, 8);
+
+        const Corpus::GeneratedCorpus corpus = Corpus::Generator{options}.generate();
+
+        CHECK(corpus.linesCount >= options.linesCount);
+        CHECK(corpus.cppLinesCount > 0);
+        CHECK(corpus.invalidDeclarationsCount == 0);
+
+        Diagnosis diagnosis;
+        bool hasCpp = false;
+
+        CHECK(compile(diagnosis, corpus.text, hasCpp) == corpus.declarationsCount);
+        CHECK(hasCpp);
+
+        checkNoErrorOrWarning(diagnosis);
+    }
+
+    SECTION("invalid")
+    {
+        options.invalidPercent = 20;
+
+        const Corpus::GeneratedCorpus corpus = Corpus::Generator{options}.generate();
+
+        CHECK(corpus.invalidDeclarationsCount > 0);
+
+        Diagnosis diagnosis;
+        bool hasCpp = false;
+
+        // the declarations after an invalid one are still parsed, each invalid one reports its own errors
+        CHECK(compile(diagnosis, corpus.text, hasCpp) >= corpus.declarationsCount - corpus.invalidDeclarationsCount);
+        CHECK(diagnosis.getErrorsCount() >= corpus.invalidDeclarationsCount);
+    }
+}
+
+} // namespace CPPS::CST
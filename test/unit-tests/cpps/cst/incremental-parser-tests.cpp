@@ -0,0 +1,344 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstdint>
+#include <fmt/format.h>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cpps/cst.hpp"
+#include "cpps/cst/incremental-parser.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+#include "cpps/tokens.hpp"
+#include "cpps-corpus-generator/generator.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+Source read(Diagnosis& diagnosis, const std::string& text)
+{
+    std::istringstream stream{text};
+
+    SourceReader reader{diagnosis, stream};
+
+    std::optional<Source> source = reader.read();
+
+    REQUIRE(source.has_value());
+
+    return std::move(*source);
+}
+
+std::string join(const std::vector<std::string>& lines)
+{
+    std::string text;
+
+    for (const std::string& line : lines)
+    {
+        text += line;
+        text += '\n';
+    }
+
+    return text;
+}
+
+std::vector<std::string> split(const std::string& text)
+{
+    std::vector<std::string> lines;
+
+    std::istringstream stream{text};
+
+    for (std::string line; std::getline(stream, line);)
+    {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+bool isViewOf(const Tokens& tokens, const Token& token)
+{
+    return &token >= &*tokens.begin() && &token < &*tokens.begin() + tokens.size();
+}
+
+// the incremental result must be the one of a full lex and parse, with the tokens viewing its own source
+void checkSameAsFull(const IncrementalParser& parser, const Diagnosis& diagnosis, const std::string& text)
+{
+    Diagnosis fullDiagnosis;
+
+    const Source source = read(fullDiagnosis, text);
+
+    Lexer lexer{fullDiagnosis, source};
+
+    const Tokens tokens = lexer.lex();
+
+    Parser fullParser{fullDiagnosis, tokens};
+
+    const TranslationUnit tu = fullParser.parse();
+
+    REQUIRE(diagnosis.getErrorsCount() == fullDiagnosis.getErrorsCount());
+
+    for (std::size_t i = 0; i < diagnosis.getErrors().size(); ++i)
+    {
+        CHECK(diagnosis.getErrors()[i].message.str() == fullDiagnosis.getErrors()[i].message.str());
+        CHECK(diagnosis.getErrors()[i].location == fullDiagnosis.getErrors()[i].location);
+    }
+
+    const Tokens& incrementalTokens = parser.getTokens();
+
+    REQUIRE(incrementalTokens.size() == tokens.size());
+
+    bool areSameTokens = true;
+
+    for (std::size_t i = 0; i < tokens.size(); ++i)
+    {
+        const Token& token = incrementalTokens.at(i);
+
+        areSameTokens &= token == tokens.at(i);
+        areSameTokens &= token.text.data() == parser.getSource()[token.location.line].getText().data() + token.location.column;
+    }
+
+    CHECK(areSameTokens);
+
+    REQUIRE(incrementalTokens.comments().size() == tokens.comments().size());
+
+    for (std::size_t i = 0; i < tokens.comments().size(); ++i)
+    {
+        CHECK(incrementalTokens.comments()[i].text == tokens.comments()[i].text);
+        CHECK(incrementalTokens.comments()[i].beginLocation == tokens.comments()[i].beginLocation);
+        CHECK(incrementalTokens.comments()[i].endLocation == tokens.comments()[i].endLocation);
+    }
+
+    const TranslationUnit& incrementalTu = parser.getTranslationUnit();
+
+    REQUIRE(incrementalTu.declarations.size() == tu.declarations.size());
+
+    for (std::size_t i = 0; i < tu.declarations.size(); ++i)
+    {
+        const Declaration& incrementalDeclaration = incrementalTu.declarations[i];
+        const Declaration& declaration = tu.declarations[i];
+
+        CHECK(incrementalDeclaration.startLocation == declaration.startLocation);
+        CHECK(incrementalDeclaration.equalLocation == declaration.equalLocation);
+        CHECK(incrementalDeclaration.endLocation == declaration.endLocation);
+        CHECK(incrementalDeclaration.type.is<FunctionSignature>() == declaration.type.is<FunctionSignature>());
+
+        const Token& identifier = incrementalDeclaration.identifier->identifier.get();
+
+        CHECK(isViewOf(incrementalTokens, identifier));
+        CHECK(identifier == declaration.identifier->identifier.get());
+    }
+}
+
+} // namespace
+
+TEST_CASE("Incremental parse", "[CST]")
+{
+    IncrementalParser parser;
+
+    std::vector<std::string> lines{
+        "a: int = 1;",
+        "f: (x: int) -> int = {",
+        "    y: int = x;",
+        "    return y;",
+        "}",
+        "// comment",
+        "b: int = 2;",
+        "c: int = b;"};
+
+    auto update = [&parser, &lines] {
+        Diagnosis diagnosis;
+
+        const std::string text = join(lines);
+
+        parser.update(diagnosis, read(diagnosis, text));
+
+        checkSameAsFull(parser, diagnosis, text);
+    };
+
+    update();
+
+    CHECK_FALSE(parser.getStats().isIncremental);
+    CHECK(parser.getStats().parsedDeclarationsCount == 4);
+
+    SECTION("function body")
+    {
+        lines[2] = "    y: int = x + 1;";
+
+        update();
+
+        CHECK(parser.getStats().isIncremental);
+        CHECK(parser.getStats().lexedLinesCount == 1);
+        CHECK(parser.getStats().parsedDeclarationsCount == 1);
+        CHECK(parser.getStats().reusedDeclarationsCount == 3);
+    }
+
+    SECTION("inserted lines shift the next declarations")
+    {
+        lines.insert(lines.begin() + 3, {"    z: int = y;", "", "    z = y;"});
+
+        update();
+
+        CHECK(parser.getStats().isIncremental);
+        CHECK(parser.getStats().parsedDeclarationsCount == 1);
+        CHECK(parser.getTranslationUnit().declarations[2].startLocation == SourceLocation{9, 0});
+
+        lines.erase(lines.begin() + 3, lines.begin() + 6);
+
+        update();
+
+        CHECK(parser.getStats().isIncremental);
+        CHECK(parser.getTranslationUnit().declarations[2].startLocation == SourceLocation{6, 0});
+    }
+
+    SECTION("new declaration")
+    {
+        lines.insert(lines.begin() + 6, "d: int = 3;");
+
+        update();
+
+        CHECK(parser.getStats().isIncremental);
+        CHECK(parser.getTranslationUnit().declarations.size() == 5);
+    }
+
+    SECTION("new tokens beyond the previous capacity")
+    {
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            lines.insert(lines.begin() + 6, fmt::format("d{}: int = {};", i, i));
+        }
+
+        update();
+
+        CHECK(parser.getStats().isIncremental);
+        // f is followed by a new token
+        CHECK(parser.getStats().parsedDeclarationsCount == 101);
+        CHECK(parser.getTranslationUnit().declarations.size() == 104);
+    }
+
+    SECTION("error then fix")
+    {
+        lines[6] = "b: int = 2";
+
+        update();
+
+        CHECK_FALSE(parser.getStats().isIncremental);
+
+        lines[6] = "b: int = 2;";
+
+        update();
+
+        CHECK_FALSE(parser.getStats().isIncremental);
+
+        lines[0] = "a: int = 3;";
+
+        update();
+
+        CHECK(parser.getStats().isIncremental);
+    }
+
+    SECTION("block comment")
+    {
+        lines[5] = "/* comment";
+        lines.insert(lines.begin() + 6, "*/");
+
+        update();
+
+        CHECK(parser.getTokens().comments().size() == 1);
+
+        lines[0] = "a: int = 1; /*";
+        lines.insert(lines.begin() + 1, "*/");
+
+        update();
+
+        lines.insert(lines.begin() + 1, "x: int = 0;");
+
+        update();
+
+        CHECK_FALSE(parser.getStats().isIncremental);
+    }
+
+    SECTION("no change")
+    {
+        update();
+
+        CHECK(parser.getStats().isIncremental);
+        CHECK(parser.getStats().lexedLinesCount == 0);
+        CHECK(parser.getStats().parsedDeclarationsCount == 1);
+    }
+}
+
+// each edit is reverted, an edit introducing an error makes the next update full
+TEST_CASE("Incremental parse of random edits", "[CST]")
+{
+    Corpus::GeneratorOptions options;
+    options.seed = GENERATE(as<std::uint64_t>{}, 1, 2, 3);
+    options.linesCount = 300;
+
+    const std::vector<std::string> originalLines = split(Corpus::Generator{options}.generate().text);
+
+    std::mt19937_64 random{options.seed};
+
+    auto randomLineIndex = [&random, &originalLines]() -> std::size_t {
+        return random() % originalLines.size();
+    };
+
+    IncrementalParser parser;
+
+    std::size_t incrementalUpdatesCount = 0;
+
+    auto update = [&parser, &incrementalUpdatesCount](const std::vector<std::string>& lines) {
+        Diagnosis diagnosis;
+
+        const std::string text = join(lines);
+
+        parser.update(diagnosis, read(diagnosis, text));
+
+        checkSameAsFull(parser, diagnosis, text);
+
+        if (parser.getStats().isIncremental)
+        {
+            ++incrementalUpdatesCount;
+        }
+    };
+
+    update(originalLines);
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        std::vector<std::string> lines = originalLines;
+
+        const auto lineIt = lines.begin() + static_cast<std::ptrdiff_t>(randomLineIndex());
+
+        switch (random() % 5)
+        {
+        case 0:
+            *lineIt = originalLines[randomLineIndex()];
+            break;
+        case 1:
+            lines.erase(lineIt);
+            break;
+        case 2:
+            lines.insert(lineIt, originalLines[randomLineIndex()]);
+            break;
+        case 3:
+            lines.insert(lineIt, "");
+            break;
+        default:
+            *lineIt += " ";
+            break;
+        }
+
+        update(lines);
+        update(originalLines);
+    }
+
+    CHECK(incrementalUpdatesCount > 0);
+}
+
+} // namespace CPPS::CST
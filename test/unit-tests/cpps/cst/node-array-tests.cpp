@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <utility>
+
+#include "cpps/cst/node-array.hpp"
+#include "cpps/utility/bump-pointer-allocator.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+std::size_t aliveCount{0};
+
+struct ElementMock
+{
+    explicit ElementMock(int v)
+        : value(v)
+    {
+        ++aliveCount;
+    }
+
+    // the moved-from element is marked, to detect a read after the move
+    ElementMock(ElementMock&& other) noexcept
+        : value(std::exchange(other.value, -1))
+    {
+        ++aliveCount;
+    }
+
+    ElementMock& operator=(ElementMock&&) = delete;
+
+    ElementMock(const ElementMock&) = delete;
+    ElementMock& operator=(const ElementMock&) = delete;
+
+    ~ElementMock()
+    {
+        --aliveCount;
+    }
+
+    int value;
+};
+
+} // namespace
+
+TEST_CASE("NodeArray emplaceBack", "[Node], [CST]")
+{
+    BumpPointerAllocator<> allocator;
+
+    {
+        NodeArray<ElementMock> array;
+
+        CHECK(array.empty());
+
+        for (int i = 0; i < 100; ++i)
+        {
+            CHECK(array.emplaceBack(allocator, i).value == i);
+        }
+
+        REQUIRE(array.size() == 100);
+        CHECK(aliveCount == 100);
+
+        int expected = 0;
+
+        for (const ElementMock& element : array)
+        {
+            CHECK(element.value == expected++);
+        }
+
+        CHECK(array[42].value == 42);
+        CHECK(array.back().value == 99);
+    }
+
+    CHECK(aliveCount == 0);
+}
+
+TEST_CASE("NodeArray emplaceBack from an element", "[Node], [CST]")
+{
+    BumpPointerAllocator<> allocator;
+
+    {
+        NodeArray<ElementMock> array;
+
+        array.emplaceBack(allocator, 1);
+
+        // the array is full, its element is read while the storage grows
+        CHECK(array.emplaceBack(allocator, array[0].value).value == 1);
+        CHECK(array.emplaceBack(allocator, array.back().value).value == 1);
+
+        CHECK(array[0].value == 1);
+        CHECK(aliveCount == 3);
+    }
+
+    CHECK(aliveCount == 0);
+}
+
+TEST_CASE("NodeArray reuses its storage when nothing was allocated since", "[Node], [CST]")
+{
+    BumpPointerAllocator<> allocator;
+
+    NodeArray<ElementMock> array;
+
+    array.emplaceBack(allocator, 0);
+
+    const std::size_t usedBytesCount = allocator.getUsedBytesCount();
+
+    array.emplaceBack(allocator, 1);
+
+    // the array of 1 element is given back, the array of 2 elements takes its place
+    CHECK(allocator.getUsedBytesCount() - usedBytesCount <= sizeof(ElementMock) + alignof(ElementMock));
+
+    array = NodeArray<ElementMock>{};
+
+    CHECK(aliveCount == 0);
+}
+
+TEST_CASE("NodeArray move", "[Node], [CST]")
+{
+    BumpPointerAllocator<> allocator;
+
+    NodeArray<ElementMock> array;
+    array.emplaceBack(allocator, 1);
+
+    NodeArray<ElementMock> newArray{std::move(array)};
+
+    CHECK(array.empty());
+    REQUIRE(newArray.size() == 1);
+    CHECK(newArray[0].value == 1);
+
+    array = std::move(newArray);
+
+    CHECK(newArray.empty());
+    CHECK(array.size() == 1);
+    CHECK(aliveCount == 1);
+}
+
+} // namespace CPPS::CST
@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <fmt/format.h>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 #include "cpps/cst/node-list.hpp"
 #include "cpps/cst/node-variant.hpp"
@@ -30,4 +33,48 @@ TEST_CASE("NodeVariant", "[NodeVariant], [CST]")
     CHECK(node.is<Token>());
 }
 
+TEST_CASE("NodeVariant visit", "[NodeVariant], [CST]")
+{
+    BumpPointerAllocator<> allocator;
+
+    std::string visited;
+
+    auto visitor = [&visited]<typename T>(T& value) {
+        if constexpr (std::is_same_v<T, const Token>)
+        {
+            visited += fmt::format("token {};", value.text);
+        }
+        else if constexpr (std::is_const_v<T>)
+        {
+            visited += fmt::format("const int {};", value);
+        }
+        else
+        {
+            visited += fmt::format("int {};", value);
+            value = 42;
+        }
+    };
+
+    NodeVariant<std::monostate, int, Token> node;
+    node.visit(visitor);
+    CHECK(visited.empty());
+
+    node = Node<int>{};
+    node.visit(visitor);
+    CHECK(visited.empty());
+
+    node = Node<int>{allocator, 1};
+    node.visit(visitor);
+    CHECK(visited == "int 1;");
+    CHECK(node.as<int>() == 42);
+
+    std::as_const(node).visit(visitor);
+    CHECK(visited == "int 1;const int 42;");
+
+    const Token token{Lexeme{}, SourceLocation{}, "a"};
+    node = token;
+    node.visit(visitor);
+    CHECK(visited == "int 1;const int 42;token a;");
+}
+
 } // namespace CPPS::CST
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+
+#include "cpps/cst.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source-reader.hpp"
+#include "cpps/tokens.hpp"
+#include "cpps/utility/thread-pool.hpp"
+#include "cpps-corpus-generator/generator.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+void checkSameDiagnoses(const Diagnosis& serial, const Diagnosis& parallel)
+{
+    REQUIRE(serial.getErrors().size() == parallel.getErrors().size());
+    REQUIRE(serial.getWarnings().size() == parallel.getWarnings().size());
+
+    for (std::size_t i = 0; i < serial.getErrors().size(); ++i)
+    {
+        CHECK(serial.getErrors()[i].message.str() == parallel.getErrors()[i].message.str());
+        CHECK(serial.getErrors()[i].location == parallel.getErrors()[i].location);
+    }
+
+    CHECK(serial.getErrorsCount() == parallel.getErrorsCount());
+
+    const std::optional<Diagnosis::SkippedWork> serialSkippedWork = serial.getSkippedWork(Diagnosis::Phase::Parse);
+    const std::optional<Diagnosis::SkippedWork> parallelSkippedWork = parallel.getSkippedWork(Diagnosis::Phase::Parse);
+
+    REQUIRE(serialSkippedWork.has_value() == parallelSkippedWork.has_value());
+
+    if (serialSkippedWork)
+    {
+        CHECK(serialSkippedWork->processedCount == parallelSkippedWork->processedCount);
+        CHECK(serialSkippedWork->skippedCount == parallelSkippedWork->skippedCount);
+    }
+}
+
+// the nodes point to the same tokens, their locations are compared
+void checkSameDeclarations(const TranslationUnit& serial, const TranslationUnit& parallel)
+{
+    REQUIRE(serial.declarations.size() == parallel.declarations.size());
+
+    for (std::size_t i = 0; i < serial.declarations.size(); ++i)
+    {
+        const Declaration& serialDeclaration = serial.declarations[i];
+        const Declaration& parallelDeclaration = parallel.declarations[i];
+
+        CHECK(serialDeclaration.startLocation == parallelDeclaration.startLocation);
+        CHECK(serialDeclaration.equalLocation == parallelDeclaration.equalLocation);
+        CHECK(serialDeclaration.endLocation == parallelDeclaration.endLocation);
+        CHECK(serialDeclaration.type.is<FunctionSignature>() == parallelDeclaration.type.is<FunctionSignature>());
+        CHECK(serialDeclaration.initializer.has_value() == parallelDeclaration.initializer.has_value());
+    }
+}
+
+void checkSameParse(const std::string& text, std::size_t errorLimit, bool failFast)
+{
+    Diagnosis readDiagnosis;
+
+    std::istringstream stream{text};
+
+    SourceReader reader{readDiagnosis, stream};
+
+    const std::optional<Source> source = reader.read();
+
+    REQUIRE(source.has_value());
+
+    Lexer lexer{readDiagnosis, *source};
+
+    const Tokens tokens = lexer.lex();
+
+    auto makeDiagnosis = [errorLimit, failFast] {
+        Diagnosis diagnosis;
+        diagnosis.setErrorLimit(errorLimit);
+        diagnosis.setFailFast(failFast);
+        return diagnosis;
+    };
+
+    Diagnosis serialDiagnosis = makeDiagnosis();
+    Parser serialParser{serialDiagnosis, tokens};
+
+    const TranslationUnit serialTu = serialParser.parse();
+
+    ThreadPool pool{4};
+
+    Diagnosis parallelDiagnosis = makeDiagnosis();
+    Parser parallelParser{parallelDiagnosis, tokens};
+
+    const TranslationUnit parallelTu = parallelParser.parse(pool);
+
+    checkSameDiagnoses(serialDiagnosis, parallelDiagnosis);
+    checkSameDeclarations(serialTu, parallelTu);
+}
+
+} // namespace
+
+TEST_CASE("Parallel parse", "[CST]")
+{
+    Corpus::GeneratorOptions options;
+    options.seed = GENERATE(as<std::uint64_t>{}, 1, 2, 3);
+    options.linesCount = 4000;
+
+    SECTION("valid")
+    {
+        options.statementDepth = GENERATE(as<std::size_t>{}, 0, 4);
+
+        const Corpus::GeneratedCorpus corpus = Corpus::Generator{options}.generate();
+
+        checkSameParse(corpus.text, Diagnosis::NoErrorLimit, false);
+    }
+
+    SECTION("invalid")
+    {
+        options.invalidPercent = GENERATE(as<std::size_t>{}, 1, 20);
+
+        const bool failFast = GENERATE(false, true);
+        const std::size_t errorLimit = GENERATE(as<std::size_t>{}, 1, 3);
+
+        const Corpus::GeneratedCorpus corpus = Corpus::Generator{options}.generate();
+
+        checkSameParse(corpus.text, errorLimit, failFast);
+    }
+
+    SECTION("small")
+    {
+        checkSameParse("a: int = 1;\nf: () = { b: int = 2; }\n", Diagnosis::NoErrorLimit, false);
+    }
+}
+
+TEST_CASE("Parallel parse allocator stats", "[CST], [AllocatorStats]")
+{
+    Corpus::GeneratorOptions options;
+    options.seed = 1;
+    options.linesCount = 4000;
+
+    const Corpus::GeneratedCorpus corpus = Corpus::Generator{options}.generate();
+
+    Diagnosis diagnosis;
+
+    std::istringstream stream{corpus.text};
+
+    SourceReader reader{diagnosis, stream};
+
+    const std::optional<Source> source = reader.read();
+
+    REQUIRE(source.has_value());
+
+    Lexer lexer{diagnosis, *source};
+
+    const Tokens tokens = lexer.lex();
+
+    ThreadPool pool{4};
+
+    Parser parser{diagnosis, tokens};
+
+    const TranslationUnit tu = parser.parse(pool);
+
+    REQUIRE(diagnosis.getErrors().empty());
+    REQUIRE(!tu.mergedAllocators.empty());
+
+#if defined(CPPS_ENABLE_ALLOCATOR_STATS)
+    const AllocatorStats stats = tu.getAllocatorStats();
+
+    std::size_t allocationsCount = tu.allocator.getStats().getAllocationsCount();
+
+    for (const TranslationUnit::Allocator& mergedAllocator : tu.mergedAllocators)
+    {
+        CHECK(mergedAllocator.getStats().getAllocationsCount() > 0);
+
+        allocationsCount += mergedAllocator.getStats().getAllocationsCount();
+    }
+
+    CHECK(stats.getAllocationsCount() == allocationsCount);
+    CHECK(tu.dumpAllocatorStats() == stats.dump());
+#else
+    CHECK(tu.dumpAllocatorStats().empty());
+#endif
+}
+
+} // namespace CPPS::CST
@@ -1,5 +1,10 @@
+#include <array>
 #include <catch2/catch_test_macros.hpp>
+#include <cstddef>
 #include <fmt/format.h>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <tuple>
 
 #include "cpps/check-diagnosis.hpp"
@@ -52,11 +57,19 @@ const T& getAs(auto& value)
     return value.template as<T>();
 }
 
+const BasicExpression& getBasic(const Node<Expression>& expression)
+{
+    REQUIRE(expression);
+    REQUIRE(expression->isBasic());
+
+    return expression->getBasic(expression->getRoot());
+}
+
 void checkTerm(const ExpressionTerm& term, ParameterModifier parameterModifier, std::string_view value)
 {
     CHECK(term.modifier == parameterModifier);
 
-    const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(term.expression->assignment->primary->type);
+    const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(getBasic(term.expression).primary->type);
     const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(identifierExpression.identifier.type);
 
     CHECK(unqualifiedIdentifier.identifier.get().text == value);
@@ -277,7 +290,7 @@ TEST_CASE("parser return statement", "[Parser], [CST]")
 
         REQUIRE(returnStatement.expression);
 
-        CHECK(getAs<Token>(returnStatement.expression->assignment->primary->type).text == "42");
+        CHECK(getAs<Token>(getBasic(returnStatement.expression).primary->type).text == "42");
     }
 
     SECTION("empty")
@@ -320,7 +333,7 @@ TEST_CASE("Parser expression statement", "[Parser], [CST]")
 
     CHECK(expressionStatement.hasSemicolon);
 
-    CHECK(getAs<Token>(expressionStatement.expression->assignment->primary->type).text == "42");
+    CHECK(getAs<Token>(getBasic(expressionStatement.expression).primary->type).text == "42");
 }
 
 TEST_CASE("Parser assignation expression", "[Parser], [CST]")
@@ -347,18 +360,21 @@ TEST_CASE("Parser assignation expression", "[Parser], [CST]")
 
         CHECK(expressionStatement.hasSemicolon);
 
-        REQUIRE(expressionStatement.expression->assignment->terms.size() == 1);
+        const Expression& expression = *expressionStatement.expression;
 
-        const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(
-            getAs<IdentifierExpression>(expressionStatement.expression->assignment->primary->type).identifier.type);
+        REQUIRE(expression.operations.size() == 3);
 
-        CHECK(unqualifiedIdentifier.identifier.get().text == lhs_v);
+        const Expression::Operation& root = expression.getRoot();
 
-        const AssignmentExpression::Term& term = expressionStatement.expression->assignment->terms[0];
+        CHECK(root.kind == Expression::Kind::Assignment);
+        CHECK(root.op->get().lexeme == punctuator);
 
-        CHECK(term.op.get().lexeme == punctuator);
+        const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(
+            getAs<IdentifierExpression>(expression.getBasic(expression.getLhs(root)).primary->type).identifier.type);
+
+        CHECK(unqualifiedIdentifier.identifier.get().text == lhs_v);
 
-        CHECK(getAs<Token>(term.primary->type).text == rhs_v);
+        CHECK(getAs<Token>(expression.getBasic(expression.getRhs(root)).primary->type).text == rhs_v);
     };
 
     check("=", "my_var = 4;", "my_var", Punctuator::Assignment, "4");
@@ -376,29 +392,46 @@ TEST_CASE("Parser assignation expression", "[Parser], [CST]")
 
 TEST_CASE("Parser binary expression", "[Parser], [CST]")
 {
-    auto check = []<typename Expression>(std::string info, std::string code, std::string_view lhs_v, Punctuator punctuator, std::string_view rhs_v, Expression* = nullptr) {
+    auto check = []<typename TypedExpressionT>(std::string info, std::string code, std::string_view lhs_v, Punctuator punctuator, std::string_view rhs_v, TypedExpressionT* = nullptr) {
         INFO(info);
 
-        const auto [source, diagnosis, tokens, tu] = parse(std::move(code));
+        auto [source, diagnosis, tokens, tu] = parse(std::move(code));
 
         checkNoErrorOrWarning(diagnosis);
 
-        const Declaration& declaration = tu.declarations.back();
+        Declaration& declaration = tu.declarations.back();
 
-        const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
+        REQUIRE(declaration.initializer.value()->type.is<ExpressionStatement>());
+
+        ExpressionStatement& expressionStatement = declaration.initializer.value()->type.as<ExpressionStatement>();
 
         CHECK(expressionStatement.hasSemicolon);
 
-        CHECK(getAs<Token>(expressionStatement.expression->assignment->primary->type).text == lhs_v);
+        const Expression& expression = *expressionStatement.expression;
+
+        REQUIRE(expression.operations.size() == 3);
+
+        const Expression::Operation& root = expression.getRoot();
+
+        CHECK(root.op->get().lexeme == punctuator);
+        CHECK(getAs<Token>(expression.getBasic(expression.getLhs(root)).primary->type).text == lhs_v);
+        CHECK(getAs<Token>(expression.getBasic(expression.getRhs(root)).primary->type).text == rhs_v);
 
-        const Expression& expression = *expressionStatement.expression->assignment;
+        const Node<AssignmentExpression> assignment = makeTypedExpression(tu.allocator, expression);
+        const TypedExpressionT& typed = *assignment;
 
-        REQUIRE(expression.terms.size() == 1);
+        // the typed view references the basic-expressions, the expression is unchanged
+        CHECK(typed.basic == &expression.getBasic(expression.getLhs(root)));
+        CHECK(getAs<Token>(typed.basic->primary->type).text == lhs_v);
+        CHECK(getAs<Token>(expression.getBasic(expression.getLhs(root)).primary->type).text == lhs_v);
 
-        const auto& term = expression.terms[0];
+        REQUIRE(typed.terms.size() == 1);
+
+        const auto& term = typed.terms[0];
 
         CHECK(term.op.get().lexeme == punctuator);
-        CHECK(getAs<Token>(term.primary->type).text == rhs_v);
+        CHECK(term.basic == &expression.getBasic(expression.getRhs(root)));
+        CHECK(getAs<Token>(term.basic->primary->type).text == rhs_v);
     }; // NOLINT(readability/braces)
 
     check("*", "my_var: int = 4 * 2;", "4", Punctuator::Multiply, "2", static_cast<MultiplicativeExpression*>(nullptr));
@@ -421,6 +454,117 @@ TEST_CASE("Parser binary expression", "[Parser], [CST]")
     check("||", "my_var: int = 4 || 2;", "4", Punctuator::LogicalOr, "2", static_cast<LogicalOrExpression*>(nullptr));
 }
 
+TEST_CASE("Parser binary expression precedence", "[Parser], [CST]")
+{
+    auto getExpression = [](TranslationUnit& tu) -> Expression& {
+        REQUIRE(tu.declarations.back().initializer.value()->type.is<CompoundStatement>());
+
+        CompoundStatement& compoundStatement = tu.declarations.back().initializer.value()->type.as<CompoundStatement>();
+
+        REQUIRE(compoundStatement.size() == 1);
+        REQUIRE(compoundStatement[0].type.is<ExpressionStatement>());
+
+        return *compoundStatement[0].type.as<ExpressionStatement>().expression;
+    };
+
+    auto getText = [](const Expression& expression, const Expression::Operation& operation) {
+        return getAs<IdentifierExpression>(expression.getBasic(operation).primary->type).identifier.type.as<UnqualifiedIdentifier>().identifier.get().text;
+    };
+
+    SECTION("left associative")
+    {
+        auto [source, diagnosis, tokens, tu] = parse("f: () = { a - b - c; }");
+
+        checkNoErrorOrWarning(diagnosis);
+
+        const Expression& expression = getExpression(tu);
+
+        // (a - b) - c
+        const Expression::Operation& root = expression.getRoot();
+        const Expression::Operation& lhs = expression.getLhs(root);
+
+        CHECK(root.kind == Expression::Kind::Additive);
+        CHECK(lhs.kind == Expression::Kind::Additive);
+        CHECK(getText(expression, expression.getLhs(lhs)) == "a");
+        CHECK(getText(expression, expression.getRhs(lhs)) == "b");
+        CHECK(getText(expression, expression.getRhs(root)) == "c");
+    }
+
+    SECTION("right associative")
+    {
+        auto [source, diagnosis, tokens, tu] = parse("f: () = { a = b += c; }");
+
+        checkNoErrorOrWarning(diagnosis);
+
+        const Expression& expression = getExpression(tu);
+
+        // a = (b += c)
+        const Expression::Operation& root = expression.getRoot();
+        const Expression::Operation& rhs = expression.getRhs(root);
+
+        CHECK(root.op->get().lexeme == Punctuator::Assignment);
+        CHECK(rhs.op->get().lexeme == Punctuator::PlusEqual);
+        CHECK(getText(expression, expression.getLhs(root)) == "a");
+        CHECK(getText(expression, expression.getLhs(rhs)) == "b");
+        CHECK(getText(expression, expression.getRhs(rhs)) == "c");
+    }
+
+    SECTION("precedence")
+    {
+        auto [source, diagnosis, tokens, tu] = parse("f: () = { a + b * c == d; }");
+
+        checkNoErrorOrWarning(diagnosis);
+
+        const Expression& expression = getExpression(tu);
+
+        // (a + (b * c)) == d
+        const Expression::Operation& root = expression.getRoot();
+        const Expression::Operation& additive = expression.getLhs(root);
+        const Expression::Operation& multiplicative = expression.getRhs(additive);
+
+        CHECK(root.kind == Expression::Kind::Equality);
+        CHECK(additive.kind == Expression::Kind::Additive);
+        CHECK(multiplicative.kind == Expression::Kind::Multiplicative);
+        CHECK(getText(expression, expression.getLhs(additive)) == "a");
+        CHECK(getText(expression, expression.getLhs(multiplicative)) == "b");
+        CHECK(getText(expression, expression.getRhs(multiplicative)) == "c");
+        CHECK(getText(expression, expression.getRhs(root)) == "d");
+
+        // the basic-expressions are in source order
+        REQUIRE(expression.basics.size() == 4);
+        CHECK(&expression.basics[0] == &expression.getBasic(expression.getLhs(additive)));
+        CHECK(&expression.basics[3] == &expression.getBasic(expression.getRhs(root)));
+    }
+
+    SECTION("typed view")
+    {
+        auto [source, diagnosis, tokens, tu] = parse("f: () = { a = b = c - d - e; }");
+
+        checkNoErrorOrWarning(diagnosis);
+
+        const Expression& expression = getExpression(tu);
+
+        const Node<AssignmentExpression> assignment = makeTypedExpression(tu.allocator, expression);
+
+        // a, = b, = c - d - e
+        REQUIRE(assignment->terms.size() == 2);
+        CHECK(assignment->terms[1].op.get().lexeme == Punctuator::Assignment);
+
+        const AdditiveExpression& additive = assignment->terms[1];
+
+        REQUIRE(additive.terms.size() == 2);
+        CHECK(additive.terms[0].op.get().lexeme == Punctuator::Minus);
+        CHECK(additive.terms[1].op.get().lexeme == Punctuator::Minus);
+
+        // built again from the unchanged expression
+        const Node<AssignmentExpression> rebuilt = makeTypedExpression(tu.allocator, expression);
+
+        REQUIRE(rebuilt->terms.size() == 2);
+        CHECK(rebuilt->basic == assignment->basic);
+        CHECK(getText(expression, expression.getLhs(expression.getRoot())) == "a");
+    }
+}
+
 TEST_CASE("Parser prefix expression", "[Parser], [CST]")
 {
     auto check = [](std::string info, std::string_view code, Punctuator punctuator) {
@@ -432,12 +576,12 @@ TEST_CASE("Parser prefix expression", "[Parser], [CST]")
 
         const Declaration& declaration = tu.declarations.back();
         const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-        const PrefixExpression& prefix = *expressionStatement.expression->assignment->prefix;
+        const PrefixExpression& prefix = *getBasic(expressionStatement.expression).prefix;
 
         REQUIRE(prefix.ops.size() == 1);
         CHECK(prefix.ops[0].get().lexeme == punctuator);
 
-        const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(expressionStatement.expression->assignment->primary->type);
+        const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(getBasic(expressionStatement.expression).primary->type);
         const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(identifierExpression.identifier.type);
 
         CHECK(unqualifiedIdentifier.identifier.get().text == "i");
@@ -461,12 +605,12 @@ TEST_CASE("Parser postfix", "[Parser], [CST]")
 
             const Declaration& declaration = tu.declarations.back();
             const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-            const PostfixExpression& postfix = *expressionStatement.expression->assignment->postfix;
+            const PostfixExpression& postfix = *getBasic(expressionStatement.expression).postfix;
 
             REQUIRE(postfix.terms.size() == 1);
             CHECK(postfix.terms[0].op.get().lexeme == punctuator);
 
-            const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(expressionStatement.expression->assignment->primary->type);
+            const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(getBasic(expressionStatement.expression).primary->type);
             const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(identifierExpression.identifier.type);
 
             CHECK(unqualifiedIdentifier.identifier.get().text == "i");
@@ -487,19 +631,18 @@ TEST_CASE("Parser postfix", "[Parser], [CST]")
 
         const Declaration& declaration = tu.declarations.back();
         const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-        const PostfixExpression& postfix = *expressionStatement.expression->assignment->postfix;
+        const PostfixExpression& postfix = *getBasic(expressionStatement.expression).postfix;
 
         REQUIRE(postfix.terms.size() == 1);
 
         const PostfixExpression::Term& term = postfix.terms[0];
 
-        REQUIRE(term.closeOp);
+        REQUIRE(term.arguments);
 
         CHECK(term.op.get().lexeme == Punctuator::OpenBracket);
-        CHECK(term.closeOp->get().lexeme == Punctuator::CloseBracket);
+        CHECK(term.arguments->closeOp.get().lexeme == Punctuator::CloseBracket);
 
-        REQUIRE(term.expressions);
-        const ExpressionList& expressions = *term.expressions;
+        const ExpressionList& expressions = term.arguments->expressions;
 
         CHECK(expressions.openParenthesisLocation == SourceLocation{0, 21});
         CHECK(expressions.closeParenthesisLocation == SourceLocation{0, 26});
@@ -520,18 +663,18 @@ TEST_CASE("Parser postfix", "[Parser], [CST]")
 
             const Declaration& declaration = tu.declarations.back();
             const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-            const PostfixExpression& postfix = *expressionStatement.expression->assignment->postfix;
+            const PostfixExpression& postfix = *getBasic(expressionStatement.expression).postfix;
 
             REQUIRE(postfix.terms.size() == 1);
 
             const PostfixExpression::Term& term = postfix.terms[0];
 
-            REQUIRE(term.closeOp);
+            REQUIRE(term.arguments);
 
             CHECK(term.op.get().lexeme == Punctuator::OpenParenthesis);
-            CHECK(term.closeOp.value().get().lexeme == Punctuator::CloseParenthesis);
+            CHECK(term.arguments->closeOp.get().lexeme == Punctuator::CloseParenthesis);
 
-            const ExpressionList& expressions = *term.expressions;
+            const ExpressionList& expressions = term.arguments->expressions;
 
             CHECK(expressions.openParenthesisLocation == SourceLocation{0, 21});
             CHECK(expressions.closeParenthesisLocation == SourceLocation{0, 22});
@@ -546,18 +689,18 @@ TEST_CASE("Parser postfix", "[Parser], [CST]")
 
             const Declaration& declaration = tu.declarations.back();
             const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-            const PostfixExpression& postfix = *expressionStatement.expression->assignment->postfix;
+            const PostfixExpression& postfix = *getBasic(expressionStatement.expression).postfix;
 
             REQUIRE(postfix.terms.size() == 1);
 
             const PostfixExpression::Term& term = postfix.terms[0];
 
-            REQUIRE(term.closeOp);
+            REQUIRE(term.arguments);
 
             CHECK(term.op.get().lexeme == Punctuator::OpenParenthesis);
-            CHECK(term.closeOp.value().get().lexeme == Punctuator::CloseParenthesis);
+            CHECK(term.arguments->closeOp.get().lexeme == Punctuator::CloseParenthesis);
 
-            const ExpressionList& expressions = *term.expressions;
+            const ExpressionList& expressions = term.arguments->expressions;
 
             CHECK(expressions.openParenthesisLocation == SourceLocation{0, 21});
             CHECK(expressions.closeParenthesisLocation == SourceLocation{0, 26});
@@ -576,20 +719,57 @@ TEST_CASE("Parser postfix", "[Parser], [CST]")
 
             const Declaration& declaration = tu.declarations.back();
             const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-            const PostfixExpression& postfix = *expressionStatement.expression->assignment->postfix;
+            const PostfixExpression& postfix = *getBasic(expressionStatement.expression).postfix;
 
             REQUIRE(postfix.terms.size() == 1);
 
             const PostfixExpression::Term& term = postfix.terms[0];
 
             CHECK(term.op.get().lexeme == Punctuator::Dot);
-            CHECK_FALSE(term.closeOp.has_value());
+            CHECK_FALSE(term.arguments);
 
             const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(term.identifierExpression->identifier.type);
 
             CHECK(unqualifiedIdentifier.identifier.get().text == "my_member");
         }
     }
+
+    SECTION("chain")
+    {
+        const auto [source, diagnosis, tokens, tu] = parse(R"(my_var: int = a.b(c)[d].e()++;)");
+
+        checkNoErrorOrWarning(diagnosis);
+
+        const Declaration& declaration = tu.declarations.back();
+        const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
+        const PostfixExpression& postfix = *getBasic(expressionStatement.expression).postfix;
+
+        const std::array punctuators{
+            Punctuator::Dot,
+            Punctuator::OpenParenthesis,
+            Punctuator::OpenBracket,
+            Punctuator::Dot,
+            Punctuator::OpenParenthesis,
+            Punctuator::PlusPlus};
+
+        REQUIRE(postfix.terms.size() == punctuators.size());
+
+        std::size_t i = 0;
+
+        for (const PostfixExpression::Term& term : postfix.terms)
+        {
+            const bool isCall = punctuators[i] == Punctuator::OpenParenthesis || punctuators[i] == Punctuator::OpenBracket;
+
+            CHECK(term.op.get().lexeme == punctuators[i]);
+            CHECK(static_cast<bool>(term.identifierExpression) == (punctuators[i] == Punctuator::Dot));
+            CHECK(static_cast<bool>(term.arguments) == isCall);
+
+            ++i;
+        }
+
+        REQUIRE(postfix.terms[2].arguments);
+        CHECK(postfix.terms[2].arguments->closeOp.get().location == SourceLocation{0, 22});
+    }
 }
 
 TEST_CASE("Parser primary-expression", "[Parser], [CST]")
@@ -604,7 +784,7 @@ TEST_CASE("Parser primary-expression", "[Parser], [CST]")
 
             const Declaration& declaration = tu.declarations.back();
             const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-            const PrimaryExpression& primaryExpression = *expressionStatement.expression->assignment->primary;
+            const PrimaryExpression& primaryExpression = *getBasic(expressionStatement.expression).primary;
 
             CHECK(getAs<Token>(primaryExpression.type).lexeme == BooleanLiteral::True);
         }
@@ -617,7 +797,7 @@ TEST_CASE("Parser primary-expression", "[Parser], [CST]")
 
             const Declaration& declaration = tu.declarations.back();
             const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-            const PrimaryExpression& primaryExpression = *expressionStatement.expression->assignment->primary;
+            const PrimaryExpression& primaryExpression = *getBasic(expressionStatement.expression).primary;
 
             CHECK(getAs<Token>(primaryExpression.type).lexeme == PointerLiteral::NullPtr);
         }
@@ -647,11 +827,11 @@ TEST_CASE("Parser primary-expression", "[Parser], [CST]")
 
         const Declaration& declaration = tu.declarations.back();
         const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-        const ExpressionList& expressions = getAs<ExpressionList>(expressionStatement.expression->assignment->primary->type);
+        const ExpressionList& expressions = getAs<ExpressionList>(getBasic(expressionStatement.expression).primary->type);
 
         REQUIRE(expressions.size() == 1);
 
-        const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(expressions[0].expression->assignment->primary->type);
+        const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(getBasic(expressions[0].expression).primary->type);
         const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(identifierExpression.identifier.type);
 
         CHECK(unqualifiedIdentifier.identifier.get().text == "i");
@@ -668,7 +848,7 @@ TEST_CASE("Parser primary-expression", "[Parser], [CST]")
             const Declaration& declaration = tu.declarations.back();
 
             const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-            const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(expressionStatement.expression->assignment->primary->type);
+            const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(getBasic(expressionStatement.expression).primary->type);
             const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(identifierExpression.identifier.type);
 
             CHECK(unqualifiedIdentifier.identifier.get().text == "i");
@@ -685,18 +865,20 @@ TEST_CASE("Parser expression list", "[Parser], [CST]")
     const Declaration& declaration = tu.declarations.back();
 
     const ExpressionStatement& expressionStatement = getAs<ExpressionStatement>(declaration.initializer.value()->type);
-    const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(expressionStatement.expression->assignment->primary->type);
+    const IdentifierExpression& identifierExpression = getAs<IdentifierExpression>(getBasic(expressionStatement.expression).primary->type);
     const UnqualifiedIdentifier& unqualifiedIdentifier = getAs<UnqualifiedIdentifier>(identifierExpression.identifier.type);
 
     CHECK(unqualifiedIdentifier.identifier.get().text == "my_func");
 
-    REQUIRE(expressionStatement.expression->assignment->postfix->terms.size() == 1);
+    REQUIRE(getBasic(expressionStatement.expression).postfix->terms.size() == 1);
 
-    const auto& term = expressionStatement.expression->assignment->postfix->terms[0];
+    const auto& term = getBasic(expressionStatement.expression).postfix->terms[0];
 
     CHECK(term.op.get().lexeme == Punctuator::OpenParenthesis);
 
-    const ExpressionList& expressions = *term.expressions;
+    REQUIRE(term.arguments);
+
+    const ExpressionList& expressions = term.arguments->expressions;
 
     REQUIRE(expressions.size() == 3);
 
@@ -860,4 +1042,254 @@ TEST_CASE("Parser diagnosis unnamed function at expression scope cannot returns
     checkError(diagnosis, Parser::DiagnosisMessage::unnamedFunctionAtExpressionScopeCannotReturnsMultipleValues(), SourceLocation{0, 21});
 }
 
+TEST_CASE("Parser diagnosis invalid declaration", "[Parser], [CST]")
+{
+    const auto [source, diagnosis, tokens, tu] = parse("my_var int = 0;");
+
+    checkNoWarning(diagnosis);
+    checkError(diagnosis, Parser::DiagnosisMessage::invalidDeclaration(), SourceLocation{0, 0});
+}
+
+// a declaration may report several errors, each damaged declaration reports at least one
+TEST_CASE("Parser recovery", "[Parser], [CST], [Diagnosis]")
+{
+    auto check = [](const auto& parsed, std::size_t declarationsCount, std::size_t damagedRegionsCount) {
+        const auto& [source, diagnosis, tokens, tu] = parsed;
+
+        checkNoWarning(diagnosis);
+
+        CHECK(tu.declarations.size() == declarationsCount);
+        CHECK(tu.damagedRegions.size() == damagedRegionsCount);
+        CHECK(diagnosis.getErrorsCount() >= damagedRegionsCount);
+        CHECK_FALSE(diagnosis.getSkippedWork(Diagnosis::Phase::Parse).has_value());
+    };
+
+    SECTION("semicolon")
+    {
+        const auto parsed = parse("a: int = 1;", "b: int = c.;", "d: int = 2;", "e: int = f[];", "g: int = 3;");
+
+        check(parsed, 4, 1);
+
+        const auto& [source, diagnosis, tokens, tu] = parsed;
+
+        checkError(diagnosis, Parser::DiagnosisMessage::dotMustFollowedByValidMemberName(), SourceLocation{1, 10});
+        checkError(diagnosis, Parser::DiagnosisMessage::subscriptExpressionBracketEmpty(), SourceLocation{3, 10});
+
+        CHECK(tu.damagedRegions[0].beginLocation == SourceLocation{3, 0});
+        CHECK(tu.damagedRegions[0].endLocation == SourceLocation{3, 12});
+        CHECK(tu.declarations[3].startLocation == SourceLocation{4, 0});
+    }
+
+    SECTION("balanced brace")
+    {
+        const auto parsed = parse("f: () -> int = {", "    x: int = (1;", "    return x;", "}", "a: int = 1;");
+
+        check(parsed, 1, 1);
+
+        const auto& [source, diagnosis, tokens, tu] = parsed;
+
+        CHECK(tu.damagedRegions[0].endLocation == SourceLocation{3, 0});
+        CHECK(tu.declarations[0].startLocation == SourceLocation{4, 0});
+    }
+
+    SECTION("missing semicolon")
+    {
+        const auto parsed = parse("a: int = 1", "b: int = 2;", "c: int = (3;", "d: int = 4;");
+
+        check(parsed, 2, 2);
+
+        const auto& [source, diagnosis, tokens, tu] = parsed;
+
+        checkError(diagnosis, Parser::DiagnosisMessage::missingSemicolonAtEndStatement(), SourceLocation{1, 0});
+        checkError(diagnosis, Parser::DiagnosisMessage::unexpectedTextAfterExpressionList(), SourceLocation{2, 11});
+
+        CHECK(tu.damagedRegions[0].endLocation == SourceLocation{0, 9});
+        CHECK(tu.damagedRegions[1].beginLocation == SourceLocation{2, 0});
+        CHECK(tu.damagedRegions[1].endLocation == SourceLocation{2, 11});
+    }
+
+    SECTION("stray tokens")
+    {
+        check(parse("} ; a: int = 1;", "x y", "b: int = 2;"), 2, 3);
+    }
+}
+
+// each unbalanced declaration fails far beyond its own tokens, its declarations are then parsed again
+TEST_CASE("Parser recovery budget", "[Parser], [CST], [Diagnosis]")
+{
+    constexpr std::size_t LinesCount{5'000};
+
+    auto check = [](std::string_view line) {
+        Diagnosis diagnosis;
+
+        Source source;
+        source.add("a: int = 1;", Source::Line::Type::Cpps);
+
+        for (std::size_t i = 0; i < LinesCount; ++i)
+        {
+            source.add(std::string{line}, Source::Line::Type::Cpps);
+        }
+
+        Lexer lexer{diagnosis, source};
+
+        const Tokens tokens = lexer.lex();
+
+        checkNoErrorOrWarning(diagnosis);
+
+        Parser parser{diagnosis, tokens};
+
+        const TranslationUnit tu = parser.parse();
+
+        CHECK(tu.declarations.size() == 1);
+
+        // the parse stops at the declaration which exceeds the budget
+        const std::optional<Diagnosis::SkippedWork> skipped = diagnosis.getSkippedWork(Diagnosis::Phase::Parse);
+
+        REQUIRE(skipped.has_value());
+        REQUIRE(skipped->skippedCount > 0);
+        CHECK(skipped->processedCount + skipped->skippedCount == tokens.size());
+
+        const SourceLocation stopLocation = tokens.at(skipped->processedCount).location;
+
+        checkError(diagnosis, Parser::DiagnosisMessage::recoveryBudgetExceeded(), stopLocation);
+
+        // the rest of the input is damaged
+        REQUIRE_FALSE(tu.damagedRegions.empty());
+        CHECK(tu.damagedRegions.back().beginLocation == stopLocation);
+        CHECK(tu.damagedRegions.back().endLocation == tokens.at(tokens.size() - 1).location);
+    };
+
+    SECTION("braces")
+    {
+        check("f: () = {");
+    }
+
+    SECTION("parentheses and braces")
+    {
+        check("b: int = (:() = {");
+    }
+}
+
+TEST_CASE("Parser nesting depth", "[Parser], [CST], [Diagnosis]")
+{
+    auto nest = [](std::string_view open, std::string_view inner, std::string_view close, std::size_t depth) {
+        std::string text;
+
+        for (std::size_t i = 0; i < depth; ++i)
+        {
+            text += open;
+        }
+
+        text += inner;
+
+        for (std::size_t i = 0; i < depth; ++i)
+        {
+            text += close;
+        }
+
+        return text;
+    };
+
+    // the statement of the initializer and its expression are the first two levels
+    constexpr std::size_t MaxParenthesesDepth = Parser::MaxNestingDepth - 2;
+
+    SECTION("parentheses")
+    {
+        const auto [source, diagnosis, tokens, tu] = parse("a: int = " + nest("(", "1", ")", MaxParenthesesDepth) + ";");
+
+        checkNoErrorOrWarning(diagnosis);
+        CHECK(tu.declarations.size() == 1);
+    }
+
+    SECTION("too deep parentheses")
+    {
+        const auto [source, diagnosis, tokens, tu] = parse("a: int = " + nest("(", "1", ")", MaxParenthesesDepth + 1) + ";", "b: int = 2;");
+
+        checkNoWarning(diagnosis);
+        checkError(diagnosis, Parser::DiagnosisMessage::nestingTooDeep(Parser::MaxNestingDepth), SourceLocation{0, static_cast<SourceColumn>(9 + MaxParenthesesDepth + 1)});
+
+        // only the deepest level reports
+        CHECK(diagnosis.getErrorsCount() == 1);
+
+        REQUIRE(tu.declarations.size() == 1);
+        CHECK(tu.declarations[0].startLocation == SourceLocation{1, 0});
+        CHECK(tu.damagedRegions.size() == 1);
+    }
+
+    SECTION("too deep compound statements")
+    {
+        const auto [source, diagnosis, tokens, tu] = parse("f: () = " + nest("{", "", "}", Parser::MaxNestingDepth + 1), "b: int = 2;");
+
+        checkNoWarning(diagnosis);
+        CHECK(diagnosis.getErrorsCount() == 1);
+        CHECK(tu.declarations.size() == 1);
+    }
+
+    SECTION("too deep calls and parameters")
+    {
+        const auto [source, diagnosis, tokens, tu] = parse(
+            "a: int = " + nest("f(", "1", ")", MaxParenthesesDepth + 1) + ";",
+            "g: " + nest("(x: ", "int", ")", Parser::MaxNestingDepth + 1) + " = 0;",
+            "b: int = 2;");
+
+        checkNoWarning(diagnosis);
+        CHECK(diagnosis.getErrorsCount() == 2);
+        CHECK(tu.declarations.size() == 1);
+        CHECK(tu.damagedRegions.size() == 2);
+    }
+
+    SECTION("adversarial")
+    {
+        const auto [source, diagnosis, tokens, tu] = parse("a: int = " + nest("(", "1", ")", 100'000) + ";", "b: int = 2;");
+
+        CHECK(diagnosis.getErrorsCount() == 1);
+        CHECK(tu.declarations.size() == 1);
+    }
+}
+
+TEST_CASE("Parser fail fast", "[Parser], [CST], [Diagnosis]")
+{
+    Diagnosis diagnosis;
+
+    Source source;
+    source.add("a: int = 0;", Source::Line::Type::Cpps);
+    source.add("b: int = 0;", Source::Line::Type::Cpps);
+
+    Lexer lexer{diagnosis, source};
+
+    const Tokens tokens = lexer.lex();
+
+    checkNoErrorOrWarning(diagnosis);
+
+    SECTION("previous phase error")
+    {
+        diagnosis.setFailFast(true);
+        diagnosis.error("previous phase error");
+
+        Parser parser{diagnosis, tokens};
+
+        const TranslationUnit tu = parser.parse();
+
+        CHECK(tu.declarations.empty());
+
+        const std::optional<Diagnosis::SkippedWork> skipped = diagnosis.getSkippedWork(Diagnosis::Phase::Parse);
+
+        REQUIRE(skipped.has_value());
+        CHECK(skipped->processedCount == 0);
+        CHECK(skipped->skippedCount == tokens.size());
+    }
+
+    SECTION("no fail fast")
+    {
+        diagnosis.error("previous phase error");
+
+        Parser parser{diagnosis, tokens};
+
+        const TranslationUnit tu = parser.parse();
+
+        CHECK(tu.declarations.size() == 2);
+        CHECK_FALSE(diagnosis.getSkippedWork(Diagnosis::Phase::Parse).has_value());
+    }
+}
+
 } // namespace CPPS
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "cpps/check-diagnosis.hpp"
+#include "cpps/cst.hpp"
+#include "cpps/cst/parser.hpp"
+#include "cpps/cst/walker.hpp"
+#include "cpps/diagnosis.hpp"
+#include "cpps/lexer.hpp"
+#include "cpps/source.hpp"
+#include "cpps/tokens.hpp"
+
+namespace CPPS::CST {
+
+namespace {
+
+// records the declarations, the expressions and the primary tokens
+class Recorder : public ConstWalker<Recorder>
+{
+public:
+    explicit Recorder(bool skipFunctions)
+        : _skipFunctions(skipFunctions)
+    {
+    }
+
+    [[nodiscard]] const std::string& getTrace() const
+    {
+        return _trace;
+    }
+
+private:
+    friend class Walker<Recorder, true>;
+
+    bool pre(const Declaration& declaration)
+    {
+        _trace += "{";
+
+        return !_skipFunctions || !declaration.type.is<FunctionSignature>();
+    }
+
+    void post(const Declaration&)
+    {
+        _trace += "}";
+    }
+
+    void pre(const Expression&)
+    {
+        _trace += "(";
+    }
+
+    void post(const Expression&)
+    {
+        _trace += ")";
+    }
+
+    void pre(const Token& token)
+    {
+        _trace += token.text;
+    }
+
+    void post(const UnqualifiedIdentifier& identifier)
+    {
+        _trace += identifier.identifier.get().text;
+    }
+
+private:
+    bool _skipFunctions;
+
+    std::string _trace;
+};
+
+// counts the expressions and the deepest one
+class DepthCounter : public ConstWalker<DepthCounter>
+{
+private:
+    friend class Walker<DepthCounter, true>;
+
+    void pre(const Expression&)
+    {
+        ++count;
+        ++depth;
+        maxDepth = std::max(maxDepth, depth);
+    }
+
+    void post(const Expression&)
+    {
+        --depth;
+    }
+
+public:
+    std::size_t count{0};
+    std::size_t depth{0};
+    std::size_t maxDepth{0};
+};
+
+// counts the basic-expressions of a literal
+class LiteralCounter : public Walker<LiteralCounter>
+{
+private:
+    friend class Walker<LiteralCounter>;
+
+    void post(BasicExpression& expression)
+    {
+        if (expression.primary->type.is<Token>())
+        {
+            ++count;
+        }
+    }
+
+public:
+    std::size_t count{0};
+};
+
+// a ConstWalker which hook takes a non-const node, never called
+class NonConstHook : public ConstWalker<NonConstHook>
+{
+private:
+    friend class Walker<NonConstHook, true>;
+
+    void pre(Expression&) {}
+};
+
+// a hook for a type which is not walked, next to a matching one
+class UnwalkedHook : public Walker<UnwalkedHook>
+{
+private:
+    friend class Walker<UnwalkedHook>;
+
+    void post(Expression&) {}
+
+    void post(Expression::Operation&) {}
+};
+
+// a template hook matches every node
+class TemplateHook : public ConstWalker<TemplateHook>
+{
+private:
+    friend class Walker<TemplateHook, true>;
+
+    template<typename T>
+    void pre(T&)
+    {
+    }
+};
+
+static_assert(Recorder::hasCallableHooks());
+static_assert(LiteralCounter::hasCallableHooks());
+static_assert(TemplateHook::hasCallableHooks());
+static_assert(!NonConstHook::hasCallableHooks());
+static_assert(!UnwalkedHook::hasCallableHooks());
+
+struct Parsed
+{
+    Source source;
+    Tokens tokens;
+    TranslationUnit translationUnit;
+};
+
+void parse(Parsed& parsed, std::string_view code)
+{
+    Diagnosis diagnosis;
+
+    parsed.source.add(std::string(code), Source::Line::Type::Cpps);
+
+    Lexer lexer{diagnosis, parsed.source};
+    parsed.tokens = lexer.lex();
+
+    Parser parser{diagnosis, parsed.tokens};
+    parsed.translationUnit = parser.parse();
+
+    checkNoErrorOrWarning(diagnosis);
+}
+
+} // namespace
+
+TEST_CASE("Walker order", "[Walker], [CST]")
+{
+    Parsed parsed;
+    parse(parsed, "a: int = 1 + b * 2; f: (x: int) -> int = { return x * (3 - c); }");
+
+    Recorder recorder{false};
+    recorder.walk(parsed.translationUnit);
+
+    CHECK(recorder.getTrace() == "{aint(1b2)}{f{xint}int(x(3c))}");
+}
+
+TEST_CASE("Walker skips the children", "[Walker], [CST]")
+{
+    Parsed parsed;
+    parse(parsed, "a: int = 1; f: () = { g(2); } b: int = h(3, 4);");
+
+    Recorder recorder{true};
+    recorder.walk(parsed.translationUnit);
+
+    // the skipped declaration is not left either
+    CHECK(recorder.getTrace() == "{aint(1)}{{bint(h(3)(4))}");
+}
+
+TEST_CASE("Walker deep tree", "[Walker], [CST]")
+{
+    // the deepest parentheses the parser accepts
+    const std::size_t depth = Parser::MaxNestingDepth - 2;
+
+    Parsed parsed;
+    parse(parsed, "a: int = " + std::string(depth, '(') + "1" + std::string(depth, ')') + ";");
+
+    DepthCounter counter;
+    counter.walk(parsed.translationUnit);
+
+    CHECK(counter.count == depth + 1);
+    CHECK(counter.maxDepth == depth + 1);
+    CHECK(counter.depth == 0);
+
+    // the stack is reused
+    counter.walk(std::as_const(parsed.translationUnit));
+
+    CHECK(counter.count == 2 * (depth + 1));
+}
+
+TEST_CASE("Walker non const", "[Walker], [CST]")
+{
+    Parsed parsed;
+    parse(parsed, "a: int = 1 + f(2, x); b: int = (3);");
+
+    LiteralCounter counter;
+    counter.walk(parsed.translationUnit);
+
+    // 1, 2 and the 3 inside the parentheses
+    CHECK(counter.count == 3);
+}
+
+} // namespace CPPS::CST
@@ -1,4 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "cpps/diagnosis.hpp"
 
@@ -91,4 +95,135 @@ TEST_CASE("Diagnosis", "[Diagnosis]")
     CHECK(warnings[5].location.value() == SourceLocation{1, 1});
 }
 
+TEST_CASE("Diagnosis::Message", "[Diagnosis]")
+{
+    using Message = Diagnosis::Message;
+
+    SECTION("static text")
+    {
+        const Message message{"unexpected }"};
+
+        CHECK(message.str() == "unexpected }");
+    }
+
+    SECTION("owned text")
+    {
+        const Message message{std::string{"owned {}"}};
+
+        CHECK(message.str() == "owned {}");
+    }
+
+    SECTION("format")
+    {
+        CHECK(Message{"char '{}'", 'a'}.str() == "char 'a'");
+        CHECK(Message{"size {}", std::size_t{42}}.str() == "size 42");
+        CHECK(Message{"text {}", std::string_view{"abc"}}.str() == "text abc");
+        CHECK(Message{"{} and {}", 'x', std::size_t{7}}.str() == "x and 7");
+        CHECK(Message{"escaped {{}} {}", 'c'}.str() == "escaped {} c");
+    }
+
+    SECTION("arguments")
+    {
+        STATIC_REQUIRE(std::is_constructible_v<Message, const char*, std::string_view>);
+        STATIC_REQUIRE(std::is_constructible_v<Message, const char*, const char*>);
+        STATIC_REQUIRE(std::is_constructible_v<Message, const char*, std::size_t>);
+        STATIC_REQUIRE_FALSE(std::is_constructible_v<Message, const char*, std::string>);
+    }
+
+    SECTION("comparison")
+    {
+        CHECK(Message{"size {}", std::size_t{42}} == "size 42");
+        CHECK(Message{"size {}", std::size_t{42}} == Message{std::string{"size 42"}});
+        CHECK_FALSE(Message{"size {}", std::size_t{42}} == "size 43");
+    }
+
+    SECTION("detach")
+    {
+        std::string text{"abc"};
+
+        Message message{"text {}", std::string_view{text}};
+        message.detach();
+
+        text = "xyz";
+
+        CHECK(message.str() == "text abc");
+    }
+
+    SECTION("fmt")
+    {
+        CHECK(fmt::format("[{}]", Message{"size {}", std::size_t{42}}) == "[size 42]");
+    }
+}
+
+TEST_CASE("Diagnosis error limit", "[Diagnosis]")
+{
+    Diagnosis diagnosis;
+
+    diagnosis.setErrorLimit(2);
+
+    diagnosis.error("error 0");
+    diagnosis.error("error 1");
+    diagnosis.error("error 2");
+    diagnosis.warning("warning 0");
+
+    CHECK(diagnosis.getErrors().size() == 2);
+    CHECK(diagnosis.getWarnings().size() == 1);
+    CHECK(diagnosis.getErrorsCount() == 3);
+    CHECK(diagnosis.getDroppedErrorsCount() == 1);
+
+    CHECK_FALSE(diagnosis.shouldStop());
+
+    diagnosis.setFailFast(true);
+
+    CHECK(diagnosis.shouldStop());
+}
+
+TEST_CASE("Diagnosis fail fast", "[Diagnosis]")
+{
+    Diagnosis diagnosis;
+
+    diagnosis.setFailFast(true);
+
+    SECTION("without limit")
+    {
+        CHECK_FALSE(diagnosis.shouldStop());
+
+        diagnosis.warning("warning");
+
+        CHECK_FALSE(diagnosis.shouldStop());
+
+        diagnosis.error("error");
+
+        CHECK(diagnosis.shouldStop());
+    }
+
+    SECTION("with limit")
+    {
+        diagnosis.setErrorLimit(2);
+
+        diagnosis.error("error 0");
+
+        CHECK_FALSE(diagnosis.shouldStop());
+
+        diagnosis.error("error 1");
+
+        CHECK(diagnosis.shouldStop());
+    }
+
+    SECTION("skipped work")
+    {
+        CHECK_FALSE(diagnosis.getSkippedWork(Diagnosis::Phase::Lex).has_value());
+        CHECK(diagnosis.getSkippedWorkSummary().empty());
+
+        diagnosis.skip(Diagnosis::Phase::Lex, {.processedCount = 3, .skippedCount = 7});
+
+        REQUIRE(diagnosis.getSkippedWork(Diagnosis::Phase::Lex).has_value());
+        CHECK(diagnosis.getSkippedWork(Diagnosis::Phase::Lex)->processedCount == 3);
+        CHECK(diagnosis.getSkippedWork(Diagnosis::Phase::Lex)->skippedCount == 7);
+        CHECK_FALSE(diagnosis.getSkippedWork(Diagnosis::Phase::Parse).has_value());
+
+        CHECK(diagnosis.getSkippedWorkSummary() == "lex: stopped after 3 lines, 7 lines skipped\n");
+    }
+}
+
 } // namespace CPPS
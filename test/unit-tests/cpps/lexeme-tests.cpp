@@ -16,7 +16,11 @@ void check(std::size_t typeCount, auto typeGetter)
         CHECK(lexeme.is<T>());
         CHECK((lexeme.*typeGetter)() == value);
         CHECK(lexeme == value);
+        CHECK(Lexeme::isData(lexeme.getData()));
     }
+
+    // the value after the last one
+    CHECK_FALSE(Lexeme::isData(Lexeme{static_cast<T>(typeCount - 1)}.getData() + 0x0100));
 }
 
 TEST_CASE("Lexeme", "[Lexeme]")
@@ -29,6 +33,14 @@ TEST_CASE("Lexeme", "[Lexeme]")
     check<Punctuator>(PunctuatorCount, &Lexeme::get<Punctuator>);
 }
 
+TEST_CASE("Lexeme data", "[Lexeme]")
+{
+    CHECK(Lexeme::isData(Lexeme{}.getData()));
+    CHECK(Lexeme::isData(Lexeme{BinaryLiteral{}}.getData()));
+    CHECK_FALSE(Lexeme::isData(Lexeme{BinaryLiteral{}}.getData() + 0x0100));
+    CHECK_FALSE(Lexeme::isData(0x00FE));
+}
+
 TEST_CASE("Lexeme format", "[Lexeme]")
 {
     CHECK(fmt::format("{}", Lexeme{}) == "invalid");
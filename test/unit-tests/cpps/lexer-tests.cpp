@@ -74,7 +74,7 @@ void check(auto lexeme, std::string_view base)
     }
 }
 
-void checkErrors(std::vector<std::string> expectedDiagnosisMessages, std::string_view base)
+void checkErrors(std::vector<Diagnosis::Message> expectedDiagnosisMessages, std::string_view base)
 {
     INFO(fmt::format("based on {}", base));
 
@@ -120,7 +120,7 @@ void checkErrors(std::vector<std::string> expectedDiagnosisMessages, std::string
     }
 }
 
-void checkError(std::string expectedDiagnosisMessage, std::string_view base)
+void checkError(Diagnosis::Message expectedDiagnosisMessage, std::string_view base)
 {
     checkErrors(std::vector{std::move(expectedDiagnosisMessage)}, base);
 }
@@ -143,6 +143,7 @@ TEST_CASE("Lexer BinaryLiteral", "[Lexer]")
     check(BinaryLiteral{}, "0B01");
     check(BinaryLiteral{}, "0b0'1");
     check(BinaryLiteral{}, "0B0'1");
+    check(BinaryLiteral{}, "0b01u");
 }
 
 TEST_CASE("Lexer BooleanLiteral", "[Lexer]")
@@ -175,6 +176,15 @@ TEST_CASE("Lexer DecimalLiteral", "[Lexer]")
 {
     check(DecimalLiteral{}, "012345679");
     check(DecimalLiteral{}, "012'345'679");
+
+    // integer-suffix
+    check(DecimalLiteral{}, "1u");
+    check(DecimalLiteral{}, "1U");
+    check(DecimalLiteral{}, "1l");
+    check(DecimalLiteral{}, "1LL");
+    check(DecimalLiteral{}, "1ul");
+    check(DecimalLiteral{}, "1LLU");
+    check(DecimalLiteral{}, "1'000ull");
 }
 
 TEST_CASE("Lexer FloatingLiteral", "[Lexer]")
@@ -196,6 +206,7 @@ TEST_CASE("Lexer HexadecimalLiteral", "[Lexer]")
     check(HexadecimalLiteral{}, "0x0'F");
     check(HexadecimalLiteral{}, "0x0ab1022f");
     check(HexadecimalLiteral{}, "0x0ab1022F");
+    check(HexadecimalLiteral{}, "0xffUL");
 }
 
 TEST_CASE("Lexer Keyword", "[Lexer]")
@@ -415,4 +426,29 @@ TEST_CASE("Lexer source is empty", "[Lexer]")
     CHECK(tokens.empty());
 }
 
+TEST_CASE("Lexer fail fast", "[Lexer], [Diagnosis]")
+{
+    Diagnosis diagnosis;
+    Source source;
+
+    source.add("@", Source::Line::Type::Cpps);
+    source.add("a: int = 0;", Source::Line::Type::Cpps);
+    source.add("b: int = 0;", Source::Line::Type::Cpps);
+
+    diagnosis.setFailFast(true);
+
+    Lexer lexer{diagnosis, source};
+
+    const Tokens tokens{lexer.lex()};
+
+    CHECK(diagnosis.getErrors().size() == 1);
+    CHECK(tokens.empty());
+
+    const std::optional<Diagnosis::SkippedWork> skipped = diagnosis.getSkippedWork(Diagnosis::Phase::Lex);
+
+    REQUIRE(skipped.has_value());
+    CHECK(skipped->processedCount == 1);
+    CHECK(skipped->skippedCount == 2);
+}
+
 } // namespace CPPS
@@ -231,4 +231,23 @@ TEST_CASE("SourceReader diagnosis", "[Diagnosis], [SourceReader]")
     }
 }
 
+TEST_CASE("SourceReader fail fast", "[Diagnosis], [SourceReader]")
+{
+    std::stringstream stream{"}\nint a;\n"};
+
+    Diagnosis diagnosis;
+    diagnosis.setFailFast(true);
+
+    SourceReader sourceReader{diagnosis, stream};
+
+    CHECK_FALSE(sourceReader.read().has_value());
+    CHECK(diagnosis.getErrors().size() == 1);
+
+    const std::optional<Diagnosis::SkippedWork> skipped = diagnosis.getSkippedWork(Diagnosis::Phase::Read);
+
+    REQUIRE(skipped.has_value());
+    CHECK(skipped->processedCount == 2);
+    CHECK(skipped->skippedCount == 7);
+}
+
 } // namespace CPPS
@@ -0,0 +1,47 @@
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+
+#include "cpps/utility/allocation-counter.hpp"
+
+namespace CPPS {
+
+TEST_CASE("AllocationCounter", "[AllocationCounter]")
+{
+    const AllocationCount start = AllocationCounter::getThreadCount();
+
+    AllocationCounter::onAllocate(16);
+    AllocationCounter::onAllocate(32);
+
+    const AllocationCount count = AllocationCounter::getThreadCount() - start;
+
+    CHECK(count.count >= 2);
+    CHECK(count.bytesCount >= 48);
+
+    SECTION("per thread")
+    {
+        AllocationCount otherThreadCount;
+
+        std::thread thread{[&otherThreadCount] {
+            const AllocationCount otherStart = AllocationCounter::getThreadCount();
+            AllocationCounter::onAllocate(8);
+            otherThreadCount = AllocationCounter::getThreadCount() - otherStart;
+        }};
+
+        thread.join();
+
+        CHECK(otherThreadCount.count >= 1);
+        CHECK(otherThreadCount.bytesCount >= 8);
+    }
+}
+
+TEST_CASE("AllocationCount", "[AllocationCounter]")
+{
+    AllocationCount count{.count = 1, .bytesCount = 10};
+
+    count += AllocationCount{.count = 2, .bytesCount = 20};
+
+    CHECK(count == AllocationCount{.count = 3, .bytesCount = 30});
+    CHECK(count - AllocationCount{.count = 1, .bytesCount = 5} == AllocationCount{.count = 2, .bytesCount = 25});
+}
+
+} // namespace CPPS
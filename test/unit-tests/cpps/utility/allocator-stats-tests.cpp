@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+
+#include "cpps/cst/node.hpp"
+#include "cpps/utility/allocator-stats.hpp"
+#include "cpps/utility/bump-pointer-allocator.hpp"
+
+namespace CPPS {
+
+struct StatsObject
+{
+    std::uint64_t value{0};
+};
+
+TEST_CASE("getTypeName", "[AllocatorStats], [Allocator]")
+{
+    CHECK(getTypeName<int>() == "int");
+    CHECK(getTypeName<StatsObject>() == "CPPS::StatsObject");
+}
+
+TEST_CASE("AllocatorStats", "[AllocatorStats], [Allocator]")
+{
+    constexpr std::size_t BlockCapacity = 32;
+
+    BumpPointerAllocator<BlockCapacity, HeapBlockPolicy, AllocatorStats> allocator;
+
+    const AllocatorStats& stats = allocator.getStats();
+
+    SECTION("allocations per type")
+    {
+        StatsObject* object0 = allocator.allocate<StatsObject>();
+        StatsObject* object1 = allocator.allocate<StatsObject>();
+        std::uint8_t* byte = allocator.allocate<std::uint8_t>();
+
+        CHECK(object0);
+        CHECK(object1);
+        CHECK(byte);
+
+        CHECK(stats.getAllocationsCount() == 3);
+        CHECK(stats.getAllocatedBytesCount() == sizeof(StatsObject) * 2 + sizeof(std::uint8_t));
+
+        const std::vector<AllocatorStats::TypeStats> types = stats.getTypeStats();
+
+        REQUIRE(types.size() == 2);
+
+        CHECK(types[0].name == "CPPS::StatsObject");
+        CHECK(types[0].allocationsCount == 2);
+        CHECK(types[0].bytesCount == sizeof(StatsObject) * 2);
+
+        CHECK(types[1].allocationsCount == 1);
+        CHECK(types[1].bytesCount == sizeof(std::uint8_t));
+    }
+
+    SECTION("node")
+    {
+        CST::Node<StatsObject> node{allocator};
+
+        const std::vector<AllocatorStats::TypeStats> types = stats.getTypeStats();
+
+        REQUIRE(types.size() == 1);
+        CHECK(types[0].name == "CPPS::StatsObject");
+    }
+
+    SECTION("padding")
+    {
+        std::uint8_t* byte = allocator.allocate<std::uint8_t>();
+        StatsObject* object = allocator.allocate<StatsObject>();
+
+        CHECK(byte);
+        CHECK(object);
+
+        CHECK(stats.getPaddingBytesCount() == alignof(StatsObject) - sizeof(std::uint8_t));
+    }
+
+    SECTION("fragmentation")
+    {
+        std::uint8_t* byte = allocator.allocate<std::uint8_t>();
+        void* big = allocator.allocate(BlockCapacity, 1);
+
+        CHECK(byte);
+        CHECK(big);
+
+        CHECK(allocator.getBlockCount() == 2);
+        CHECK(stats.getFragmentationBytesCount() == BlockCapacity - sizeof(std::uint8_t));
+    }
+
+    SECTION("reclaimed and abandoned")
+    {
+        StatsObject* object0 = allocator.allocate<StatsObject>();
+        StatsObject* object1 = allocator.allocate<StatsObject>();
+
+        allocator.deallocate(object0);
+
+        CHECK(stats.getAbandonedBytesCount() == sizeof(StatsObject));
+        CHECK(stats.getReclaimedBytesCount() == 0);
+
+        allocator.deallocate(object1);
+
+        CHECK(stats.getAbandonedBytesCount() == sizeof(StatsObject));
+        CHECK(stats.getReclaimedBytesCount() == sizeof(StatsObject));
+    }
+
+    SECTION("peak")
+    {
+        StatsObject* object0 = allocator.allocate<StatsObject>();
+        allocator.deallocate(object0);
+
+        StatsObject* object1 = allocator.allocate<StatsObject>();
+
+        CHECK(object0 == object1);
+        CHECK(stats.getPeakBytesCount() == sizeof(StatsObject));
+    }
+
+    SECTION("reclaimed with its padding")
+    {
+        std::uint8_t* byte = allocator.allocate<std::uint8_t>();
+        StatsObject* object = allocator.allocate<StatsObject>();
+
+        CHECK(byte);
+
+        CHECK(stats.getLiveBytesCount() == alignof(StatsObject) + sizeof(StatsObject));
+
+        allocator.deallocate(object);
+
+        CHECK(stats.getReclaimedBytesCount() == sizeof(StatsObject));
+        CHECK(stats.getLiveBytesCount() == sizeof(std::uint8_t));
+    }
+
+    SECTION("add")
+    {
+        BumpPointerAllocator<BlockCapacity, HeapBlockPolicy, AllocatorStats> otherAllocator;
+
+        StatsObject* object = allocator.allocate<StatsObject>();
+        StatsObject* otherObject = otherAllocator.allocate<StatsObject>();
+        std::uint8_t* otherByte = otherAllocator.allocate<std::uint8_t>();
+
+        CHECK(object);
+        CHECK(otherObject);
+        CHECK(otherByte);
+
+        AllocatorStats total = stats;
+        total.add(otherAllocator.getStats());
+
+        CHECK(total.getAllocationsCount() == 3);
+        CHECK(total.getAllocatedBytesCount() == sizeof(StatsObject) * 2 + sizeof(std::uint8_t));
+        CHECK(total.getLiveBytesCount() == stats.getLiveBytesCount() + otherAllocator.getStats().getLiveBytesCount());
+
+        const std::vector<AllocatorStats::TypeStats> types = total.getTypeStats();
+
+        REQUIRE(types.size() == 2);
+
+        CHECK(types[0].name == "CPPS::StatsObject");
+        CHECK(types[0].allocationsCount == 2);
+        CHECK(types[1].allocationsCount == 1);
+    }
+
+    SECTION("dump")
+    {
+        StatsObject* object = allocator.allocate<StatsObject>();
+
+        CHECK(object);
+
+        const std::string dump = stats.dump();
+
+        CHECK(dump.find("CPPS::StatsObject") != std::string::npos);
+    }
+}
+
+} // namespace CPPS
@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+
+#include "cpps/utility/arena-stack.hpp"
+
+namespace CPPS {
+
+TEST_CASE("ArenaStack push pop", "[ArenaStack], [Allocator]")
+{
+    ArenaStack<std::size_t, 4> stack;
+
+    CHECK(stack.empty());
+    CHECK(stack.getChunkCount() == 0);
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        stack.push(i);
+
+        CHECK(stack.top() == i);
+    }
+
+    CHECK(stack.size() == 10);
+    CHECK(stack.getChunkCount() == 3);
+
+    for (std::size_t i = 10; i-- > 0;)
+    {
+        CHECK(stack.top() == i);
+        CHECK(stack.pop() == i);
+    }
+
+    CHECK(stack.empty());
+}
+
+TEST_CASE("ArenaStack chunk boundary", "[ArenaStack], [Allocator]")
+{
+    ArenaStack<int, 2> stack;
+
+    stack.push(0);
+    stack.push(1);
+    stack.push(2);
+
+    // the last chunk is empty, the top is in the previous one
+    CHECK(stack.pop() == 2);
+    CHECK(stack.top() == 1);
+
+    stack.push(3);
+    CHECK(stack.top() == 3);
+
+    CHECK(stack.pop() == 3);
+    CHECK(stack.pop() == 1);
+    CHECK(stack.pop() == 0);
+    CHECK(stack.empty());
+}
+
+TEST_CASE("ArenaStack reuses the chunks", "[ArenaStack], [Allocator]")
+{
+    ArenaStack<int, 8> stack;
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            stack.push(i);
+        }
+
+        while (!stack.empty())
+        {
+            static_cast<void>(stack.pop());
+        }
+
+        CHECK(stack.getChunkCount() == 13);
+    }
+}
+
+} // namespace CPPS
@@ -1,3 +1,4 @@
+#include <array>
 #include <catch2/catch_test_macros.hpp>
 #include <cstdint>
 
@@ -98,4 +99,90 @@ TEST_CASE("BumpPointerAllocator memory usage", "[BumpPointerAllocator], [Allocat
     CHECK(allocator.getUsedBytesCount() == BlockCapacity + sizeof(int));
 }
 
+TEST_CASE("BumpPointerAllocator block policy", "[BumpPointerAllocator], [Allocator]")
+{
+    auto check = []<typename AllocatorT>(AllocatorT& allocator) {
+        constexpr std::size_t ObjectsCount = 3;
+
+        std::array<Object*, ObjectsCount> objects{};
+
+        for (Object*& object : objects)
+        {
+            object = allocator.template allocate<Object>();
+
+            REQUIRE(object);
+            CHECK(reinterpret_cast<std::uintptr_t>(object) % alignof(Object) == 0);
+
+            *object = Object{};
+        }
+
+        CHECK(allocator.getBlockCount() == ObjectsCount);
+        CHECK(allocator.getUsedBytesCount() == allocator.getBlockCapacity() * (ObjectsCount - 1) + sizeof(Object));
+
+        for (const Object* object : objects)
+        {
+            CHECK(object->value3 == 3);
+        }
+    };
+
+    SECTION("heap")
+    {
+        BumpPointerAllocator<sizeof(Object), HeapBlockPolicy> allocator;
+        check(allocator);
+    }
+
+    SECTION("small blocks of the huge page policies, on the heap")
+    {
+        static_assert(!isHugePageBlock(sizeof(Object)));
+
+        BumpPointerAllocator<sizeof(Object), HugePageBlockPolicy<HugePages::Transparent>> transparentAllocator;
+        check(transparentAllocator);
+
+        BumpPointerAllocator<sizeof(Object), HugePageBlockPolicy<HugePages::Explicit, true>> explicitAllocator;
+        check(explicitAllocator);
+    }
+}
+
+TEST_CASE("BumpPointerAllocator huge page blocks", "[BumpPointerAllocator], [Allocator]")
+{
+    static_assert(isHugePageBlock(HugePageSize));
+
+    auto check = []<typename AllocatorT>(AllocatorT& allocator) {
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            auto* bytes = static_cast<std::byte*>(allocator.allocate(HugePageSize, 1));
+            REQUIRE(bytes);
+
+#if defined(__linux__)
+            // aligned for the huge pages to back the whole block
+            CHECK(reinterpret_cast<std::uintptr_t>(bytes) % HugePageSize == 0);
+#endif
+
+            bytes[0] = std::byte{1};
+            bytes[HugePageSize - 1] = std::byte{2};
+        }
+
+        CHECK(allocator.getBlockCount() == 2);
+    };
+
+    SECTION("transparent")
+    {
+        BumpPointerAllocator<HugePageSize, HugePageBlockPolicy<HugePages::Transparent>> allocator;
+        check(allocator);
+    }
+
+    SECTION("transparent, pre-faulted")
+    {
+        BumpPointerAllocator<HugePageSize, HugePageBlockPolicy<HugePages::Transparent, true>> allocator;
+        check(allocator);
+    }
+
+    SECTION("explicit, pre-faulted")
+    {
+        // fallback to transparent huge pages without a huge pages pool
+        BumpPointerAllocator<HugePageSize, HugePageBlockPolicy<HugePages::Explicit, true>> allocator;
+        check(allocator);
+    }
+}
+
 } // namespace CPPS
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "cpps/utility/output-sink.hpp"
+
+namespace CPPS {
+
+namespace {
+
+struct FileCloser
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+std::string readAll(std::FILE* file)
+{
+    std::fflush(file);
+    std::rewind(file);
+
+    std::string text;
+
+    for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file))
+    {
+        text += static_cast<char>(c);
+    }
+
+    return text;
+}
+
+} // namespace
+
+TEST_CASE("OutputSink", "[OutputSink]")
+{
+    File file{std::tmpfile()};
+    REQUIRE(file != nullptr);
+
+    SECTION("buffered until flushed")
+    {
+        OutputSink sink{file.get(), 16};
+
+        sink.write("abc");
+        sink.write('d');
+
+        CHECK(sink.getSize() == 4);
+        CHECK(readAll(file.get()).empty());
+
+        CHECK(sink.flush());
+        CHECK(readAll(file.get()) == "abcd");
+    }
+
+    SECTION("a full buffer is written")
+    {
+        OutputSink sink{file.get(), 4};
+
+        sink.write("abc");
+        sink.write("de");
+
+        CHECK(readAll(file.get()) == "abc");
+
+        for (char c : std::string_view{"fgh"})
+        {
+            sink.write(c);
+        }
+
+        CHECK(readAll(file.get()) == "abcdefg");
+
+        CHECK(sink.flush());
+        CHECK(readAll(file.get()) == "abcdefgh");
+        CHECK(sink.getSize() == 8);
+    }
+
+    SECTION("a large text is written with the buffer")
+    {
+        OutputSink sink{file.get(), 4};
+
+        sink.write("ab");
+        sink.write("0123456789");
+
+        CHECK(readAll(file.get()) == "ab0123456789");
+
+        sink.write("cd");
+
+        CHECK(sink.getSize() == 14);
+    }
+
+    SECTION("flushed when destroyed")
+    {
+        {
+            OutputSink sink{file.get()};
+
+            sink.write("text");
+            sink.write('\n');
+        }
+
+        CHECK(readAll(file.get()) == "text\n");
+    }
+
+    SECTION("after the text written to the file")
+    {
+        std::fputs("before ", file.get());
+
+        {
+            OutputSink sink{file.get(), 4};
+
+            sink.write("sink");
+        }
+
+        CHECK(readAll(file.get()) == "before sink");
+    }
+}
+
+} // namespace CPPS
@@ -0,0 +1,25 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+
+#include "cpps/utility/thread-cpu-clock.hpp"
+
+namespace CPPS {
+
+TEST_CASE("ThreadCpuClock", "[ThreadCpuClock]")
+{
+    const ThreadCpuClock::time_point start = ThreadCpuClock::now();
+
+    // busy loop until the thread consumed some cpu time
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    volatile std::size_t sink{0};
+
+    while (ThreadCpuClock::now() == start && std::chrono::steady_clock::now() - wallStart < std::chrono::seconds{1})
+    {
+        sink = sink + 1;
+    }
+
+    CHECK(ThreadCpuClock::now() > start);
+}
+
+} // namespace CPPS
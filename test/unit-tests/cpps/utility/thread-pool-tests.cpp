@@ -0,0 +1,92 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "cpps/utility/thread-pool.hpp"
+
+namespace CPPS {
+
+TEST_CASE("ThreadPool", "[ThreadPool]")
+{
+    constexpr std::size_t TasksCount{1000};
+
+    SECTION("threads count")
+    {
+        CHECK(ThreadPool{0}.getThreadsCount() == 1);
+        CHECK(ThreadPool{3}.getThreadsCount() == 3);
+        CHECK(ThreadPool::getDefaultThreadsCount() >= 1);
+    }
+
+    SECTION("all tasks executed once")
+    {
+        std::vector<std::atomic<std::size_t>> counts(TasksCount);
+
+        ThreadPool pool{4};
+
+        for (std::size_t i = 0; i < TasksCount; ++i)
+        {
+            pool.submit([&counts, i] { ++counts[i]; });
+        }
+
+        pool.wait();
+
+        for (const std::atomic<std::size_t>& count : counts)
+        {
+            CHECK(count == 1);
+        }
+    }
+
+    SECTION("nested submit")
+    {
+        std::atomic<std::size_t> count{0};
+
+        ThreadPool pool{4};
+
+        for (std::size_t i = 0; i < TasksCount; ++i)
+        {
+            pool.submit([&pool, &count] {
+                pool.submit([&count] { ++count; });
+                ++count;
+            });
+        }
+
+        pool.wait();
+
+        CHECK(count == TasksCount * 2);
+    }
+
+    SECTION("wait reusable")
+    {
+        std::atomic<std::size_t> count{0};
+
+        ThreadPool pool{2};
+
+        pool.submit([&count] { ++count; });
+        pool.wait();
+
+        CHECK(count == 1);
+
+        pool.submit([&count] { ++count; });
+        pool.wait();
+
+        CHECK(count == 2);
+    }
+
+    SECTION("exception")
+    {
+        std::atomic<std::size_t> count{0};
+
+        ThreadPool pool{2};
+
+        pool.submit([] { throw std::runtime_error{"task failed"}; });
+        pool.submit([&count] { ++count; });
+
+        CHECK_THROWS_AS(pool.wait(), std::runtime_error);
+        CHECK(count == 1);
+
+        CHECK_NOTHROW(pool.wait());
+    }
+}
+
+} // namespace CPPS
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "cpps/utility/trace.hpp"
+
+namespace CPPS {
+
+TEST_CASE("Trace", "[Trace]")
+{
+    SECTION("not started")
+    {
+        Trace::start();
+        Trace::stop();
+
+        CHECK_FALSE(Trace::isStarted());
+
+        bool isDetailMade = false;
+
+        {
+            const ScopedTraceZone zone{"Trace::notStarted"};
+            const ScopedTraceZone detailedZone{"Trace::notStarted", [&isDetailMade] {
+                                                   isDetailMade = true;
+                                                   return std::string{"detail"};
+                                               }};
+        }
+
+        CHECK_FALSE(isDetailMade);
+
+        CHECK(Trace::formatChromeJson().find("Trace::notStarted") == std::string::npos);
+    }
+
+    SECTION("started")
+    {
+        Trace::start();
+
+        CHECK(Trace::isStarted());
+
+        {
+            const ScopedTraceZone zone{"Trace::mainThread", [] { return std::string{"main \"detail\""}; }};
+        }
+
+        std::thread thread{[] {
+            const ScopedTraceZone zone{"Trace::otherThread"};
+        }};
+
+        thread.join();
+
+        Trace::stop();
+
+        const std::string json = Trace::formatChromeJson();
+
+        CHECK(json.starts_with(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+        CHECK(json.find(R"("name":"Trace::mainThread","ph":"X")") != std::string::npos);
+        CHECK(json.find(R"("name":"Trace::otherThread","ph":"X")") != std::string::npos);
+        CHECK(json.find(R"("args":{"detail":"main \"detail\""})") != std::string::npos);
+        CHECK(json.find(R"("name":"thread_name","ph":"M")") != std::string::npos);
+
+        SECTION("restart clears the zones")
+        {
+            Trace::start();
+            Trace::stop();
+
+            CHECK(Trace::formatChromeJson().find("Trace::mainThread") == std::string::npos);
+        }
+    }
+
+    SECTION("restarted while the threads record")
+    {
+        std::atomic<bool> isDone{false};
+
+        Trace::start();
+
+        std::thread thread{[&isDone] {
+            while (!isDone)
+            {
+                const ScopedTraceZone zone{"Trace::restarted"};
+            }
+        }};
+
+        for (int i = 0; i < 100; ++i)
+        {
+            Trace::start();
+        }
+
+        isDone = true;
+        thread.join();
+
+        Trace::stop();
+
+        // the zones recorded before the last start are cleared, the other ones are kept
+        CHECK(Trace::formatChromeJson().ends_with("\n]}\n"));
+    }
+}
+
+} // namespace CPPS